@@ -16,6 +16,9 @@
 **/
 
 #include "val_interface.h"
+#include "val_benchmark.h"
+#include "val_soak.h"
+#include "val_stack.h"
 
 /**
   @brief   Entry point to SCMI suite
@@ -30,6 +33,8 @@ void arm_scmi_agent_execute(void *agent_info)
     uint32_t num_pass;
     uint32_t num_fail;
     uint32_t num_skip;
+    SOAK_CONFIG_s soak_config;
+    WATCHDOG_CONFIG_s watchdog_config;
 
     val_print(VAL_PRINT_ERR, "\n\n        **** SCMI Compliance Suite **** ");
 
@@ -37,6 +42,8 @@ void arm_scmi_agent_execute(void *agent_info)
         val_print(VAL_PRINT_ERR, "\n **** INIT FAILED ***");
         return;
     }
+    val_watchdog_get_default_config(&watchdog_config);
+    val_watchdog_init(&watchdog_config);
 
     val_print(VAL_PRINT_ERR, "\n\n          *** Starting BASE tests ***");
     val_base_execute_tests();
@@ -76,6 +83,11 @@ void arm_scmi_agent_execute(void *agent_info)
     val_voltage_execute_tests();
 #endif
 
+#ifdef POWERCAP_PROTOCOL
+    val_print(VAL_PRINT_ERR, "\n\n          *** Starting POWERCAP tests ***  ");
+    val_powercap_execute_tests();
+#endif
+
     num_pass = val_get_test_passed();
     num_fail = val_get_test_failed();
     num_skip = val_get_test_skipped();
@@ -85,7 +97,14 @@ void arm_scmi_agent_execute(void *agent_info)
     val_print(VAL_PRINT_ERR, "    PASSED: %d", num_pass);
     val_print(VAL_PRINT_ERR, "    FAILED: %d", num_fail);
     val_print(VAL_PRINT_ERR, "    SKIPPED: %d", num_skip);
+    if (val_get_test_timed_out())
+        val_print(VAL_PRINT_ERR, "\n  TIMED OUT: %d (counted as failed)", val_get_test_timed_out());
+    val_stack_report();
     val_print(VAL_PRINT_ERR, "\n****************************************************", 0);
 
+    val_watchdog_run_complete();
+    val_soak_get_default_config(&soak_config);
+    val_soak_execute(&soak_config);
+
     val_print(VAL_PRINT_ERR, "\n\n        **** SCMI tests complete **** \n ");
 }
@@ -15,7 +15,154 @@
  * limitations under the License.
 **/
 
+#include <getopt.h>
 #include "val_interface.h"
+#include "val_benchmark.h"
+#include "val_soak.h"
+#include "val_energy_model.h"
+#include "val_perf_replay.h"
+#include "val_baseline.h"
+#include "val_counters.h"
+#include "val_stack.h"
+
+/**
+  @brief   This function prints the command line usage of the test agent
+  @param   name  program name
+  @return  none
+**/
+static void app_print_usage(char *name)
+{
+    printf("\nUsage: %s [options]\n", name);
+    printf("  --soak-duration <sec>     loop the soak test subset for <sec> seconds\n");
+    printf("  --soak-interval <sec>     latency/error report period (default %d)\n",
+           SOAK_INTERVAL_SEC);
+    printf("  --soak-iterations <num>   stop the soak run after <num> iterations\n");
+    printf("  --drift-window <num>      intervals inspected for drift (default %d)\n",
+           SOAK_DEFAULT_DRIFT_WINDOW);
+    printf("  --drift-threshold <pct>   latency rise flagged as drift (default %d)\n",
+           SOAK_DEFAULT_DRIFT_THRESHOLD);
+    printf("  --test-timeout <ms>       per test watchdog budget, 0 disables (default %d)\n",
+           TEST_TIMEOUT_MS);
+    printf("  --checkpoint <file>       record finished tests in <file> and resume from it\n");
+    printf("  --energy-model <file>     write the performance energy model to <file> as JSON\n");
+    printf("  --em-table <file>         write it to <file> as a Linux energy model table\n");
+    printf("  --perf-trace <file>       replay the governor requests in <file>, a CSV of\n");
+    printf("                            time, domain and frequency in kHz\n");
+    printf("  --perf-trace-out <file>   write every replayed request to <file> as CSV\n");
+    printf("  --baseline-save <file>    add the message latencies of this run to <file>\n");
+    printf("  --baseline-compare <file> compare message latencies against <file>, exit 2\n");
+    printf("                            if any regressed\n");
+    printf("  --baseline-threshold <pct> p50/p99 rise flagged as a regression (default %d)\n",
+           BASELINE_DEFAULT_THRESHOLD);
+    printf("  --perf-counters           count cycles, instructions, context switches and\n");
+    printf("                            page faults per message\n");
+    printf("  --help                    print this message\n");
+}
+
+/**
+  @brief   This function parses the command line options of the test agent
+  @param   argc         argument count
+  @param   argv         argument list
+  @param   soak_config      soak configuration filled from the options
+  @param   watchdog_config  watchdog configuration filled from the options
+  @param   baseline_config  baseline store configuration filled from the options
+  @param   perf_counters    1 if per message counters are requested
+  @return  0 on success, 1 if usage was asked for, -1 on invalid option
+**/
+static int app_parse_options(int argc, char *argv[], SOAK_CONFIG_s *soak_config,
+                             WATCHDOG_CONFIG_s *watchdog_config,
+                             BASELINE_CONFIG_s *baseline_config, uint32_t *perf_counters)
+{
+    int opt;
+    const char *em_json_file = NULL, *em_table_file = NULL;
+    const char *perf_trace_file = NULL, *perf_trace_out_file = NULL;
+    static struct option long_options[] = {
+        {"soak-duration",   required_argument, 0, 'd'},
+        {"soak-interval",   required_argument, 0, 'i'},
+        {"soak-iterations", required_argument, 0, 'n'},
+        {"drift-window",    required_argument, 0, 'w'},
+        {"drift-threshold", required_argument, 0, 't'},
+        {"test-timeout",    required_argument, 0, 'T'},
+        {"checkpoint",      required_argument, 0, 'c'},
+        {"energy-model",    required_argument, 0, 'e'},
+        {"em-table",        required_argument, 0, 'E'},
+        {"perf-trace",      required_argument, 0, 'g'},
+        {"perf-trace-out",  required_argument, 0, 'G'},
+        {"baseline-save",   required_argument, 0, 'b'},
+        {"baseline-compare", required_argument, 0, 'B'},
+        {"baseline-threshold", required_argument, 0, 'r'},
+        {"perf-counters",   no_argument,       0, 'P'},
+        {"help",            no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    val_soak_get_default_config(soak_config);
+    val_watchdog_get_default_config(watchdog_config);
+    val_baseline_get_default_config(baseline_config);
+    *perf_counters = 0;
+
+    while ((opt = getopt_long(argc, argv, "d:i:n:w:t:T:c:e:E:g:G:b:B:r:Ph", long_options, NULL)) != -1) {
+        switch (opt)
+        {
+        case 'd':
+            soak_config->duration_sec = strtoul(optarg, NULL, 0);
+            break;
+        case 'i':
+            soak_config->interval_sec = strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            soak_config->max_iterations = strtoul(optarg, NULL, 0);
+            break;
+        case 'w':
+            soak_config->drift_window = strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            soak_config->drift_threshold_pct = strtoul(optarg, NULL, 0);
+            break;
+        case 'T':
+            watchdog_config->test_timeout_ms = strtoul(optarg, NULL, 0);
+            break;
+        case 'c':
+            watchdog_config->checkpoint_file = optarg;
+            break;
+        case 'e':
+            em_json_file = optarg;
+            break;
+        case 'E':
+            em_table_file = optarg;
+            break;
+        case 'g':
+            perf_trace_file = optarg;
+            break;
+        case 'G':
+            perf_trace_out_file = optarg;
+            break;
+        case 'b':
+            baseline_config->save_file = optarg;
+            break;
+        case 'B':
+            baseline_config->compare_file = optarg;
+            break;
+        case 'r':
+            baseline_config->threshold_pct = strtoul(optarg, NULL, 0);
+            break;
+        case 'P':
+            *perf_counters = 1;
+            break;
+        case 'h':
+            app_print_usage(argv[0]);
+            return 1;
+        default:
+            app_print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    val_energy_model_set_files(em_json_file, em_table_file);
+    val_perf_replay_set_files(perf_trace_file, perf_trace_out_file);
+
+    return 0;
+}
 
 /**
   @brief   Entry point to SCMI suite
@@ -30,6 +177,18 @@ int main(int argc, char *argv[])
     uint32_t num_pass;
     uint32_t num_fail;
     uint32_t num_skip;
+    int exit_status = 1;
+    int options;
+    SOAK_CONFIG_s soak_config;
+    WATCHDOG_CONFIG_s watchdog_config;
+    BASELINE_CONFIG_s baseline_config;
+    uint32_t perf_counters;
+
+    options = app_parse_options(argc, argv, &soak_config, &watchdog_config, &baseline_config,
+                                &perf_counters);
+    /* A bad command line fails apart from test results, help alone does not */
+    if (options)
+        return (options < 0) ? 4 : 0;
 
     val_print(VAL_PRINT_ERR, "\n\n        **** SCMI Compliance Suite **** ");
 
@@ -37,6 +196,9 @@ int main(int argc, char *argv[])
         val_print(VAL_PRINT_ERR, "\n **** INIT FAILED ***");
         return 0;
     }
+    val_watchdog_init(&watchdog_config);
+    val_baseline_start(&baseline_config);
+    val_counters_enable(perf_counters);
 
     val_print(VAL_PRINT_ERR, "\n\n          *** Starting BASE tests ***");
     val_base_execute_tests();
@@ -76,6 +238,11 @@ int main(int argc, char *argv[])
     val_voltage_execute_tests();
 #endif
 
+#ifdef POWERCAP_PROTOCOL
+    val_print(VAL_PRINT_ERR, "\n\n          *** Starting POWERCAP tests ***  ");
+    val_powercap_execute_tests();
+#endif
+
     num_pass = val_get_test_passed();
     num_fail = val_get_test_failed();
     num_skip = val_get_test_skipped();
@@ -85,9 +252,23 @@ int main(int argc, char *argv[])
     val_print(VAL_PRINT_ERR, "    PASSED: %d", num_pass);
     val_print(VAL_PRINT_ERR, "    FAILED: %d", num_fail);
     val_print(VAL_PRINT_ERR, "    SKIPPED: %d", num_skip);
+    if (val_get_test_timed_out())
+        val_print(VAL_PRINT_ERR, "\n  TIMED OUT: %d (counted as failed)", val_get_test_timed_out());
+    val_stack_report();
     val_print(VAL_PRINT_ERR, "\n****************************************************", 0);
+    val_counters_report();
+
+    /* A latency regression is reported apart from test failures, for gating */
+    if (val_baseline_complete() != VAL_STATUS_PASS)
+        exit_status = 2;
+
+    val_watchdog_run_complete();
+
+    /* As is a soak run with errors or drift, unless a regression already set the status */
+    if ((val_soak_execute(&soak_config) == VAL_STATUS_FAIL) && (exit_status != 2))
+        exit_status = 3;
 
     val_print(VAL_PRINT_ERR, "\n\n        **** SCMI tests complete **** \n ");
 
-    return 1;
+    return exit_status;
 }
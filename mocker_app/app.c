@@ -15,7 +15,256 @@
  * limitations under the License.
 **/
 
+#include <getopt.h>
 #include "val_interface.h"
+#include "val_benchmark.h"
+#include "val_soak.h"
+#include "val_energy_model.h"
+#include "val_perf_replay.h"
+#include "val_baseline.h"
+#include "val_counters.h"
+#include "val_stack.h"
+#include "pal_socket.h"
+#include "app_parallel.h"
+
+/* Protocols run after the base tests, in the order their logs are printed */
+static const APP_PROTOCOL_s g_app_protocols[] = {
+#ifdef POWER_DOMAIN_PROTOCOL
+    {"POWER",        val_power_domain_execute_tests},
+#endif
+#ifdef SYSTEM_POWER_PROTOCOL
+    {"SYSTEM POWER", val_system_power_execute_tests},
+#endif
+#ifdef PERFORMANCE_PROTOCOL
+    {"PERFORMANCE",  val_performance_execute_tests},
+#endif
+#ifdef CLOCK_PROTOCOL
+    {"CLOCK",        val_clock_execute_tests},
+#endif
+#ifdef SENSOR_PROTOCOL
+    {"SENSOR",       val_sensor_execute_tests},
+#endif
+#ifdef RESET_PROTOCOL
+    {"RESET",        val_reset_execute_tests},
+#endif
+#ifdef VOLTAGE_PROTOCOL
+    {"VOLTAGE",      val_voltage_execute_tests},
+#endif
+#ifdef POWERCAP_PROTOCOL
+    {"POWERCAP",     val_powercap_execute_tests},
+#endif
+    {NULL, NULL}
+};
+
+/**
+  @brief   This function prints the command line usage of the test agent
+  @param   name  program name
+  @return  none
+**/
+static void app_print_usage(char *name)
+{
+    printf("\nUsage: %s [options]\n", name);
+    printf("  --soak-duration <sec>     loop the soak test subset for <sec> seconds\n");
+    printf("  --soak-interval <sec>     latency/error report period (default %d)\n",
+           SOAK_INTERVAL_SEC);
+    printf("  --soak-iterations <num>   stop the soak run after <num> iterations\n");
+    printf("  --drift-window <num>      intervals inspected for drift (default %d)\n",
+           SOAK_DEFAULT_DRIFT_WINDOW);
+    printf("  --drift-threshold <pct>   latency rise flagged as drift (default %d)\n",
+           SOAK_DEFAULT_DRIFT_THRESHOLD);
+    printf("  --test-timeout <ms>       per test watchdog budget, 0 disables (default %d)\n",
+           TEST_TIMEOUT_MS);
+    printf("  --checkpoint <file>       record finished tests in <file> and resume from it\n");
+    printf("  --energy-model <file>     write the performance energy model to <file> as JSON\n");
+    printf("  --em-table <file>         write it to <file> as a Linux energy model table\n");
+    printf("  --perf-trace <file>       replay the governor requests in <file>, a CSV of\n");
+    printf("                            time, domain and frequency in kHz\n");
+    printf("  --perf-trace-out <file>   write every replayed request to <file> as CSV\n");
+    printf("  --baseline-save <file>    add the message latencies of this run to <file>\n");
+    printf("  --baseline-compare <file> compare message latencies against <file>, exit 2\n");
+    printf("                            if any regressed\n");
+    printf("  --baseline-threshold <pct> p50/p99 rise flagged as a regression (default %d)\n",
+           BASELINE_DEFAULT_THRESHOLD);
+    printf("  --perf-counters           count cycles, instructions, context switches and\n");
+    printf("                            page faults per message\n");
+    printf("  --connect <socket>        run against scmi_mocker_server listening on <socket>\n");
+    printf("  --agent-id <id>           agent id to connect as (default: first free)\n");
+    printf("  --virtual-clock           run the in process platform on simulated time\n");
+    printf("  --suspend-us <us>         time the in process platform takes to suspend\n");
+    printf("  --resume-us <us>          time from suspend until it is back up\n");
+    printf("  --jobs <num>              run protocols in <num> worker processes, 0 for one\n");
+    printf("                            per cpu (default 1, in this process)\n");
+    printf("  --help                    print this message\n");
+}
+
+/**
+  @brief   This function parses the command line options of the test agent
+  @param   argc         argument count
+  @param   argv         argument list
+  @param   soak_config      soak configuration filled from the options
+  @param   watchdog_config  watchdog configuration filled from the options
+  @param   baseline_config  baseline store configuration filled from the options
+  @param   perf_counters    1 if per message counters are requested
+  @param   socket_config    mocker server connection filled from the options
+  @param   jobs             number of worker processes filled from the options
+  @return  0 on success, 1 if usage was asked for, -1 on invalid option
+**/
+static int app_parse_options(int argc, char *argv[], SOAK_CONFIG_s *soak_config,
+                             WATCHDOG_CONFIG_s *watchdog_config,
+                             BASELINE_CONFIG_s *baseline_config, uint32_t *perf_counters,
+                             MOCKER_SOCKET_CONFIG_s *socket_config, uint32_t *jobs)
+{
+    int opt;
+    const char *em_json_file = NULL, *em_table_file = NULL;
+    const char *perf_trace_file = NULL, *perf_trace_out_file = NULL;
+    static struct option long_options[] = {
+        {"soak-duration",   required_argument, 0, 'd'},
+        {"soak-interval",   required_argument, 0, 'i'},
+        {"soak-iterations", required_argument, 0, 'n'},
+        {"drift-window",    required_argument, 0, 'w'},
+        {"drift-threshold", required_argument, 0, 't'},
+        {"test-timeout",    required_argument, 0, 'T'},
+        {"checkpoint",      required_argument, 0, 'c'},
+        {"energy-model",    required_argument, 0, 'e'},
+        {"em-table",        required_argument, 0, 'E'},
+        {"perf-trace",      required_argument, 0, 'g'},
+        {"perf-trace-out",  required_argument, 0, 'G'},
+        {"baseline-save",   required_argument, 0, 'b'},
+        {"baseline-compare", required_argument, 0, 'B'},
+        {"baseline-threshold", required_argument, 0, 'r'},
+        {"perf-counters",   no_argument,       0, 'P'},
+        {"connect",         required_argument, 0, 's'},
+        {"agent-id",        required_argument, 0, 'a'},
+        {"virtual-clock",   no_argument,       0, 'V'},
+        {"suspend-us",      required_argument, 0, 'S'},
+        {"resume-us",       required_argument, 0, 'R'},
+        {"jobs",            required_argument, 0, 'j'},
+        {"help",            no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    val_soak_get_default_config(soak_config);
+    val_watchdog_get_default_config(watchdog_config);
+    val_baseline_get_default_config(baseline_config);
+    *perf_counters = 0;
+    socket_config->socket_path = NULL;
+    socket_config->agent_id = MOCKER_SOCKET_ANY_AGENT;
+    socket_config->virtual_clock = false;
+    socket_config->suspend_us = 0;
+    socket_config->resume_us = 0;
+    *jobs = 1;
+
+    while ((opt = getopt_long(argc, argv, "d:i:n:w:t:T:c:e:E:g:G:b:B:r:Ps:a:VS:R:j:h", long_options, NULL)) != -1) {
+        switch (opt)
+        {
+        case 'd':
+            soak_config->duration_sec = strtoul(optarg, NULL, 0);
+            break;
+        case 'i':
+            soak_config->interval_sec = strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            soak_config->max_iterations = strtoul(optarg, NULL, 0);
+            break;
+        case 'w':
+            soak_config->drift_window = strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            soak_config->drift_threshold_pct = strtoul(optarg, NULL, 0);
+            break;
+        case 'T':
+            watchdog_config->test_timeout_ms = strtoul(optarg, NULL, 0);
+            break;
+        case 'c':
+            watchdog_config->checkpoint_file = optarg;
+            break;
+        case 'e':
+            em_json_file = optarg;
+            break;
+        case 'E':
+            em_table_file = optarg;
+            break;
+        case 'g':
+            perf_trace_file = optarg;
+            break;
+        case 'G':
+            perf_trace_out_file = optarg;
+            break;
+        case 'b':
+            baseline_config->save_file = optarg;
+            break;
+        case 'B':
+            baseline_config->compare_file = optarg;
+            break;
+        case 'r':
+            baseline_config->threshold_pct = strtoul(optarg, NULL, 0);
+            break;
+        case 'P':
+            *perf_counters = 1;
+            break;
+        case 's':
+            socket_config->socket_path = optarg;
+            break;
+        case 'a':
+            socket_config->agent_id = strtoul(optarg, NULL, 0);
+            break;
+        case 'V':
+            socket_config->virtual_clock = true;
+            break;
+        case 'S':
+            socket_config->suspend_us = strtoul(optarg, NULL, 0);
+            break;
+        case 'R':
+            socket_config->resume_us = strtoul(optarg, NULL, 0);
+            break;
+        case 'j':
+            *jobs = app_get_num_jobs(strtoul(optarg, NULL, 0));
+            break;
+        case 'h':
+            app_print_usage(argv[0]);
+            return 1;
+        default:
+            app_print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    /* The server keeps its own clock, time cannot be simulated across the socket */
+    if (socket_config->virtual_clock && (socket_config->socket_path != NULL)) {
+        printf("\n--virtual-clock cannot be used with --connect\n");
+        return -1;
+    }
+
+    /* Likewise the server models suspend with its build time durations */
+    if ((socket_config->suspend_us || socket_config->resume_us) &&
+        (socket_config->socket_path != NULL)) {
+        printf("\n--suspend-us and --resume-us cannot be used with --connect\n");
+        return -1;
+    }
+
+    /* Counters only count the thread that opened them, not forked workers */
+    if ((*jobs > 1) && *perf_counters) {
+        printf("\n--perf-counters cannot be used with --jobs\n");
+        return -1;
+    }
+
+    /* Workers would share one checkpoint file and the test positions recorded in it */
+    if ((*jobs > 1) && (watchdog_config->checkpoint_file != NULL)) {
+        printf("\n--checkpoint cannot be used with --jobs\n");
+        return -1;
+    }
+
+    /* Workers each need a platform of their own, the server has one per agent id */
+    if ((*jobs > 1) && (socket_config->socket_path != NULL)) {
+        printf("\n--jobs cannot be used with --connect\n");
+        return -1;
+    }
+
+    val_energy_model_set_files(em_json_file, em_table_file);
+    val_perf_replay_set_files(perf_trace_file, perf_trace_out_file);
+
+    return 0;
+}
 
 /**
   @brief   Entry point to SCMI suite
@@ -30,64 +279,72 @@ int main(int argc, char *argv[])
     uint32_t num_pass;
     uint32_t num_fail;
     uint32_t num_skip;
+    int exit_status = 1;
+    int options;
+    uint32_t num_timed_out;
+    uint32_t jobs, i;
+    SOAK_CONFIG_s soak_config;
+    WATCHDOG_CONFIG_s watchdog_config;
+    BASELINE_CONFIG_s baseline_config;
+    uint32_t perf_counters;
+    MOCKER_SOCKET_CONFIG_s socket_config;
+    APP_RESULTS_s results = {0};
+
+    options = app_parse_options(argc, argv, &soak_config, &watchdog_config, &baseline_config,
+                                &perf_counters, &socket_config, &jobs);
+    /* A bad command line fails apart from test results, help alone does not */
+    if (options)
+        return (options < 0) ? 4 : 0;
 
     val_print(VAL_PRINT_ERR, "\n\n        **** SCMI Compliance Suite **** ");
 
-    if (val_initialize_system((void *) NULL)) {
+    if (val_initialize_system((void *) &socket_config)) {
         val_print(VAL_PRINT_ERR, "\n **** INIT FAILED ***");
         return 0;
     }
+    val_watchdog_init(&watchdog_config);
+    val_baseline_start(&baseline_config);
+    val_counters_enable(perf_counters);
 
     val_print(VAL_PRINT_ERR, "\n\n          *** Starting BASE tests ***");
     val_base_execute_tests();
 
-#ifdef POWER_DOMAIN_PROTOCOL
-    val_print(VAL_PRINT_ERR, "\n\n          *** Starting POWER tests *** ");
-    val_power_domain_execute_tests();
-#endif
-
-#ifdef SYSTEM_POWER_PROTOCOL
-    val_print(VAL_PRINT_ERR, "\n\n          *** Starting SYSTEM POWER tests ***  ");
-    val_system_power_execute_tests();
-#endif
-
-#ifdef PERFORMANCE_PROTOCOL
-    val_print(VAL_PRINT_ERR, "\n\n          *** Starting PERFORMANCE tests ***  ");
-    val_performance_execute_tests();
-#endif
-
- #ifdef CLOCK_PROTOCOL
-    val_print(VAL_PRINT_ERR, "\n\n          *** Starting CLOCK tests ***");
-    val_clock_execute_tests();
-#endif
-
-#ifdef SENSOR_PROTOCOL
-    val_print(VAL_PRINT_ERR, "\n\n          *** Starting SENSOR tests ***  ");
-    val_sensor_execute_tests();
-#endif
-
-#ifdef RESET_PROTOCOL
-    val_print(VAL_PRINT_ERR, "\n\n          *** Starting RESET tests ***  ");
-    val_reset_execute_tests();
-#endif
-
-#ifdef VOLTAGE_PROTOCOL
-    val_print(VAL_PRINT_ERR, "\n\n          *** Starting VOLTAGE tests ***  ");
-    val_voltage_execute_tests();
-#endif
+    /* Base tests discover the protocol list, so workers are forked after them */
+    if (jobs > 1) {
+        app_run_protocols_parallel(g_app_protocols, NUM_ELEMS(g_app_protocols) - 1, jobs,
+                                   (void *) &socket_config, &results);
+    } else {
+        for (i = 0; g_app_protocols[i].name != NULL; i++)
+            app_run_protocol(&g_app_protocols[i]);
+    }
 
-    num_pass = val_get_test_passed();
-    num_fail = val_get_test_failed();
-    num_skip = val_get_test_skipped();
+    num_pass = val_get_test_passed() + results.num_pass;
+    num_fail = val_get_test_failed() + results.num_fail;
+    num_skip = val_get_test_skipped() + results.num_skip;
+    num_timed_out = val_get_test_timed_out() + results.num_timed_out;
 
     val_print(VAL_PRINT_ERR, "\n****************************************************", 0);
     val_print(VAL_PRINT_ERR, "\n  TOTAL TESTS: %d", num_pass + num_fail + num_skip);
     val_print(VAL_PRINT_ERR, "    PASSED: %d", num_pass);
     val_print(VAL_PRINT_ERR, "    FAILED: %d", num_fail);
     val_print(VAL_PRINT_ERR, "    SKIPPED: %d", num_skip);
+    if (num_timed_out)
+        val_print(VAL_PRINT_ERR, "\n  TIMED OUT: %d (counted as failed)", num_timed_out);
+    val_stack_report();
     val_print(VAL_PRINT_ERR, "\n****************************************************", 0);
+    val_counters_report();
+
+    /* A latency regression is reported apart from test failures, for gating */
+    if (val_baseline_complete() != VAL_STATUS_PASS)
+        exit_status = 2;
+
+    val_watchdog_run_complete();
+
+    /* As is a soak run with errors or drift, unless a regression already set the status */
+    if ((val_soak_execute(&soak_config) == VAL_STATUS_FAIL) && (exit_status != 2))
+        exit_status = 3;
 
     val_print(VAL_PRINT_ERR, "\n\n        **** SCMI tests complete **** \n ");
 
-    return 1;
+    return exit_status;
 }
@@ -0,0 +1,378 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <poll.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include "val_interface.h"
+#include "val_benchmark.h"
+#include "app_parallel.h"
+
+#define APP_READ_CHUNK              4096
+
+/* Latencies a worker recorded, sent after its verdicts */
+typedef struct {
+    uint32_t protocol_id;
+    uint32_t msg_id;
+    VAL_HIST_s hist;
+} APP_LATENCY_RECORD_s;
+
+typedef struct {
+    pid_t    pid;
+    int      log_fd;
+    int      result_fd;
+    char    *log;
+    size_t   log_len;
+    uint32_t done;
+    APP_RESULTS_s results;
+} APP_WORKER_s;
+
+/**
+  @brief   This function returns the number of workers to run protocols on
+  @param   requested  value of --jobs, 0 for one per online cpu
+  @return  number of workers, between 1 and APP_MAX_JOBS
+**/
+uint32_t app_get_num_jobs(uint32_t requested)
+{
+    long num_cpus;
+
+    if (requested == 0) {
+        num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        requested = (num_cpus > 0) ? (uint32_t)num_cpus : 1;
+    }
+
+    return (requested > APP_MAX_JOBS) ? APP_MAX_JOBS : requested;
+}
+
+/**
+  @brief   This function writes a whole buffer to a pipe
+  @param   fd    pipe
+  @param   buf   data
+  @param   size  data size
+  @return  0 on success, -1 if the pipe closed
+**/
+static int app_write_full(int fd, const void *buf, size_t size)
+{
+    const char *pos = buf;
+    ssize_t done;
+
+    while (size)
+    {
+        done = write(fd, pos, size);
+        if (done <= 0)
+            return -1;
+        pos += done;
+        size -= done;
+    }
+
+    return 0;
+}
+
+/**
+  @brief   This function reads a whole buffer from a pipe
+  @param   fd    pipe
+  @param   buf   data
+  @param   size  data size
+  @return  0 on success, -1 if the pipe ended first
+**/
+static int app_read_full(int fd, void *buf, size_t size)
+{
+    char *pos = buf;
+    ssize_t done;
+
+    while (size)
+    {
+        done = read(fd, pos, size);
+        if (done <= 0)
+            return -1;
+        pos += done;
+        size -= done;
+    }
+
+    return 0;
+}
+
+/**
+  @brief   This function runs the tests of one protocol in the calling process
+  @param   protocol  protocol to run
+  @return  none
+**/
+void app_run_protocol(const APP_PROTOCOL_s *protocol)
+{
+    val_print(VAL_PRINT_ERR, "\n\n          *** Starting %s tests ***", protocol->name);
+    protocol->execute_tests();
+}
+
+/**
+  @brief   This function is the body of a worker. It starts from a freshly
+           initialized platform, so the protocol runs on the state it would
+           have in a serial run, and hands its verdicts back to the parent.
+  @param   protocol   protocol to run
+  @param   init_info  platform configuration passed to val_initialize_system
+  @param   result_fd  pipe the verdicts are written to
+  @return  does not return
+**/
+static void app_worker_main(const APP_PROTOCOL_s *protocol, void *init_info, int result_fd)
+{
+    APP_RESULTS_s results;
+    APP_LATENCY_RECORD_s record;
+    VAL_HIST_s *hist;
+
+    if (val_initialize_system(init_info)) {
+        val_print(VAL_PRINT_ERR, "\n **** INIT FAILED *** (%s worker)", protocol->name);
+        fflush(stdout);
+        _exit(1);
+    }
+
+    /* Latencies recorded by the parent before the fork are already counted there */
+    val_latency_reset();
+    app_run_protocol(protocol);
+
+    results.num_pass = val_get_test_passed();
+    results.num_fail = val_get_test_failed();
+    results.num_skip = val_get_test_skipped();
+    results.num_timed_out = val_get_test_timed_out();
+
+    /* End the log first, the parent reads the verdicts once it sees the log end */
+    fflush(stdout);
+    close(STDOUT_FILENO);
+    if (app_write_full(result_fd, &results, sizeof(results)))
+        _exit(1);
+
+    for (record.protocol_id = PROTOCOL_BASE; record.protocol_id < PROTOCOL_MAX;
+         record.protocol_id++)
+    {
+        for (record.msg_id = 0; record.msg_id < VAL_LATENCY_MAX_MSG_ID; record.msg_id++)
+        {
+            hist = val_latency_get_msg_hist(record.protocol_id, record.msg_id);
+            if ((hist == NULL) || (hist->count == 0))
+                continue;
+            record.hist = *hist;
+            if (app_write_full(result_fd, &record, sizeof(record)))
+                _exit(1);
+        }
+    }
+    _exit(0);
+}
+
+/**
+  @brief   This function forks a worker for a protocol, its output going to
+           a pipe read by the parent
+  @param   worker     worker state
+  @param   protocol   protocol to run
+  @param   init_info  platform configuration
+  @return  0 on success, -1 if the worker could not be started
+**/
+static int app_worker_start(APP_WORKER_s *worker, const APP_PROTOCOL_s *protocol,
+                            void *init_info)
+{
+    int log_pipe[2], result_pipe[2];
+    pid_t parent = getpid();
+
+    if (pipe(log_pipe))
+        return -1;
+    if (pipe(result_pipe)) {
+        close(log_pipe[0]);
+        close(log_pipe[1]);
+        return -1;
+    }
+
+    /* Anything still buffered would otherwise be printed by both processes */
+    fflush(stdout);
+
+    worker->pid = fork();
+    if (worker->pid == 0) {
+        /* Go down with the parent rather than run on into a closed pipe */
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (getppid() != parent)
+            _exit(1);
+        close(log_pipe[0]);
+        close(result_pipe[0]);
+        dup2(log_pipe[1], STDOUT_FILENO);
+        close(log_pipe[1]);
+        app_worker_main(protocol, init_info, result_pipe[1]);
+    }
+
+    close(log_pipe[1]);
+    close(result_pipe[1]);
+    if (worker->pid < 0) {
+        close(log_pipe[0]);
+        close(result_pipe[0]);
+        return -1;
+    }
+
+    worker->log_fd = log_pipe[0];
+    worker->result_fd = result_pipe[0];
+    return 0;
+}
+
+/**
+  @brief   This function holds output of a worker until it can be printed.
+           Output that does not fit is dropped, what is already held is kept.
+  @param   worker  worker state
+  @param   data    output to hold
+  @param   len     number of bytes
+  @return  none
+**/
+static void app_worker_hold(APP_WORKER_s *worker, const char *data, size_t len)
+{
+    char *log = realloc(worker->log, worker->log_len + len);
+
+    if (log == NULL)
+        return;
+    memcpy(log + worker->log_len, data, len);
+    worker->log = log;
+    worker->log_len += len;
+}
+
+/**
+  @brief   This function collects the verdicts and recorded latencies of a
+           worker whose output has ended. A worker that died without reporting
+           counts as one failure.
+  @param   worker    worker state
+  @param   protocol  protocol the worker ran
+  @return  none
+**/
+static void app_worker_finish(APP_WORKER_s *worker, const APP_PROTOCOL_s *protocol)
+{
+    APP_LATENCY_RECORD_s record;
+    char note[128];
+    int status = 0, len = 0;
+
+    if (app_read_full(worker->result_fd, &worker->results, sizeof(worker->results))) {
+        memset(&worker->results, 0, sizeof(worker->results));
+        worker->results.num_fail = 1;
+    } else {
+        while (app_read_full(worker->result_fd, &record, sizeof(record)) == 0)
+            val_latency_merge(record.protocol_id, record.msg_id, &record.hist);
+    }
+    close(worker->result_fd);
+    close(worker->log_fd);
+    waitpid(worker->pid, &status, 0);
+
+    if (WIFSIGNALED(status))
+        len = snprintf(note, sizeof(note), "\n       %s worker killed by signal %d",
+                       protocol->name, WTERMSIG(status));
+    else if (WEXITSTATUS(status))
+        len = snprintf(note, sizeof(note), "\n       %s worker exited with status %d",
+                       protocol->name, WEXITSTATUS(status));
+
+    if (len > 0)
+        app_worker_hold(worker, note, len);
+    worker->done = 1;
+}
+
+/**
+  @brief   This function runs each protocol in its own worker process, up to
+           jobs at a time. Logs are printed in protocol order: the output of
+           the oldest unfinished worker streams through, the rest is held
+           until every worker before it has finished.
+           1. Caller       -  App layer, after the base tests.
+  @param   list       protocols to run
+  @param   count      number of protocols
+  @param   jobs       workers run at the same time
+  @param   init_info  platform configuration each worker is initialized with
+  @param   results    verdicts summed over all workers
+  @return  none
+**/
+void app_run_protocols_parallel(const APP_PROTOCOL_s *list, uint32_t count, uint32_t jobs,
+                                void *init_info, APP_RESULTS_s *results)
+{
+    APP_WORKER_s *workers;
+    struct pollfd fds[APP_MAX_JOBS];
+    uint32_t index[APP_MAX_JOBS];
+    uint32_t i, num_fds, next_start = 0, next_print = 0, num_running = 0;
+    char chunk[APP_READ_CHUNK];
+    ssize_t size;
+    APP_WORKER_s *worker;
+
+    memset(results, 0, sizeof(*results));
+    workers = calloc(count, sizeof(*workers));
+    if (workers == NULL)
+        return;
+
+    while (next_print < count)
+    {
+        while ((num_running < jobs) && (next_start < count))
+        {
+            if (app_worker_start(&workers[next_start], &list[next_start], init_info)) {
+                /* Run it here instead, the platform state is still untouched */
+                app_run_protocol(&list[next_start]);
+                workers[next_start].done = 1;
+            } else {
+                num_running++;
+            }
+            next_start++;
+        }
+
+        num_fds = 0;
+        for (i = next_print; i < next_start; i++)
+        {
+            if (workers[i].done)
+                continue;
+            fds[num_fds].fd = workers[i].log_fd;
+            fds[num_fds].events = POLLIN;
+            index[num_fds++] = i;
+        }
+
+        if (num_fds && (poll(fds, num_fds, -1) > 0)) {
+            for (i = 0; i < num_fds; i++)
+            {
+                if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                    continue;
+
+                worker = &workers[index[i]];
+                size = read(worker->log_fd, chunk, sizeof(chunk));
+                if (size <= 0) {
+                    app_worker_finish(worker, &list[index[i]]);
+                    num_running--;
+                } else if (index[i] == next_print) {
+                    fwrite(chunk, 1, size, stdout);
+                } else {
+                    app_worker_hold(worker, chunk, size);
+                }
+            }
+        }
+
+        /* Release held output of the workers now at the head of the list */
+        while ((next_print < next_start) && (workers[next_print].log_len || workers[next_print].done))
+        {
+            worker = &workers[next_print];
+            if (worker->log_len)
+                fwrite(worker->log, 1, worker->log_len, stdout);
+            free(worker->log);
+            worker->log = NULL;
+            worker->log_len = 0;
+            if (!worker->done)
+                break;
+
+            results->num_pass += worker->results.num_pass;
+            results->num_fail += worker->results.num_fail;
+            results->num_skip += worker->results.num_skip;
+            results->num_timed_out += worker->results.num_timed_out;
+            next_print++;
+        }
+        fflush(stdout);
+    }
+
+    free(workers);
+}
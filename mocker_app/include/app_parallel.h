@@ -0,0 +1,43 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __APP_PARALLEL_H__
+#define __APP_PARALLEL_H__
+
+#include <stdint.h>
+
+/* Upper bound on --jobs, 0 on the command line picks the number of online cpus */
+#define APP_MAX_JOBS                64
+
+typedef struct {
+    const char *name;
+    uint32_t (*execute_tests)(void);
+} APP_PROTOCOL_s;
+
+typedef struct {
+    uint32_t num_pass;
+    uint32_t num_fail;
+    uint32_t num_skip;
+    uint32_t num_timed_out;
+} APP_RESULTS_s;
+
+uint32_t app_get_num_jobs(uint32_t requested);
+void     app_run_protocol(const APP_PROTOCOL_s *protocol);
+void     app_run_protocols_parallel(const APP_PROTOCOL_s *list, uint32_t count, uint32_t jobs,
+                                    void *init_info, APP_RESULTS_s *results);
+
+#endif
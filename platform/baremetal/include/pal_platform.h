@@ -25,6 +25,46 @@
 #define NO_ERROR 0
 #define MAX_RETURNS_SIZE 32
 #define LOG_STR_SIZE 96
+
+/*
+ * Deferred logging, enabled with LOG_DEFERRED. Prints are not formatted on
+ * target: each one is recorded in arm_scmi_log_ring as a record of 32-bit
+ * words and turned back into text on the host by tools/scmi_log_decode.py,
+ * which reads the format strings from the linked image.
+ *
+ * Record: header word (record length in words << 16 | print level), the
+ * address of the format string as two words (low, high), then one entry
+ * per argument in format order. Integers, pointers and doubles take two
+ * words (low, high), strings take a byte length word followed by the bytes
+ * padded to a word.
+ *
+ * String free builds (STRING_IDS) set LOG_RECORD_STRING_ID in the header and
+ * record the file id and line of the print instead of the format address.
+ * A check name or test description left out of the image takes the length
+ * word LOG_STRING_ID_LENGTH followed by its file id and line.
+ */
+#ifndef LOG_RING_WORDS
+#define LOG_RING_WORDS 16384
+#endif
+#define LOG_RING_MAGIC 0x474C4353  /* "SCLG" */
+#define LOG_MAX_RECORD_WORDS 128
+#define LOG_RECORD_STRING_ID 0x8000
+#define LOG_STRING_ID_LENGTH 0xFFFFFFFF
+
+/* The oldest records are dropped to make room, so the longest one must fit */
+#if LOG_RING_WORDS < LOG_MAX_RECORD_WORDS
+#error "LOG_RING_WORDS must be at least LOG_MAX_RECORD_WORDS (128)"
+#endif
+
+struct arm_scmi_log_ring {
+    uint32_t magic;
+    uint32_t size_words;        /* LOG_RING_WORDS */
+    uint32_t head;              /* words written since start, data[head % size_words] is next */
+    uint32_t tail;              /* words written when the oldest kept record started */
+    uint32_t num_dropped;       /* oldest records overwritten once the ring is full */
+    uint32_t data[LOG_RING_WORDS];
+};
+
 /*
  * Structure to pass information from the platform to arm_scmi_agent_execute
  */
@@ -91,6 +131,92 @@ int arm_scmi_wait_for_notification(uint32_t *message_header_rcv,
  */
 void arm_scmi_log_output(const char *output);
 
+/*!
+ * @brief Interface function used to read a monotonic platform timer.
+ *
+ * A weak default returning 0 is provided; integrators that want latency
+ * figures from the suite must override it.
+ *
+ * @return Monotonic time in nanoseconds.
+ */
+uint64_t arm_scmi_get_time_ns(void);
+
+/*!
+ * @brief Interface function used to clear the channel after a test timed out.
+ *
+ * Called when a test overruns its watchdog budget so that a late reply is
+ * not taken as the reply to a later command. A weak empty default is
+ * provided.
+ */
+void arm_scmi_reset_channel(void);
+
+/*!
+ * @brief Interface function used to get the lowest address of the agent stack.
+ *
+ * When the suite is built with STACK_USAGE=1 the stack between this address
+ * and the current stack pointer is painted before each test and scanned
+ * after it, to report how deep the test went. A weak default returning 0 is
+ * provided, in which case nothing is painted. Integrators typically return
+ * the stack limit symbol of their linker script.
+ *
+ * @return Lowest stack address.
+ */
+uintptr_t arm_scmi_get_stack_limit(void);
+
+/*!
+ * @brief Ring holding the deferred log, present when built with LOG_DEFERRED.
+ *
+ * Dump sizeof(arm_scmi_log_ring) bytes from its address, for example with a
+ * debugger, and decode them with tools/scmi_log_decode.py.
+ */
+extern struct arm_scmi_log_ring arm_scmi_log_ring;
+
+/*!
+ * @brief Interface function used to read the CPU time spent by the agent.
+ *
+ * A weak default returning 0 is provided, in which case the CPU cost of the
+ * completion modes is not reported.
+ *
+ * @return CPU time in nanoseconds.
+ */
+uint64_t arm_scmi_get_cpu_time_ns(void);
+
+/* Command completion modes passed to arm_scmi_set_completion_mode */
+#define ARM_SCMI_COMPLETION_INTERRUPT 0
+#define ARM_SCMI_COMPLETION_POLLED    1
+#define ARM_SCMI_COMPLETION_ADAPTIVE  2
+
+/*!
+ * @brief Interface function used to select how arm_scmi_send_message waits
+ *        for the completion of a command.
+ *
+ * ARM_SCMI_COMPLETION_INTERRUPT requests the completion interrupt with bit 0
+ * of the mailbox flags and waits for it. ARM_SCMI_COMPLETION_POLLED clears
+ * the flag and spins on the channel free bit of the channel status word.
+ * ARM_SCMI_COMPLETION_ADAPTIVE spins on the channel status word for a short
+ * time, then waits for the interrupt. A weak default only accepts
+ * ARM_SCMI_COMPLETION_INTERRUPT.
+ *
+ * @param mode One of the ARM_SCMI_COMPLETION_* modes.
+ *
+ * @return NO_ERROR if the mode is supported, or any other value otherwise.
+ */
+int arm_scmi_set_completion_mode(uint32_t mode);
+
+/*!
+ * @brief Interface function used to map a fast channel described by the
+ *        platform into the address space of the agent.
+ *
+ * A weak default returns the channel address unchanged, for agents that run
+ * with the shared memory identity mapped.
+ *
+ * @param chan_addr Channel address from the DESCRIBE_FASTCHANNEL command.
+ * @param chan_size Channel size in bytes.
+ *
+ * @return Pointer to the channel, or NULL if it cannot be accessed.
+ */
+void *arm_scmi_fast_channel_map(uint64_t chan_addr, uint32_t chan_size);
+
 int arm_scmi_agent_execute(void *agent_info);
 
 #endif /* _PAL_PLATFORM_H_ */
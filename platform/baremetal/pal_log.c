@@ -0,0 +1,253 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "pal_interface.h"
+#include "pal_platform.h"
+
+#ifdef LOG_DEFERRED
+
+struct arm_scmi_log_ring arm_scmi_log_ring = {
+    .magic = LOG_RING_MAGIC,
+    .size_words = LOG_RING_WORDS,
+};
+
+/**
+  @brief Record staging buffer, a record is only copied to the ring complete
+**/
+static uint32_t log_record[LOG_MAX_RECORD_WORDS];
+
+static uint32_t pal_log_put64(uint32_t index, uint64_t value)
+{
+    if (index + 2 > LOG_MAX_RECORD_WORDS)
+        return index;
+
+    log_record[index++] = (uint32_t)value;
+    log_record[index++] = (uint32_t)(value >> 32);
+    return index;
+}
+
+static uint32_t pal_log_put_string(uint32_t index, const char *str)
+{
+    uint32_t len = 0, max_len;
+
+    if (str == NULL)
+        str = "(null)";
+
+    if (index + 1 >= LOG_MAX_RECORD_WORDS)
+        return index;
+
+    max_len = (LOG_MAX_RECORD_WORDS - index - 1) * sizeof(uint32_t);
+    while ((len < max_len) && str[len])
+        len++;
+
+    log_record[index++] = len;
+    pal_memcpy(&log_record[index], str, len);
+    return index + ((len + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+}
+
+#ifdef STRING_IDS
+static uint32_t pal_log_put_string_id(uint32_t index, PAL_STRING_ID_s string_id)
+{
+    if (index + 3 > LOG_MAX_RECORD_WORDS)
+        return index;
+
+    log_record[index++] = LOG_STRING_ID_LENGTH;
+    log_record[index++] = (uint32_t)(string_id.site >> 32);    /* file id */
+    log_record[index++] = (uint32_t)string_id.site;            /* line */
+    return index;
+}
+#endif
+
+/**
+  @brief   This function copies the staged record to the ring, overwriting
+           the oldest records if it does not fit
+  @param   num_words  record length
+  @return  none
+**/
+static void pal_log_commit(uint32_t num_words)
+{
+    struct arm_scmi_log_ring *ring = &arm_scmi_log_ring;
+    uint32_t i;
+
+    while (ring->head + num_words - ring->tail > LOG_RING_WORDS) {
+        ring->tail += ring->data[ring->tail % LOG_RING_WORDS] >> 16;
+        ring->num_dropped++;
+    }
+
+    for (i = 0; i < num_words; i++)
+        ring->data[(ring->head + i) % LOG_RING_WORDS] = log_record[i];
+    ring->head += num_words;
+}
+
+/**
+  @brief   This API records a print without formatting it. The arguments are
+           walked with the same conversions the host decoder parses.
+           1. Caller       -  pal_print.
+  @param   print_level  print level
+  @param   format       format string, kept in the image
+  @param   args         arguments
+  @return  none
+**/
+void pal_log_record(uint32_t print_level, const char *format, va_list args)
+{
+    uint32_t index = 3, length;
+    const char *fmt = format;
+    double fp;
+    uint64_t bits;
+
+    log_record[1] = (uint32_t)(uintptr_t)format;
+    log_record[2] = (uint32_t)((uint64_t)(uintptr_t)format >> 32);
+
+    while (*fmt) {
+        if (*fmt++ != '%')
+            continue;
+        if (*fmt == '%') {
+            fmt++;
+            continue;
+        }
+
+        while (*fmt && ((*fmt == '-') || (*fmt == '+') || (*fmt == ' ') ||
+                        (*fmt == '#') || (*fmt == '0')))
+            fmt++;
+        for (; *fmt && ((*fmt == '*') || (*fmt == '.') || ((*fmt >= '0') && (*fmt <= '9')));
+             fmt++) {
+            if (*fmt == '*')
+                index = pal_log_put64(index, (int64_t)va_arg(args, int));
+        }
+
+        /* 0: int, 1: long, 2: long long or wider */
+        length = 0;
+        while (*fmt && ((*fmt == 'h') || (*fmt == 'l') || (*fmt == 'z') ||
+                        (*fmt == 'j') || (*fmt == 't') || (*fmt == 'L'))) {
+            if (*fmt == 'l')
+                length++;
+            else if (*fmt != 'h')
+                length = 2;
+            fmt++;
+        }
+
+        switch (*fmt) {
+        case 'd':
+        case 'i':
+            if (length == 0)
+                index = pal_log_put64(index, (int64_t)va_arg(args, int));
+            else if (length == 1)
+                index = pal_log_put64(index, (int64_t)va_arg(args, long));
+            else
+                index = pal_log_put64(index, (int64_t)va_arg(args, long long));
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        case 'c':
+            if (length == 0)
+                index = pal_log_put64(index, va_arg(args, unsigned int));
+            else if (length == 1)
+                index = pal_log_put64(index, va_arg(args, unsigned long));
+            else
+                index = pal_log_put64(index, va_arg(args, unsigned long long));
+            break;
+        case 'p':
+            index = pal_log_put64(index, (uintptr_t)va_arg(args, void *));
+            break;
+        case 's':
+            index = pal_log_put_string(index, va_arg(args, const char *));
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+            fp = va_arg(args, double);
+            pal_memcpy(&bits, &fp, sizeof(bits));
+            index = pal_log_put64(index, bits);
+            break;
+        default:
+            /* Unknown conversion, the decoder stops at the same place */
+            fmt = "";
+            continue;
+        }
+        fmt++;
+    }
+
+    log_record[0] = (index << 16) | (print_level & 0xFFFF);
+    pal_log_commit(index);
+}
+
+#ifdef STRING_IDS
+/**
+  @brief   This API records a print of a string free build, by the call site
+           of its format
+           1. Caller       -  val_print_id.
+  @param   print_level  print level
+  @param   file_id      id of the file the print is written in
+  @param   line         line of the print
+  @param   arg_kinds    PAL_LOG_ARG_* kind of each argument, first in the low bits
+  @param   args         arguments
+  @return  none
+**/
+void pal_print_id(uint32_t print_level, uint32_t file_id, uint32_t line, uint64_t arg_kinds,
+                  va_list args)
+{
+    PAL_STRING_ID_s string_id;
+    uint64_t bits;
+    double fp;
+    uint32_t index = 3;
+
+    log_record[1] = file_id;
+    log_record[2] = line;
+
+    for (; arg_kinds; arg_kinds >>= PAL_LOG_ARG_BITS)
+    {
+        switch (arg_kinds & ((1 << PAL_LOG_ARG_BITS) - 1)) {
+        case PAL_LOG_ARG_INT:
+            index = pal_log_put64(index, (int64_t)va_arg(args, int));
+            break;
+        case PAL_LOG_ARG_LONG:
+            index = pal_log_put64(index, (int64_t)va_arg(args, long));
+            break;
+        case PAL_LOG_ARG_LONG_LONG:
+            index = pal_log_put64(index, va_arg(args, unsigned long long));
+            break;
+        case PAL_LOG_ARG_DOUBLE:
+            fp = va_arg(args, double);
+            pal_memcpy(&bits, &fp, sizeof(bits));
+            index = pal_log_put64(index, bits);
+            break;
+        case PAL_LOG_ARG_POINTER:
+            index = pal_log_put64(index, (uintptr_t)va_arg(args, void *));
+            break;
+        case PAL_LOG_ARG_STRING:
+            index = pal_log_put_string(index, va_arg(args, const char *));
+            break;
+        case PAL_LOG_ARG_STRING_ID:
+            string_id = va_arg(args, PAL_STRING_ID_s);
+            index = pal_log_put_string_id(index, string_id);
+            break;
+        default:
+            break;
+        }
+    }
+
+    log_record[0] = (index << 16) | LOG_RECORD_STRING_ID | (print_level & 0x7FFF);
+    pal_log_commit(index);
+}
+#endif /* STRING_IDS */
+
+#endif /* LOG_DEFERRED */
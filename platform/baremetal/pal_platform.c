@@ -40,6 +40,9 @@ extern void pal_reset_set_expected(const void *);
 #ifdef VOLTAGE_PROTOCOL
 extern void pal_voltage_set_expected(const void *);
 #endif
+#ifdef POWERCAP_PROTOCOL
+extern void pal_powercap_set_expected(const void *);
+#endif
 
 /**
   @brief   This API is used to call platform function to send command
@@ -145,6 +148,11 @@ uint32_t pal_initialize_system(void *info)
          case 0x17:
              pal_voltage_set_expected(protocol_info->expected_return_values);
              break;
+#endif
+#ifdef POWERCAP_PROTOCOL
+         case 0x18:
+             pal_powercap_set_expected(protocol_info->expected_return_values);
+             break;
 #endif
          }
          protocol_info++; index++;
@@ -152,10 +160,290 @@ uint32_t pal_initialize_system(void *info)
     return PAL_STATUS_PASS;
 }
 
+/**
+  @brief   Default timer hook, overridden by integrators with a real timer
+  @param   none
+  @return  time in nanoseconds
+**/
+__attribute__((weak)) uint64_t arm_scmi_get_time_ns(void)
+{
+    return 0;
+}
+
+/**
+  @brief   This API is used to read the agent monotonic time
+  @param   none
+  @return  time in nanoseconds
+**/
+uint64_t pal_get_time_ns(void)
+{
+    return arm_scmi_get_time_ns();
+}
+
+/**
+  @brief   Default CPU time hook, overridden by integrators that can tell
+           the agent CPU time apart from the time it waits
+  @param   none
+  @return  time in nanoseconds
+**/
+__attribute__((weak)) uint64_t arm_scmi_get_cpu_time_ns(void)
+{
+    return 0;
+}
+
+/**
+  @brief   This API is used to read the CPU time used by the agent
+  @param   none
+  @return  time in nanoseconds
+**/
+uint64_t pal_get_cpu_time_ns(void)
+{
+    return arm_scmi_get_cpu_time_ns();
+}
+
+/**
+  @brief   Default completion mode hook, the transport only waits for the
+           completion interrupt
+  @param   mode  completion mode
+  @return  NO_ERROR if the mode is supported
+**/
+__attribute__((weak)) int arm_scmi_set_completion_mode(uint32_t mode)
+{
+    return (mode == ARM_SCMI_COMPLETION_INTERRUPT) ? NO_ERROR : 1;
+}
+
+/**
+  @brief   This API is used to select how command completion is waited for
+  @param   mode  PAL_COMPLETION_INTERRUPT, PAL_COMPLETION_POLLED or
+                 PAL_COMPLETION_ADAPTIVE
+  @return  PAL_STATUS_PASS, PAL_STATUS_FAIL if the mode is not supported
+**/
+uint32_t pal_set_completion_mode(uint32_t mode)
+{
+    return (arm_scmi_set_completion_mode(mode) == NO_ERROR) ? PAL_STATUS_PASS :
+                                                              PAL_STATUS_FAIL;
+}
+
+/**
+  @brief   Default fast channel hook, the shared memory is identity mapped
+  @param   chan_addr  channel address
+  @param   chan_size  channel size in bytes
+  @return  pointer to the channel
+**/
+__attribute__((weak)) void *arm_scmi_fast_channel_map(uint64_t chan_addr, uint32_t chan_size)
+{
+    return (void *)(uintptr_t)chan_addr;
+}
+
+/**
+  @brief   This API is used to map a fast channel for the agent to access
+  @param   protocol_id  protocol of the channel
+  @param   domain_id    domain of the channel
+  @param   message_id   message carried by the channel
+  @param   chan_addr    channel address from DESCRIBE_FASTCHANNEL
+  @param   chan_size    channel size in bytes
+  @return  pointer to the channel, NULL if it cannot be accessed
+**/
+void *pal_fast_channel_map(uint32_t protocol_id, uint32_t domain_id, uint32_t message_id,
+                           uint64_t chan_addr, uint32_t chan_size)
+{
+    return arm_scmi_fast_channel_map(chan_addr, chan_size);
+}
+
+/**
+  @brief   Agent side counters are not read on baremetal, the message
+           latency is reported alone
+  @param   enable  1 to open the counters, 0 to close them
+  @return  0, no counter available
+**/
+uint32_t pal_counters_enable(uint32_t enable)
+{
+    return 0;
+}
+
+/**
+  @brief   Agent side counters are not read on baremetal
+  @param   values  PAL_NUM_COUNTERS totals, all 0
+  @return  none
+**/
+void pal_counters_read(uint64_t *values)
+{
+    uint32_t i;
+
+    for (i = 0; i < PAL_NUM_COUNTERS; i++)
+        values[i] = 0;
+}
+
+/**
+  @brief   Default stack limit hook, overridden by integrators that know
+           where the agent stack ends
+  @param   none
+  @return  0, the stack bounds are unknown
+**/
+__attribute__((weak)) uintptr_t arm_scmi_get_stack_limit(void)
+{
+    return 0;
+}
+
+/**
+  @brief   This API is used to get the lowest address the agent stack may
+           grow to, the stack is painted down to it before each test
+  @param   none
+  @return  lowest stack address, 0 if unknown
+**/
+uint64_t pal_get_stack_limit(void)
+{
+    return arm_scmi_get_stack_limit();
+}
+
+/**
+  @brief   Default channel reset hook, overridden by integrators whose
+           transport can hold a late reply
+  @param   none
+  @return  none
+**/
+__attribute__((weak)) void arm_scmi_reset_channel(void)
+{
+}
+
+/**
+  @brief   This API is used to drop stale replies after a test timed out
+  @param   none
+  @return  none
+**/
+void pal_reset_channel(void)
+{
+    arm_scmi_reset_channel();
+}
+
+/**
+  @brief   Checkpoints need a file system, no records are available
+  @param   file         checkpoint file
+  @param   test_num     test numbers read
+  @param   outcome      test outcomes read
+  @param   max_entries  size of the test_num and outcome lists
+  @return  number of records read
+**/
+uint32_t pal_checkpoint_load(const char *file, uint32_t *test_num, uint32_t *outcome,
+                             uint32_t max_entries)
+{
+    return 0;
+}
+
+/**
+  @brief   Checkpoints need a file system, records are dropped
+  @param   file      checkpoint file
+  @param   test_num  test number
+  @param   outcome   test outcome
+  @return  none
+**/
+void pal_checkpoint_append(const char *file, uint32_t test_num, uint32_t outcome)
+{
+}
+
+/**
+  @brief   Checkpoints need a file system, nothing to remove
+  @param   file  checkpoint file
+  @return  none
+**/
+void pal_checkpoint_remove(const char *file)
+{
+}
+
+/**
+  @brief   Report files need a file system, reports are only printed
+  @param   file  file name
+  @return  NULL
+**/
+void *pal_file_open(const char *file)
+{
+    return NULL;
+}
+
+/**
+  @brief   Report files need a file system, records are dropped
+  @param   file  file name
+  @return  NULL
+**/
+void *pal_file_open_append(const char *file)
+{
+    return NULL;
+}
+
+/**
+  @brief   Files need a file system, there is nothing to read
+  @param   file  file name
+  @return  NULL
+**/
+void *pal_file_open_read(const char *file)
+{
+    return NULL;
+}
+
+/**
+  @brief   Files need a file system, there is nothing to read
+  @param   handle  file handle
+  @param   line    buffer for the line
+  @param   size    size of the buffer
+  @return  0
+**/
+uint32_t pal_file_read_line(void *handle, char *line, uint32_t size)
+{
+    return 0;
+}
+
+/**
+  @brief   Report files need a file system, nothing is written
+  @param   handle  file handle
+  @param   format  print data and format
+  @param   args    values to be printed
+  @return  none
+**/
+void pal_file_print(void *handle, const char *format, va_list args)
+{
+}
+
+/**
+  @brief   Report files need a file system, nothing to close
+  @param   handle  file handle
+  @return  none
+**/
+void pal_file_close(void *handle)
+{
+}
+
+/**
+  @brief   This API copies memory, byte by byte as no C library is assumed
+  @param   dest  destination buffer
+  @param   src   source buffer
+  @param   size  number of bytes to copy
+  @return  dest, or NULL if there is nothing to copy
+**/
+void *pal_memcpy(void *dest, const void *src, size_t size)
+{
+    uint8_t *to = dest;
+    const uint8_t *from = src;
+
+    if (dest == NULL || src == NULL || size == 0)
+        return NULL;
+
+    while (size--)
+        *to++ = *from++;
+
+    return dest;
+}
+
+#ifdef LOG_DEFERRED
+/**
+  @brief Deferred log recorder, see pal_log.c
+**/
+void pal_log_record(uint32_t print_level, const char *format, va_list args);
+#else
 /**
   @brief Printing buffer
 **/
 static char p_str[LOG_STR_SIZE];
+#endif
 
 /**
   @brief   This API is used to print test log
@@ -164,6 +452,10 @@ static char p_str[LOG_STR_SIZE];
 **/
 void pal_print(uint32_t print_level, const char *format, va_list args)
 {
+#ifdef LOG_DEFERRED
+    pal_log_record(print_level, format, args);
+#else
     vsnprintf(p_str, LOG_STR_SIZE, format, args);
     arm_scmi_log_output(p_str);
+#endif
 }
@@ -77,4 +77,15 @@ uint32_t pal_sensor_get_expected_stats_addr_len(void)
     return g_sensor_info->sensor_reg_length;
 }
 
+/**
+  @brief   This API is used for checking the sensor timestamp clock drift
+  @param   drift_ppb  expected drift against the agent clock, in ppb
+  @return  PAL_STATUS_SKIP, the platform clock drift is not known
+**/
+uint32_t pal_sensor_get_expected_clock_drift(int32_t *drift_ppb)
+{
+    *drift_ppb = 0;
+    return PAL_STATUS_SKIP;
+}
+
 #endif
@@ -15,7 +15,9 @@
 # * limitations under the License.
 #**/
 
-C_FILES := $(wildcard *.c)
+# SHARED_C_FILES names sources of another platform directory built in this one
+C_FILES := $(wildcard *.c) $(notdir $(SHARED_C_FILES))
+vpath %.c $(dir $(SHARED_C_FILES))
 H_FILES := $(wildcard $(HEADER_DIR)/*.h)
 OBJS := $(patsubst %.c,$(PLATFORM_OBJ_DIR)/%.o,$(C_FILES))
 
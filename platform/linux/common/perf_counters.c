@@ -0,0 +1,144 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <pal_platform.h>
+#include <pal_interface.h>
+
+/* Events in PAL_COUNTER_* order */
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} g_counter_event[PAL_NUM_COUNTERS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+};
+
+static int g_counter_fd[PAL_NUM_COUNTERS] = {-1, -1, -1, -1};
+static int g_counter_leader = -1;
+static uint32_t g_counter_slot[PAL_NUM_COUNTERS];
+static uint32_t g_counter_num_open;
+static uint32_t g_counter_mask;
+
+/*!
+ * @brief Opens one counter of the agent thread, in the group of the leader.
+ * Kernel time is left out if the perf_event_paranoid setting forbids it.
+ */
+static int linux_counter_open(uint32_t index, int group_fd)
+{
+    struct perf_event_attr attr;
+    int fd;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = g_counter_event[index].type;
+    attr.config = g_counter_event[index].config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.disabled = (group_fd == -1);
+    attr.exclude_hv = 1;
+
+    fd = syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+    if ((fd < 0) && ((errno == EACCES) || (errno == EPERM))) {
+        attr.exclude_kernel = 1;
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+    }
+
+    return fd;
+}
+
+/*!
+ * @brief Interface function that opens or closes the per message counters.
+ * Counters perf cannot open are left out, except context switches and page
+ * faults which are then read from getrusage.
+ */
+uint32_t linux_counters_enable(uint32_t enable)
+{
+    uint32_t i;
+
+    for (i = 0; i < PAL_NUM_COUNTERS; i++)
+    {
+        if (g_counter_fd[i] >= 0)
+            close(g_counter_fd[i]);
+        g_counter_fd[i] = -1;
+    }
+    g_counter_leader = -1;
+    g_counter_num_open = 0;
+    g_counter_mask = 0;
+
+    if (!enable)
+        return 0;
+
+    for (i = 0; i < PAL_NUM_COUNTERS; i++)
+    {
+        g_counter_fd[i] = linux_counter_open(i, g_counter_leader);
+        if (g_counter_fd[i] < 0)
+            continue;
+
+        if (g_counter_leader < 0)
+            g_counter_leader = g_counter_fd[i];
+        g_counter_slot[i] = g_counter_num_open++;
+        g_counter_mask |= (1 << i);
+    }
+
+    if (g_counter_leader >= 0) {
+        ioctl(g_counter_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(g_counter_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    if (!(g_counter_mask & (1 << PAL_COUNTER_CONTEXT_SWITCHES)) ||
+        !(g_counter_mask & (1 << PAL_COUNTER_PAGE_FAULTS)))
+        g_counter_mask |= (1 << PAL_COUNTER_CONTEXT_SWITCHES) |
+                          (1 << PAL_COUNTER_PAGE_FAULTS) | PAL_COUNTERS_RUSAGE;
+
+    return g_counter_mask;
+}
+
+/*!
+ * @brief Interface function that reads the running totals of the counters,
+ * the whole group in one read.
+ */
+void linux_counters_read(uint64_t *values)
+{
+    uint64_t group[PAL_NUM_COUNTERS + 1];
+    struct rusage usage;
+    uint32_t i;
+
+    memset(values, 0, PAL_NUM_COUNTERS * sizeof(uint64_t));
+
+    if ((g_counter_leader >= 0) &&
+        (read(g_counter_leader, group, sizeof(group)) >= (ssize_t)sizeof(uint64_t))) {
+        for (i = 0; i < PAL_NUM_COUNTERS; i++)
+        {
+            if ((g_counter_fd[i] >= 0) && (g_counter_slot[i] < group[0]))
+                values[i] = group[1 + g_counter_slot[i]];
+        }
+    }
+
+    if ((g_counter_mask & PAL_COUNTERS_RUSAGE) && (getrusage(RUSAGE_SELF, &usage) == 0)) {
+        values[PAL_COUNTER_CONTEXT_SWITCHES] = usage.ru_nvcsw + usage.ru_nivcsw;
+        values[PAL_COUNTER_PAGE_FAULTS] = usage.ru_minflt + usage.ru_majflt;
+    }
+}
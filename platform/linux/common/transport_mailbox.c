@@ -16,16 +16,20 @@
  **/
 
 #include <poll.h>
+#include <stdio.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <signal.h>
 #include <fcntl.h>
+#include <time.h>
 #include <unistd.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <pal_platform.h>
+#include <pal_interface.h>
 
 /* mailbox transport macros and libraries */
 #define MAX_MEMORY_LENGTH 128
@@ -33,6 +37,23 @@
 
 #define NO_ERROR 0
 #define ERROR 5
+#define TIMEOUT_ERROR 6
+
+/* Upper bound on late replies dropped when the channel is reset */
+#define MB_MAX_STALE_MESSAGES 8
+
+/* Completion modes, the same values as PAL_COMPLETION_* */
+#define MB_COMPLETION_INTERRUPT 0
+#define MB_COMPLETION_POLLED 1
+#define MB_COMPLETION_ADAPTIVE 2
+
+/* Time adaptive mode spins before it sleeps, about a fast command round trip */
+#define MB_COMPLETION_SPIN_NS 50000
+
+/* MB_FLAGS bit 0 asks the platform to raise the completion interrupt */
+#define MB_FLAGS_INTERRUPT 0x1
+/* MB_CHANNEL_STATUS bit 0 is set by the platform when the channel is free */
+#define MB_CHANNEL_FREE 0x1
 
 #ifdef HARDWARE_TC0
     #define MB_SIGNAL_FILE "/sys/kernel/debug/6000000.mailbox-test/signal"
@@ -64,6 +85,145 @@ enum {
     MB_LENGTH_MESSAGE_HEADER =                  0x4
 } mailbox_byte_length;
 
+static uint32_t completion_mode = MB_COMPLETION_INTERRUPT;
+
+#ifdef MB_SHMEM_ADDR
+/* Agent to platform shared memory, mapped from /dev/mem on first use */
+static volatile uint32_t *mb_shmem;
+
+/*!
+ * @brief Map the agent to platform shared memory at MB_SHMEM_ADDR.
+ *
+ * @return the mapping, NULL if /dev/mem cannot be mapped.
+ */
+static volatile uint32_t *linux_map_shmem(void)
+{
+    off_t page_mask = (off_t)sysconf(_SC_PAGESIZE) - 1;
+    off_t base = (off_t)MB_SHMEM_ADDR & ~page_mask;
+    size_t offset = (size_t)((off_t)MB_SHMEM_ADDR - base);
+    void *map;
+    int fd;
+
+    if (mb_shmem != NULL)
+        return mb_shmem;
+
+    fd = open("/dev/mem", O_RDWR | O_SYNC);
+    if (fd < 0)
+        return NULL;
+    map = mmap(NULL, offset + MAX_MEMORY_LENGTH, PROT_READ | PROT_WRITE, MAP_SHARED, fd, base);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    mb_shmem = (volatile uint32_t *)((uint8_t *)map + offset);
+    return mb_shmem;
+}
+
+/*!
+ * @brief Spin on the channel status word until the platform frees the channel.
+ *
+ * @return 1 when the channel is free, 0 if spin_ns went by first.
+ */
+static int linux_wait_channel_free(uint64_t spin_ns)
+{
+    uint64_t start_ns = linux_get_time_ns();
+
+    do {
+        if (mb_shmem[MB_CHANNEL_STATUS / 4] & MB_CHANNEL_FREE)
+            return 1;
+    } while ((linux_get_time_ns() - start_ns) < spin_ns);
+
+    return 0;
+}
+#endif
+
+/*!
+ * @brief Wait for the mailbox message file to hold a message.
+ *
+ * Platform to agent messages are always signalled by the platform doorbell,
+ * so the agent sleeps in poll() until the driver receives it.
+ *
+ * @return positive when a message is ready, 0 on timeout, negative on error.
+ */
+static int linux_wait_message(int fd_message, uint32_t timeout)
+{
+    struct pollfd pfd;
+
+    pfd.fd = fd_message;
+    pfd.events = POLLIN;
+    return poll(&pfd, 1, timeout);
+}
+
+/*!
+ * @brief Wait for the platform to complete a command and copy out its reply.
+ *
+ * In interrupt mode the agent sleeps until the driver receives the completion
+ * interrupt and reads the reply from the message file. Polled mode spins on
+ * the channel status word for the whole timeout with the interrupt cleared in
+ * MB_FLAGS, and reads the reply straight from the shared memory. Adaptive mode
+ * keeps the interrupt requested, spins on the channel status word for
+ * MB_COMPLETION_SPIN_NS, then collects the reply the driver copied out.
+ *
+ * @return positive when the reply is in buffer, 0 on timeout, negative on error.
+ */
+static int linux_wait_completion(int fd_message, uint32_t timeout, uint8_t *buffer)
+{
+    int ret;
+#ifdef MB_SHMEM_ADDR
+    uint64_t start_ns = linux_get_time_ns();
+    uint64_t spin_ns = (uint64_t)timeout * 1000000ull;
+    uint32_t counter, elapsed_ms;
+
+    if (completion_mode == MB_COMPLETION_POLLED) {
+        if (!linux_wait_channel_free(spin_ns))
+            return 0;
+        for (counter = 0; counter < (MAX_MEMORY_LENGTH / 4); counter++)
+            ((uint32_t *)buffer)[counter] = mb_shmem[counter];
+        return 1;
+    }
+
+    if (completion_mode == MB_COMPLETION_ADAPTIVE) {
+        if (spin_ns > MB_COMPLETION_SPIN_NS)
+            spin_ns = MB_COMPLETION_SPIN_NS;
+        linux_wait_channel_free(spin_ns);
+        elapsed_ms = (uint32_t)((linux_get_time_ns() - start_ns) / 1000000ull);
+        timeout = (elapsed_ms < timeout) ? (timeout - elapsed_ms) : 0;
+    }
+#endif
+
+    ret = linux_wait_message(fd_message, timeout);
+    if (ret > 0)
+        read(fd_message, buffer, MAX_MEMORY_LENGTH);
+
+    return ret;
+}
+
+/*!
+ * @brief Interface function that selects how the agent waits for the
+ * completion of a command, one of the PAL_COMPLETION_* modes.
+ *
+ * The polled modes spin on the channel status word, so they need the agent
+ * to platform shared memory. They are only accepted when the build gives its
+ * physical address in MB_SHMEM_ADDR and /dev/mem can map it.
+ */
+uint32_t linux_set_completion_mode(uint32_t mode)
+{
+    if (mode > MB_COMPLETION_ADAPTIVE)
+        return ERROR;
+
+    if (mode != MB_COMPLETION_INTERRUPT) {
+#ifdef MB_SHMEM_ADDR
+        if (linux_map_shmem() == NULL)
+            return ERROR;
+#else
+        return ERROR;
+#endif
+    }
+
+    completion_mode = mode;
+    return NO_ERROR;
+}
+
 /*!
  * @brief Interface function that sends a
  * command to mailbox driver interfaces and receives a platform
@@ -79,12 +239,11 @@ int32_t linux_send_message(uint32_t message_header_send, size_t parameter_count,
         size_t *return_values_count, uint32_t *return_values)
 {
     /* variables to be used in this function */
-    uint32_t fd_signal, fd_message; // file descriptors for each mailbox interface
-    uint32_t ret = 0; // return polling signal
+    int fd_signal, fd_message; // file descriptors for each mailbox interface
+    int ret = 0; // return polling signal
     uint8_t *buffer; // pointer to access mailbox memory
     uint32_t counter;
     uint32_t *header_payload_length; // pointer to read payload length
-    struct pollfd pfd;
 
     /* initialise buffer */
     buffer = (uint8_t *)malloc(MAX_MEMORY_LENGTH);
@@ -96,13 +255,15 @@ int32_t linux_send_message(uint32_t message_header_send, size_t parameter_count,
      *      - RESERVED 1 (skipped as it has already been defaulted to zero)
      *      - CHANNEL STATUS (skipped as it has already been defaulted to zero)
      *      - RESERVED 2 (skipped as it has already been defaulted to zero)
-     *      - MAILBOX FLAGS (always set to 1 to indicate completion via an interrupt)
+     *      - MAILBOX FLAGS (set to 1 for completion via an interrupt, 0 in polled mode)
      *      - LENGTH (this will be particularly useful to dertermine the returned payload length)
      *      - MESSAGE HEADER (as the data passed in)
      *      - MESSAGE PAYLOAD (used to hold parameter when sending OR return values upon receipt)
      * */
 
-    buffer[MB_FLAGS] = 0x1; // populating MAILBOX_FLAGS
+    // populating MAILBOX_FLAGS
+    if (completion_mode != MB_COMPLETION_POLLED)
+        buffer[MB_FLAGS] = MB_FLAGS_INTERRUPT;
 
     buffer[MB_HEADER_PAYLOAD_LENGTH] = 0x04 + (parameter_count * 4); // populating LENGTH (4+N)
 
@@ -137,6 +298,7 @@ int32_t linux_send_message(uint32_t message_header_send, size_t parameter_count,
      * */
     fd_signal = open(MB_SIGNAL_FILE, 0x0001);
     if (fd_signal < 0) {
+        close(fd_message);
         free(buffer);
         return ERROR;
     }
@@ -144,20 +306,17 @@ int32_t linux_send_message(uint32_t message_header_send, size_t parameter_count,
     buffer[0] = 0x01;
     write(fd_signal, buffer, 1);
 
-    /* polling */
-    pfd.fd = fd_message;
-    pfd.revents = POLLIN;
-    ret = poll(&pfd, 1, 1000);
+    /* wait for completion and read the returned message into the buffer */
+    ret = linux_wait_completion(fd_message, 1000, buffer);
+    close(fd_signal);
+    close(fd_message);
 
-    // non-negative indicates successful completion
-    if (ret < 0) {
+    // positive indicates a reply is ready, zero that the platform did not answer in time
+    if (ret <= 0) {
         free(buffer);
-        return ERROR;
+        return (ret == 0) ? TIMEOUT_ERROR : ERROR;
     }
 
-    /* read returned message into the buffer */
-    read(fd_message, buffer, MAX_MEMORY_LENGTH);
-
     /* Extract bytes using an uint32_t pointer. */
     header_payload_length = (uint32_t *) &buffer[MB_HEADER_PAYLOAD_LENGTH];
 
@@ -194,12 +353,11 @@ int linux_wait_for_response(uint32_t *message_header_rcv,
         bool *message_ready, uint32_t timeout)
 {
     /* variables to be used in this function */
-    uint32_t fd_message; // file descriptors for each mailbox interface
-    uint32_t ret = 0; // return polling signal
+    int fd_message; // file descriptors for each mailbox interface
+    int ret = 0; // return polling signal
     uint8_t *buffer; // pointer to access mailbox memory
     uint32_t counter;
     uint32_t *header_payload_length; // pointer to read payload length
-    struct pollfd pfd;
 
     /* initialise buffer */
     buffer = (uint8_t *)malloc(MAX_MEMORY_LENGTH);
@@ -228,19 +386,19 @@ int linux_wait_for_response(uint32_t *message_header_rcv,
         return ERROR;
     }
 
-    /* polling */
-    pfd.fd = fd_message;
-    pfd.revents = POLLIN;
-    ret = poll(&pfd, 1, timeout);
+    /* wait for the message */
+    ret = linux_wait_message(fd_message, timeout);
 
-    // non-negative indicates successful completion
-    if (ret < 0) {
+    // positive indicates a message is ready, zero that none arrived in time
+    if (ret <= 0) {
+        close(fd_message);
         free(buffer);
-        return ERROR;
+        return (ret == 0) ? TIMEOUT_ERROR : ERROR;
     }
 
     /* read returned message into the buffer */
     read(fd_message, buffer, MAX_MEMORY_LENGTH);
+    close(fd_message);
 
     /* Extract bytes using an uint32_t pointer. */
     header_payload_length = (uint32_t *) &buffer[MB_HEADER_PAYLOAD_LENGTH];
@@ -280,12 +438,11 @@ int linux_wait_for_notification(uint32_t *message_header_rcv,
         uint32_t timeout)
 {
     /* variables to be used in this function */
-    uint32_t fd_message; // file descriptors for each mailbox interface
-    uint32_t ret = 0; // return polling signal
+    int fd_message; // file descriptors for each mailbox interface
+    int ret = 0; // return polling signal
     uint8_t *buffer; // pointer to access mailbox memory
     uint32_t counter;
     uint32_t *header_payload_length; // pointer to read payload length
-    struct pollfd pfd;
 
     /* initialise buffer */
     buffer = (uint8_t *)malloc(MAX_MEMORY_LENGTH);
@@ -314,19 +471,19 @@ int linux_wait_for_notification(uint32_t *message_header_rcv,
         return ERROR;
     }
 
-    /* polling */
-    pfd.fd = fd_message;
-    pfd.revents = POLLIN;
-    ret = poll(&pfd, 1, timeout);
+    /* wait for the message */
+    ret = linux_wait_message(fd_message, timeout);
 
-    // non-negative indicates successful completion
-    if (ret < 0) {
+    // positive indicates a message is ready, zero that none arrived in time
+    if (ret <= 0) {
+        close(fd_message);
         free(buffer);
-        return ERROR;
+        return (ret == 0) ? TIMEOUT_ERROR : ERROR;
     }
 
     /* read returned message into the buffer */
     read(fd_message, buffer, MAX_MEMORY_LENGTH);
+    close(fd_message);
 
     /* Extract bytes using an uint32_t pointer. */
     header_payload_length = (uint32_t *) &buffer[MB_HEADER_PAYLOAD_LENGTH];
@@ -352,6 +509,130 @@ int linux_wait_for_notification(uint32_t *message_header_rcv,
     return NO_ERROR;
 }
 
+/*!
+ * @brief Interface function that drops replies which arrived after their
+ * command timed out, so they are not read as the reply to a later command.
+ */
+void linux_reset_channel(void)
+{
+    int fd_message;
+    uint32_t counter;
+    uint8_t buffer[MAX_MEMORY_LENGTH];
+    struct pollfd pfd;
+
+    fd_message = open(MB_MESSAGE_FILE, 0x0002);
+    if (fd_message < 0)
+        return;
+
+    pfd.fd = fd_message;
+    pfd.events = POLLIN;
+    for (counter = 0; counter < MB_MAX_STALE_MESSAGES; ++counter) {
+        if (poll(&pfd, 1, 0) <= 0)
+            break;
+        read(fd_message, buffer, MAX_MEMORY_LENGTH);
+    }
+    close(fd_message);
+}
+
+/*!
+ * @brief Interface function that reads the "<test num> <outcome>" records
+ * of a checkpoint file.
+ */
+uint32_t linux_checkpoint_load(const char *file, uint32_t *test_num, uint32_t *outcome,
+        uint32_t max_entries)
+{
+    FILE *file_ptr;
+    uint32_t count = 0;
+
+    file_ptr = fopen(file, "r");
+    if (file_ptr == NULL)
+        return 0;
+
+    while ((count < max_entries) &&
+           (fscanf(file_ptr, "%" SCNu32 " %" SCNu32, &test_num[count], &outcome[count]) == 2))
+        count++;
+
+    fclose(file_ptr);
+    return count;
+}
+
+/*!
+ * @brief Interface function that appends a record to a checkpoint file. The
+ * file is closed after every record so it survives a crash of the agent.
+ */
+void linux_checkpoint_append(const char *file, uint32_t test_num, uint32_t outcome)
+{
+    FILE *file_ptr;
+
+    file_ptr = fopen(file, "a");
+    if (file_ptr == NULL)
+        return;
+
+    fprintf(file_ptr, "%" PRIu32 " %" PRIu32 "\n", test_num, outcome);
+    fclose(file_ptr);
+}
+
+/*!
+ * @brief Interface function that removes a checkpoint file.
+ */
+void linux_checkpoint_remove(const char *file)
+{
+    remove(file);
+}
+
+/*!
+ * @brief Interface function that creates a report file.
+ */
+void *linux_file_open(const char *file)
+{
+    return fopen(file, "w");
+}
+
+/*!
+ * @brief Interface function that opens a file to add records to.
+ */
+void *linux_file_open_append(const char *file)
+{
+    return fopen(file, "a");
+}
+
+/*!
+ * @brief Interface function that opens a file to read back.
+ */
+void *linux_file_open_read(const char *file)
+{
+    return fopen(file, "r");
+}
+
+/*!
+ * @brief Interface function that reads the next line of a file, without
+ * the line end.
+ */
+uint32_t linux_file_read_line(void *handle, char *line, uint32_t size)
+{
+    if (fgets(line, size, (FILE *)handle) == NULL)
+        return 0;
+
+    line[strcspn(line, "\r\n")] = '\0';
+    return 1;
+}
+
+/*!
+ * @brief Interface function that appends formatted text to a report file.
+ */
+void linux_file_print(void *handle, const char *format, va_list args)
+{
+    vfprintf((FILE *)handle, format, args);
+}
+
+/*!
+ * @brief Interface function that closes a report file.
+ */
+void linux_file_close(void *handle)
+{
+    fclose((FILE *)handle);
+}
+
 /*!
  * @brief Interface function that gets accessible device for given agent
  */
@@ -376,4 +657,36 @@ uint32_t linux_device_get_accessible_protocol(uint32_t device_id)
     return NO_ERROR;
 }
 
+/*!
+ * @brief Interface function that reads the agent monotonic clock in ns
+ */
+uint64_t linux_get_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + ts.tv_nsec;
+}
+
+/*!
+ * @brief Interface function that reads the CPU time used by the agent in ns
+ */
+uint64_t linux_get_cpu_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + ts.tv_nsec;
+}
+
+/*!
+ * @brief Interface function that returns the lowest stack address painted for
+ * the high-water measurement. The stack grows on demand, so a window below
+ * the caller is used rather than the full stack size limit.
+ */
+uint64_t linux_get_stack_limit(void)
+{
+    volatile uint8_t marker;
 
+    return (uint64_t)(uintptr_t)&marker - PAL_STACK_WINDOW;
+}
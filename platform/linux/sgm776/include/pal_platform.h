@@ -19,6 +19,7 @@
 #define __PAL_PLATFORM_H__
 
 #include <stddef.h>
+#include <stdarg.h>
 #include <stdbool.h>
 #include <inttypes.h>
 
@@ -35,6 +36,7 @@
 #define SENSOR_PROTOCOL_ID            0x15
 #define RESET_PROTOCOL_ID             0x16
 #define VOLTAGE_PROTOCOL_ID           0x17
+#define POWERCAP_PROTOCOL_ID          0x18
 #define APCORE_PROTOCOL_ID            0x09
 
 #define TIMEOUT  100
@@ -51,6 +53,24 @@ int linux_wait_for_response(uint32_t *message_header_rcv,
         int32_t *status, size_t *return_values_count, uint32_t *return_values,
         bool *message_ready, uint32_t timeout);
 
+uint64_t linux_get_time_ns(void);
+uint64_t linux_get_cpu_time_ns(void);
+uint32_t linux_set_completion_mode(uint32_t mode);
+uint32_t linux_counters_enable(uint32_t enable);
+void linux_counters_read(uint64_t *values);
+uint64_t linux_get_stack_limit(void);
+void linux_reset_channel(void);
+uint32_t linux_checkpoint_load(const char *file, uint32_t *test_num, uint32_t *outcome,
+        uint32_t max_entries);
+void linux_checkpoint_append(const char *file, uint32_t test_num, uint32_t outcome);
+void linux_checkpoint_remove(const char *file);
+void *linux_file_open(const char *file);
+void *linux_file_open_append(const char *file);
+void *linux_file_open_read(const char *file);
+uint32_t linux_file_read_line(void *handle, char *line, uint32_t size);
+void linux_file_print(void *handle, const char *format, va_list args);
+void linux_file_close(void *handle);
+
 uint32_t linux_agent_get_accessible_device(uint32_t agent_id);
 uint32_t linux_agent_get_inaccessible_device(uint32_t agent_id);
 uint32_t linux_device_get_accessible_protocol(uint32_t device_id);
@@ -0,0 +1,30 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __PAL_POWERCAP_EXPECTED_H__
+#define __PAL_POWERCAP_EXPECTED_H__
+
+#ifdef POWERCAP_PROTOCOL
+
+uint32_t num_powercap_domains = 0x01;
+
+static char *powercap_domain_names[] = {
+    "SOC",
+};
+#endif
+
+#endif /* __PAL_POWERCAP_EXPECTED_H__ */
@@ -33,9 +33,11 @@ void pal_send_message(uint32_t message_header_send, size_t parameter_count,
         const uint32_t *parameters, uint32_t *message_header_rcv, int32_t *status,
         size_t *return_values_count, uint32_t *return_values)
 {
-    linux_send_message(message_header_send, parameter_count, parameters,
-                        message_header_rcv, status, return_values_count,
-                        return_values);
+    /* A timed out or failed transfer leaves the channel in an unknown state */
+    if (linux_send_message(message_header_send, parameter_count, parameters,
+                           message_header_rcv, status, return_values_count,
+                           return_values) != 0)
+        *status = PAL_COMMS_ERROR;
 }
 
 /**
@@ -77,8 +79,9 @@ void pal_receive_delayed_response(uint32_t *message_header_rcv, int32_t *status,
 {
     uint32_t timeout = TIMEOUT; /* In ms*/
 
-    linux_wait_for_response(message_header_rcv, status,
-            return_values_count, return_values, NULL, timeout);
+    if (linux_wait_for_response(message_header_rcv, status,
+            return_values_count, return_values, NULL, timeout) != 0)
+        *status = PAL_COMMS_ERROR;
 }
 
 /**
@@ -96,3 +99,191 @@ void pal_receive_notification(uint32_t *message_header_rcv, size_t *return_value
             return_values_count, return_values, timeout);
 }
 
+/**
+  @brief   This API is used to read the agent monotonic time
+  @param   none
+  @return  time in nanoseconds
+**/
+uint64_t pal_get_time_ns(void)
+{
+    return linux_get_time_ns();
+}
+
+/**
+  @brief   This API is used to read the CPU time used by the agent
+  @param   none
+  @return  time in nanoseconds
+**/
+uint64_t pal_get_cpu_time_ns(void)
+{
+    return linux_get_cpu_time_ns();
+}
+
+/**
+  @brief   This API is used to open or close the agent side counters
+  @param   enable  1 to open the counters, 0 to close them
+  @return  mask of the available PAL_COUNTER_* counters, PAL_COUNTERS_RUSAGE
+           if context switches and page faults come from getrusage
+**/
+uint32_t pal_counters_enable(uint32_t enable)
+{
+    return linux_counters_enable(enable);
+}
+
+/**
+  @brief   This API is used to read the running totals of the counters
+  @param   values  PAL_NUM_COUNTERS totals, 0 for unavailable counters
+  @return  none
+**/
+void pal_counters_read(uint64_t *values)
+{
+    linux_counters_read(values);
+}
+
+/**
+  @brief   This API is used to get the lowest address the agent stack is
+           painted down to for the stack high-water measurement
+  @param   none
+  @return  lowest stack address
+**/
+uint64_t pal_get_stack_limit(void)
+{
+    return linux_get_stack_limit();
+}
+
+/**
+  @brief   This API is used to select how command completion is waited for
+  @param   mode  PAL_COMPLETION_INTERRUPT, PAL_COMPLETION_POLLED or
+                 PAL_COMPLETION_ADAPTIVE
+  @return  PAL_STATUS_PASS, PAL_STATUS_FAIL if the mode is not supported
+**/
+uint32_t pal_set_completion_mode(uint32_t mode)
+{
+    return linux_set_completion_mode(mode) ? PAL_STATUS_FAIL : PAL_STATUS_PASS;
+}
+
+/**
+  @brief   Fast channels sit in platform memory the mailbox-test driver does
+           not expose, the agent uses the mailbox instead
+  @param   protocol_id  protocol of the channel
+  @param   domain_id    domain of the channel
+  @param   message_id   message carried by the channel
+  @param   chan_addr    channel address from DESCRIBE_FASTCHANNEL
+  @param   chan_size    channel size in bytes
+  @return  NULL
+**/
+void *pal_fast_channel_map(uint32_t protocol_id, uint32_t domain_id, uint32_t message_id,
+                           uint64_t chan_addr, uint32_t chan_size)
+{
+    return NULL;
+}
+
+/**
+  @brief   This API is used to drop stale replies after a command timed out
+  @param   none
+  @return  none
+**/
+void pal_reset_channel(void)
+{
+    linux_reset_channel();
+}
+
+/**
+  @brief   This API is used to read the records of a checkpoint file
+  @param   file         checkpoint file
+  @param   test_num     test numbers read
+  @param   outcome      test outcomes read
+  @param   max_entries  size of the test_num and outcome lists
+  @return  number of records read
+**/
+uint32_t pal_checkpoint_load(const char *file, uint32_t *test_num, uint32_t *outcome,
+                             uint32_t max_entries)
+{
+    return linux_checkpoint_load(file, test_num, outcome, max_entries);
+}
+
+/**
+  @brief   This API is used to append a record to a checkpoint file
+  @param   file      checkpoint file
+  @param   test_num  test number
+  @param   outcome   test outcome
+  @return  none
+**/
+void pal_checkpoint_append(const char *file, uint32_t test_num, uint32_t outcome)
+{
+    linux_checkpoint_append(file, test_num, outcome);
+}
+
+/**
+  @brief   This API is used to remove a checkpoint file
+  @param   file  checkpoint file
+  @return  none
+**/
+void pal_checkpoint_remove(const char *file)
+{
+    linux_checkpoint_remove(file);
+}
+
+/**
+  @brief   This API is used to create a report file
+  @param   file  file name
+  @return  file handle, NULL on failure
+**/
+void *pal_file_open(const char *file)
+{
+    return linux_file_open(file);
+}
+
+/**
+  @brief   This API is used to open a file to add records to
+  @param   file  file name
+  @return  file handle, NULL on failure
+**/
+void *pal_file_open_append(const char *file)
+{
+    return linux_file_open_append(file);
+}
+
+/**
+  @brief   This API is used to open a file to read back
+  @param   file  file name
+  @return  file handle, NULL on failure
+**/
+void *pal_file_open_read(const char *file)
+{
+    return linux_file_open_read(file);
+}
+
+/**
+  @brief   This API is used to read the next line of a file
+  @param   handle  file handle
+  @param   line    buffer for the line
+  @param   size    size of the buffer
+  @return  1 if a line was read, 0 at the end of the file
+**/
+uint32_t pal_file_read_line(void *handle, char *line, uint32_t size)
+{
+    return linux_file_read_line(handle, line, size);
+}
+
+/**
+  @brief   This API is used to append formatted text to a report file
+  @param   handle  file handle
+  @param   format  print data and format
+  @param   args    values to be printed
+  @return  none
+**/
+void pal_file_print(void *handle, const char *format, va_list args)
+{
+    linux_file_print(handle, format, args);
+}
+
+/**
+  @brief   This API is used to close a report file
+  @param   handle  file handle
+  @return  none
+**/
+void pal_file_close(void *handle)
+{
+    linux_file_close(handle);
+}
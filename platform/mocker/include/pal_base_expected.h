@@ -28,6 +28,7 @@ static uint8_t supported_protocols[] = {
     SENSOR_PROTOCOL_ID,
     RESET_PROTOCOL_ID,
     VOLTAGE_PROTOCOL_ID,
+    POWERCAP_PROTOCOL_ID,
 };
 
 /* Expected BASE parameters */
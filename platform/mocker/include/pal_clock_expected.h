@@ -20,7 +20,7 @@
 
 /* Expected CLOCK parameters */
 
-static uint32_t max_num_pending_async_rate_chg_supported = 0;
+static uint32_t max_num_pending_async_rate_chg_supported = 4;
 static uint32_t num_of_clock_rates[] = {
     0x03, /* Clock 0 */
     0x04, /* Clock 1 */
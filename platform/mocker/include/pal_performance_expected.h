@@ -27,8 +27,8 @@ static uint32_t statistics_address_len_perf = 0xFF;
 
 static uint8_t  set_limit_capable[] = {1, 1, 1 ,0};
 static uint8_t  set_performance_level_capable[] = {1, 1, 1 ,0};
-static uint8_t  performance_level_notification_support[] = {0, 0, 0 ,0};
-static uint8_t  performance_limit_notification_support[] = {0, 0, 0 ,0};
+static uint8_t  performance_level_notification_support[] = {1, 1, 0 ,0};
+static uint8_t  performance_limit_notification_support[] = {1, 1, 0 ,0};
 static uint32_t performance_rate_limit[] = {10, 20, 30 ,40};
 static uint32_t performance_sustained_freq[] = {100, 200, 300 ,400};
 static uint32_t performance_sustained_level[] = {110, 120, 130 ,140};
@@ -20,7 +20,9 @@
 
 #include <inttypes.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include <assert.h>
+#include <time.h>
 
 #define BASE_PROTOCOL_ID              0x10
 #define POWER_DOMAIN_PROTOCOL_ID      0x11
@@ -30,6 +32,11 @@
 #define SENSOR_PROTOCOL_ID            0x15
 #define RESET_PROTOCOL_ID             0x16
 #define VOLTAGE_PROTOCOL_ID           0x17
+#define POWERCAP_PROTOCOL_ID          0x18
+
+/* Agents the mocker keeps separate message queues for */
+#define MOCKER_MAX_AGENTS             4
+#define MOCKER_NOTHING_QUEUED         UINT64_MAX
 
 enum BITS_HEADER {
     RESERVED_LOW =      28,
@@ -56,6 +63,8 @@ uint32_t agent_get_accessible_device(uint32_t agent_id);
 uint32_t agent_get_inaccessible_device(uint32_t agent_id);
 uint32_t device_get_accessible_protocol(uint32_t device_id);
 uint32_t check_trusted_agent(uint32_t agent_id);
+char *agent_name_get(uint32_t agent_id);
+bool base_check_access(uint32_t protocol_id, int32_t *status);
 
 void base_send_message(uint32_t message_id, uint32_t parameter_count,
         const uint32_t *parameters, int32_t *status,
@@ -68,6 +77,7 @@ void system_power_send_message(uint32_t message_id, uint32_t parameter_count,
 void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
         const uint32_t *parameters, int32_t *status,
         size_t *return_values_count, uint32_t *return_values);
+void sensor_advance_waveforms(void);
 
 void clock_send_message(uint32_t message_id, uint32_t parameter_count,
         const uint32_t *parameters, int32_t *status,
@@ -89,6 +99,10 @@ void voltage_send_message(uint32_t message_id, uint32_t parameter_count,
         const uint32_t *parameters, int32_t *status,
         size_t *return_values_count, uint32_t *return_values);
 
+void powercap_send_message(uint32_t message_id, uint32_t parameter_count,
+        const uint32_t *parameters, int32_t *status,
+        size_t *return_values_count, uint32_t *return_values);
+
 
 void fill_base_protocol(void);
 void fill_power_protocol(void);
@@ -97,5 +111,35 @@ void fill_sensor_protocol(void);
 void fill_performance_protocol(void);
 void fill_reset_protocol(void);
 void fill_voltage_protocol(void);
+void fill_powercap_protocol(void);
+void fill_system_power_protocol(void);
+void mocker_set_system_suspend_durations(uint32_t suspend_us, uint32_t resume_us);
+void performance_drop_agent(uint32_t agent_id);
+void power_drop_agent(uint32_t agent_id);
+void reset_drop_agent(uint32_t agent_id);
+void sensor_drop_agent(uint32_t agent_id);
+void system_power_drop_agent(uint32_t agent_id);
+uint32_t *mocker_performance_fast_channel(uint32_t domain_id, uint32_t message_id);
+
+bool mocker_receive_notification(uint32_t *message_header_rcv, size_t *return_values_count,
+        uint32_t *return_values);
+bool mocker_receive_delayed_response(uint32_t *message_header_rcv, int32_t *status,
+        size_t *return_values_count, uint32_t *return_values);
+void mocker_reset_channel(void);
+void mocker_drop_agent(uint32_t agent_id);
+uint64_t mocker_notification_due_ns(void);
+uint64_t mocker_delayed_response_due_ns(void);
+void mocker_set_calling_agent(uint32_t agent_id);
+uint32_t mocker_get_calling_agent(void);
+void mocker_initialize(void);
+void mocker_enable_virtual_clock(void);
+uint64_t mocker_get_time_ns(void);
+void mocker_send_message(uint32_t message_header_send, size_t parameter_count,
+        const uint32_t *parameters, uint32_t *message_header_rcv, int32_t *status,
+        size_t *return_values_count, uint32_t *return_values);
+
+/* Agent side counters, built from platform/linux/common/perf_counters.c */
+uint32_t linux_counters_enable(uint32_t enable);
+void linux_counters_read(uint64_t *values);
 
 #endif /*__PAL_PLATFORM__*/
@@ -30,6 +30,8 @@
 #define SENSOR_EXT_ATTR_NOT_SUPPORTED       0
 #define SENSOR_AXIS_SUPPORTED               1
 #define SENSOR_AXIS_NOT_SUPPORTED           0
+/* Timestamp clock rate error modelled by the mocker, 1 / SENSOR_CLOCK_DRIFT_DIV */
+#define SENSOR_CLOCK_DRIFT_PPB              50000
 /*
  * This should have the Asynchronous sensor read support in this platform
  * bounded by the number of sensor descriptors.
@@ -0,0 +1,70 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __PAL_SOCKET_H__
+#define __PAL_SOCKET_H__
+
+#include <pal_platform.h>
+
+/*
+ * Wire format between test agents and scmi_mocker_server. Every request is
+ * one SOCK_SEQPACKET message answered by exactly one reply of the same type.
+ * The whole payload is always carried, as the protocol models report string
+ * returns in bytes and expect the agent to read past the count.
+ */
+#define MOCKER_SOCKET_MAX_WORDS         64
+#define MOCKER_SOCKET_ANY_AGENT         0xFFFFFFFF
+#define MOCKER_SOCKET_COMMS_ERROR       (-7)
+/* Time the adaptive completion mode spins before it sleeps */
+#define MOCKER_SOCKET_SPIN_NS           50000
+
+typedef enum {
+    MOCKER_SOCKET_HELLO,            /* payload[0]: requested agent id, reply header: agent id */
+    MOCKER_SOCKET_COMMAND,
+    MOCKER_SOCKET_DELAYED_RESPONSE, /* reply header 0 when nothing is queued */
+    MOCKER_SOCKET_NOTIFICATION,     /* reply header 0 when nothing is queued */
+    MOCKER_SOCKET_RESET_CHANNEL
+} MOCKER_SOCKET_MSG_TYPE;
+
+typedef struct {
+    uint32_t type;
+    uint32_t message_header;
+    int32_t  status;
+    uint32_t count;
+    uint32_t payload[MOCKER_SOCKET_MAX_WORDS];
+} MOCKER_SOCKET_MSG_s;
+
+/* Passed to pal_initialize_system, a NULL socket_path keeps the platform in process */
+typedef struct {
+    const char *socket_path;
+    uint32_t agent_id;
+    bool virtual_clock;     /* in process only, run the platform on simulated time */
+    uint32_t suspend_us;    /* in process only, system suspend model, 0 for the default */
+    uint32_t resume_us;
+} MOCKER_SOCKET_CONFIG_s;
+
+uint32_t pal_socket_connect(MOCKER_SOCKET_CONFIG_s *config);
+uint32_t pal_socket_set_completion_mode(uint32_t mode);
+bool pal_socket_connected(void);
+void pal_socket_send_message(uint32_t message_header_send, size_t parameter_count,
+        const uint32_t *parameters, uint32_t *message_header_rcv, int32_t *status,
+        size_t *return_values_count, uint32_t *return_values);
+void pal_socket_receive(uint32_t type, uint32_t *message_header_rcv, int32_t *status,
+        size_t *return_values_count, uint32_t *return_values);
+void pal_socket_reset_channel(void);
+
+#endif /* __PAL_SOCKET_H__ */
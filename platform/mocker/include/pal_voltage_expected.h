@@ -18,10 +18,11 @@
 #ifndef __PAL_VOLTAGE_EXPECTED_H__
 #define __PAL_VOLTAGE_EXPECTED_H__
 
-static uint32_t num_voltage_domains = 0x01;
+static uint32_t num_voltage_domains = 0x02;
 
 static char *voltage_domain_names[] = {
     "USB",
+    "CPU",
 };
 
 #endif /* __PAL_VOLTAGE_EXPECTED_H__ */
@@ -41,6 +41,9 @@
 #define PERF_NOTIFY_LVL_MSG_ID              0xA
 #define PERF_DESCRIBE_FASTCHANNEL           0xB
 
+#define PERF_LIMITS_CHANGED_NOTIFICATION_ID 0x0
+#define PERF_LEVEL_CHANGED_NOTIFICATION_ID  0x1
+
 #define MAX_PERFORMANCE_DOMAIN_COUNT        10
 
 struct arm_scmi_performance_protocol {
@@ -37,6 +37,8 @@
 #define PWR_STATE_NOTIFY_MSG_ID                     0x6
 #define PWR_STATE_CHANGE_REQUESTED_NOTIFY_MSG_ID    0x7
 
+#define POWER_STATE_CHANGED_NOTIFICATION_ID         0x0
+
 #define PWR_NOTIFY_ENABLE_SET       1
 #define PWR_NOTIFY_ENABLE_UNSET     0
 
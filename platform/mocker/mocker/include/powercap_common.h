@@ -0,0 +1,147 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef POWERCAP_COMMON_H_
+#define POWERCAP_COMMON_H_
+
+#include <protocol_common.h>
+
+/* Structure for powercap protocol version*/
+struct arm_scmi_powercap_protocol_version {
+    struct  {
+        uint32_t version;
+    } returns;
+};
+
+/* Structure for powercap protocol attributes*/
+struct arm_scmi_powercap_protocol_attributes {
+    struct {
+        uint32_t attributes;
+    } returns;
+    /* all the enums must be at the end */
+    enum {
+        POWERCAP_NUMBER_DOMAIN_LOW = 0,
+        POWERCAP_NUMBER_DOMAIN_HIGH = 15,
+    } attributes_bits;
+};
+
+/* Structure for powercap message attributes*/
+struct arm_scmi_powercap_protocol_message_attributes {
+    struct {
+        uint32_t message_id;
+    } parameters;
+    struct {
+        uint32_t attributes;
+    } returns;
+};
+
+/* Structure for powercap domain attributes*/
+struct arm_scmi_powercap_domain_attributes {
+    struct {
+        uint32_t domain_id;
+    } parameters;
+    struct {
+        uint32_t attributes;
+        char domain_name[SCMI_NAME_STR_SIZE];
+        uint32_t min_pai;
+        uint32_t max_pai;
+        uint32_t pai_step;
+        uint32_t min_power_cap;
+        uint32_t max_power_cap;
+        uint32_t power_cap_step;
+        uint32_t sustainable_power;
+        uint32_t accuracy;
+        uint32_t parent_id;
+    } returns;
+    /* all the enums must be at the end */
+    enum {
+        POWERCAP_POWER_UNIT_LOW = 23,
+        POWERCAP_POWER_UNIT_HIGH = 24,
+        POWERCAP_PAI_CONFIG = 26,
+        POWERCAP_MONITORING = 27,
+        POWERCAP_CAP_CONFIG = 28,
+        POWERCAP_ASYNC_CAP_SET = 29,
+        POWERCAP_MEASUREMENTS_NOTIFY = 30,
+        POWERCAP_CAP_CHANGE_NOTIFY = 31
+    } attributes_bits;
+};
+
+/* Structure for powercap cap get*/
+struct arm_scmi_powercap_cap_get {
+    struct {
+        uint32_t domain_id;
+    } parameters;
+    struct {
+        uint32_t power_cap;
+    } returns;
+};
+
+/* Structure for powercap cap set*/
+struct arm_scmi_powercap_cap_set {
+    struct {
+        uint32_t domain_id;
+        uint32_t flags;
+        uint32_t power_cap;
+    } parameters;
+    /* all the enums must be at the end */
+    enum {
+        POWERCAP_CAP_SET_IGNORE_DRESP = 0,
+        POWERCAP_CAP_SET_ASYNC = 1,
+        POWERCAP_CAP_SET_RESERVED_LOW = 2,
+        POWERCAP_CAP_SET_RESERVED_HIGH = 31
+    } flags_bits;
+};
+
+/* Structure for powercap cap set delayed response*/
+struct arm_scmi_powercap_cap_set_complete {
+    struct {
+        uint32_t domain_id;
+        uint32_t power_cap;
+    } returns;
+};
+
+/* Structure for powercap pai get*/
+struct arm_scmi_powercap_pai_get {
+    struct {
+        uint32_t domain_id;
+    } parameters;
+    struct {
+        uint32_t pai;
+    } returns;
+};
+
+/* Structure for powercap pai set*/
+struct arm_scmi_powercap_pai_set {
+    struct {
+        uint32_t domain_id;
+        uint32_t flags;
+        uint32_t pai;
+    } parameters;
+};
+
+/* Structure for powercap measurements get*/
+struct arm_scmi_powercap_measurements_get {
+    struct {
+        uint32_t domain_id;
+    } parameters;
+    struct {
+        uint32_t power;
+        uint32_t pai;
+    } returns;
+};
+
+#endif /* POWERCAP_COMMON_H_ */
@@ -0,0 +1,106 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef POWERCAP_PROTOCOL_H_
+#define POWERCAP_PROTOCOL_H_
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#define POWERCAP_VERSION 0x00010000
+
+#define POWERCAP_PROTO_ID                    0x18
+#define POWERCAP_PROTO_VER_MSG_ID            0x0
+#define POWERCAP_PROTO_ATTR_MSG_ID           0x1
+#define POWERCAP_PROTO_MSG_ATTR_MSG_ID       0x2
+#define POWERCAP_DOMAIN_ATTRIB_MSG_ID        0x3
+#define POWERCAP_CAP_GET_MSG_ID              0x4
+#define POWERCAP_CAP_SET_MSG_ID              0x5
+#define POWERCAP_PAI_GET_MSG_ID              0x6
+#define POWERCAP_PAI_SET_MSG_ID              0x7
+#define POWERCAP_DOMAIN_NAME_GET_MSG_ID      0x8
+#define POWERCAP_MEASUREMENTS_GET_MSG_ID     0x9
+#define POWERCAP_CAP_NOTIFY_MSG_ID           0xA
+#define POWERCAP_MEASUREMENTS_NOTIFY_MSG_ID  0xB
+#define POWERCAP_DESCRIBE_FASTCHANNEL_MSG_ID 0xC
+
+#define POWERCAP_NO_PARENT                   0xFFFFFFFF
+
+/* Piece of the power model, flat at start_mw until start_ns then linear to end */
+struct powercap_power_ramp {
+    uint64_t start_ns;
+    uint64_t end_ns;
+    uint32_t start_mw;
+    uint32_t end_mw;
+};
+
+struct arm_scmi_powercap_protocol {
+  /*
+   * This enum is to specify the flag_mask and have to be ensured that
+   *  it is in the same order as the below structure elements after
+   *  flags_mask member.
+   */
+  enum {
+      POWERCAP_PROTOCOL_VERSION = 1,
+      POWERCAP_NUMBER_DOMAINS,
+      POWERCAP_DOMAIN_NAME
+  } FLAGS;
+  /*
+   * The expectation is that there is no more
+   * than 32 elements specified via this expected results data structure.
+   * This mask is used to indicate which of the structure members hold valid
+   * data.
+   */
+  uint32_t flags_mask;
+  uint32_t protocol_version;
+
+  uint32_t number_domains;
+
+  /*
+   * This should have the names of the domains in this platform bounded by the
+   * number of domains descriptors.
+   */
+  char  **powercap_domain_name;
+
+  /* Domain attributes and the ranges advertised with them, power in mW */
+  uint32_t *powercap_attributes;
+  uint32_t *powercap_min_pai;
+  uint32_t *powercap_max_pai;
+  uint32_t *powercap_pai_step;
+  uint32_t *powercap_min_cap;
+  uint32_t *powercap_max_cap;
+  uint32_t *powercap_cap_step;
+  uint32_t *powercap_sustainable_power;
+  uint32_t *powercap_accuracy;
+  uint32_t *powercap_parent_id;
+
+  /*
+   * Power model of each domain. The load draws its demand when uncapped,
+   * a new cap takes the apply latency in us to reach the controller, then
+   * power slews to the capped load at the slew rate in mW per us.
+   */
+  uint32_t *powercap_demand;
+  uint32_t *powercap_apply_latency;
+  uint32_t *powercap_slew_rate;
+
+  /* Current state of each domain */
+  uint32_t *powercap_current_cap;
+  uint32_t *powercap_current_pai;
+  struct powercap_power_ramp *powercap_ramp;
+};
+
+#endif /* POWERCAP_PROTOCOL_H_ */
@@ -59,4 +59,28 @@ enum SCMI_STATUS_CODES {
     SCMI_STATUS_NOT_SPECIFIED =         -100
 };
 
+/* Notifications and delayed responses held before the agent collects them */
+#define MOCKER_MAX_PENDING_NOTIFICATIONS    8
+#define MOCKER_MAX_NOTIFICATION_PAYLOAD     32
+
+#define MOCKER_DELAYED_RESPONSE_MSG_TYPE    2
+#define MOCKER_NOTIFICATION_MSG_TYPE        3
+#define MOCKER_MSG_HDR(protocol_id, msg_type, msg_id) \
+    (((protocol_id) << 10) | ((msg_type) << 8) | (msg_id))
+
+/* Virtual clock, starting off zero as agents take a zero time as no time source */
+#define MOCKER_VIRTUAL_CLOCK_START_NS       1000000000ull
+#define MOCKER_VIRTUAL_CLOCK_READ_NS        10
+#define MOCKER_VIRTUAL_COMMAND_NS           1000
+
+uint64_t mocker_get_time_ns(void);
+void mocker_delay_ns(uint64_t delay_ns);
+uint32_t mocker_subscribe(uint32_t agents, bool enable);
+void mocker_post_notification(uint32_t agents, uint32_t message_header, uint64_t due_ns,
+        size_t return_values_count, const uint32_t *return_values);
+void mocker_coalesce_notification(uint32_t agents, uint32_t message_header, uint64_t due_ns,
+        size_t return_values_count, const uint32_t *return_values, const uint32_t *match_mask);
+void mocker_post_delayed_response(uint32_t message_header, uint64_t due_ns, int32_t status,
+        size_t return_values_count, const uint32_t *return_values);
+
 #endif
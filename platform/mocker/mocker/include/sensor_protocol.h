@@ -38,6 +38,10 @@
 #define SNSR_CONFIG_SET_MSG_ID          0xA
 #define SNSR_CNT_UPDATE_NOTIFY_MSG_ID   0xB
 
+#define SNSR_READING_COMPLETE_MSG_ID    0x6
+#define SNSR_TRIP_POINT_EVENT_ID        0x0
+#define SNSR_UPDATE_NOTIFICATION_ID     0x1
+
 #define MAX_NUMBER_SENSOR   32
 #define SENSOR_ASYNC        1
 #define SENSOR_SYNC         0
@@ -75,4 +75,12 @@ struct arm_scmi_system_power_state_set_notify {
         SYSTEM_POWER_SET_NOTIFY_RESERVED_HIGH=31,
     } notify_sys_pwr_set_enable_bits;
 };
+
+struct arm_scmi_system_power_state_notifier {
+    struct {
+        uint32_t agent_id;
+        uint32_t flags;
+        uint32_t system_state;
+    } returns;
+};
 #endif /* SYSTEM_POWER_COMMON_H_ */
@@ -30,6 +30,18 @@
 #define SYSTEM_POWER_STATE_SET_MSG_ID           0x3
 #define SYSTEM_POWER_STATE_GET_MSG_ID           0x4
 #define SYSTEM_POWER_STATE_NOTIFY_MSG_ID        0x5
+#define SYSTEM_POWER_STATE_NOTIFIER_MSG_ID      0x0
+
+#define SYSTEM_POWER_STATE_POWER_UP             0x3
+#define SYSTEM_POWER_STATE_SUSPEND              0x4
+
+/* Suspend model in us, time to enter suspend and time from there to being back up */
+#ifndef SYSTEM_POWER_SUSPEND_US
+#define SYSTEM_POWER_SUSPEND_US                 5000
+#endif
+#ifndef SYSTEM_POWER_RESUME_US
+#define SYSTEM_POWER_RESUME_US                  20000
+#endif
 
 struct arm_scmi_system_power_protocol {
     /*
@@ -50,6 +62,16 @@ struct arm_scmi_system_power_protocol {
     uint32_t protocol_version;
 
     bool system_power_state_notify_cmd_supported;
+
+    bool warm_reset_support;
+    bool system_suspend_support;
+
+    uint64_t suspend_ns;
+    uint64_t resume_ns;
+    /* End of the suspend round trip in progress, STATE_SET is busy until then */
+    uint64_t resume_done_ns;
+    /* Agents with SYSTEM_POWER_STATE_NOTIFIER enabled, one bit per agent id */
+    uint32_t state_notify_agents;
 };
 
 #endif /* SYSTEM_POWER_PROTOCOL_H_ */
@@ -27,4 +27,101 @@ struct arm_scmi_voltage_protocol_version {
     } returns;
 };
 
+/* Structure for voltage protocol attributes*/
+struct arm_scmi_voltage_protocol_attributes {
+    struct {
+        uint32_t attributes;
+    } returns;
+    /* all the enums must be at the end */
+    enum {
+        VOLTAGE_NUMBER_DOMAIN_LOW = 0,
+        VOLTAGE_NUMBER_DOMAIN_HIGH = 15,
+    } attributes_bits;
+};
+
+/* Structure for voltage message attributes*/
+struct arm_scmi_voltage_protocol_message_attributes {
+    struct {
+        uint32_t message_id;
+    } parameters;
+    struct {
+        uint32_t attributes;
+    } returns;
+};
+
+/* Structure for voltage domain attributes*/
+struct arm_scmi_voltage_domain_attributes {
+    struct {
+        uint32_t domain_id;
+    } parameters;
+    struct {
+        uint32_t attributes;
+        char domain_name[SCMI_NAME_STR_SIZE];
+    } returns;
+};
+
+/* Structure for voltage describe levels*/
+struct arm_scmi_voltage_describe_levels {
+    struct {
+        uint32_t domain_id;
+        uint32_t level_index;
+    } parameters;
+    struct {
+        uint32_t flags;
+        int32_t voltage[];
+    } returns;
+    /* all the enums must be at the end */
+    enum {
+        VOLTAGE_NUM_LEVELS_LOW = 0,
+        VOLTAGE_NUM_LEVELS_HIGH = 11,
+        VOLTAGE_RETURN_FORMAT = 12,
+        VOLTAGE_REMAINING_LEVELS_LOW = 16,
+        VOLTAGE_REMAINING_LEVELS_HIGH = 31
+    } flags_bits;
+};
+
+/* Structure for voltage config set*/
+struct arm_scmi_voltage_config_set {
+    struct {
+        uint32_t domain_id;
+        uint32_t config;
+    } parameters;
+    /* all the enums must be at the end */
+    enum {
+        VOLTAGE_CONFIG_MODE_LOW = 0,
+        VOLTAGE_CONFIG_MODE_HIGH = 3,
+        VOLTAGE_CONFIG_RESERVED_LOW = 4,
+        VOLTAGE_CONFIG_RESERVED_HIGH = 31
+    } config_bits;
+};
+
+/* Structure for voltage config get*/
+struct arm_scmi_voltage_config_get {
+    struct {
+        uint32_t domain_id;
+    } parameters;
+    struct {
+        uint32_t config;
+    } returns;
+};
+
+/* Structure for voltage level set*/
+struct arm_scmi_voltage_level_set {
+    struct {
+        uint32_t domain_id;
+        uint32_t flags;
+        int32_t voltage_level;
+    } parameters;
+};
+
+/* Structure for voltage level get*/
+struct arm_scmi_voltage_level_get {
+    struct {
+        uint32_t domain_id;
+    } parameters;
+    struct {
+        int32_t voltage_level;
+    } returns;
+};
+
 #endif /* VOLTAGE_COMMON_H_ */
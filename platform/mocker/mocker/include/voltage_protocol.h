@@ -25,6 +25,21 @@
 
 #define VOLTAGE_PROTO_ID                   0x17
 #define VOLTAGE_PROTO_VER_MSG_ID           0x0
+#define VOLTAGE_PROTO_ATTR_MSG_ID          0x1
+#define VOLTAGE_PROTO_MSG_ATTR_MSG_ID      0x2
+#define VOLTAGE_DOMAIN_ATTRIB_MSG_ID       0x3
+#define VOLTAGE_DESCRIBE_LEVELS_MSG_ID     0x4
+#define VOLTAGE_CONFIG_SET_MSG_ID          0x5
+#define VOLTAGE_CONFIG_GET_MSG_ID          0x6
+#define VOLTAGE_LEVEL_SET_MSG_ID           0x7
+#define VOLTAGE_LEVEL_GET_MSG_ID           0x8
+
+#define VOLTAGE_LEVEL_FORMAT_ARRAY         0
+#define VOLTAGE_LEVEL_FORMAT_TRIPLET       1
+
+#define VOLTAGE_CONFIG_ARCH_OFF            0x0
+#define VOLTAGE_CONFIG_ARCH_ON             0x7
+#define VOLTAGE_CONFIG_IMPL_DEFINED        0x8
 
 
 struct arm_scmi_voltage_protocol {
@@ -57,6 +72,21 @@ struct arm_scmi_voltage_protocol {
    * number of domains descriptors.
    */
   char  **voltage_domain_name;
+
+  /*
+   * Level description of each domain, either a list of levels or a
+   * start/end/step triplet depending on voltage_level_format.
+   */
+  uint8_t *voltage_level_format;
+  uint32_t *voltage_num_levels;
+  int32_t **voltage_levels;
+
+  /* Regulator slew rate in uV per us used to model level changes */
+  uint32_t *voltage_slew_rate;
+
+  /* Current state of each domain */
+  uint32_t *voltage_config;
+  int32_t *voltage_current_level;
 };
 
 #endif /* VOLTAGE_PROTOCOL_H_ */
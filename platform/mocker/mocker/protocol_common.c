@@ -0,0 +1,409 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include <protocol_common.h>
+#include <pal_platform.h>
+#include <val_schema.h>
+#include <time.h>
+
+struct mocker_message {
+    uint32_t message_header;
+    uint64_t due_ns;
+    int32_t status;
+    size_t return_values_count;
+    uint32_t return_values[MOCKER_MAX_NOTIFICATION_PAYLOAD];
+};
+
+struct mocker_message_queue {
+    struct mocker_message entry[MOCKER_MAX_PENDING_NOTIFICATIONS];
+    uint32_t head;
+    uint32_t count;
+};
+
+/* Every agent collects its own notifications and delayed responses */
+static struct mocker_message_queue notification_queue[MOCKER_MAX_AGENTS];
+static struct mocker_message_queue delayed_response_queue[MOCKER_MAX_AGENTS];
+static uint32_t calling_agent;
+
+/*
+ * With the virtual clock, time only moves when the platform model does work,
+ * when a command is handled or when the clock is read. Waiting for a queued
+ * message jumps straight to the time it falls due.
+ */
+static bool virtual_clock_enabled;
+static uint64_t virtual_time_ns;
+
+void mocker_enable_virtual_clock(void)
+{
+    virtual_clock_enabled = true;
+    virtual_time_ns = MOCKER_VIRTUAL_CLOCK_START_NS;
+}
+
+uint64_t mocker_get_time_ns(void)
+{
+    struct timespec ts;
+
+    /* Reads move the clock on so callers spinning on it still make progress */
+    if (virtual_clock_enabled) {
+        virtual_time_ns += MOCKER_VIRTUAL_CLOCK_READ_NS;
+        return virtual_time_ns;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + ts.tv_nsec;
+}
+
+/* Hold the caller to model the platform taking time to complete a request */
+void mocker_delay_ns(uint64_t delay_ns)
+{
+    uint64_t start;
+
+    if (virtual_clock_enabled) {
+        virtual_time_ns += delay_ns;
+        return;
+    }
+
+    start = mocker_get_time_ns();
+    while ((mocker_get_time_ns() - start) < delay_ns)
+        ;
+}
+
+/* Messages are handled on behalf of, and queued for, the calling agent */
+void mocker_set_calling_agent(uint32_t agent_id)
+{
+    assert(agent_id < MOCKER_MAX_AGENTS);
+    calling_agent = agent_id;
+}
+
+uint32_t mocker_get_calling_agent(void)
+{
+    return calling_agent;
+}
+
+/* When a queue is full the oldest message is dropped */
+static void mocker_queue_post(struct mocker_message_queue *queue, uint32_t message_header,
+        uint64_t due_ns, int32_t status, size_t return_values_count,
+        const uint32_t *return_values)
+{
+    struct mocker_message *entry;
+    uint32_t i;
+
+    if (return_values_count > MOCKER_MAX_NOTIFICATION_PAYLOAD)
+        return_values_count = MOCKER_MAX_NOTIFICATION_PAYLOAD;
+
+    if (queue->count == MOCKER_MAX_PENDING_NOTIFICATIONS) {
+        queue->head = (queue->head + 1) % MOCKER_MAX_PENDING_NOTIFICATIONS;
+        queue->count--;
+    }
+
+    entry = &queue->entry[(queue->head + queue->count) % MOCKER_MAX_PENDING_NOTIFICATIONS];
+    entry->message_header = message_header;
+    entry->due_ns = due_ns;
+    entry->status = status;
+    entry->return_values_count = return_values_count;
+    for (i = 0; i < return_values_count; i++)
+        entry->return_values[i] = return_values[i];
+    queue->count++;
+}
+
+/* Deliver the oldest queued message, waiting for it to fall due */
+static bool mocker_queue_receive(struct mocker_message_queue *queue, uint32_t *message_header_rcv,
+        int32_t *status, size_t *return_values_count, uint32_t *return_values)
+{
+    struct mocker_message *entry;
+    uint64_t now;
+    uint32_t i;
+
+    if (queue->count == 0)
+        return false;
+
+    entry = &queue->entry[queue->head];
+    now = mocker_get_time_ns();
+    if (entry->due_ns > now)
+        mocker_delay_ns(entry->due_ns - now);
+
+    *message_header_rcv = entry->message_header;
+    if (status)
+        *status = entry->status;
+    *return_values_count = entry->return_values_count;
+    for (i = 0; i < entry->return_values_count; i++)
+        return_values[i] = entry->return_values[i];
+
+    queue->head = (queue->head + 1) % MOCKER_MAX_PENDING_NOTIFICATIONS;
+    queue->count--;
+    return true;
+}
+
+/*
+ * Check a reply the model built against the message schema the agent decodes
+ * with, so a model that drifts from the specification is reported here rather
+ * than as a test failure. Messages without a schema are not checked.
+ */
+static void mocker_schema_check(uint32_t message_header, size_t return_values_count,
+        const uint32_t *return_values)
+{
+    VAL_SCHEMA_RESULT_s result;
+
+    switch (val_schema_decode(message_header, return_values_count, return_values, &result))
+    {
+    case VAL_SCHEMA_BAD_COUNT:
+        fprintf(stderr, "mocker: message 0x%05x returns %zu words, schema expects %u\n",
+                message_header & VAL_SCHEMA_HDR_MASK, return_values_count,
+                result.expected_count);
+        break;
+    case VAL_SCHEMA_RESERVED_SET:
+        fprintf(stderr, "mocker: message 0x%05x sets reserved bits 0x%08x in word %u\n",
+                message_header & VAL_SCHEMA_HDR_MASK, result.reserved_bits, result.word);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Update the calling agent's bit in a mask of agents subscribed to an event */
+uint32_t mocker_subscribe(uint32_t agents, bool enable)
+{
+    if (enable)
+        return agents | (1u << calling_agent);
+
+    return agents & ~(1u << calling_agent);
+}
+
+/*
+ * Queue a notification for every agent in agents, the agents subscribed to
+ * it. It is not delivered before due_ns so asynchronous completions become
+ * visible only once the modelled work ends.
+ */
+void mocker_post_notification(uint32_t agents, uint32_t message_header, uint64_t due_ns,
+        size_t return_values_count, const uint32_t *return_values)
+{
+    uint32_t agent_id;
+
+    if (agents == 0)
+        return;
+
+    mocker_schema_check(message_header, return_values_count, return_values);
+    for (agent_id = 0; agent_id < MOCKER_MAX_AGENTS; agent_id++)
+    {
+        if (agents & (1u << agent_id))
+            mocker_queue_post(&notification_queue[agent_id], message_header, due_ns,
+                    SCMI_STATUS_SUCCESS, return_values_count, return_values);
+    }
+}
+
+/*
+ * Merge a notification into one still waiting for the agent if their payloads
+ * agree on every bit of match_mask, as a platform with one pending event slot
+ * per source does. The waiting entry takes the new payload and keeps its
+ * place in the queue. Otherwise the notification is queued as usual.
+ * Returns true if it was merged.
+ */
+static bool mocker_coalesce_one(struct mocker_message_queue *queue, uint32_t message_header,
+        size_t return_values_count, const uint32_t *return_values, const uint32_t *match_mask)
+{
+    struct mocker_message *entry;
+    uint32_t i, j;
+
+    for (i = 0; i < queue->count; i++)
+    {
+        entry = &queue->entry[(queue->head + i) % MOCKER_MAX_PENDING_NOTIFICATIONS];
+        if ((entry->message_header != message_header) ||
+            (entry->return_values_count != return_values_count))
+            continue;
+
+        for (j = 0; j < return_values_count; j++)
+        {
+            if ((entry->return_values[j] ^ return_values[j]) & match_mask[j])
+                break;
+        }
+        if (j < return_values_count)
+            continue;
+
+        for (j = 0; j < return_values_count; j++)
+            entry->return_values[j] = return_values[j];
+        return true;
+    }
+
+    return false;
+}
+
+/* Coalesce a notification for every agent in agents, see mocker_coalesce_one */
+void mocker_coalesce_notification(uint32_t agents, uint32_t message_header, uint64_t due_ns,
+        size_t return_values_count, const uint32_t *return_values, const uint32_t *match_mask)
+{
+    uint32_t agent_id;
+
+    if (agents == 0)
+        return;
+
+    mocker_schema_check(message_header, return_values_count, return_values);
+    for (agent_id = 0; agent_id < MOCKER_MAX_AGENTS; agent_id++)
+    {
+        if (!(agents & (1u << agent_id)) ||
+            mocker_coalesce_one(&notification_queue[agent_id], message_header,
+                                return_values_count, return_values, match_mask))
+            continue;
+
+        mocker_queue_post(&notification_queue[agent_id], message_header, due_ns,
+                SCMI_STATUS_SUCCESS, return_values_count, return_values);
+    }
+}
+
+/* Queue the delayed response completing an asynchronous command */
+void mocker_post_delayed_response(uint32_t message_header, uint64_t due_ns, int32_t status,
+        size_t return_values_count, const uint32_t *return_values)
+{
+    if (status == SCMI_STATUS_SUCCESS)
+        mocker_schema_check(message_header, return_values_count, return_values);
+    mocker_queue_post(&delayed_response_queue[calling_agent], message_header, due_ns, status,
+            return_values_count, return_values);
+}
+
+bool mocker_receive_notification(uint32_t *message_header_rcv, size_t *return_values_count,
+        uint32_t *return_values)
+{
+    return mocker_queue_receive(&notification_queue[calling_agent], message_header_rcv, NULL,
+            return_values_count, return_values);
+}
+
+bool mocker_receive_delayed_response(uint32_t *message_header_rcv, int32_t *status,
+        size_t *return_values_count, uint32_t *return_values)
+{
+    return mocker_queue_receive(&delayed_response_queue[calling_agent], message_header_rcv, status,
+            return_values_count, return_values);
+}
+
+/* Time the oldest message queued for the agent falls due, MOCKER_NOTHING_QUEUED if none */
+static uint64_t mocker_queue_due_ns(struct mocker_message_queue *queue)
+{
+    if (queue->count == 0)
+        return MOCKER_NOTHING_QUEUED;
+
+    return queue->entry[queue->head].due_ns;
+}
+
+uint64_t mocker_notification_due_ns(void)
+{
+    return mocker_queue_due_ns(&notification_queue[calling_agent]);
+}
+
+uint64_t mocker_delayed_response_due_ns(void)
+{
+    return mocker_queue_due_ns(&delayed_response_queue[calling_agent]);
+}
+
+/* Drop everything still queued for an agent that gave up waiting */
+void mocker_reset_channel(void)
+{
+    notification_queue[calling_agent].head = 0;
+    notification_queue[calling_agent].count = 0;
+    delayed_response_queue[calling_agent].head = 0;
+    delayed_response_queue[calling_agent].count = 0;
+}
+
+/* Forget an agent that went away, so one connecting as it later starts afresh */
+void mocker_drop_agent(uint32_t agent_id)
+{
+    mocker_set_calling_agent(agent_id);
+    mocker_reset_channel();
+    performance_drop_agent(agent_id);
+    power_drop_agent(agent_id);
+    reset_drop_agent(agent_id);
+    sensor_drop_agent(agent_id);
+    system_power_drop_agent(agent_id);
+}
+
+void mocker_initialize(void)
+{
+    fill_base_protocol();
+    fill_power_protocol();
+    fill_performance_protocol();
+    fill_sensor_protocol();
+    fill_clock_protocol();
+    fill_reset_protocol();
+    fill_voltage_protocol();
+    fill_powercap_protocol();
+    fill_system_power_protocol();
+}
+
+/* Check the calling agent may use the protocol and hand the command to it */
+void mocker_send_message(uint32_t message_header_send, size_t parameter_count,
+        const uint32_t *parameters, uint32_t *message_header_rcv, int32_t *status,
+        size_t *return_values_count, uint32_t *return_values)
+{
+    int message_id;
+    int protocol_id;
+
+    if (virtual_clock_enabled)
+        virtual_time_ns += MOCKER_VIRTUAL_COMMAND_NS;
+
+    *message_header_rcv = message_header_send;
+    protocol_id = SCMI_EXRACT_BITS(message_header_send,
+            PROTOCOL_ID_HIGH, PROTOCOL_ID_LOW);
+    message_id = SCMI_EXRACT_BITS(message_header_send,
+            MESSAGE_ID_HIGH, MESSAGE_ID_LOW);
+
+    if (!base_check_access(protocol_id, status))
+        return;
+
+    switch (protocol_id)
+    {
+    case BASE_PROTOCOL_ID:
+        base_send_message(message_id, parameter_count, parameters, status,
+                return_values_count, return_values);
+        break;
+    case POWER_DOMAIN_PROTOCOL_ID:
+        power_send_message(message_id, parameter_count, parameters, status,
+                return_values_count, return_values);
+        break;
+    case SYSTEM_POWER_PROTOCOL_ID:
+        system_power_send_message(message_id, parameter_count, parameters, status,
+                return_values_count, return_values);
+        break;
+    case PERFORMANCE_PROTOCOL_ID:
+        performance_send_message(message_id, parameter_count, parameters, status,
+                return_values_count, return_values);
+        break;
+    case CLOCK_PROTOCOL_ID:
+        clock_send_message(message_id, parameter_count, parameters, status,
+                return_values_count, return_values);
+        break;
+    case SENSOR_PROTOCOL_ID:
+        sensor_send_message(message_id, parameter_count, parameters, status,
+                return_values_count, return_values);
+        break;
+    case RESET_PROTOCOL_ID:
+        reset_send_message(message_id, parameter_count, parameters, status,
+                return_values_count, return_values);
+        break;
+    case VOLTAGE_PROTOCOL_ID:
+        voltage_send_message(message_id, parameter_count, parameters, status,
+                return_values_count, return_values);
+        break;
+    case POWERCAP_PROTOCOL_ID:
+        powercap_send_message(message_id, parameter_count, parameters, status,
+                return_values_count, return_values);
+        break;
+    default:
+        *status = SCMI_STATUS_NOT_SUPPORTED;
+        break;
+    }
+
+    if (*status == SCMI_STATUS_SUCCESS)
+        mocker_schema_check(message_header_send, *return_values_count, return_values);
+}
+
@@ -48,19 +48,33 @@ uint32_t get_unsupported_protocol()
 
 static char* devices[] =
 {
-    "DEVICE 1", "DEVICE 2"
+    "DEVICE_0", "DEVICE_1"
 };
 
-static struct device_access_info agent1_device_access[] =
+#define NUM_DEVICES         NUM_ELEMS(devices)
+#define NUM_AGENT_ENTRIES   (NUM_ELEMS(agents) + 1)
+#define PROTOCOL_BIT(id)    (1u << ((id) - BASE_PROTOCOL_ID))
+
+/* Protocols exposed by each device */
+static const uint32_t device_protocols[] =
 {
-    {"DEVICE_0", true, 0},
-    {"DEVICE_1", true, 1}
+    PROTOCOL_BIT(POWER_DOMAIN_PROTOCOL_ID) | PROTOCOL_BIT(SYSTEM_POWER_PROTOCOL_ID) |
+    PROTOCOL_BIT(PERFORMANCE_PROTOCOL_ID) | PROTOCOL_BIT(POWERCAP_PROTOCOL_ID),
+    PROTOCOL_BIT(CLOCK_PROTOCOL_ID) | PROTOCOL_BIT(SENSOR_PROTOCOL_ID) |
+    PROTOCOL_BIT(RESET_PROTOCOL_ID) | PROTOCOL_BIT(VOLTAGE_PROTOCOL_ID)
 };
 
-static struct device_protocol_access_info agent_protocol_access[] =
+/* Permission matrix, one bit per device and per protocol, cleared means allowed */
+static uint32_t agent_device_denied[NUM_AGENT_ENTRIES];
+static uint32_t agent_protocol_denied[NUM_AGENT_ENTRIES][NUM_DEVICES];
+
+static bool device_has_protocol(uint32_t device_id, uint32_t protocol_id)
 {
-    {POWER_DOMAIN_PROTOCOL_ID, true},
-};
+    if ((protocol_id <= BASE_PROTOCOL_ID) || (protocol_id >= BASE_PROTOCOL_ID + 32))
+        return false;
+
+    return (device_protocols[device_id] & PROTOCOL_BIT(protocol_id)) != 0;
+}
 
 char *agent_name_get(uint32_t agent_id)
 {
@@ -73,29 +87,44 @@ char *agent_name_get(uint32_t agent_id)
 
 uint32_t agent_get_accessible_device(uint32_t agent_id)
 {
-    return agent1_device_access[0].device_id;
+    return 0;
 }
 
-bool device_access_permitted (void)
+/* The calling agent may use a protocol through any device that exposes it,
+ * provided both the device and the protocol on it are allowed. The base
+ * protocol and protocols no device exposes are not subject to permissions. */
+static bool protocol_access_permitted(uint32_t protocol_id)
 {
-    return agent1_device_access[0].device_access;
+    uint32_t device_id, agent_id = mocker_get_calling_agent();
+    bool exposed = false;
+
+    for (device_id = 0; device_id < NUM_DEVICES; device_id++) {
+        if (!device_has_protocol(device_id, protocol_id))
+            continue;
+        exposed = true;
+        if (agent_device_denied[agent_id] & (1u << device_id))
+            continue;
+        if (agent_protocol_denied[agent_id][device_id] & PROTOCOL_BIT(protocol_id))
+            continue;
+        return true;
+    }
+    return !exposed;
 }
 
-bool protocol_access_permitted (uint32_t protocol_id)
+/* Checked for every command before it is dispatched to its protocol */
+bool base_check_access(uint32_t protocol_id, int32_t *status)
 {
-    int32_t i;
+    if (protocol_access_permitted(protocol_id))
+        return true;
 
-    for(i = 0; i < NUM_ELEMS(agent_protocol_access); i++) {
-        if(agent_protocol_access[i].protocol_id == protocol_id)
-            return agent_protocol_access[i].protocol_access;
-    }
+    *status = SCMI_STATUS_DENIED;
     return false;
 }
 
+/* No device beyond the last one exists, so no agent can be given access to it */
 uint32_t agent_get_inaccessible_device(uint32_t agent_id)
 {
-    return agent1_device_access[NUM_ELEMS(agent1_device_access)].device_id + 1;
-
+    return NUM_DEVICES;
 }
 
 uint32_t device_get_accessible_protocol(uint32_t device_id)
@@ -231,8 +260,9 @@ void base_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_SUCCESS;
             if (parameters[parameter_idx] == 0xFFFFFFFF)
             {
-                return_values[0] = 0;
-                sprintf((char *)&return_values[1], "%s", agent_name_get(0));
+                return_values[0] = mocker_get_calling_agent();
+                sprintf((char *)&return_values[1], "%s",
+                        agent_name_get(mocker_get_calling_agent()));
             }
             else
             {
@@ -279,16 +309,15 @@ void base_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_INVALID_PARAMETERS;
             break;
         }
-        if ((agent_id > base_protocol.num_agents) || (device_id > NUM_ELEMS(devices))) {
+        if ((agent_id > base_protocol.num_agents) || (device_id >= NUM_DEVICES)) {
             *status = SCMI_STATUS_NOT_FOUND;
             break;
         }
 
-        if (device_id > NUM_ELEMS(agent1_device_access)) {
-            *status = SCMI_STATUS_DENIED;
-            break;
-        }
-        agent1_device_access[device_id].device_access = flags;
+        if (flags == 1)
+            agent_device_denied[agent_id] &= ~(1u << device_id);
+        else
+            agent_device_denied[agent_id] |= (1u << device_id);
         *status = SCMI_STATUS_SUCCESS;
         break;
     case BASE_SET_PROTOCOL_PERMISSIONS_MSG_ID:
@@ -310,8 +339,9 @@ void base_send_message(uint32_t message_id, uint32_t parameter_count,
             break;
         }
         if ((parameters[agent_id] > base_protocol.num_agents) ||
-                (parameters[device_id] > NUM_ELEMS(devices)) ||
-                (parameters[command_id] >= get_unsupported_protocol())) {
+                (parameters[device_id] >= NUM_DEVICES) ||
+                (parameters[command_id] >= get_unsupported_protocol()) ||
+                !device_has_protocol(parameters[device_id], parameters[command_id])) {
             *status = SCMI_STATUS_NOT_FOUND;
             break;
         }
@@ -319,10 +349,12 @@ void base_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_INVALID_PARAMETERS;
             break;
         }
-        for(i = 0; i < NUM_ELEMS(agent_protocol_access); i++) {
-            if(agent_protocol_access[i].protocol_id == parameters[command_id])
-                agent_protocol_access[i].protocol_access = parameters[flags];
-        }
+        if (parameters[flags] == 1)
+            agent_protocol_denied[parameters[agent_id]][parameters[device_id]] &=
+                    ~PROTOCOL_BIT(parameters[command_id]);
+        else
+            agent_protocol_denied[parameters[agent_id]][parameters[device_id]] |=
+                    PROTOCOL_BIT(parameters[command_id]);
         break;
     case BASE_RESET_AGENT_CONFIGURATION_MSG_ID:
         if (base_protocol.reset_agent_config_cmd_supported == false)
@@ -343,10 +375,9 @@ void base_send_message(uint32_t message_id, uint32_t parameter_count,
             break;
         }
         if(parameters[flags] == 1) {
-            agent1_device_access[0].device_access = true;
-            for(i = 0; i < NUM_ELEMS(agent_protocol_access); i++) {
-                agent_protocol_access[i].protocol_access = true;
-            }
+            agent_device_denied[parameters[agent_id]] = 0;
+            for(i = 0; i < NUM_DEVICES; i++)
+                agent_protocol_denied[parameters[agent_id]][i] = 0;
         }
         break;
     default:
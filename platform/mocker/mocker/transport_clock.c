@@ -19,10 +19,58 @@
 #include <clock_common.h>
 #include <pal_clock_expected.h>
 
+#define CLOCK_RATE_SET_COMPLETE_MSG_ID  CLK_RATE_SET_MSG_ID
+/* Time a clock takes to relock at a new rate, changes to one clock queue up */
+#define CLOCK_RATE_CHANGE_NS            50000
+#define CLOCK_MAX_PENDING_ASYNC         16
+
 struct arm_scmi_clock_protocol clock_protocol;
 static unsigned int clock_status[MAX_NUM_CLOCK];
 struct arm_scmi_clock_rate clock_rate[MAX_NUM_CLOCK];
 
+static uint64_t clock_busy_until_ns[MAX_NUM_CLOCK];
+static uint64_t clock_pending_due_ns[CLOCK_MAX_PENDING_ASYNC];
+
+/*
+ * Start an asynchronous rate change, or return false if the platform already
+ * has as many in flight as it advertises. A change stops being pending once
+ * the clock has relocked, whether or not the agent has collected the
+ * delayed response yet.
+ */
+static bool clock_rate_set_async(uint32_t clock_id, uint32_t flags)
+{
+    uint64_t now = mocker_get_time_ns();
+    uint32_t i, num_pending = 0, free_slot = CLOCK_MAX_PENDING_ASYNC;
+    uint32_t payload[3];
+
+    for (i = 0; i < CLOCK_MAX_PENDING_ASYNC; i++)
+    {
+        if (clock_pending_due_ns[i] > now)
+            num_pending++;
+        else if (free_slot == CLOCK_MAX_PENDING_ASYNC)
+            free_slot = i;
+    }
+    if ((num_pending >= clock_protocol.max_num_pending_async_rate_chg_supported) ||
+        (free_slot == CLOCK_MAX_PENDING_ASYNC))
+        return false;
+
+    if (clock_busy_until_ns[clock_id] < now)
+        clock_busy_until_ns[clock_id] = now;
+    clock_busy_until_ns[clock_id] += CLOCK_RATE_CHANGE_NS;
+    clock_pending_due_ns[free_slot] = clock_busy_until_ns[clock_id];
+
+    if ((flags >> CLK_RATESET_IGNORE_DELAY_RSP_LOW) & 0x1)
+        return true;
+
+    payload[0] = clock_id;
+    payload[1] = clock_rate[clock_id].lower;
+    payload[2] = clock_rate[clock_id].upper;
+    mocker_post_delayed_response(MOCKER_MSG_HDR(CLK_PROTO_ID,
+            MOCKER_DELAYED_RESPONSE_MSG_TYPE, CLOCK_RATE_SET_COMPLETE_MSG_ID),
+            clock_busy_until_ns[clock_id], SCMI_STATUS_SUCCESS, 3, payload);
+    return true;
+}
+
 void fill_clock_protocol()
 {
     clock_protocol.protocol_version = CLOCK_VERSION;
@@ -37,7 +85,7 @@ void clock_send_message(uint32_t message_id, uint32_t parameter_count,
         size_t *return_values_count, uint32_t *return_values)
 {
 
-    uint32_t parameter_idx, return_idx, clock_id;
+    uint32_t parameter_idx, return_idx, clock_id, flags, lower, upper;
     char * str;
     int i, j;
 
@@ -136,10 +184,20 @@ void clock_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_INVALID_PARAMETERS;
             break;
         }
+        flags = parameters[OFFSET_PARAM(struct arm_scmi_clock_rate_set, flags)];
+        lower = clock_rate[clock_id].lower;
+        upper = clock_rate[clock_id].upper;
         clock_rate[clock_id].lower = parameters[OFFSET_PARAM(
                                      struct arm_scmi_clock_rate_set, rate)];
         clock_rate[clock_id].upper = parameters[OFFSET_PARAM(
                                      struct arm_scmi_clock_rate_set, rate) + 1];
+        if (((flags >> CLK_RATESET_ASYNC_FLAG_LOW) & 0x1) &&
+            !clock_rate_set_async(clock_id, flags)) {
+            clock_rate[clock_id].lower = lower;
+            clock_rate[clock_id].upper = upper;
+            *status = SCMI_STATUS_BUSY;
+            break;
+        }
         *status = SCMI_STATUS_SUCCESS;
         break;
     case CLK_RATE_GET_MSG_ID:
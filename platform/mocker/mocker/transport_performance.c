@@ -25,6 +25,31 @@ static unsigned int perf_level_max_limit[MAX_PERFORMANCE_DOMAIN_COUNT];
 static unsigned int perf_level_min_limit[MAX_PERFORMANCE_DOMAIN_COUNT];
 static unsigned int perf_level_current[MAX_PERFORMANCE_DOMAIN_COUNT];
 
+/*
+ * Rate limit model. A request arriving within the domain rate limit of the
+ * last applied one is accepted but coalesced, only the latest is applied once
+ * the window has passed.
+ */
+static bool perf_level_pending[MAX_PERFORMANCE_DOMAIN_COUNT];
+static unsigned int perf_level_requested[MAX_PERFORMANCE_DOMAIN_COUNT];
+static uint64_t perf_level_applied_ns[MAX_PERFORMANCE_DOMAIN_COUNT];
+static bool perf_limits_pending[MAX_PERFORMANCE_DOMAIN_COUNT];
+static unsigned int perf_limits_requested_max[MAX_PERFORMANCE_DOMAIN_COUNT];
+static unsigned int perf_limits_requested_min[MAX_PERFORMANCE_DOMAIN_COUNT];
+static uint64_t perf_limits_applied_ns[MAX_PERFORMANCE_DOMAIN_COUNT];
+
+/* Agents subscribed to the notifications of each domain, one bit per agent */
+static uint32_t perf_level_notify_agents[MAX_PERFORMANCE_DOMAIN_COUNT];
+static uint32_t perf_limits_notify_agents[MAX_PERFORMANCE_DOMAIN_COUNT];
+
+/*
+ * Level set fast channels of the in process model. The agent writes a level
+ * into the channel and the model picks it up the next time it handles a
+ * performance command, as a platform polling its channels would.
+ */
+static uint32_t perf_fast_channel_level[MAX_PERFORMANCE_DOMAIN_COUNT];
+static uint32_t perf_fast_channel_level_seen[MAX_PERFORMANCE_DOMAIN_COUNT];
+
 void fill_performance_protocol()
 {
     performance_protocol.protocol_version = PERFORMANCE_VERSION;
@@ -67,6 +92,181 @@ void fill_performance_protocol()
             perf_performance_fast_chan_doorbell_preserve_mask_high;
 }
 
+/* Returns the time a request can next be applied, 0 if there is no earlier one */
+static uint64_t performance_window_end_ns(uint32_t domain_id, uint64_t applied_ns)
+{
+    if (applied_ns == 0)
+        return 0;
+    return applied_ns + performance_protocol.performance_rate_limit[domain_id] * 1000ull;
+}
+
+/* Worst case latency of the transition to a level, 0 for an unknown level */
+static uint64_t performance_level_latency_ns(uint32_t domain_id, unsigned int level)
+{
+    uint32_t i;
+
+    for (i = 0; i < performance_protocol.num_performance_levels[domain_id]; i++)
+    {
+        if (performance_protocol.performance_level_value[domain_id][i] == level)
+            return performance_protocol.performance_level_worst_latency[domain_id][i] * 1000ull;
+    }
+
+    return 0;
+}
+
+/*
+ * Notify a change once it has been applied. There is one event slot per
+ * domain, so a change still waiting for the agent is replaced by the newer.
+ */
+static void performance_notify_level(uint32_t domain_id, unsigned int level, uint64_t applied_ns)
+{
+    static const uint32_t match_mask[] = {0xFFFFFFFF, 0xFFFFFFFF, 0};
+    uint32_t notify[3];
+
+    if (!perf_level_notify_agents[domain_id])
+        return;
+
+    /* agent id, domain id, performance level */
+    notify[0] = 0;
+    notify[1] = domain_id;
+    notify[2] = level;
+    mocker_coalesce_notification(perf_level_notify_agents[domain_id],
+            MOCKER_MSG_HDR(PERF_MGMT_PROTO_ID, MOCKER_NOTIFICATION_MSG_TYPE,
+            PERF_LEVEL_CHANGED_NOTIFICATION_ID),
+            applied_ns + performance_level_latency_ns(domain_id, level), NUM_ELEMS(notify),
+            notify, match_mask);
+}
+
+static void performance_notify_limits(uint32_t domain_id, unsigned int range_max,
+                                      unsigned int range_min, uint64_t applied_ns)
+{
+    static const uint32_t match_mask[] = {0xFFFFFFFF, 0xFFFFFFFF, 0, 0};
+    uint32_t notify[4];
+
+    if (!perf_limits_notify_agents[domain_id])
+        return;
+
+    /* agent id, domain id, range max, range min */
+    notify[0] = 0;
+    notify[1] = domain_id;
+    notify[2] = range_max;
+    notify[3] = range_min;
+    mocker_coalesce_notification(perf_limits_notify_agents[domain_id],
+            MOCKER_MSG_HDR(PERF_MGMT_PROTO_ID, MOCKER_NOTIFICATION_MSG_TYPE,
+            PERF_LIMITS_CHANGED_NOTIFICATION_ID),
+            applied_ns, NUM_ELEMS(notify), notify, match_mask);
+}
+
+void performance_drop_agent(uint32_t agent_id)
+{
+    uint32_t domain_id;
+
+    for (domain_id = 0; domain_id < MAX_PERFORMANCE_DOMAIN_COUNT; domain_id++)
+    {
+        perf_level_notify_agents[domain_id] &= ~(1u << agent_id);
+        perf_limits_notify_agents[domain_id] &= ~(1u << agent_id);
+    }
+}
+
+static void performance_update_level(uint32_t domain_id)
+{
+    uint64_t due_ns = performance_window_end_ns(domain_id, perf_level_applied_ns[domain_id]);
+
+    if (perf_level_pending[domain_id] && mocker_get_time_ns() >= due_ns) {
+        perf_level_current[domain_id] = perf_level_requested[domain_id];
+        perf_level_applied_ns[domain_id] = due_ns;
+        perf_level_pending[domain_id] = false;
+    }
+}
+
+static void performance_update_limits(uint32_t domain_id)
+{
+    uint64_t due_ns = performance_window_end_ns(domain_id, perf_limits_applied_ns[domain_id]);
+
+    if (perf_limits_pending[domain_id] && mocker_get_time_ns() >= due_ns) {
+        perf_level_max_limit[domain_id] = perf_limits_requested_max[domain_id];
+        perf_level_min_limit[domain_id] = perf_limits_requested_min[domain_id];
+        perf_limits_applied_ns[domain_id] = due_ns;
+        perf_limits_pending[domain_id] = false;
+    }
+}
+
+static void performance_set_level(uint32_t domain_id, unsigned int level)
+{
+    uint64_t now_ns = mocker_get_time_ns();
+    uint64_t due_ns = performance_window_end_ns(domain_id, perf_level_applied_ns[domain_id]);
+
+    if (now_ns < due_ns) {
+        perf_level_requested[domain_id] = level;
+        perf_level_pending[domain_id] = true;
+        performance_notify_level(domain_id, level, due_ns);
+        return;
+    }
+
+    perf_level_current[domain_id] = level;
+    perf_level_applied_ns[domain_id] = now_ns;
+    perf_level_pending[domain_id] = false;
+    performance_notify_level(domain_id, level, now_ns);
+}
+
+static void performance_set_limits(uint32_t domain_id, unsigned int range_max,
+                                   unsigned int range_min)
+{
+    uint64_t now_ns = mocker_get_time_ns();
+    uint64_t due_ns = performance_window_end_ns(domain_id, perf_limits_applied_ns[domain_id]);
+
+    if (now_ns < due_ns) {
+        perf_limits_requested_max[domain_id] = range_max;
+        perf_limits_requested_min[domain_id] = range_min;
+        perf_limits_pending[domain_id] = true;
+        performance_notify_limits(domain_id, range_max, range_min, due_ns);
+        return;
+    }
+
+    perf_level_max_limit[domain_id] = range_max;
+    perf_level_min_limit[domain_id] = range_min;
+    perf_limits_applied_ns[domain_id] = now_ns;
+    perf_limits_pending[domain_id] = false;
+    performance_notify_limits(domain_id, range_max, range_min, now_ns);
+}
+
+/* Returns the channel the agent writes, NULL if the domain has none for the message */
+uint32_t *mocker_performance_fast_channel(uint32_t domain_id, uint32_t message_id)
+{
+    if ((domain_id >= performance_protocol.num_performance_domains) ||
+        (message_id != PERF_LVL_SET_MSG_ID) ||
+        !performance_protocol.performance_domain_fast_channel_support[domain_id] ||
+        !performance_protocol.performance_message_fast_channel_support[message_id])
+        return NULL;
+
+    return &perf_fast_channel_level[domain_id];
+}
+
+/* Apply levels written since the last poll, a level outside the limits is dropped */
+static void performance_poll_fast_channels(void)
+{
+    uint32_t domain_id, level;
+    unsigned int range_max, range_min;
+
+    for (domain_id = 0; domain_id < performance_protocol.num_performance_domains; domain_id++)
+    {
+        level = perf_fast_channel_level[domain_id];
+        if (level == perf_fast_channel_level_seen[domain_id])
+            continue;
+        perf_fast_channel_level_seen[domain_id] = level;
+
+        /* Checked against the latest accepted limits, as PERF_LVL_SET is */
+        performance_update_limits(domain_id);
+        performance_update_level(domain_id);
+        range_max = perf_limits_pending[domain_id] ?
+                    perf_limits_requested_max[domain_id] : perf_level_max_limit[domain_id];
+        range_min = perf_limits_pending[domain_id] ?
+                    perf_limits_requested_min[domain_id] : perf_level_min_limit[domain_id];
+        if ((level <= range_max) && (level >= range_min))
+            performance_set_level(domain_id, level);
+    }
+}
+
 void performance_send_message(uint32_t message_id, uint32_t parameter_count,
         const uint32_t *parameters, int32_t *status,
         size_t *return_values_count, uint32_t *return_values)
@@ -75,6 +275,9 @@ void performance_send_message(uint32_t message_id, uint32_t parameter_count,
     uint32_t parameter_idx, return_idx;
     char * str;
     int i, domain_id, messageid;
+    unsigned int range_max, range_min;
+
+    performance_poll_fast_channels();
 
     switch(message_id)
     {
@@ -156,7 +359,7 @@ void performance_send_message(uint32_t message_id, uint32_t parameter_count,
         str = (char *)
               (&return_values[OFFSET_RET(struct arm_scmi_performance_domain_attributes, name)]);
         sprintf(str, "Domain_%d", domain_id);
-        *return_values_count = 5;
+        *return_values_count = 8;
         break;
     case PERF_DESC_LVL_MSG_ID:
         domain_id = parameters[OFFSET_PARAM(struct arm_scmi_performance_describe_levels,domain_id)];
@@ -215,10 +418,10 @@ void performance_send_message(uint32_t message_id, uint32_t parameter_count,
              return;
         }
         *status = SCMI_STATUS_SUCCESS;
-        perf_level_max_limit[domain_id] =
-             parameters[OFFSET_PARAM(struct arm_scmi_performance_limits_set,range_max)];
-        perf_level_min_limit[domain_id] =
-             parameters[OFFSET_PARAM(struct arm_scmi_performance_limits_set,range_min)] ;
+        performance_update_limits(domain_id);
+        performance_set_limits(domain_id,
+             parameters[OFFSET_PARAM(struct arm_scmi_performance_limits_set,range_max)],
+             parameters[OFFSET_PARAM(struct arm_scmi_performance_limits_set,range_min)]);
         break;
     case PERF_LIMIT_GET_MSG_ID:
         domain_id = parameters[OFFSET_PARAM(struct arm_scmi_performance_limits_get,domain_id)];
@@ -228,6 +431,7 @@ void performance_send_message(uint32_t message_id, uint32_t parameter_count,
              return;
         }
         *status = SCMI_STATUS_SUCCESS;
+        performance_update_limits(domain_id);
         return_values[OFFSET_RET(struct arm_scmi_performance_limits_get,range_max)] =
              perf_level_max_limit[domain_id];
         return_values[OFFSET_RET(struct arm_scmi_performance_limits_get,range_min)] =
@@ -255,17 +459,24 @@ void performance_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_DENIED;
              return;
         }
-        if((perf_level_max_limit[domain_id] <
+        /* Levels are checked against the latest accepted limits, applied or not */
+        performance_update_limits(domain_id);
+        performance_update_level(domain_id);
+        range_max = perf_limits_pending[domain_id] ?
+                    perf_limits_requested_max[domain_id] : perf_level_max_limit[domain_id];
+        range_min = perf_limits_pending[domain_id] ?
+                    perf_limits_requested_min[domain_id] : perf_level_min_limit[domain_id];
+        if((range_max <
             parameters[OFFSET_PARAM(struct arm_scmi_performance_levels_set,performance_level)])||
-            (perf_level_min_limit[domain_id] >
+            (range_min >
             parameters[OFFSET_PARAM(struct arm_scmi_performance_levels_set,performance_level)]))
         {
             *status = SCMI_STATUS_OUT_OF_RANGE;
              return;
         }
         *status = SCMI_STATUS_SUCCESS;
-        perf_level_current[domain_id] =
-            parameters[OFFSET_PARAM(struct arm_scmi_performance_levels_set,performance_level)];
+        performance_set_level(domain_id,
+            parameters[OFFSET_PARAM(struct arm_scmi_performance_levels_set,performance_level)]);
         break;
     case PERF_LVL_GET_MSG_ID:
         domain_id = parameters[OFFSET_PARAM(struct arm_scmi_performance_levels_get,domain_id)];
@@ -274,6 +485,7 @@ void performance_send_message(uint32_t message_id, uint32_t parameter_count,
              return;
         }
         *status = SCMI_STATUS_SUCCESS;
+        performance_update_level(domain_id);
         if(perf_level_current[domain_id] == 0)
             return_values[OFFSET_RET(struct arm_scmi_performance_levels_get,performance_level)] =
                 performance_protocol.performance_level_value[domain_id][0];
@@ -301,6 +513,10 @@ void performance_send_message(uint32_t message_id, uint32_t parameter_count,
              return;
         }
         *status = SCMI_STATUS_SUCCESS;
+        perf_limits_notify_agents[domain_id] = mocker_subscribe(
+            perf_limits_notify_agents[domain_id],
+            parameters[OFFSET_PARAM(struct arm_scmi_performance_notify_limits,notify_enable)] &
+            (1u << PERFORMANCE_NOTIFY_LIMIT_ENABLED));
         break;
     case PERF_NOTIFY_LVL_MSG_ID:
         domain_id = parameters[OFFSET_PARAM(struct arm_scmi_performance_notify_level,domain_id)];
@@ -321,6 +537,10 @@ void performance_send_message(uint32_t message_id, uint32_t parameter_count,
              return;
         }
         *status = SCMI_STATUS_SUCCESS;
+        perf_level_notify_agents[domain_id] = mocker_subscribe(
+            perf_level_notify_agents[domain_id],
+            parameters[OFFSET_PARAM(struct arm_scmi_performance_notify_level,notify_enable)] &
+            (1u << PERFORMANCE_NOTIFY_LEVEL_ENABLED));
         break;
     case PERF_DESCRIBE_FASTCHANNEL:
         parameter_idx = OFFSET_PARAM(struct arm_scmi_performance_describe_fast_channel, domain_id);
@@ -19,9 +19,47 @@
 #include <power_domain_common.h>
 #include <pal_power_domain_expected.h>
 
+/* Power state encoding, bit 30 set for states that lose context */
+#define POWER_STATE_TYPE_BIT        30
+#define POWER_STATE_ON_VALUE        0x00000000
+
+/*
+ * Mocker power domain model. Transition latencies are in us and taken from
+ * the target state type, operational states use the retention latency.
+ */
+static uint32_t power_domain_state[] = {
+    POWER_STATE_ON_VALUE,
+    POWER_STATE_ON_VALUE,
+    POWER_STATE_ON_VALUE
+};
+
+static uint32_t power_on_latency_us[] = {
+    20,
+    50,
+    100
+};
+
+static uint32_t power_off_latency_us[] = {
+    10,
+    40,
+    150
+};
+
+static uint32_t power_retention_latency_us[] = {
+    5,
+    10,
+    20
+};
+
+/* Agents subscribed to the state change of each domain, one bit per agent */
+static uint32_t power_state_notify_agents[NUM_ELEMS(power_domain_state)];
+
+/* Async requests take effect once their completion time has passed */
+static bool power_state_pending[NUM_ELEMS(power_domain_state)];
+static uint32_t power_pending_state[NUM_ELEMS(power_domain_state)];
+static uint64_t power_pending_due_ns[NUM_ELEMS(power_domain_state)];
+
 struct arm_scmi_power_protocol power_protocol;
-extern bool device_access_permitted (void);
-extern bool protocol_access_permitted (uint32_t protocol_id);
 
 void fill_power_protocol()
 {
@@ -35,21 +73,75 @@ void fill_power_protocol()
     power_protocol.power_state_change_requested_notify_cmd_supported = true;
 }
 
+static uint64_t power_transition_latency_ns(uint32_t domain_id, uint32_t state)
+{
+    if (state == POWER_STATE_ON_VALUE)
+        return power_on_latency_us[domain_id] * 1000ull;
+    if (state & (1u << POWER_STATE_TYPE_BIT))
+        return power_off_latency_us[domain_id] * 1000ull;
+    return power_retention_latency_us[domain_id] * 1000ull;
+}
+
+static void power_update_state(uint32_t domain_id)
+{
+    if (power_state_pending[domain_id] &&
+        mocker_get_time_ns() >= power_pending_due_ns[domain_id]) {
+        power_domain_state[domain_id] = power_pending_state[domain_id];
+        power_state_pending[domain_id] = false;
+    }
+}
+
+static void power_set_state(uint32_t domain_id, uint32_t state, bool async)
+{
+    uint32_t notify[3];
+    uint64_t due_ns;
+
+    /* Any earlier async request has completed by the time a new one is taken */
+    if (power_state_pending[domain_id]) {
+        power_domain_state[domain_id] = power_pending_state[domain_id];
+        power_state_pending[domain_id] = false;
+    }
+
+    if (async) {
+        due_ns = mocker_get_time_ns() + power_transition_latency_ns(domain_id, state);
+        power_pending_state[domain_id] = state;
+        power_pending_due_ns[domain_id] = due_ns;
+        power_state_pending[domain_id] = true;
+    } else {
+        mocker_delay_ns(power_transition_latency_ns(domain_id, state));
+        power_domain_state[domain_id] = state;
+        due_ns = mocker_get_time_ns();
+    }
+
+    if (power_state_notify_agents[domain_id]) {
+        /* agent id, domain id, power state */
+        notify[0] = 0;
+        notify[1] = domain_id;
+        notify[2] = state;
+        mocker_post_notification(power_state_notify_agents[domain_id],
+                MOCKER_MSG_HDR(POWER_DOMAIN_PROTOCOL_ID, MOCKER_NOTIFICATION_MSG_TYPE,
+                POWER_STATE_CHANGED_NOTIFICATION_ID), due_ns, NUM_ELEMS(notify), notify);
+    }
+}
+
+void power_drop_agent(uint32_t agent_id)
+{
+    uint32_t domain_id;
+
+    for (domain_id = 0; domain_id < NUM_ELEMS(power_state_notify_agents); domain_id++)
+        power_state_notify_agents[domain_id] &= ~(1u << agent_id);
+}
+
 void power_send_message(uint32_t message_id, uint32_t parameter_count,
         const uint32_t *parameters, int32_t *status,
         size_t *return_values_count, uint32_t *return_values)
 {
 
-    uint32_t parameter_idx, return_idx;
+    uint32_t parameter_idx, return_idx, domain_id;
     char * str;
     int num_power_domains = 3;
     int stats_low = 0x1234, stats_high = stats_low + 0xff;
 
-    if(device_access_permitted() == false ||
-       protocol_access_permitted(POWER_DOMAIN_PROTOCOL_ID) == false) {
-        *status = SCMI_STATUS_DENIED;
-        return;
-    }
     switch(message_id)
     {
         case PWR_PROTO_VER_MSG_ID:
@@ -59,7 +151,7 @@ void power_send_message(uint32_t message_id, uint32_t parameter_count,
             break;
         case PWR_PROTO_ATTR_MSG_ID:
             *status = SCMI_STATUS_SUCCESS;
-            *return_values_count = 1;
+            *return_values_count = 4;
             return_idx = OFFSET_RET(struct arm_scmi_power_protocol_attributes,
                     attributes);
             return_values[return_idx] =
@@ -135,19 +227,27 @@ void power_send_message(uint32_t message_id, uint32_t parameter_count,
                 *status = SCMI_STATUS_NOT_FOUND;
                 break;
             }
+            domain_id = parameters[OFFSET_PARAM(struct arm_scmi_power_state_set,
+                    domain_id)];
+            power_set_state(domain_id,
+                    parameters[OFFSET_PARAM(struct arm_scmi_power_state_set,
+                            power_state)],
+                    parameters[OFFSET_PARAM(struct arm_scmi_power_state_set,
+                            flags)] & (1 << POWER_STATE_SET_ASYNC_LOW));
             *status = SCMI_STATUS_SUCCESS;
             break;
         case PWR_STATE_GET_MSG_ID:
-            if (parameters[OFFSET_PARAM(
-                    struct arm_scmi_power_state_get, domain_id)] >=
-                    num_power_domains) {
+            domain_id = parameters[OFFSET_PARAM(
+                    struct arm_scmi_power_state_get, domain_id)];
+            if (domain_id >= num_power_domains) {
                 *status = SCMI_STATUS_NOT_FOUND;
                 break;
             }
+            power_update_state(domain_id);
             *status = SCMI_STATUS_SUCCESS;
             *return_values_count = 1;
             return_values[OFFSET_RET(struct arm_scmi_power_state_get,
-                    power_state)] = 0xf;
+                    power_state)] = power_domain_state[domain_id];
             break;
         case PWR_STATE_NOTIFY_MSG_ID:
             if (parameters[OFFSET_PARAM(
@@ -168,6 +268,10 @@ void power_send_message(uint32_t message_id, uint32_t parameter_count,
                 *status = SCMI_STATUS_NOT_SUPPORTED;
                 break;
             }
+            domain_id = parameters[OFFSET_PARAM(struct arm_scmi_power_state_notify, domain_id)];
+            power_state_notify_agents[domain_id] = mocker_subscribe(
+                    power_state_notify_agents[domain_id], parameters[OFFSET_PARAM(
+                            struct arm_scmi_power_state_notify, notify_enable)]);
             *status = SCMI_STATUS_SUCCESS;
             break;
         case PWR_STATE_CHANGE_REQUESTED_NOTIFY_MSG_ID:
@@ -0,0 +1,429 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include <powercap_common.h>
+#include <powercap_protocol.h>
+#include <pal_powercap_expected.h>
+
+#define POWERCAP_CAP_SET_COMPLETE_MSG_ID    POWERCAP_CAP_SET_MSG_ID
+#define POWERCAP_UNIT_MW                    (0x1 << POWERCAP_POWER_UNIT_LOW)
+
+/*
+ * Mocker power model, one entry per domain in pal_powercap_expected.h.
+ * CPU is capped asynchronously with a configurable averaging interval, GPU
+ * only synchronously, and DRAM is monitored under a fixed cap.
+ */
+static uint32_t powercap_attributes[] = {
+    (1 << POWERCAP_ASYNC_CAP_SET) | (1 << POWERCAP_CAP_CONFIG) | (1 << POWERCAP_MONITORING) |
+    (1 << POWERCAP_PAI_CONFIG) | POWERCAP_UNIT_MW,
+    (1 << POWERCAP_CAP_CONFIG) | (1 << POWERCAP_MONITORING) | POWERCAP_UNIT_MW,
+    (1 << POWERCAP_MONITORING) | POWERCAP_UNIT_MW,
+};
+
+/* Power averaging intervals in us */
+static uint32_t powercap_min_pai[] = {100, 2000, 1000};
+static uint32_t powercap_max_pai[] = {100000, 2000, 1000};
+static uint32_t powercap_pai_step[] = {100, 0, 0};
+
+/* Caps and loads in mW */
+static uint32_t powercap_min_cap[] = {1000, 500, 1500};
+static uint32_t powercap_max_cap[] = {6000, 3000, 1500};
+static uint32_t powercap_cap_step[] = {100, 50, 0};
+static uint32_t powercap_sustainable_power[] = {3500, 2000, 1500};
+static uint32_t powercap_accuracy[] = {0, 0, 0};
+static uint32_t powercap_parent_id[] = {
+    POWERCAP_NO_PARENT,
+    POWERCAP_NO_PARENT,
+    POWERCAP_NO_PARENT,
+};
+static uint32_t powercap_demand[] = {4800, 2200, 900};
+
+/* Cap apply latency in us and power slew rate in mW/us, 0 for instant */
+static uint32_t powercap_apply_latency[] = {200, 100, 0};
+static uint32_t powercap_slew_rate[] = {20, 10, 0};
+
+static uint32_t powercap_current_cap[] = {6000, 3000, 1500};
+static uint32_t powercap_current_pai[] = {1000, 2000, 1000};
+static struct powercap_power_ramp powercap_ramp[NUM_ELEMS(powercap_demand)];
+
+struct arm_scmi_powercap_protocol powercap_protocol;
+
+static uint32_t powercap_target_power(uint32_t domain_id)
+{
+    uint32_t demand = powercap_protocol.powercap_demand[domain_id];
+    uint32_t cap = powercap_protocol.powercap_current_cap[domain_id];
+
+    return (demand < cap) ? demand : cap;
+}
+
+void fill_powercap_protocol()
+{
+    uint32_t domain_id;
+
+    powercap_protocol.protocol_version = POWERCAP_VERSION;
+    powercap_protocol.number_domains = num_powercap_domains;
+    powercap_protocol.powercap_domain_name = powercap_domain_names;
+    powercap_protocol.powercap_attributes = powercap_attributes;
+    powercap_protocol.powercap_min_pai = powercap_min_pai;
+    powercap_protocol.powercap_max_pai = powercap_max_pai;
+    powercap_protocol.powercap_pai_step = powercap_pai_step;
+    powercap_protocol.powercap_min_cap = powercap_min_cap;
+    powercap_protocol.powercap_max_cap = powercap_max_cap;
+    powercap_protocol.powercap_cap_step = powercap_cap_step;
+    powercap_protocol.powercap_sustainable_power = powercap_sustainable_power;
+    powercap_protocol.powercap_accuracy = powercap_accuracy;
+    powercap_protocol.powercap_parent_id = powercap_parent_id;
+    powercap_protocol.powercap_demand = powercap_demand;
+    powercap_protocol.powercap_apply_latency = powercap_apply_latency;
+    powercap_protocol.powercap_slew_rate = powercap_slew_rate;
+    powercap_protocol.powercap_current_cap = powercap_current_cap;
+    powercap_protocol.powercap_current_pai = powercap_current_pai;
+    powercap_protocol.powercap_ramp = powercap_ramp;
+
+    /* Every domain starts settled at its capped load */
+    for (domain_id = 0; domain_id < powercap_protocol.number_domains; domain_id++)
+    {
+        powercap_ramp[domain_id].start_ns = 0;
+        powercap_ramp[domain_id].end_ns = 0;
+        powercap_ramp[domain_id].start_mw = powercap_target_power(domain_id);
+        powercap_ramp[domain_id].end_mw = powercap_ramp[domain_id].start_mw;
+    }
+}
+
+/* Instantaneous power of the model */
+static uint32_t powercap_power_at(uint32_t domain_id, uint64_t time_ns)
+{
+    struct powercap_power_ramp *ramp = &powercap_protocol.powercap_ramp[domain_id];
+    int64_t delta_mw = (int64_t)ramp->end_mw - ramp->start_mw;
+
+    if (time_ns <= ramp->start_ns)
+        return ramp->start_mw;
+    if (time_ns >= ramp->end_ns)
+        return ramp->end_mw;
+
+    return (uint32_t)(ramp->start_mw + (delta_mw * (int64_t)(time_ns - ramp->start_ns)) /
+                      (int64_t)(ramp->end_ns - ramp->start_ns));
+}
+
+/* Energy in mW.ns between two times, summed over the flat and slewing parts */
+static uint64_t powercap_energy(uint32_t domain_id, uint64_t from_ns, uint64_t to_ns)
+{
+    struct powercap_power_ramp *ramp = &powercap_protocol.powercap_ramp[domain_id];
+    uint64_t energy = 0, low, high;
+
+    if (from_ns < ramp->start_ns) {
+        high = (to_ns < ramp->start_ns) ? to_ns : ramp->start_ns;
+        energy += (uint64_t)ramp->start_mw * (high - from_ns);
+    }
+
+    low = (from_ns > ramp->start_ns) ? from_ns : ramp->start_ns;
+    high = (to_ns < ramp->end_ns) ? to_ns : ramp->end_ns;
+    if (low < high)
+        energy += (((uint64_t)powercap_power_at(domain_id, low) +
+                    powercap_power_at(domain_id, high)) * (high - low)) / 2;
+
+    low = (from_ns > ramp->end_ns) ? from_ns : ramp->end_ns;
+    if (low < to_ns)
+        energy += (uint64_t)ramp->end_mw * (to_ns - low);
+
+    return energy;
+}
+
+/*
+ * Measured power is the average over the last averaging interval, so it
+ * trails the instantaneous power by up to one interval after a cap change.
+ */
+static uint32_t powercap_measured_power(uint32_t domain_id)
+{
+    uint64_t now = mocker_get_time_ns();
+    uint64_t pai_ns = powercap_protocol.powercap_current_pai[domain_id] * 1000ull;
+
+    if ((pai_ns == 0) || (now < pai_ns))
+        return powercap_power_at(domain_id, now);
+
+    return (uint32_t)(powercap_energy(domain_id, now - pai_ns, now) / pai_ns);
+}
+
+/*
+ * Start slewing towards the capped load once the cap reaches the controller.
+ * Power before a change is taken as flat at its value when the change is made.
+ */
+static void powercap_apply_cap(uint32_t domain_id, uint64_t apply_ns)
+{
+    struct powercap_power_ramp *ramp = &powercap_protocol.powercap_ramp[domain_id];
+    uint32_t slew_rate = powercap_protocol.powercap_slew_rate[domain_id];
+    uint32_t power = powercap_power_at(domain_id, mocker_get_time_ns());
+    uint32_t target = powercap_target_power(domain_id);
+    uint64_t delta_mw = (target > power) ? (target - power) : (power - target);
+
+    ramp->start_ns = apply_ns;
+    ramp->start_mw = power;
+    ramp->end_mw = target;
+    ramp->end_ns = apply_ns + (slew_rate ? (delta_mw * 1000) / slew_rate : 0);
+}
+
+static bool powercap_value_is_valid(uint32_t value, uint32_t min, uint32_t max, uint32_t step)
+{
+    if (value < min || value > max)
+        return false;
+
+    return (min == max) || (step && ((value - min) % step) == 0);
+}
+
+static bool powercap_attribute(uint32_t domain_id, uint32_t bit)
+{
+    return (powercap_protocol.powercap_attributes[domain_id] >> bit) & 0x1;
+}
+
+/* Apply a cap, holding a sync request or completing an async one with a delayed response */
+static void powercap_cap_set(uint32_t domain_id, uint32_t flags, uint32_t cap)
+{
+    uint64_t latency_ns = powercap_protocol.powercap_apply_latency[domain_id] * 1000ull;
+    uint32_t payload[2];
+    uint64_t due_ns;
+
+    powercap_protocol.powercap_current_cap[domain_id] = cap;
+
+    if (!((flags >> POWERCAP_CAP_SET_ASYNC) & 0x1)) {
+        mocker_delay_ns(latency_ns);
+        powercap_apply_cap(domain_id, mocker_get_time_ns());
+        return;
+    }
+
+    due_ns = mocker_get_time_ns() + latency_ns;
+    powercap_apply_cap(domain_id, due_ns);
+
+    if ((flags >> POWERCAP_CAP_SET_IGNORE_DRESP) & 0x1)
+        return;
+
+    payload[OFFSET_RET(struct arm_scmi_powercap_cap_set_complete, domain_id)] = domain_id;
+    payload[OFFSET_RET(struct arm_scmi_powercap_cap_set_complete, power_cap)] = cap;
+    mocker_post_delayed_response(MOCKER_MSG_HDR(POWERCAP_PROTO_ID,
+            MOCKER_DELAYED_RESPONSE_MSG_TYPE, POWERCAP_CAP_SET_COMPLETE_MSG_ID),
+            due_ns, SCMI_STATUS_SUCCESS, 2, payload);
+}
+
+void powercap_send_message(uint32_t message_id, uint32_t parameter_count,
+        const uint32_t *parameters, int32_t *status,
+        size_t *return_values_count, uint32_t *return_values)
+{
+    uint32_t parameter_idx, domain_id, return_idx, flags, value;
+    char *str;
+
+      switch(message_id)
+      {
+      case POWERCAP_PROTO_VER_MSG_ID:
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = 1;
+          return_values[0] = powercap_protocol.protocol_version;
+          break;
+      case POWERCAP_PROTO_ATTR_MSG_ID:
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = 1;
+          return_values[OFFSET_RET(
+                  struct arm_scmi_powercap_protocol_attributes,
+                  attributes)] =
+                          (powercap_protocol.number_domains <<
+                                  POWERCAP_NUMBER_DOMAIN_LOW);
+          break;
+      case POWERCAP_PROTO_MSG_ATTR_MSG_ID:
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_powercap_protocol_message_attributes, message_id);
+          /* No extended names, notifications or fast channels */
+          if (parameters[parameter_idx] > POWERCAP_MEASUREMENTS_GET_MSG_ID ||
+              parameters[parameter_idx] == POWERCAP_DOMAIN_NAME_GET_MSG_ID)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+          }
+          else
+          {
+              *status = SCMI_STATUS_SUCCESS;
+              *return_values_count = 1;
+              return_values[OFFSET_RET(
+                      struct arm_scmi_powercap_protocol_message_attributes,
+                      attributes)] = 0x0;
+          }
+          break;
+      case POWERCAP_DOMAIN_ATTRIB_MSG_ID:
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_powercap_domain_attributes, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= powercap_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          return_values[OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  attributes)] = powercap_protocol.powercap_attributes[domain_id];
+
+          return_idx = OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  domain_name);
+          str = (char *)&return_values[return_idx];
+          snprintf(str, SCMI_NAME_STR_SIZE, "%s",
+                   powercap_protocol.powercap_domain_name[domain_id]);
+
+          return_values[OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  min_pai)] = powercap_protocol.powercap_min_pai[domain_id];
+          return_values[OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  max_pai)] = powercap_protocol.powercap_max_pai[domain_id];
+          return_values[OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  pai_step)] = powercap_protocol.powercap_pai_step[domain_id];
+          return_values[OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  min_power_cap)] = powercap_protocol.powercap_min_cap[domain_id];
+          return_values[OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  max_power_cap)] = powercap_protocol.powercap_max_cap[domain_id];
+          return_values[OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  power_cap_step)] = powercap_protocol.powercap_cap_step[domain_id];
+          return_values[OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  sustainable_power)] =
+                          powercap_protocol.powercap_sustainable_power[domain_id];
+          return_values[OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  accuracy)] = powercap_protocol.powercap_accuracy[domain_id];
+          return_idx = OFFSET_RET(struct arm_scmi_powercap_domain_attributes,
+                  parent_id);
+          return_values[return_idx] = powercap_protocol.powercap_parent_id[domain_id];
+
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = return_idx + 1;
+          break;
+      case POWERCAP_CAP_GET_MSG_ID:
+          parameter_idx = OFFSET_PARAM(struct arm_scmi_powercap_cap_get, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= powercap_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = 1;
+          return_values[OFFSET_RET(struct arm_scmi_powercap_cap_get, power_cap)] =
+                  powercap_protocol.powercap_current_cap[domain_id];
+          break;
+      case POWERCAP_CAP_SET_MSG_ID:
+          parameter_idx = OFFSET_PARAM(struct arm_scmi_powercap_cap_set, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= powercap_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          parameter_idx = OFFSET_PARAM(struct arm_scmi_powercap_cap_set, flags);
+          flags = parameters[parameter_idx];
+          if (flags >> POWERCAP_CAP_SET_RESERVED_LOW)
+          {
+              *status = SCMI_STATUS_INVALID_PARAMETERS;
+              break;
+          }
+
+          if (!powercap_attribute(domain_id, POWERCAP_CAP_CONFIG) ||
+              (((flags >> POWERCAP_CAP_SET_ASYNC) & 0x1) &&
+               !powercap_attribute(domain_id, POWERCAP_ASYNC_CAP_SET)))
+          {
+              *status = SCMI_STATUS_NOT_SUPPORTED;
+              break;
+          }
+
+          parameter_idx = OFFSET_PARAM(struct arm_scmi_powercap_cap_set, power_cap);
+          value = parameters[parameter_idx];
+          if (!powercap_value_is_valid(value, powercap_protocol.powercap_min_cap[domain_id],
+                                       powercap_protocol.powercap_max_cap[domain_id],
+                                       powercap_protocol.powercap_cap_step[domain_id]))
+          {
+              *status = SCMI_STATUS_INVALID_PARAMETERS;
+              break;
+          }
+
+          powercap_cap_set(domain_id, flags, value);
+          *status = SCMI_STATUS_SUCCESS;
+          break;
+      case POWERCAP_PAI_GET_MSG_ID:
+          parameter_idx = OFFSET_PARAM(struct arm_scmi_powercap_pai_get, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= powercap_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = 1;
+          return_values[OFFSET_RET(struct arm_scmi_powercap_pai_get, pai)] =
+                  powercap_protocol.powercap_current_pai[domain_id];
+          break;
+      case POWERCAP_PAI_SET_MSG_ID:
+          parameter_idx = OFFSET_PARAM(struct arm_scmi_powercap_pai_set, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= powercap_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          if (!powercap_attribute(domain_id, POWERCAP_PAI_CONFIG))
+          {
+              *status = SCMI_STATUS_NOT_SUPPORTED;
+              break;
+          }
+
+          /* Powercap v1.0 defines no PAI set flags */
+          parameter_idx = OFFSET_PARAM(struct arm_scmi_powercap_pai_set, flags);
+          flags = parameters[parameter_idx];
+          parameter_idx = OFFSET_PARAM(struct arm_scmi_powercap_pai_set, pai);
+          value = parameters[parameter_idx];
+          if ((flags != 0) ||
+              !powercap_value_is_valid(value, powercap_protocol.powercap_min_pai[domain_id],
+                                       powercap_protocol.powercap_max_pai[domain_id],
+                                       powercap_protocol.powercap_pai_step[domain_id]))
+          {
+              *status = SCMI_STATUS_INVALID_PARAMETERS;
+              break;
+          }
+
+          powercap_protocol.powercap_current_pai[domain_id] = value;
+          *status = SCMI_STATUS_SUCCESS;
+          break;
+      case POWERCAP_MEASUREMENTS_GET_MSG_ID:
+          parameter_idx = OFFSET_PARAM(struct arm_scmi_powercap_measurements_get,
+                  domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= powercap_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          if (!powercap_attribute(domain_id, POWERCAP_MONITORING))
+          {
+              *status = SCMI_STATUS_NOT_SUPPORTED;
+              break;
+          }
+
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = 2;
+          return_values[OFFSET_RET(struct arm_scmi_powercap_measurements_get, power)] =
+                  powercap_measured_power(domain_id);
+          return_values[OFFSET_RET(struct arm_scmi_powercap_measurements_get, pai)] =
+                  powercap_protocol.powercap_current_pai[domain_id];
+          break;
+      default:
+          *status = SCMI_STATUS_NOT_FOUND;
+          break;
+      }
+}
@@ -19,8 +19,73 @@
 #include <reset_common.h>
 #include <pal_reset_expected.h>
 
+#define RESET_COMPLETE_MSG_ID           RESET_PROTO_RESET_MSG_ID
+#define RESET_ISSUED_NOTIFICATION_ID    0x0
+
 struct arm_scmi_reset_protocol reset_protocol;
 
+/* Agents subscribed to the resets of each domain, one bit per agent */
+static uint32_t reset_notify_agents[NUM_ELEMS(reset_latency)];
+
+/* The advertised latencies are worst cases, the model runs this much faster */
+#define RESET_MODEL_SPEEDUP             100
+
+/*
+ * Time the mocker takes to act on a reset request. Autonomous resets use
+ * most of the modelled latency, explicit assert and deassert share it.
+ */
+static uint64_t reset_model_time_ns(uint32_t domain_id, uint32_t reset_flag)
+{
+    uint64_t latency_ns = (reset_protocol.reset_latency[domain_id] * 1000ull) /
+                          RESET_MODEL_SPEEDUP;
+
+    if ((reset_flag >> RESET_FLAG_AUTONOMOUS_RESET_BIT) & 0x1)
+        return (latency_ns * 3) / 4;
+    if ((reset_flag >> RESET_FLAG_EXPLICIT_SIGNAL_BIT) & 0x1)
+        return latency_ns / 4;
+    return latency_ns / 2;
+}
+
+static void reset_issue(uint32_t domain_id, uint32_t reset_flag, uint32_t reset_state)
+{
+    uint32_t payload[3];
+    uint64_t due_ns;
+
+    /* Async only applies to autonomous resets, explicit ones always complete in line */
+    if (((reset_flag >> RESET_FLAG_ASYNC_RESET_BIT) & 0x1) &&
+        ((reset_flag >> RESET_FLAG_AUTONOMOUS_RESET_BIT) & 0x1)) {
+        due_ns = mocker_get_time_ns() + reset_model_time_ns(domain_id, reset_flag);
+        payload[0] = domain_id;
+        mocker_post_delayed_response(MOCKER_MSG_HDR(RESET_PROTO_ID,
+                MOCKER_DELAYED_RESPONSE_MSG_TYPE, RESET_COMPLETE_MSG_ID),
+                due_ns, SCMI_STATUS_SUCCESS, 1, payload);
+    } else {
+        mocker_delay_ns(reset_model_time_ns(domain_id, reset_flag));
+        due_ns = mocker_get_time_ns();
+    }
+
+    /* A deassert only releases a reset that has already been issued */
+    if (reset_notify_agents[domain_id] &&
+        (reset_flag & ((1 << RESET_FLAG_AUTONOMOUS_RESET_BIT) |
+                       (1 << RESET_FLAG_EXPLICIT_SIGNAL_BIT)))) {
+        /* agent id, domain id, reset state */
+        payload[0] = 0;
+        payload[1] = domain_id;
+        payload[2] = reset_state;
+        mocker_post_notification(reset_notify_agents[domain_id], MOCKER_MSG_HDR(RESET_PROTO_ID,
+                MOCKER_NOTIFICATION_MSG_TYPE, RESET_ISSUED_NOTIFICATION_ID),
+                due_ns, 3, payload);
+    }
+}
+
+void reset_drop_agent(uint32_t agent_id)
+{
+    uint32_t domain_id;
+
+    for (domain_id = 0; domain_id < NUM_ELEMS(reset_notify_agents); domain_id++)
+        reset_notify_agents[domain_id] &= ~(1u << agent_id);
+}
+
 void fill_reset_protocol()
 {
     reset_protocol.protocol_version = RESET_VERSION;
@@ -139,6 +204,7 @@ void reset_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_INVALID_PARAMETERS;
             break;
         }
+        reset_issue(domain_id, reset_flag, reset_state);
         *status = SCMI_STATUS_SUCCESS;
         break;
     case RESET_PROTO_NOTIFY_MSG_ID:
@@ -160,6 +226,13 @@ void reset_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_INVALID_PARAMETERS;
             break;
         }
+        if (reset_protocol.reset_notify_supported[domain_id] == 0)
+        {
+            *status = SCMI_STATUS_NOT_SUPPORTED;
+            break;
+        }
+        reset_notify_agents[domain_id] =
+                mocker_subscribe(reset_notify_agents[domain_id], notify_en);
         *status = SCMI_STATUS_SUCCESS;
         break;
     default:
@@ -22,9 +22,227 @@
 struct arm_scmi_sensor_protocol sensor_protocol;
 #define SENSOR_DESC_LEN 13
 #define SENSOR_AXIS_DESC_LEN  12
+#define SENSOR_READING_LEN    4
+#define SENSOR_WAVE_PERIOD    8
+
+/*
+ * Timestamps come from a platform clock that runs 1 s ahead of the agent
+ * and gains 50 ppm, reported in ns (exponent -9, 5 bit two's complement).
+ */
+#define SENSOR_CLOCK_OFFSET_NS      1000000000ull
+#define SENSOR_CLOCK_DRIFT_DIV      20000
+#define SENSOR_TIMESTAMP_EXPONENT   0x17
+
+/*
+ * Waveform generator. A sensor with a waveform is sampled by the platform
+ * every SENSOR_WAVE_SAMPLE_NS, and armed trip points fire on the samples
+ * that cross them. Sensors without a waveform return the capture sawtooth.
+ */
+#define SENSOR_WAVE_NONE            0
+#define SENSOR_WAVE_SQUARE          1
+#define SENSOR_WAVE_TRIANGLE        2
+#define SENSOR_WAVE_SAWTOOTH        3
+#define SENSOR_WAVE_SAMPLE_NS       10000
+/* Samples evaluated per call at most; older ones were never taken */
+#define SENSOR_WAVE_MAX_CATCHUP     64
+#define SENSOR_MAX_TRIP_POINTS      16
+
+#define SENSOR_TRIP_EV_CTRL_UP      0x1
+#define SENSOR_TRIP_EV_CTRL_DOWN    0x2
+#define SENSOR_TRIP_DESC_DIR_UP     (1u << 16)
+/* Trip point events for the same sensor and trip point are merged while pending */
+#define SENSOR_TRIP_DESC_ID_MASK    0xFF
+
+static uint8_t sensor_waveform_shape[] = { SENSOR_WAVE_NONE, SENSOR_WAVE_TRIANGLE };
+static int32_t sensor_waveform_min[] = { 0, -1000 };
+static int32_t sensor_waveform_max[] = { 0, 1000 };
+static uint32_t sensor_waveform_period_us[] = { 0, 200 };
+
+static uint32_t sensor_sample_count[MAX_NUMBER_SENSOR];
+/* Agents subscribed to the notifications of each sensor, one bit per agent */
+static uint32_t sensor_update_notify_agents[MAX_NUMBER_SENSOR];
+static uint32_t sensor_disabled[MAX_NUMBER_SENSOR];    /* set by SENSOR_CONFIG_SET */
+static uint32_t sensor_trip_notify_agents[MAX_NUMBER_SENSOR];
+static uint32_t sensor_trip_ev_ctrl[MAX_NUMBER_SENSOR][SENSOR_MAX_TRIP_POINTS];
+static int64_t sensor_trip_value[MAX_NUMBER_SENSOR][SENSOR_MAX_TRIP_POINTS];
+static uint64_t sensor_wave_start_ns;
+static uint64_t sensor_wave_sample_ns[MAX_NUMBER_SENSOR];
+static int64_t sensor_wave_value[MAX_NUMBER_SENSOR];
+
+static uint64_t sensor_platform_time_ns(void)
+{
+    uint64_t now = mocker_get_time_ns();
+
+    return now + (now / SENSOR_CLOCK_DRIFT_DIV) + SENSOR_CLOCK_OFFSET_NS;
+}
+
+static bool sensor_has_waveform(uint32_t sensor_id)
+{
+    return (sensor_id < sizeof(sensor_waveform_shape)) &&
+           (sensor_waveform_shape[sensor_id] != SENSOR_WAVE_NONE);
+}
+
+/* Value of the sensor waveform at a platform time */
+static int64_t sensor_waveform_at(uint32_t sensor_id, uint64_t time_ns)
+{
+    uint64_t period = (uint64_t)sensor_waveform_period_us[sensor_id] * 1000;
+    int64_t min = sensor_waveform_min[sensor_id];
+    int64_t swing = (int64_t)sensor_waveform_max[sensor_id] - min;
+    uint64_t phase = (time_ns - sensor_wave_start_ns) % period;
+
+    switch (sensor_waveform_shape[sensor_id])
+    {
+    case SENSOR_WAVE_SQUARE:
+        return (phase < (period / 2)) ? min : min + swing;
+    case SENSOR_WAVE_TRIANGLE:
+        if (phase < (period / 2))
+            return min + (swing * (int64_t)phase) / (int64_t)(period / 2);
+        return min + swing - (swing * (int64_t)(phase - (period / 2))) / (int64_t)(period / 2);
+    case SENSOR_WAVE_SAWTOOTH:
+        return min + (swing * (int64_t)phase) / (int64_t)period;
+    default:
+        return 0;
+    }
+}
+
+/* Report every armed trip point the last sample crossed */
+static void sensor_check_trip_points(uint32_t sensor_id, int64_t previous, int64_t value,
+        uint64_t time_ns)
+{
+    static const uint32_t match_mask[] = { 0xFFFFFFFF, 0xFFFFFFFF, SENSOR_TRIP_DESC_ID_MASK };
+    uint32_t event[3];
+    uint32_t trip_point, num_trip_points, direction;
+
+    num_trip_points = sensor_protocol.number_of_trip_points_supported[sensor_id];
+    if (num_trip_points > SENSOR_MAX_TRIP_POINTS)
+        num_trip_points = SENSOR_MAX_TRIP_POINTS;
+
+    for (trip_point = 0; trip_point < num_trip_points; trip_point++)
+    {
+        if ((previous < sensor_trip_value[sensor_id][trip_point]) &&
+            (value >= sensor_trip_value[sensor_id][trip_point]))
+            direction = SENSOR_TRIP_EV_CTRL_UP;
+        else if ((previous >= sensor_trip_value[sensor_id][trip_point]) &&
+                 (value < sensor_trip_value[sensor_id][trip_point]))
+            direction = SENSOR_TRIP_EV_CTRL_DOWN;
+        else
+            continue;
+
+        if (!(sensor_trip_ev_ctrl[sensor_id][trip_point] & direction))
+            continue;
+
+        event[0] = 0;
+        event[1] = sensor_id;
+        event[2] = trip_point |
+                   ((direction == SENSOR_TRIP_EV_CTRL_UP) ? SENSOR_TRIP_DESC_DIR_UP : 0);
+        mocker_coalesce_notification(sensor_trip_notify_agents[sensor_id],
+                MOCKER_MSG_HDR(SNSR_PROTO_ID, MOCKER_NOTIFICATION_MSG_TYPE,
+                SNSR_TRIP_POINT_EVENT_ID), time_ns, 3, event, match_mask);
+    }
+}
+
+/*
+ * Run the platform sampling up to now, firing trip points on the way. Called
+ * whenever the agent talks to the platform, as the mocker has no thread.
+ */
+void sensor_advance_waveforms(void)
+{
+    uint64_t now = mocker_get_time_ns();
+    uint32_t sensor_id;
+    int64_t previous;
+
+    for (sensor_id = 0; sensor_id < sensor_protocol.number_sensors; sensor_id++)
+    {
+        if (!sensor_has_waveform(sensor_id))
+            continue;
+
+        if ((now - sensor_wave_sample_ns[sensor_id]) >
+            (SENSOR_WAVE_MAX_CATCHUP * SENSOR_WAVE_SAMPLE_NS)) {
+            sensor_wave_sample_ns[sensor_id] = now -
+                    (SENSOR_WAVE_MAX_CATCHUP * SENSOR_WAVE_SAMPLE_NS);
+            sensor_wave_value[sensor_id] = sensor_waveform_at(sensor_id,
+                    sensor_wave_sample_ns[sensor_id]);
+        }
+
+        while ((now - sensor_wave_sample_ns[sensor_id]) >= SENSOR_WAVE_SAMPLE_NS)
+        {
+            sensor_wave_sample_ns[sensor_id] += SENSOR_WAVE_SAMPLE_NS;
+            previous = sensor_wave_value[sensor_id];
+            sensor_wave_value[sensor_id] = sensor_waveform_at(sensor_id,
+                    sensor_wave_sample_ns[sensor_id]);
+            if (sensor_trip_notify_agents[sensor_id])
+                sensor_check_trip_points(sensor_id, previous, sensor_wave_value[sensor_id],
+                        sensor_wave_sample_ns[sensor_id]);
+        }
+    }
+}
+
+/*
+ * Fill one reading structure per axis: a sawtooth around zero whose swing
+ * grows with the axis index, so every axis has its own known min and max.
+ * Returns the number of words written.
+ */
+static uint32_t sensor_fill_readings(uint32_t sensor_id, uint32_t *readings)
+{
+    uint32_t axis, num_axes;
+    int64_t value;
+    uint64_t timestamp;
+
+    num_axes = sensor_protocol.axis_supported[sensor_id] ?
+            number_of_axis_supported[sensor_id] : 1;
+    timestamp = sensor_protocol.timestamp_support[sensor_id] ? sensor_platform_time_ns() : 0;
+
+    for (axis = 0; axis < num_axes; axis++)
+    {
+        if (sensor_has_waveform(sensor_id))
+            value = sensor_wave_value[sensor_id] * (axis + 1);
+        else
+            value = ((int64_t)(sensor_sample_count[sensor_id] % SENSOR_WAVE_PERIOD) -
+                     (SENSOR_WAVE_PERIOD / 2)) * 100 * (axis + 1);
+        readings[(axis * SENSOR_READING_LEN) + 0] = (uint32_t)value;
+        readings[(axis * SENSOR_READING_LEN) + 1] = (uint32_t)((uint64_t)value >> 32);
+        readings[(axis * SENSOR_READING_LEN) + 2] = (uint32_t)timestamp;
+        readings[(axis * SENSOR_READING_LEN) + 3] = (uint32_t)(timestamp >> 32);
+    }
+    sensor_sample_count[sensor_id]++;
+
+    return num_axes * SENSOR_READING_LEN;
+}
+
+/* A new sample is reported to agents that asked for continuous updates */
+static void sensor_post_update(uint32_t sensor_id, const uint32_t *readings,
+        uint32_t num_words)
+{
+    uint32_t notify[MOCKER_MAX_NOTIFICATION_PAYLOAD];
+    uint32_t i;
+
+    if (!sensor_update_notify_agents[sensor_id])
+        return;
+
+    notify[0] = 0;
+    notify[1] = sensor_id;
+    for (i = 0; (i < num_words) && (i + 2 < MOCKER_MAX_NOTIFICATION_PAYLOAD); i++)
+        notify[i + 2] = readings[i];
+    mocker_post_notification(sensor_update_notify_agents[sensor_id],
+            MOCKER_MSG_HDR(SNSR_PROTO_ID, MOCKER_NOTIFICATION_MSG_TYPE,
+            SNSR_UPDATE_NOTIFICATION_ID), mocker_get_time_ns(), i + 2, notify);
+}
+
+void sensor_drop_agent(uint32_t agent_id)
+{
+    uint32_t sensor_id;
+
+    for (sensor_id = 0; sensor_id < MAX_NUMBER_SENSOR; sensor_id++)
+    {
+        sensor_update_notify_agents[sensor_id] &= ~(1u << agent_id);
+        sensor_trip_notify_agents[sensor_id] &= ~(1u << agent_id);
+    }
+}
 
 void fill_sensor_protocol()
 {
+    uint32_t i;
+
     sensor_protocol.protocol_version = SENSOR_VERSION;
     sensor_protocol.number_sensors = num_sensors;
     sensor_protocol.sensor_trip_point_notify_supported = true;
@@ -43,6 +261,14 @@ void fill_sensor_protocol()
     sensor_protocol.number_of_trip_points_supported =
             number_of_trip_points_supported;
     sensor_protocol.axis_supported = sensor_axis_supported;
+
+    sensor_wave_start_ns = mocker_get_time_ns();
+    for (i = 0; i < sensor_protocol.number_sensors; i++)
+    {
+        sensor_wave_sample_ns[i] = sensor_wave_start_ns;
+        if (sensor_has_waveform(i))
+            sensor_wave_value[i] = sensor_waveform_at(i, sensor_wave_start_ns);
+    }
 }
 
 void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
@@ -50,10 +276,12 @@ void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
         size_t *return_values_count, uint32_t *return_values)
 {
 
-    uint32_t parameter_idx, return_idx, sensor_id, sensor_cfg;
+    uint32_t parameter_idx, return_idx, sensor_id, sensor_cfg, trip_point_id;
     char * str;
     int i;
 
+    sensor_advance_waveforms();
+
     switch(message_id)
     {
     case SNSR_PROTO_VER_MSG_ID:
@@ -121,6 +349,9 @@ void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
                                     SNR_DESC_ATTRLOW_CNT_SNR_UPDATE_NOT) |
                             (sensor_protocol.timestamp_support[i] <<
                                     SNR_DESC_ATTRLOW_TIMESTAMP_SUPPORT) |
+                            ((sensor_protocol.timestamp_support[i] ?
+                                    SENSOR_TIMESTAMP_EXPONENT : 0) <<
+                                    SNR_DESC_ATTRLOW_TIMESTAMP_EXP_LOW) |
                             (sensor_protocol.extended_attributes_support[i] <<
                                     SNR_DESC_ATTRLOW_EXT_ATTR_SUPPORT) |
                             (sensor_protocol.number_of_trip_points_supported[i] <<
@@ -179,6 +410,10 @@ void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_INVALID_PARAMETERS;
             break;
         }
+        sensor_id = parameters[OFFSET_PARAM(struct arm_scmi_sensor_trip_point_notify, sensor_id)];
+        sensor_trip_notify_agents[sensor_id] = mocker_subscribe(
+                sensor_trip_notify_agents[sensor_id], parameters[OFFSET_PARAM(
+                        struct arm_scmi_sensor_trip_point_notify, sensor_event_control)]);
         *status = SCMI_STATUS_SUCCESS;
         break;
     case SNSR_TRIP_POINT_CONFIG_ID:
@@ -191,7 +426,7 @@ void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
         }
         if (((parameters[OFFSET_PARAM(
                 struct arm_scmi_sensor_trip_point_config, trip_point_ev_ctrl)] >>
-                SNR_TRIP_POINT_ID_LOW) & 0xFF) >
+                SNR_TRIP_POINT_ID_LOW) & 0xFF) >=
         sensor_protocol.number_of_trip_points_supported[
                                                         parameters[OFFSET_PARAM(
                                                                 struct arm_scmi_sensor_trip_point_config, sensor_id)]])
@@ -206,6 +441,18 @@ void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_INVALID_PARAMETERS;
             break;
         }
+        sensor_id = parameters[OFFSET_PARAM(struct arm_scmi_sensor_trip_point_config, sensor_id)];
+        sensor_cfg = parameters[OFFSET_PARAM(
+                struct arm_scmi_sensor_trip_point_config, trip_point_ev_ctrl)];
+        trip_point_id = (sensor_cfg >> SNR_TRIP_POINT_ID_LOW) & 0xFF;
+        if (trip_point_id < SENSOR_MAX_TRIP_POINTS) {
+            sensor_trip_ev_ctrl[sensor_id][trip_point_id] = sensor_cfg & 0x3;
+            sensor_trip_value[sensor_id][trip_point_id] = (int64_t)
+                    (((uint64_t)parameters[OFFSET_PARAM(
+                            struct arm_scmi_sensor_trip_point_config, trip_point_val_high)] << 32) |
+                     parameters[OFFSET_PARAM(
+                            struct arm_scmi_sensor_trip_point_config, trip_point_val_low)]);
+        }
         *status = SCMI_STATUS_SUCCESS;
         break;
     case SNSR_READING_GET_MSG_ID:
@@ -231,8 +478,10 @@ void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_NOT_SUPPORTED;
             break;
         }
+        sensor_id = parameters[OFFSET_PARAM(struct arm_scmi_sensor_reading_get, sensor_id)];
         *status = SCMI_STATUS_SUCCESS;
-        *return_values_count = 2;
+        *return_values_count = sensor_fill_readings(sensor_id, return_values);
+        sensor_post_update(sensor_id, return_values, *return_values_count);
         break;
     case SNSR_AXIS_DESC_GET_MSG_ID:
         sensor_id = parameters[OFFSET_PARAM(struct arm_scmi_sensor_axis_description_get, sensor_id)];
@@ -330,7 +579,8 @@ void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
                                             (1 << SNR_CFG_UPDATE_INT_EXP_LOW) |
                                             (RESERVED << SNR_CFG_SET_RESV_LOW) |
                                             (1 << SNR_CFG_SET_TIMESTAMP_REPORTING) |
-                                            (1 << SNR_CFG_SET_SENSOR_STATE);
+                                            (!sensor_disabled[sensor_id] <<
+                                             SNR_CFG_SET_SENSOR_STATE);
         *status = SCMI_STATUS_SUCCESS;
         *return_values_count = 1;
         break;
@@ -341,6 +591,7 @@ void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
             break;
         }
         sensor_cfg = parameters[OFFSET_PARAM(struct arm_scmi_config_set, sensor_config)];
+        sensor_disabled[sensor_id] = !((sensor_cfg >> SNR_CFG_SET_SENSOR_STATE) & 0x1);
 
         *status = SCMI_STATUS_SUCCESS;
         break;
@@ -362,6 +613,8 @@ void sensor_send_message(uint32_t message_id, uint32_t parameter_count,
           *status = SCMI_STATUS_INVALID_PARAMETERS;
           break;
         }
+        sensor_update_notify_agents[sensor_id] =
+                mocker_subscribe(sensor_update_notify_agents[sensor_id], sensor_cfg & 0x1);
         *status = SCMI_STATUS_SUCCESS;
         break;
     default:
@@ -17,16 +17,73 @@
 
 #include <system_power_protocol.h>
 #include <system_power_common.h>
+#include <pal_platform.h>
 
 struct arm_scmi_system_power_protocol system_power_protocol;
 
+void fill_system_power_protocol(void)
+{
+    system_power_protocol.protocol_version = SYSTEM_POWER_VERSION;
+    system_power_protocol.system_power_state_notify_cmd_supported = true;
+    system_power_protocol.warm_reset_support = true;
+    system_power_protocol.system_suspend_support = true;
+    system_power_protocol.suspend_ns = SYSTEM_POWER_SUSPEND_US * 1000ull;
+    system_power_protocol.resume_ns = SYSTEM_POWER_RESUME_US * 1000ull;
+    system_power_protocol.resume_done_ns = 0;
+    system_power_protocol.state_notify_agents = 0;
+}
+
+/* A zero duration keeps the build time default */
+void mocker_set_system_suspend_durations(uint32_t suspend_us, uint32_t resume_us)
+{
+    if (suspend_us)
+        system_power_protocol.suspend_ns = suspend_us * 1000ull;
+    if (resume_us)
+        system_power_protocol.resume_ns = resume_us * 1000ull;
+}
+
+/*
+ * The system is suspended suspend_ns after the request and back up resume_ns
+ * later. Every subscribed agent is told, naming the agent that asked.
+ */
+static void system_power_suspend(uint32_t flags)
+{
+    uint32_t agents = system_power_protocol.state_notify_agents;
+    uint32_t notification[3];
+    uint32_t header = MOCKER_MSG_HDR(SYSTEM_POWER_PROTO_ID, MOCKER_NOTIFICATION_MSG_TYPE,
+                                     SYSTEM_POWER_STATE_NOTIFIER_MSG_ID);
+    uint64_t suspended_ns = mocker_get_time_ns() + system_power_protocol.suspend_ns;
+
+    system_power_protocol.resume_done_ns = suspended_ns + system_power_protocol.resume_ns;
+
+    if (agents == 0)
+        return;
+
+    notification[OFFSET_RET(struct arm_scmi_system_power_state_notifier, agent_id)] =
+        mocker_get_calling_agent();
+    notification[OFFSET_RET(struct arm_scmi_system_power_state_notifier, flags)] = flags;
+    notification[OFFSET_RET(struct arm_scmi_system_power_state_notifier, system_state)] =
+        SYSTEM_POWER_STATE_SUSPEND;
+    mocker_post_notification(agents, header, suspended_ns, NUM_ELEMS(notification),
+                             notification);
+
+    notification[OFFSET_RET(struct arm_scmi_system_power_state_notifier, system_state)] =
+        SYSTEM_POWER_STATE_POWER_UP;
+    mocker_post_notification(agents, header, system_power_protocol.resume_done_ns,
+                             NUM_ELEMS(notification), notification);
+}
+
+void system_power_drop_agent(uint32_t agent_id)
+{
+    system_power_protocol.state_notify_agents &= ~(1u << agent_id);
+}
+
 void system_power_send_message(uint32_t message_id, uint32_t parameter_count,
         const uint32_t *parameters, int32_t *status,
         size_t *return_values_count, uint32_t *return_values)
 {
 
-    uint32_t parameter_idx;
-    int warm_reset_support = 1, system_suspend_support = 1;
+    uint32_t parameter_idx, flags, system_state;
 
     switch(message_id)
     {
@@ -59,8 +116,8 @@ void system_power_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_SUCCESS;
             *return_values_count = 1;
             /*System warm reset and suspend are supported*/
-            return_values[0] = (warm_reset_support << 31) +
-                    (system_suspend_support << 30) + 0;
+            return_values[0] = (system_power_protocol.warm_reset_support << 31) +
+                    (system_power_protocol.system_suspend_support << 30) + 0;
         }
         break;
     case SYSTEM_POWER_STATE_SET_MSG_ID:
@@ -80,6 +137,20 @@ void system_power_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_INVALID_PARAMETERS;
             return;
         }
+        flags = parameters[OFFSET_PARAM(struct arm_scmi_system_power_state_set, flags)];
+        system_state = parameters[OFFSET_PARAM(struct arm_scmi_system_power_state_set,
+                system_state)];
+        if (system_state == SYSTEM_POWER_STATE_SUSPEND) {
+            if (!system_power_protocol.system_suspend_support) {
+                *status = SCMI_STATUS_NOT_SUPPORTED;
+                return;
+            }
+            if (mocker_get_time_ns() < system_power_protocol.resume_done_ns) {
+                *status = SCMI_STATUS_BUSY;
+                return;
+            }
+            system_power_suspend(flags);
+        }
         *status = SCMI_STATUS_SUCCESS;
         break;
     case SYSTEM_POWER_STATE_GET_MSG_ID:
@@ -95,6 +166,9 @@ void system_power_send_message(uint32_t message_id, uint32_t parameter_count,
             *status = SCMI_STATUS_INVALID_PARAMETERS;
             return;
         }
+        system_power_protocol.state_notify_agents = mocker_subscribe(
+                system_power_protocol.state_notify_agents, parameters[OFFSET_PARAM(
+                        struct arm_scmi_system_power_state_set_notify, notify_enable)]);
         *status = SCMI_STATUS_SUCCESS;
         break;
     default:
@@ -18,6 +18,54 @@
 #include <voltage_protocol.h>
 #include <pal_voltage_expected.h>
 
+/* Upper bound on the number of levels returned in one DESCRIBE_LEVELS call */
+#define VOLTAGE_MAX_LEVELS_PER_MSG 8
+
+/*
+ * Mocker regulator model, one entry per domain in pal_voltage_expected.h.
+ * Level format of each domain is a discrete list or start/end/step triplet.
+ */
+static uint8_t voltage_level_format[] = {
+    VOLTAGE_LEVEL_FORMAT_ARRAY,
+    VOLTAGE_LEVEL_FORMAT_TRIPLET,
+};
+
+static uint32_t voltage_num_levels[] = {
+    9,
+    3,
+};
+
+/* Voltage levels in uV */
+static int32_t voltage_domain0_levels[] = {
+    800000, 850000, 900000, 950000, 1000000,
+    1050000, 1100000, 1150000, 1200000
+};
+
+static int32_t voltage_domain1_levels[] = {
+    600000, 1000000, 12500
+};
+
+static int32_t *voltage_levels[] = {
+    voltage_domain0_levels,
+    voltage_domain1_levels,
+};
+
+/* Regulator slew rate in uV/us */
+static uint32_t voltage_slew_rate[] = {
+    10000,
+    2500,
+};
+
+static uint32_t voltage_config[] = {
+    VOLTAGE_CONFIG_ARCH_ON,
+    VOLTAGE_CONFIG_ARCH_ON,
+};
+
+static int32_t voltage_current_level[] = {
+    1000000,
+    800000,
+};
+
 struct arm_scmi_voltage_protocol voltage_protocol;
 
 void fill_voltage_protocol()
@@ -25,12 +73,60 @@ void fill_voltage_protocol()
     voltage_protocol.protocol_version = VOLTAGE_VERSION;
     voltage_protocol.number_domains = num_voltage_domains;
     voltage_protocol.voltage_domain_name = voltage_domain_names;
+    voltage_protocol.voltage_level_format = voltage_level_format;
+    voltage_protocol.voltage_num_levels = voltage_num_levels;
+    voltage_protocol.voltage_levels = voltage_levels;
+    voltage_protocol.voltage_slew_rate = voltage_slew_rate;
+    voltage_protocol.voltage_config = voltage_config;
+    voltage_protocol.voltage_current_level = voltage_current_level;
+}
+
+/* Check that a level is one the domain can be programmed to */
+static bool voltage_level_is_valid(uint32_t domain_id, int32_t level)
+{
+    uint32_t i;
+    int32_t *levels = voltage_protocol.voltage_levels[domain_id];
+
+    if (voltage_protocol.voltage_level_format[domain_id] == VOLTAGE_LEVEL_FORMAT_TRIPLET)
+    {
+        if (level < levels[0] || level > levels[1])
+            return false;
+        return ((level - levels[0]) % levels[2]) == 0;
+    }
+
+    for (i = 0; i < voltage_protocol.voltage_num_levels[domain_id]; i++)
+        if (levels[i] == level)
+            return true;
+
+    return false;
+}
+
+/*
+ * Model the regulator ramp by holding the command for the time the rail
+ * takes to slew from the current to the requested level.
+ */
+static void voltage_ramp_delay(uint32_t domain_id, int32_t level)
+{
+    int64_t delta_uv;
+
+    if (voltage_protocol.voltage_slew_rate[domain_id] == 0)
+        return;
+
+    delta_uv = (int64_t)level - voltage_protocol.voltage_current_level[domain_id];
+    if (delta_uv < 0)
+        delta_uv = -delta_uv;
+
+    mocker_delay_ns((delta_uv * 1000) / voltage_protocol.voltage_slew_rate[domain_id]);
 }
 
 void voltage_send_message(uint32_t message_id, uint32_t parameter_count,
         const uint32_t *parameters, int32_t *status,
         size_t *return_values_count, uint32_t *return_values)
 {
+    uint32_t parameter_idx, domain_id, return_idx;
+    uint32_t level_index, num_levels, remaining, i, config, flags;
+    int32_t level;
+    char *str;
 
       switch(message_id)
       {
@@ -39,8 +135,199 @@ void voltage_send_message(uint32_t message_id, uint32_t parameter_count,
           *return_values_count = 1;
           return_values[0] = voltage_protocol.protocol_version;
           break;
-      /* Other Message IDs pending implementation */
+      case VOLTAGE_PROTO_ATTR_MSG_ID:
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = 1;
+          return_values[OFFSET_RET(
+                  struct arm_scmi_voltage_protocol_attributes,
+                  attributes)] =
+                          (voltage_protocol.number_domains <<
+                                  VOLTAGE_NUMBER_DOMAIN_LOW);
+          break;
+      case VOLTAGE_PROTO_MSG_ATTR_MSG_ID:
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_protocol_message_attributes, message_id);
+          if (parameters[parameter_idx] > VOLTAGE_LEVEL_GET_MSG_ID)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+          }
+          else
+          {
+              *status = SCMI_STATUS_SUCCESS;
+              *return_values_count = 1;
+              return_values[OFFSET_RET(
+                      struct arm_scmi_voltage_protocol_message_attributes,
+                      attributes)] = 0x0;
+          }
+          break;
+      case VOLTAGE_DOMAIN_ATTRIB_MSG_ID:
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_domain_attributes, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= voltage_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          return_idx = OFFSET_RET(struct arm_scmi_voltage_domain_attributes,
+                  attributes);
+          return_values[return_idx] = 0x0;
+
+          return_idx = OFFSET_RET(struct arm_scmi_voltage_domain_attributes,
+                  domain_name);
+          str = (char *)&return_values[return_idx];
+          snprintf(str, SCMI_NAME_STR_SIZE, "%s",
+                   voltage_protocol.voltage_domain_name[domain_id]);
+
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = return_idx + (SCMI_NAME_STR_SIZE/4);
+          break;
+      case VOLTAGE_DESCRIBE_LEVELS_MSG_ID:
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_describe_levels, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= voltage_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_describe_levels, level_index);
+          level_index = parameters[parameter_idx];
+          num_levels = voltage_protocol.voltage_num_levels[domain_id];
+
+          return_idx = OFFSET_RET(struct arm_scmi_voltage_describe_levels,
+                  voltage);
+          if (voltage_protocol.voltage_level_format[domain_id] ==
+                  VOLTAGE_LEVEL_FORMAT_TRIPLET)
+          {
+              if (level_index != 0)
+              {
+                  *status = SCMI_STATUS_OUT_OF_RANGE;
+                  break;
+              }
+              for (i = 0; i < num_levels; i++)
+                  return_values[return_idx + i] =
+                          voltage_protocol.voltage_levels[domain_id][i];
+              remaining = 0;
+          }
+          else
+          {
+              if (level_index >= num_levels)
+              {
+                  *status = SCMI_STATUS_OUT_OF_RANGE;
+                  break;
+              }
+              remaining = num_levels - level_index;
+              num_levels = (remaining > VOLTAGE_MAX_LEVELS_PER_MSG) ?
+                            VOLTAGE_MAX_LEVELS_PER_MSG : remaining;
+              remaining -= num_levels;
+              for (i = 0; i < num_levels; i++)
+                  return_values[return_idx + i] =
+                          voltage_protocol.voltage_levels[domain_id][level_index + i];
+          }
+
+          return_values[OFFSET_RET(struct arm_scmi_voltage_describe_levels,
+                  flags)] = (remaining << VOLTAGE_REMAINING_LEVELS_LOW) |
+                  (voltage_protocol.voltage_level_format[domain_id] <<
+                          VOLTAGE_RETURN_FORMAT) |
+                  (num_levels << VOLTAGE_NUM_LEVELS_LOW);
+
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = return_idx + num_levels;
+          break;
+      case VOLTAGE_CONFIG_SET_MSG_ID:
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_config_set, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= voltage_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_config_set, config);
+          config = parameters[parameter_idx];
+          /* Reserved bits must be zero and only OFF/ON architectural modes exist */
+          if ((config >> VOLTAGE_CONFIG_RESERVED_LOW) ||
+              (config < VOLTAGE_CONFIG_IMPL_DEFINED &&
+               config != VOLTAGE_CONFIG_ARCH_OFF &&
+               config != VOLTAGE_CONFIG_ARCH_ON))
+          {
+              *status = SCMI_STATUS_INVALID_PARAMETERS;
+              break;
+          }
+
+          voltage_protocol.voltage_config[domain_id] = config;
+          *status = SCMI_STATUS_SUCCESS;
+          break;
+      case VOLTAGE_CONFIG_GET_MSG_ID:
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_config_get, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= voltage_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = 1;
+          return_values[OFFSET_RET(struct arm_scmi_voltage_config_get,
+                  config)] = voltage_protocol.voltage_config[domain_id];
+          break;
+      case VOLTAGE_LEVEL_SET_MSG_ID:
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_level_set, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= voltage_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          /* Voltage v1.0 defines no level set flags */
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_level_set, flags);
+          flags = parameters[parameter_idx];
+          if (flags != 0)
+          {
+              *status = SCMI_STATUS_INVALID_PARAMETERS;
+              break;
+          }
+
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_level_set, voltage_level);
+          level = (int32_t)parameters[parameter_idx];
+          if (!voltage_level_is_valid(domain_id, level))
+          {
+              *status = SCMI_STATUS_INVALID_PARAMETERS;
+              break;
+          }
 
+          voltage_ramp_delay(domain_id, level);
+          voltage_protocol.voltage_current_level[domain_id] = level;
+          *status = SCMI_STATUS_SUCCESS;
+          break;
+      case VOLTAGE_LEVEL_GET_MSG_ID:
+          parameter_idx = OFFSET_PARAM(
+                  struct arm_scmi_voltage_level_get, domain_id);
+          domain_id = parameters[parameter_idx];
+          if (domain_id >= voltage_protocol.number_domains)
+          {
+              *status = SCMI_STATUS_NOT_FOUND;
+              break;
+          }
+
+          *status = SCMI_STATUS_SUCCESS;
+          *return_values_count = 1;
+          return_values[OFFSET_RET(struct arm_scmi_voltage_level_get,
+                  voltage_level)] =
+                          (uint32_t)voltage_protocol.voltage_current_level[domain_id];
+          break;
       default:
           *status = SCMI_STATUS_NOT_FOUND;
           break;
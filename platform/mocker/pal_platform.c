@@ -17,82 +17,62 @@
 
 #include <pal_platform.h>
 #include <pal_interface.h>
+#include <pal_socket.h>
 
 void pal_send_message(uint32_t message_header_send, size_t parameter_count,
         const uint32_t *parameters, uint32_t *message_header_rcv, int32_t *status,
         size_t *return_values_count, uint32_t *return_values)
 {
-    int message_id;
-    int protocol_id;
-
-    *message_header_rcv = message_header_send;
-    protocol_id = SCMI_EXRACT_BITS(message_header_send,
-            PROTOCOL_ID_HIGH, PROTOCOL_ID_LOW);
-    message_id = SCMI_EXRACT_BITS(message_header_send,
-            MESSAGE_ID_HIGH, MESSAGE_ID_LOW);
-
-    switch (protocol_id)
-    {
-    case BASE_PROTOCOL_ID:
-        base_send_message(message_id, parameter_count, parameters, status,
-                return_values_count, return_values);
-        break;
-    case POWER_DOMAIN_PROTOCOL_ID:
-        power_send_message(message_id, parameter_count, parameters, status,
-                return_values_count, return_values);
-        break;
-    case SYSTEM_POWER_PROTOCOL_ID:
-        system_power_send_message(message_id, parameter_count, parameters, status,
-                return_values_count, return_values);
-        break;
-    case PERFORMANCE_PROTOCOL_ID:
-        performance_send_message(message_id, parameter_count, parameters, status,
-                return_values_count, return_values);
-        break;
-    case CLOCK_PROTOCOL_ID:
-        clock_send_message(message_id, parameter_count, parameters, status,
-                return_values_count, return_values);
-        break;
-    case SENSOR_PROTOCOL_ID:
-        sensor_send_message(message_id, parameter_count, parameters, status,
-                return_values_count, return_values);
-        break;
-    case RESET_PROTOCOL_ID:
-        reset_send_message(message_id, parameter_count, parameters, status,
-                return_values_count, return_values);
-        break;
-    case VOLTAGE_PROTOCOL_ID:
-        voltage_send_message(message_id, parameter_count, parameters, status,
-                return_values_count, return_values);
-        break;
-    default:
-        printf("\nProtocol: %d\n", message_id);
-        assert(!"\nUnknown protocol id\n");
-        break;
+    if (pal_socket_connected()) {
+        pal_socket_send_message(message_header_send, parameter_count, parameters,
+                message_header_rcv, status, return_values_count, return_values);
+        return;
     }
+
+    mocker_send_message(message_header_send, parameter_count, parameters,
+            message_header_rcv, status, return_values_count, return_values);
 }
 
 void pal_receive_delayed_response(uint32_t *message_header_rcv, int32_t *status,
         size_t *return_values_count, uint32_t *return_values)
 {
-    return ;
+    if (pal_socket_connected()) {
+        pal_socket_receive(MOCKER_SOCKET_DELAYED_RESPONSE, message_header_rcv, status,
+                return_values_count, return_values);
+        return;
+    }
+
+    mocker_receive_delayed_response(message_header_rcv, status, return_values_count,
+            return_values);
 }
 
 void pal_receive_notification(uint32_t *message_header_rcv, size_t *return_values_count,
        uint32_t *return_values)
 {
-    return ;
+    if (pal_socket_connected()) {
+        pal_socket_receive(MOCKER_SOCKET_NOTIFICATION, message_header_rcv, NULL,
+                return_values_count, return_values);
+        return;
+    }
+
+    sensor_advance_waveforms();
+    mocker_receive_notification(message_header_rcv, return_values_count, return_values);
 }
 
+/* The platform runs in process unless info names a mocker server to connect to */
 uint32_t pal_initialize_system(void *info)
 {
-    fill_base_protocol();
-    fill_power_protocol();
-    fill_performance_protocol();
-    fill_sensor_protocol();
-    fill_clock_protocol();
-    fill_reset_protocol();
-    fill_voltage_protocol();
+    MOCKER_SOCKET_CONFIG_s *config = info;
+
+    if ((config != NULL) && (config->socket_path != NULL))
+        return pal_socket_connect(config);
+
+    /* Models take their start time while initializing, so switch clocks first */
+    if ((config != NULL) && config->virtual_clock)
+        mocker_enable_virtual_clock();
+    mocker_initialize();
+    if (config != NULL)
+        mocker_set_system_suspend_durations(config->suspend_us, config->resume_us);
 
     return PAL_STATUS_PASS;
 }
@@ -102,6 +82,141 @@ void pal_print(uint32_t print_level, const char *format, va_list args)
     vprintf(format, args);
 }
 
+/* Agent and platform share one clock, so in process runs see the virtual time too */
+uint64_t pal_get_time_ns(void)
+{
+    return mocker_get_time_ns();
+}
+
+uint64_t pal_get_cpu_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + ts.tv_nsec;
+}
+
+/* The stack grows on demand, paint a window below the caller */
+uint64_t pal_get_stack_limit(void)
+{
+    volatile uint8_t marker;
+
+    return (uint64_t)(uintptr_t)&marker - PAL_STACK_WINDOW;
+}
+
+/* The mocker runs in the agent process, so its work is counted too */
+uint32_t pal_counters_enable(uint32_t enable)
+{
+    return linux_counters_enable(enable);
+}
+
+void pal_counters_read(uint64_t *values)
+{
+    linux_counters_read(values);
+}
+
+/* In process a command completes when the call returns, there is nothing to poll */
+uint32_t pal_set_completion_mode(uint32_t mode)
+{
+    if (pal_socket_connected())
+        return pal_socket_set_completion_mode(mode);
+
+    return (mode == PAL_COMPLETION_INTERRUPT) ? PAL_STATUS_PASS : PAL_STATUS_FAIL;
+}
+
+/*
+ * In process the fast channels of the performance model are plain memory the
+ * agent shares. The server keeps its own, so a connected agent has none.
+ */
+void *pal_fast_channel_map(uint32_t protocol_id, uint32_t domain_id, uint32_t message_id,
+                           uint64_t chan_addr, uint32_t chan_size)
+{
+    if (pal_socket_connected() || (protocol_id != PERFORMANCE_PROTOCOL_ID))
+        return NULL;
+
+    return mocker_performance_fast_channel(domain_id, message_id);
+}
+
+void pal_reset_channel(void)
+{
+    if (pal_socket_connected()) {
+        pal_socket_reset_channel();
+        return;
+    }
+
+    mocker_reset_channel();
+}
+
+uint32_t pal_checkpoint_load(const char *file, uint32_t *test_num, uint32_t *outcome,
+                             uint32_t max_entries)
+{
+    FILE *file_ptr;
+    uint32_t count = 0;
+
+    file_ptr = fopen(file, "r");
+    if (file_ptr == NULL)
+        return 0;
+
+    while ((count < max_entries) &&
+           (fscanf(file_ptr, "%" SCNu32 " %" SCNu32, &test_num[count], &outcome[count]) == 2))
+        count++;
+
+    fclose(file_ptr);
+    return count;
+}
+
+/* Closed after every record so the file survives a crash of the agent */
+void pal_checkpoint_append(const char *file, uint32_t test_num, uint32_t outcome)
+{
+    FILE *file_ptr;
+
+    file_ptr = fopen(file, "a");
+    if (file_ptr == NULL)
+        return;
+
+    fprintf(file_ptr, "%" PRIu32 " %" PRIu32 "\n", test_num, outcome);
+    fclose(file_ptr);
+}
+
+void pal_checkpoint_remove(const char *file)
+{
+    remove(file);
+}
+
+void *pal_file_open(const char *file)
+{
+    return fopen(file, "w");
+}
+
+void *pal_file_open_append(const char *file)
+{
+    return fopen(file, "a");
+}
+
+void *pal_file_open_read(const char *file)
+{
+    return fopen(file, "r");
+}
+
+uint32_t pal_file_read_line(void *handle, char *line, uint32_t size)
+{
+    if (fgets(line, size, (FILE *)handle) == NULL)
+        return 0;
+
+    line[strcspn(line, "\r\n")] = '\0';
+    return 1;
+}
+
+void pal_file_print(void *handle, const char *format, va_list args)
+{
+    vfprintf((FILE *)handle, format, args);
+}
+
+void pal_file_close(void *handle)
+{
+    fclose((FILE *)handle);
+}
+
 void *pal_memcpy(void *dest, const void *src, size_t size)
 {
     if (dest == NULL || src == NULL || size == 0)
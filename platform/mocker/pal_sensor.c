@@ -40,6 +40,12 @@ uint32_t pal_sensor_get_expected_stats_addr_len(void)
     return statistics_address_len_snsr;
 }
 
+uint32_t pal_sensor_get_expected_clock_drift(int32_t *drift_ppb)
+{
+    *drift_ppb = SENSOR_CLOCK_DRIFT_PPB;
+    return PAL_STATUS_PASS;
+}
+
 uint8_t pal_sensor_get_expected_async_support(uint32_t sensor_id)
 {
     return async_sensor_read_support[sensor_id];
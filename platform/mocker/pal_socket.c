@@ -0,0 +1,181 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <pal_interface.h>
+#include <pal_socket.h>
+
+static int socket_fd = -1;
+static uint32_t completion_mode = PAL_COMPLETION_INTERRUPT;
+
+/*
+ * Wait for a reply. Interrupt mode sleeps in recv(), polled mode spins on a
+ * non blocking recv() and adaptive mode spins for MOCKER_SOCKET_SPIN_NS
+ * before it sleeps.
+ */
+static ssize_t pal_socket_wait_reply(MOCKER_SOCKET_MSG_s *msg)
+{
+    uint64_t start_ns = pal_get_time_ns();
+    ssize_t size;
+
+    if (completion_mode == PAL_COMPLETION_INTERRUPT)
+        return recv(socket_fd, msg, sizeof(*msg), 0);
+
+    do {
+        size = recv(socket_fd, msg, sizeof(*msg), MSG_DONTWAIT);
+        if ((size >= 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK)))
+            return size;
+    } while ((completion_mode == PAL_COMPLETION_POLLED) ||
+             ((pal_get_time_ns() - start_ns) < MOCKER_SOCKET_SPIN_NS));
+
+    return recv(socket_fd, msg, sizeof(*msg), 0);
+}
+
+/* Send a request and wait for its reply, which is written over it */
+static int pal_socket_transfer(MOCKER_SOCKET_MSG_s *msg)
+{
+    uint32_t type = msg->type;
+    ssize_t size;
+
+    if (send(socket_fd, msg, sizeof(*msg), 0) < 0)
+        return -1;
+
+    size = pal_socket_wait_reply(msg);
+    if ((size != (ssize_t)sizeof(*msg)) || (msg->type != type))
+        return -1;
+
+    return 0;
+}
+
+static uint32_t pal_socket_close(void)
+{
+    close(socket_fd);
+    socket_fd = -1;
+    return PAL_STATUS_FAIL;
+}
+
+uint32_t pal_socket_connect(MOCKER_SOCKET_CONFIG_s *config)
+{
+    struct sockaddr_un addr;
+    MOCKER_SOCKET_MSG_s msg;
+
+    if (strlen(config->socket_path) >= sizeof(addr.sun_path)) {
+        printf("\n        Socket path too long: %s", config->socket_path);
+        return PAL_STATUS_FAIL;
+    }
+
+    socket_fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (socket_fd < 0)
+        return PAL_STATUS_FAIL;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, config->socket_path);
+    if (connect(socket_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        printf("\n        Cannot connect to %s", config->socket_path);
+        return pal_socket_close();
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.type = MOCKER_SOCKET_HELLO;
+    msg.count = 1;
+    msg.payload[0] = config->agent_id;
+    if (pal_socket_transfer(&msg) || (msg.status != 0)) {
+        printf("\n        Agent id %d refused by %s", config->agent_id, config->socket_path);
+        return pal_socket_close();
+    }
+
+    printf("\n        Connected to %s as agent %d", config->socket_path, msg.message_header);
+    return PAL_STATUS_PASS;
+}
+
+uint32_t pal_socket_set_completion_mode(uint32_t mode)
+{
+    if (mode > PAL_COMPLETION_ADAPTIVE)
+        return PAL_STATUS_FAIL;
+
+    completion_mode = mode;
+    return PAL_STATUS_PASS;
+}
+
+bool pal_socket_connected(void)
+{
+    return socket_fd >= 0;
+}
+
+void pal_socket_send_message(uint32_t message_header_send, size_t parameter_count,
+        const uint32_t *parameters, uint32_t *message_header_rcv, int32_t *status,
+        size_t *return_values_count, uint32_t *return_values)
+{
+    MOCKER_SOCKET_MSG_s msg;
+    uint32_t i;
+
+    *message_header_rcv = message_header_send;
+    *status = MOCKER_SOCKET_COMMS_ERROR;
+    if (parameter_count > MOCKER_SOCKET_MAX_WORDS)
+        return;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.type = MOCKER_SOCKET_COMMAND;
+    msg.message_header = message_header_send;
+    msg.count = parameter_count;
+    for (i = 0; i < parameter_count; i++)
+        msg.payload[i] = parameters[i];
+
+    if (pal_socket_transfer(&msg))
+        return;
+
+    *message_header_rcv = msg.message_header;
+    *status = msg.status;
+    *return_values_count = msg.count;
+    for (i = 0; i < MAX_RETURNS_SIZE; i++)
+        return_values[i] = msg.payload[i];
+}
+
+/* Outputs are left untouched when nothing is queued, as in process */
+void pal_socket_receive(uint32_t type, uint32_t *message_header_rcv, int32_t *status,
+        size_t *return_values_count, uint32_t *return_values)
+{
+    MOCKER_SOCKET_MSG_s msg;
+    uint32_t i;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.type = type;
+    if (pal_socket_transfer(&msg) || (msg.message_header == 0))
+        return;
+
+    *message_header_rcv = msg.message_header;
+    if (status)
+        *status = msg.status;
+    *return_values_count = msg.count;
+    for (i = 0; i < MAX_RETURNS_SIZE; i++)
+        return_values[i] = msg.payload[i];
+}
+
+void pal_socket_reset_channel(void)
+{
+    MOCKER_SOCKET_MSG_s msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.type = MOCKER_SOCKET_RESET_CHANNEL;
+    pal_socket_transfer(&msg);
+}
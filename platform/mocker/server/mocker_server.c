@@ -0,0 +1,449 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+/*
+ * Standalone mocker platform. The transport_*.c protocol models run here and
+ * test agents connect over a UNIX domain socket, each as its own agent id,
+ * so several agents can share one platform and a crash of one side does not
+ * take down the other. Ready agents are served one request at a time in
+ * round robin order, and the time each request waited behind the requests of
+ * other agents is reported when the server exits.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <protocol_common.h>
+#include <pal_socket.h>
+
+#define SERVER_NO_AGENT     MOCKER_SOCKET_ANY_AGENT
+
+typedef struct {
+    int fd;
+    uint32_t agent_id;
+    uint32_t held_type;     /* receive held until its message falls due, 0 if none */
+    uint64_t held_due_ns;
+} SERVER_CLIENT_s;
+
+typedef struct {
+    uint32_t connected;
+    uint64_t num_requests;
+    uint64_t service_ns;
+    uint64_t wait_ns;
+    uint64_t max_wait_ns;
+} SERVER_AGENT_STATS_s;
+
+static SERVER_CLIENT_s g_client[MOCKER_MAX_AGENTS];
+static SERVER_AGENT_STATS_s g_stats[MOCKER_MAX_AGENTS];
+static volatile sig_atomic_t g_stop;
+
+static void server_signal(int signum)
+{
+    g_stop = 1;
+}
+
+static void server_reply(SERVER_CLIENT_s *client, MOCKER_SOCKET_MSG_s *msg)
+{
+    send(client->fd, msg, sizeof(*msg), 0);
+}
+
+static bool server_agent_in_use(uint32_t agent_id)
+{
+    uint32_t i;
+
+    for (i = 0; i < MOCKER_MAX_AGENTS; i++)
+    {
+        if ((g_client[i].fd >= 0) && (g_client[i].agent_id == agent_id))
+            return true;
+    }
+    return false;
+}
+
+/* Give the client the agent id it asked for, or the lowest free one */
+static void server_hello(SERVER_CLIENT_s *client, MOCKER_SOCKET_MSG_s *msg)
+{
+    uint32_t agent_id = msg->payload[0];
+
+    msg->count = 0;
+    msg->status = SCMI_STATUS_SUCCESS;
+    if ((client->agent_id != SERVER_NO_AGENT) || (msg->message_header != 0)) {
+        msg->status = SCMI_STATUS_PROTOCOL_ERROR;
+        return;
+    }
+
+    if (agent_id == MOCKER_SOCKET_ANY_AGENT) {
+        for (agent_id = 0; agent_id < MOCKER_MAX_AGENTS; agent_id++)
+        {
+            if ((agent_name_get(agent_id) != NULL) && !server_agent_in_use(agent_id))
+                break;
+        }
+    }
+
+    if ((agent_id >= MOCKER_MAX_AGENTS) || (agent_name_get(agent_id) == NULL)) {
+        msg->status = SCMI_STATUS_NOT_FOUND;
+        return;
+    }
+    if (server_agent_in_use(agent_id)) {
+        msg->status = SCMI_STATUS_BUSY;
+        return;
+    }
+
+    client->agent_id = agent_id;
+    msg->message_header = agent_id;
+    g_stats[agent_id].connected = 1;
+    printf("\nAgent %d (%s) connected", agent_id, agent_name_get(agent_id));
+}
+
+/*
+ * Deliver the oldest queued notification or delayed response. One not yet
+ * due is held, and the client is not read from, until it falls due.
+ * Returns false if the reply is held.
+ */
+static bool server_receive(SERVER_CLIENT_s *client, MOCKER_SOCKET_MSG_s *msg)
+{
+    uint64_t due_ns;
+    size_t count = 0;
+
+    if (msg->type == MOCKER_SOCKET_NOTIFICATION) {
+        sensor_advance_waveforms();
+        due_ns = mocker_notification_due_ns();
+    } else {
+        due_ns = mocker_delayed_response_due_ns();
+    }
+
+    msg->message_header = 0;
+    msg->status = SCMI_STATUS_SUCCESS;
+    msg->count = 0;
+    if (due_ns == MOCKER_NOTHING_QUEUED)
+        return true;
+
+    if (due_ns > mocker_get_time_ns()) {
+        client->held_type = msg->type;
+        client->held_due_ns = due_ns;
+        return false;
+    }
+
+    if (msg->type == MOCKER_SOCKET_NOTIFICATION)
+        mocker_receive_notification(&msg->message_header, &count, msg->payload);
+    else
+        mocker_receive_delayed_response(&msg->message_header, &msg->status, &count,
+                msg->payload);
+    msg->count = count;
+
+    return true;
+}
+
+/* Returns false if the reply is held */
+static bool server_handle(SERVER_CLIENT_s *client, MOCKER_SOCKET_MSG_s *msg)
+{
+    uint32_t parameters[MOCKER_SOCKET_MAX_WORDS];
+    size_t count = 0;
+
+    if (msg->type == MOCKER_SOCKET_HELLO) {
+        server_hello(client, msg);
+        return true;
+    }
+
+    if (client->agent_id == SERVER_NO_AGENT) {
+        msg->status = SCMI_STATUS_PROTOCOL_ERROR;
+        msg->count = 0;
+        return true;
+    }
+    mocker_set_calling_agent(client->agent_id);
+
+    switch (msg->type)
+    {
+    case MOCKER_SOCKET_COMMAND:
+        memcpy(parameters, msg->payload, sizeof(parameters));
+        memset(msg->payload, 0, sizeof(msg->payload));
+        mocker_send_message(msg->message_header, msg->count, parameters,
+                &msg->message_header, &msg->status, &count, msg->payload);
+        msg->count = count;
+        return true;
+    case MOCKER_SOCKET_DELAYED_RESPONSE:
+    case MOCKER_SOCKET_NOTIFICATION:
+        return server_receive(client, msg);
+    case MOCKER_SOCKET_RESET_CHANNEL:
+        mocker_reset_channel();
+        msg->status = SCMI_STATUS_SUCCESS;
+        msg->count = 0;
+        return true;
+    default:
+        msg->status = SCMI_STATUS_NOT_SUPPORTED;
+        msg->count = 0;
+        return true;
+    }
+}
+
+static void server_disconnect(SERVER_CLIENT_s *client)
+{
+    if (client->agent_id != SERVER_NO_AGENT) {
+        printf("\nAgent %d disconnected", client->agent_id);
+        mocker_drop_agent(client->agent_id);
+    }
+
+    close(client->fd);
+    client->fd = -1;
+    client->agent_id = SERVER_NO_AGENT;
+    client->held_type = 0;
+}
+
+static void server_read(SERVER_CLIENT_s *client, uint64_t ready_ns)
+{
+    MOCKER_SOCKET_MSG_s msg;
+    SERVER_AGENT_STATS_s *stats;
+    uint64_t start_ns, wait_ns;
+    ssize_t size;
+
+    size = recv(client->fd, &msg, sizeof(msg), 0);
+    if ((size != (ssize_t)sizeof(msg)) || (msg.count > MOCKER_SOCKET_MAX_WORDS)) {
+        server_disconnect(client);
+        return;
+    }
+
+    start_ns = mocker_get_time_ns();
+    if (!server_handle(client, &msg))
+        return;
+    server_reply(client, &msg);
+
+    if (client->agent_id == SERVER_NO_AGENT)
+        return;
+
+    stats = &g_stats[client->agent_id];
+    wait_ns = start_ns - ready_ns;
+    stats->num_requests++;
+    stats->service_ns += mocker_get_time_ns() - start_ns;
+    stats->wait_ns += wait_ns;
+    if (wait_ns > stats->max_wait_ns)
+        stats->max_wait_ns = wait_ns;
+}
+
+/* Answer held receives whose message has fallen due */
+static void server_release_held(void)
+{
+    MOCKER_SOCKET_MSG_s msg;
+    uint32_t i;
+
+    for (i = 0; i < MOCKER_MAX_AGENTS; i++)
+    {
+        if ((g_client[i].fd < 0) || (g_client[i].held_type == 0) ||
+            (g_client[i].held_due_ns > mocker_get_time_ns()))
+            continue;
+
+        msg.type = g_client[i].held_type;
+        g_client[i].held_type = 0;
+        mocker_set_calling_agent(g_client[i].agent_id);
+        if (server_receive(&g_client[i], &msg))
+            server_reply(&g_client[i], &msg);
+    }
+}
+
+/* Poll timeout in ms until the first held receive falls due, -1 if none */
+static int server_poll_timeout(void)
+{
+    uint64_t now = mocker_get_time_ns(), first_due = MOCKER_NOTHING_QUEUED;
+    uint32_t i;
+
+    for (i = 0; i < MOCKER_MAX_AGENTS; i++)
+    {
+        if ((g_client[i].fd >= 0) && g_client[i].held_type &&
+            (g_client[i].held_due_ns < first_due))
+            first_due = g_client[i].held_due_ns;
+    }
+
+    if (first_due == MOCKER_NOTHING_QUEUED)
+        return -1;
+    if (first_due <= now)
+        return 0;
+
+    return (int)((first_due - now + 999999) / 1000000);
+}
+
+static void server_accept(int listen_fd)
+{
+    uint32_t i;
+    int fd;
+
+    fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0)
+        return;
+
+    for (i = 0; i < MOCKER_MAX_AGENTS; i++)
+    {
+        if (g_client[i].fd < 0) {
+            g_client[i].fd = fd;
+            g_client[i].agent_id = SERVER_NO_AGENT;
+            g_client[i].held_type = 0;
+            return;
+        }
+    }
+
+    printf("\nConnection refused, %d agents already connected", MOCKER_MAX_AGENTS);
+    close(fd);
+}
+
+/*
+ * Jain's fairness index of the requests served per connected agent, scaled
+ * by 1000. 1000 means every agent got the same share.
+ */
+static uint64_t server_fairness_index(void)
+{
+    uint64_t sum = 0, sum_sq = 0, num_agents = 0;
+    uint32_t i;
+
+    for (i = 0; i < MOCKER_MAX_AGENTS; i++)
+    {
+        if (!g_stats[i].connected)
+            continue;
+        num_agents++;
+        sum += g_stats[i].num_requests;
+        sum_sq += g_stats[i].num_requests * g_stats[i].num_requests;
+    }
+
+    if (sum_sq == 0)
+        return 0;
+
+    return (sum * sum * 1000) / (num_agents * sum_sq);
+}
+
+static void server_report(void)
+{
+    SERVER_AGENT_STATS_s *stats;
+    uint32_t i;
+
+    printf("\n\nagent     requests  service mean ns  wait mean ns   wait max ns");
+    for (i = 0; i < MOCKER_MAX_AGENTS; i++)
+    {
+        stats = &g_stats[i];
+        if (!stats->connected || (stats->num_requests == 0))
+            continue;
+        printf("\n%5d %12llu %16llu %13llu %13llu", i,
+               (unsigned long long)stats->num_requests,
+               (unsigned long long)(stats->service_ns / stats->num_requests),
+               (unsigned long long)(stats->wait_ns / stats->num_requests),
+               (unsigned long long)stats->max_wait_ns);
+    }
+    printf("\nfairness index %llu/1000\n", (unsigned long long)server_fairness_index());
+}
+
+int main(int argc, char *argv[])
+{
+    struct sockaddr_un addr;
+    struct pollfd fds[MOCKER_MAX_AGENTS + 1];
+    uint32_t client_of_fd[MOCKER_MAX_AGENTS + 1];
+    uint32_t i, k, nfds, next = 0, num_connected;
+    uint32_t keep_running = 0, served = 0;
+    uint64_t ready_ns;
+    int listen_fd;
+
+    if ((argc < 2) || (argc > 3) || ((argc == 3) && strcmp(argv[2], "--keep-running"))) {
+        printf("\nUsage: %s <socket path> [--keep-running]\n", argv[0]);
+        printf("  Exits once the last agent disconnects unless --keep-running is given\n");
+        return 1;
+    }
+    keep_running = (argc == 3);
+
+    if (strlen(argv[1]) >= sizeof(addr.sun_path)) {
+        printf("\nSocket path too long: %s\n", argv[1]);
+        return 1;
+    }
+
+    listen_fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, argv[1]);
+    unlink(argv[1]);
+    if ((listen_fd < 0) || bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) ||
+        listen(listen_fd, MOCKER_MAX_AGENTS)) {
+        perror("mocker server");
+        return 1;
+    }
+
+    signal(SIGINT, server_signal);
+    signal(SIGTERM, server_signal);
+    signal(SIGPIPE, SIG_IGN);
+
+    for (i = 0; i < MOCKER_MAX_AGENTS; i++)
+    {
+        g_client[i].fd = -1;
+        g_client[i].agent_id = SERVER_NO_AGENT;
+    }
+    mocker_initialize();
+    printf("\nMocker server listening on %s", argv[1]);
+    fflush(stdout);
+
+    while (!g_stop)
+    {
+        fds[0].fd = listen_fd;
+        fds[0].events = POLLIN;
+        nfds = 1;
+        num_connected = 0;
+        for (i = 0; i < MOCKER_MAX_AGENTS; i++)
+        {
+            if (g_client[i].fd < 0)
+                continue;
+            num_connected++;
+            if (g_client[i].held_type)
+                continue;
+            fds[nfds].fd = g_client[i].fd;
+            fds[nfds].events = POLLIN;
+            client_of_fd[nfds++] = i;
+        }
+
+        if (served && !keep_running && (num_connected == 0))
+            break;
+
+        if (poll(fds, nfds, server_poll_timeout()) < 0)
+            continue;
+        ready_ns = mocker_get_time_ns();
+
+        if (fds[0].revents & POLLIN) {
+            server_accept(listen_fd);
+            served = 1;
+        }
+
+        /* One request from every ready agent, starting one past the last start */
+        for (k = 0; k < MOCKER_MAX_AGENTS; k++)
+        {
+            for (i = 1; i < nfds; i++)
+            {
+                if ((client_of_fd[i] == (next + k) % MOCKER_MAX_AGENTS) && fds[i].revents)
+                    server_read(&g_client[client_of_fd[i]], ready_ns);
+            }
+        }
+        next = (next + 1) % MOCKER_MAX_AGENTS;
+
+        server_release_held();
+        fflush(stdout);
+    }
+
+    for (i = 0; i < MOCKER_MAX_AGENTS; i++)
+    {
+        if (g_client[i].fd >= 0)
+            server_disconnect(&g_client[i]);
+    }
+    close(listen_fd);
+    unlink(argv[1]);
+    server_report();
+
+    return 0;
+}
@@ -0,0 +1,487 @@
+/** @file
+ * Copyright (c) 2019-2020, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_base.h"
+#include "val_benchmark.h"
+
+#define TEST_NUM  (SCMI_BASE_TEST_NUM_BASE + 18)
+#define TEST_DESC "Base permission matrix sweep and cost check  "
+
+#define PARAMETER_SIZE          4
+#define PERMISSION_MAX_DEVICES  32
+#define PERMISSION_MAX_MESSAGES 32
+#define NUM_PROTOCOL_ENTRIES    (PROTOCOL_MAX - PROTOCOL_BASE)
+#define PROTOCOL_MASK(p)        (1u << ((p) - PROTOCOL_BASE))
+#define BENCH_ITERATIONS        256
+
+/* Other agents, such as the OSPM, are only swept when the build asks for it */
+#ifdef PERMISSION_SWEEP_ALL_AGENTS
+#define SWEEP_ALL_AGENTS        1
+#else
+#define SWEEP_ALL_AGENTS        0
+#endif
+
+/********* TEST ALGO ********************
+ * If the calling agent is untrusted or any of the permission commands is
+ * not supported, skip the test
+ * Find the commands implemented by every supported protocol through
+ * PROTOCOL_MESSAGE_ATTRIBUTES
+ * Find the devices by allowing the calling agent access to device ids
+ * until NOT_FOUND, and the protocols each device exposes by allowing
+ * access to every protocol on it
+ * For the calling agent, and every other agent in PERMISSION_SWEEP_ALL_AGENTS
+ * builds, which the mocker is by default
+ *   Deny the agent every device. The calling agent must get DENIED for
+ *   every implemented command of every protocol a device exposes, other
+ *   agents must leave the calling agent unaffected
+ *   Restore with BASE_RESET_AGENT_CONFIGURATION and check access is back
+ *   For every protocol, deny it on every device exposing it and check the
+ *   same, then allow it again and check access is back
+ * Commands are sent without parameters, so a platform that does not
+ * enforce permissions rejects them as malformed instead of acting on them
+ * If there is a time source, time PROTOCOL_VERSION of the base protocol,
+ * which is never checked, against every other protocol with access
+ * allowed, with every other agent denied everything in
+ * PERMISSION_SWEEP_ALL_AGENTS builds, and with access denied, and report
+ * the cost of the permission check
+*****************************************/
+
+static uint32_t g_num_devices;
+static uint32_t g_device_protocols[PERMISSION_MAX_DEVICES];
+static uint32_t g_protocol_messages[NUM_PROTOCOL_ENTRIES];
+static uint32_t g_num_enforced;
+static VAL_HIST_s g_permission_latency;
+static VAL_HIST_s g_base_latency;
+static VAL_HIST_s g_allowed_latency;
+static VAL_HIST_s g_loaded_latency;
+static VAL_HIST_s g_denied_latency;
+
+static int32_t permission_send(uint32_t message_id, size_t param_count, uint32_t *parameters)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint64_t start_ns;
+
+    rsp_msg_hdr = 0;
+    return_value_count = 0;
+    status = SCMI_GENERIC_ERROR;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_BASE, message_id, COMMAND_MSG);
+    start_ns = val_get_time_ns();
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+    val_hist_add(&g_permission_latency, val_get_time_ns() - start_ns);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+static int32_t permission_set_device(uint32_t agent_id, uint32_t device_id, uint32_t flags)
+{
+    uint32_t parameters[PARAMETER_SIZE];
+
+    parameters[0] = agent_id;
+    parameters[1] = device_id;
+    parameters[2] = flags;
+
+    return permission_send(BASE_SET_DEVICE_PERMISSIONS, 3, parameters);
+}
+
+static int32_t permission_set_protocol(uint32_t agent_id, uint32_t device_id,
+                                       uint32_t protocol_id, uint32_t flags)
+{
+    uint32_t parameters[PARAMETER_SIZE];
+
+    parameters[0] = agent_id;
+    parameters[1] = device_id;
+    parameters[2] = protocol_id;
+    parameters[3] = flags;
+
+    return permission_send(BASE_SET_PROTOCOL_PERMISSIONS, 4, parameters);
+}
+
+static int32_t permission_reset_agent(uint32_t agent_id)
+{
+    uint32_t parameters[PARAMETER_SIZE];
+
+    parameters[0] = agent_id;
+    parameters[1] = FLAG_RESET_ACCESS;
+
+    return permission_send(BASE_RESET_AGENT_CONFIGURATION, 2, parameters);
+}
+
+static int32_t permission_command(uint32_t protocol_id, uint32_t message_id,
+                                  size_t param_count, uint32_t *parameters)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t param_check;
+
+    rsp_msg_hdr = 0;
+    return_value_count = 0;
+    status = SCMI_GENERIC_ERROR;
+    cmd_msg_hdr = val_msg_hdr_create(protocol_id, message_id, COMMAND_MSG);
+    /* Probes without parameters are malformed on purpose */
+    param_check = val_set_param_check(parameters != NULL);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+    val_set_param_check(param_check);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+static uint32_t permission_supported(uint32_t message_id)
+{
+    return permission_command(PROTOCOL_BASE, BASE_PROTOCOL_MESSAGE_ATTRIBUTES, 1,
+                              &message_id) == SCMI_SUCCESS;
+}
+
+static void permission_discover_messages(void)
+{
+    uint32_t protocol_id, message_id;
+
+    for (protocol_id = PROTOCOL_BASE + 1; protocol_id < PROTOCOL_MAX; protocol_id++)
+    {
+        g_protocol_messages[protocol_id - PROTOCOL_BASE] = 0;
+        if (!val_agent_check_protocol_support(protocol_id))
+            continue;
+
+        /* PROTOCOL_VERSION, PROTOCOL_ATTRIBUTES and PROTOCOL_MESSAGE_ATTRIBUTES */
+        g_protocol_messages[protocol_id - PROTOCOL_BASE] = 0x7;
+        for (message_id = 3; message_id < PERMISSION_MAX_MESSAGES; message_id++)
+        {
+            if (permission_command(protocol_id, 0x2, 1, &message_id) == SCMI_SUCCESS)
+                g_protocol_messages[protocol_id - PROTOCOL_BASE] |= (1u << message_id);
+        }
+    }
+}
+
+static uint32_t permission_discover_devices(uint32_t agent_id)
+{
+    uint32_t device_id, protocol_id;
+    int32_t  status;
+
+    for (device_id = 0; device_id < PERMISSION_MAX_DEVICES; device_id++)
+    {
+        status = permission_set_device(agent_id, device_id, FLAG_ACCESS_ALLOW);
+        if (status == SCMI_NOT_FOUND)
+            break;
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        g_device_protocols[device_id] = 0;
+        for (protocol_id = PROTOCOL_BASE + 1; protocol_id < PROTOCOL_MAX; protocol_id++)
+        {
+            if (!val_agent_check_protocol_support(protocol_id))
+                continue;
+
+            status = permission_set_protocol(agent_id, device_id, protocol_id,
+                                             FLAG_ACCESS_ALLOW);
+            if (status == SCMI_NOT_FOUND)
+                continue;
+            if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+                return VAL_STATUS_FAIL;
+            g_device_protocols[device_id] |= PROTOCOL_MASK(protocol_id);
+        }
+    }
+    g_num_devices = device_id;
+
+    return VAL_STATUS_PASS;
+}
+
+/* Every implemented command of a denied protocol must be refused, the
+ * others must stay usable and the base protocol is never denied */
+static uint32_t permission_check_access(uint32_t denied_protocols)
+{
+    uint32_t protocol_id, message_id, messages;
+    int32_t  status;
+
+    if (val_compare_status(permission_command(PROTOCOL_BASE, BASE_PROTOCOL_VERSION, 0, NULL),
+                           SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    for (protocol_id = PROTOCOL_BASE + 1; protocol_id < PROTOCOL_MAX; protocol_id++)
+    {
+        messages = g_protocol_messages[protocol_id - PROTOCOL_BASE];
+        if (messages == 0)
+            continue;
+
+        if (!(denied_protocols & PROTOCOL_MASK(protocol_id))) {
+            status = permission_command(protocol_id, 0x0, 0, NULL);
+            if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS) {
+                val_print(VAL_PRINT_ERR, "\n       Protocol 0x%x not accessible", protocol_id);
+                return VAL_STATUS_FAIL;
+            }
+            continue;
+        }
+
+        for (message_id = 0; message_id < PERMISSION_MAX_MESSAGES; message_id++)
+        {
+            if (!(messages & (1u << message_id)))
+                continue;
+
+            status = permission_command(protocol_id, message_id, 0, NULL);
+            g_num_enforced++;
+            if (val_compare_status(status, SCMI_DENIED) != VAL_STATUS_PASS) {
+                val_print(VAL_PRINT_ERR, "\n       Protocol 0x%x command 0x%x not denied",
+                          protocol_id, message_id);
+                return VAL_STATUS_FAIL;
+            }
+        }
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t permission_sweep_agent(uint32_t agent_id, uint32_t self)
+{
+    uint32_t device_id, protocol_id, exposed = 0;
+
+    for (device_id = 0; device_id < g_num_devices; device_id++)
+    {
+        if (val_compare_status(permission_set_device(agent_id, device_id, FLAG_ACCESS_DENY),
+                               SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        exposed |= g_device_protocols[device_id];
+    }
+    if (permission_check_access(self ? exposed : 0) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_status(permission_reset_agent(agent_id), SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+    if (permission_check_access(0) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    for (protocol_id = PROTOCOL_BASE + 1; protocol_id < PROTOCOL_MAX; protocol_id++)
+    {
+        if (!(exposed & PROTOCOL_MASK(protocol_id)))
+            continue;
+
+        for (device_id = 0; device_id < g_num_devices; device_id++)
+        {
+            if (!(g_device_protocols[device_id] & PROTOCOL_MASK(protocol_id)))
+                continue;
+            if (val_compare_status(permission_set_protocol(agent_id, device_id, protocol_id,
+                                   FLAG_ACCESS_DENY), SCMI_SUCCESS) != VAL_STATUS_PASS)
+                return VAL_STATUS_FAIL;
+        }
+        if (permission_check_access(self ? PROTOCOL_MASK(protocol_id) : 0) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        for (device_id = 0; device_id < g_num_devices; device_id++)
+        {
+            if (!(g_device_protocols[device_id] & PROTOCOL_MASK(protocol_id)))
+                continue;
+            if (val_compare_status(permission_set_protocol(agent_id, device_id, protocol_id,
+                                   FLAG_ACCESS_ALLOW), SCMI_SUCCESS) != VAL_STATUS_PASS)
+                return VAL_STATUS_FAIL;
+        }
+        if (permission_check_access(0) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+static void permission_time_version(VAL_HIST_s *hist, uint32_t protocol_id, int32_t expected)
+{
+    uint32_t i;
+    uint64_t start_ns;
+
+    val_hist_reset(hist);
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start_ns = val_get_time_ns();
+        if (permission_command(protocol_id, 0x0, 0, NULL) != expected)
+            return;
+        val_hist_add(hist, val_get_time_ns() - start_ns);
+    }
+}
+
+/* Deny every other agent every device, or reset them back to full access */
+static void permission_set_others(uint32_t num_agents, uint32_t self, uint32_t flags)
+{
+    uint32_t agent_id, device_id;
+
+    for (agent_id = 0; agent_id <= num_agents; agent_id++)
+    {
+        if (agent_id == self)
+            continue;
+
+        if (flags == FLAG_ACCESS_ALLOW) {
+            permission_reset_agent(agent_id);
+            continue;
+        }
+
+        for (device_id = 0; device_id < g_num_devices; device_id++)
+            permission_set_device(agent_id, device_id, FLAG_ACCESS_DENY);
+    }
+}
+
+static uint32_t permission_benchmark(uint32_t num_agents, uint32_t self)
+{
+    uint32_t protocol_id, device_id;
+    uint64_t base_p50, allowed_p50;
+
+    permission_time_version(&g_base_latency, PROTOCOL_BASE, SCMI_SUCCESS);
+    base_p50 = val_hist_percentile(&g_base_latency, 50);
+
+    val_print(VAL_PRINT_ERR, "\n       PROTOCOL_VERSION p50 ns, base protocol %llu",
+              (unsigned long long)base_p50);
+    val_print(VAL_PRINT_ERR, "\n       protocol    allowed     loaded     denied   check cost");
+    for (protocol_id = PROTOCOL_BASE + 1; protocol_id < PROTOCOL_MAX; protocol_id++)
+    {
+        if (g_protocol_messages[protocol_id - PROTOCOL_BASE] == 0)
+            continue;
+
+        val_hist_reset(&g_denied_latency);
+        permission_time_version(&g_allowed_latency, protocol_id, SCMI_SUCCESS);
+
+        val_hist_reset(&g_loaded_latency);
+        if (SWEEP_ALL_AGENTS) {
+            permission_set_others(num_agents, self, FLAG_ACCESS_DENY);
+            permission_time_version(&g_loaded_latency, protocol_id, SCMI_SUCCESS);
+            permission_set_others(num_agents, self, FLAG_ACCESS_ALLOW);
+        }
+
+        for (device_id = 0; device_id < g_num_devices; device_id++)
+        {
+            if (g_device_protocols[device_id] & PROTOCOL_MASK(protocol_id))
+                permission_set_protocol(self, device_id, protocol_id, FLAG_ACCESS_DENY);
+        }
+        if (g_num_devices)
+            permission_time_version(&g_denied_latency, protocol_id, SCMI_DENIED);
+        if (permission_reset_agent(self) != SCMI_SUCCESS)
+            return VAL_STATUS_FAIL;
+
+        if ((g_allowed_latency.count < BENCH_ITERATIONS) ||
+            (SWEEP_ALL_AGENTS && (g_loaded_latency.count < BENCH_ITERATIONS))) {
+            val_print(VAL_PRINT_ERR, "\n       Protocol 0x%x failed while timed", protocol_id);
+            return VAL_STATUS_FAIL;
+        }
+
+        allowed_p50 = val_hist_percentile(&g_allowed_latency, 50);
+        val_print(VAL_PRINT_ERR, "\n       0x%x %13llu", protocol_id,
+                  (unsigned long long)allowed_p50);
+        if (g_loaded_latency.count)
+            val_print(VAL_PRINT_ERR, " %10llu",
+                      (unsigned long long)val_hist_percentile(&g_loaded_latency, 50));
+        else
+            val_print(VAL_PRINT_ERR, "          -");
+        val_print(VAL_PRINT_ERR, " %10llu %12lld",
+                  (unsigned long long)val_hist_percentile(&g_denied_latency, 50),
+                  (long long)allowed_p50 - (long long)base_p50);
+    }
+    val_print(VAL_PRINT_ERR, "\n       permission command p50 %llu p99 %llu max %llu ns",
+              (unsigned long long)val_hist_percentile(&g_permission_latency, 50),
+              (unsigned long long)val_hist_percentile(&g_permission_latency, 99),
+              (unsigned long long)g_permission_latency.max);
+
+    return VAL_STATUS_PASS;
+}
+
+uint32_t base_permission_matrix_sweep(void)
+{
+    uint32_t self, num_agents, agent_id, result;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    self = val_base_get_info(BASE_TEST_AGENT_ID);
+    num_agents = val_base_get_info(BASE_NUM_AGENTS);
+
+    /* If agent is not trusted , skip the test */
+    if (val_check_trusted_agent(self) == 0) {
+        val_print(VAL_PRINT_ERR, "\n       Calling agent is untrusted agent            ");
+        return VAL_STATUS_SKIP;
+    }
+
+    if (!permission_supported(BASE_SET_DEVICE_PERMISSIONS) ||
+        !permission_supported(BASE_SET_PROTOCOL_PERMISSIONS) ||
+        !permission_supported(BASE_RESET_AGENT_CONFIGURATION)) {
+        val_print(VAL_PRINT_ERR, "\n       Permission commands not supported           ");
+        return VAL_STATUS_SKIP;
+    }
+
+    val_hist_reset(&g_permission_latency);
+    g_num_enforced = 0;
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 1] Discover protocol commands and devices");
+    val_bench_quiet_begin();
+    permission_discover_messages();
+    result = permission_discover_devices(self);
+    val_bench_quiet_end();
+    if (result != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    val_print(VAL_PRINT_DEBUG, "\n       NUM DEVICES    : %d", g_num_devices);
+    if (g_num_devices == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No device found                             ");
+        return VAL_STATUS_SKIP;
+    }
+
+    if (SWEEP_ALL_AGENTS)
+        val_print(VAL_PRINT_TEST, "\n     [Check 2] Sweep permissions across %d agents",
+                  num_agents + 1);
+    else
+        val_print(VAL_PRINT_TEST, "\n     [Check 2] Sweep permissions of the calling agent");
+    for (agent_id = 0; agent_id <= num_agents; agent_id++)
+    {
+        if (!SWEEP_ALL_AGENTS && (agent_id != self))
+            continue;
+
+        val_bench_quiet_begin();
+        /* Agents the platform does not let us configure are left out */
+        result = VAL_STATUS_PASS;
+        if (permission_reset_agent(agent_id) != SCMI_NOT_FOUND) {
+            result = permission_sweep_agent(agent_id, agent_id == self);
+            permission_reset_agent(agent_id);
+        }
+        val_bench_quiet_end();
+        if (result != VAL_STATUS_PASS) {
+            val_print(VAL_PRINT_ERR, "\n       Sweep of agent %d failed", agent_id);
+            return VAL_STATUS_FAIL;
+        }
+    }
+    val_print(VAL_PRINT_ERR, "\n       %d denied commands checked", g_num_enforced);
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_WARN, "\n       No time source, enforcement cost not measured");
+        return VAL_STATUS_PASS;
+    }
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 3] Measure enforcement cost");
+    val_bench_quiet_begin();
+    result = permission_benchmark(num_agents, self);
+    if (SWEEP_ALL_AGENTS)
+        permission_set_others(num_agents, self, FLAG_ACCESS_ALLOW);
+    permission_reset_agent(self);
+    val_bench_quiet_end();
+
+    return result;
+}
@@ -0,0 +1,133 @@
+/** @file
+ * Copyright (c) 2019-2020, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_base.h"
+#include "val_benchmark.h"
+
+#define TEST_NUM  (SCMI_BASE_TEST_NUM_BASE + 19)
+#define TEST_DESC "Base command completion mode latency check   "
+
+#define BENCH_ITERATIONS        1024
+#define NUM_COMPLETION_MODES    3
+
+/********* TEST ALGO ********************
+ * If there is no time source, skip the test
+ * For the interrupt, polled and adaptive completion modes
+ *   Select the mode, modes the transport does not support are reported
+ *   and left out. The interrupt mode is the default and must be accepted.
+ *   Send BENCH_ITERATIONS PROTOCOL_VERSION commands of the base protocol
+ *   and check each succeeds
+ *   Report round trip latency and, if the platform reports CPU time, the
+ *   CPU time per command and the share of the run the agent was busy
+ * Restore the interrupt completion mode
+*****************************************/
+
+static const char *g_mode_name[NUM_COMPLETION_MODES] = {
+    "INTERRUPT", "POLLED", "ADAPTIVE"
+};
+static VAL_HIST_s g_mode_latency[NUM_COMPLETION_MODES];
+
+static uint32_t completion_run(VAL_HIST_s *hist, uint64_t *cpu_ns, uint64_t *wall_ns)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t i;
+    uint64_t start_cpu_ns, start_ns, send_ns;
+
+    val_hist_reset(hist);
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_BASE, BASE_PROTOCOL_VERSION, COMMAND_MSG);
+
+    start_cpu_ns = val_get_cpu_time_ns();
+    start_ns = val_get_time_ns();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        send_ns = val_get_time_ns();
+        val_send_message(cmd_msg_hdr, param_count, NULL, &rsp_msg_hdr, &status,
+                         &return_value_count, return_values);
+        val_hist_add(hist, val_get_time_ns() - send_ns);
+
+        if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+    }
+    *wall_ns = val_get_time_ns() - start_ns;
+    *cpu_ns = val_get_cpu_time_ns() - start_cpu_ns;
+
+    return VAL_STATUS_PASS;
+}
+
+uint32_t base_completion_mode_latency(void)
+{
+    uint32_t mode, result;
+    uint64_t cpu_ns, wall_ns;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No time source, benchmark skipped         ");
+        return VAL_STATUS_SKIP;
+    }
+
+    val_print(VAL_PRINT_ERR, "\n       mode          p50 ns     p99 ns     max ns   cpu ns/cmd  busy %%");
+    for (mode = 0; mode < NUM_COMPLETION_MODES; mode++)
+    {
+        val_print(VAL_PRINT_TEST, "\n     [Check %d] %s completion", mode + 1, g_mode_name[mode]);
+        if (val_set_completion_mode(mode) != VAL_STATUS_PASS) {
+            val_print(VAL_PRINT_ERR, "\n       %-9s     not supported by the transport",
+                      g_mode_name[mode]);
+            if (mode == VAL_COMPLETION_INTERRUPT)
+                return VAL_STATUS_FAIL;
+            continue;
+        }
+
+        val_bench_quiet_begin();
+        result = completion_run(&g_mode_latency[mode], &cpu_ns, &wall_ns);
+        val_bench_quiet_end();
+        if (result != VAL_STATUS_PASS) {
+            val_set_completion_mode(VAL_COMPLETION_INTERRUPT);
+            return VAL_STATUS_FAIL;
+        }
+
+        if ((cpu_ns == 0) || (wall_ns == 0))
+            val_print(VAL_PRINT_ERR, "\n       %-9s %10llu %10llu %10llu          n/a     n/a",
+                      g_mode_name[mode],
+                      (unsigned long long)val_hist_percentile(&g_mode_latency[mode], 50),
+                      (unsigned long long)val_hist_percentile(&g_mode_latency[mode], 99),
+                      (unsigned long long)g_mode_latency[mode].max);
+        else
+            val_print(VAL_PRINT_ERR, "\n       %-9s %10llu %10llu %10llu %12llu %7llu",
+                      g_mode_name[mode],
+                      (unsigned long long)val_hist_percentile(&g_mode_latency[mode], 50),
+                      (unsigned long long)val_hist_percentile(&g_mode_latency[mode], 99),
+                      (unsigned long long)g_mode_latency[mode].max,
+                      (unsigned long long)(cpu_ns / BENCH_ITERATIONS),
+                      (unsigned long long)((cpu_ns * 100) / wall_ns));
+        val_hist_print_buckets(VAL_PRINT_DEBUG, &g_mode_latency[mode]);
+    }
+
+    val_set_completion_mode(VAL_COMPLETION_INTERRUPT);
+
+    return VAL_STATUS_PASS;
+}
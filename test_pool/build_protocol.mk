@@ -26,7 +26,7 @@ all_test: $(OBJS)
 
 $(TEST_OBJ_DIR)/%.o: %.c $(H_FILES)
 	@echo "$(CC) $(D_NAMES) $(CFLAGS) $(I_DIRS) -c $< -o $@"
-	$(CC) $(D_NAMES) $(CFLAGS) $(I_DIRS) -g -c $< -o $@
+	$(CC) $(D_NAMES) $(CFLAGS) $(FILE_ID) $(I_DIRS) -g -c $< -o $@
 
 clean: clean_test
 
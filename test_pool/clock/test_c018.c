@@ -0,0 +1,354 @@
+/** @file
+ * Copyright (c) 2020, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_clock.h"
+#include "val_benchmark.h"
+
+#define TEST_NUM  (SCMI_CLOCK_TEST_NUM_BASE + 18)
+#define TEST_DESC "Clock async rate change saturation check     "
+
+#define PARAMETER_SIZE        4
+#define MAX_PENDING_TRACKED   64
+/* Requests issued past the advertised pending limit */
+#define OVER_LIMIT_REQUESTS   4
+#define BENCH_RATE_CHANGES    256
+
+/********* TEST ALGO ********************
+ * If async rate change is not supported or there is no time source,
+ * skip the test
+ * Save the current rate of every clock
+ * Issue async CLOCK_RATE_SET round robin across the clocks, alternating
+ * between the lowest and highest rate, up to the advertised pending limit
+ * and OVER_LIMIT_REQUESTS past it without collecting delayed responses
+ *   Requests within the limit must succeed, requests past it should
+ *   return BUSY
+ * Collect the delayed responses and match each to an accepted request by
+ * clock id and rate
+ * Keep the pending limit full for BENCH_RATE_CHANGES changes and report
+ * completion throughput, request to completion latency and BUSY retries
+ * Restore the saved rates
+*****************************************/
+
+typedef struct {
+    uint32_t clock_id;
+    uint64_t rate;
+    uint64_t send_ns;
+} ASYNC_RATE_REQ_s;
+
+static ASYNC_RATE_REQ_s g_pending[MAX_PENDING_TRACKED + OVER_LIMIT_REQUESTS];
+static uint32_t g_num_pending;
+static uint32_t g_num_reordered;
+static uint32_t g_next_highest[MAX_NUM_OF_CLOCKS];
+static uint64_t g_saved_rate[MAX_NUM_OF_CLOCKS];
+static VAL_HIST_s g_completion_latency;
+
+static int32_t clock_saturation_get_rate(uint32_t clock_id, uint64_t *rate)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    param_count++;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_CLOCK, CLOCK_RATE_GET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, &clock_id, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    *rate = VAL_GET_64BIT_DATA(return_values[RATE_UPPER_WORD_OFFSET],
+                               return_values[RATE_LOWER_WORD_OFFSET]);
+    return status;
+}
+
+static int32_t clock_saturation_set_rate(uint32_t flags, uint32_t clock_id, uint64_t rate)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = flags;
+    parameters[param_count++] = clock_id;
+    parameters[param_count++] = (uint32_t)(rate & MASK_FOR_LOWER_WORD);
+    parameters[param_count++] = (uint32_t)((rate & MASK_FOR_UPPER_WORD) >> 32);
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_CLOCK, CLOCK_RATE_SET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+/* Issue the next async change for a clock, tracking it if it is accepted */
+static int32_t clock_saturation_issue(uint32_t clock_id)
+{
+    ASYNC_RATE_REQ_s *req = &g_pending[g_num_pending];
+    int32_t status;
+
+    req->clock_id = clock_id;
+    req->rate = val_clock_get_rate(g_next_highest[clock_id] ? CLOCK_HIGHEST_RATE :
+                                   CLOCK_LOWEST_RATE, clock_id);
+    req->send_ns = val_get_time_ns();
+    status = clock_saturation_set_rate(CLOCK_SET_ASYNC_MODE, clock_id, req->rate);
+    if (status == SCMI_SUCCESS) {
+        g_next_highest[clock_id] = !g_next_highest[clock_id];
+        g_num_pending++;
+    }
+
+    return status;
+}
+
+/*
+ * Take one CLOCK_RATE_SET delayed response and match it to the oldest
+ * accepted request for the same clock and rate
+ */
+static uint32_t clock_saturation_complete(void)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t clock_id, i, first_for_clock;
+    uint64_t rate, recv_ns;
+
+    rsp_msg_hdr = 0;
+    return_value_count = 0;
+    status = SCMI_GENERIC_ERROR;
+    val_receive_delayed_response(&rsp_msg_hdr, &status, &return_value_count, return_values);
+    recv_ns = val_get_time_ns();
+
+    if (val_compare("PROTOCOL ID", VAL_EXTRACT_BITS(rsp_msg_hdr, 10, 17), PROTOCOL_CLOCK))
+        return VAL_STATUS_FAIL;
+    if (val_compare("MSG TYPE   ", VAL_EXTRACT_BITS(rsp_msg_hdr, 8, 9), DELAYED_RESPONSE_MSG))
+        return VAL_STATUS_FAIL;
+    if (val_compare("MSG ID     ", VAL_EXTRACT_BITS(rsp_msg_hdr, 0, 7),
+                    CLOCK_RATE_SET_COMPLETE))
+        return VAL_STATUS_FAIL;
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    clock_id = return_values[DELAYED_RESP_CLOCK_ID_OFFSET];
+    rate = VAL_GET_64BIT_DATA(return_values[DELAYED_RESP_RATE_UPPER_OFFSET],
+                              return_values[DELAYED_RESP_RATE_LOWER_OFFSET]);
+
+    first_for_clock = g_num_pending;
+    for (i = 0; i < g_num_pending; i++)
+    {
+        if (g_pending[i].clock_id != clock_id)
+            continue;
+        if (first_for_clock == g_num_pending)
+            first_for_clock = i;
+        if (g_pending[i].rate == rate)
+            break;
+    }
+
+    if (i == g_num_pending) {
+        val_print(VAL_PRINT_ERR, "\n       No request for clock %d rate 0x%llX", clock_id,
+                  (unsigned long long)rate);
+        return VAL_STATUS_FAIL;
+    }
+    if (i != first_for_clock)
+        g_num_reordered++;
+
+    val_hist_add(&g_completion_latency, recv_ns - g_pending[i].send_ns);
+    for (; (i + 1) < g_num_pending; i++)
+        g_pending[i] = g_pending[i + 1];
+    g_num_pending--;
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t clock_saturation_burst(uint32_t num_clocks, uint32_t max_pending)
+{
+    uint32_t i, num_accepted = 0, num_busy = 0;
+    int32_t status;
+
+    for (i = 0; i < (max_pending + OVER_LIMIT_REQUESTS); i++)
+    {
+        status = clock_saturation_issue(i % num_clocks);
+        if (status == SCMI_SUCCESS) {
+            num_accepted++;
+            continue;
+        }
+        if (status != SCMI_BUSY) {
+            val_compare_status(status, SCMI_BUSY);
+            return VAL_STATUS_FAIL;
+        }
+        if (i < max_pending) {
+            val_print(VAL_PRINT_ERR, "\n       BUSY with only %d of %d changes pending", i,
+                      max_pending);
+            return VAL_STATUS_FAIL;
+        }
+        num_busy++;
+    }
+
+    val_print(VAL_PRINT_ERR, "\n       Burst of %d: %d accepted, %d BUSY", i, num_accepted,
+              num_busy);
+    if (num_busy == 0)
+        val_print(VAL_PRINT_WARN, "\n       WARNING: no BUSY past the limit, changes completed "
+                  "during the burst");
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t clock_saturation_drain(void)
+{
+    while (g_num_pending)
+    {
+        if (clock_saturation_complete() != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t clock_saturation_bench(uint32_t num_clocks, uint32_t max_pending)
+{
+    uint32_t num_issued = 0, num_completed = 0, num_busy = 0, clock_id = 0;
+    uint64_t start, elapsed;
+    int32_t status;
+
+    val_hist_reset(&g_completion_latency);
+    start = val_get_time_ns();
+    while (num_completed < BENCH_RATE_CHANGES)
+    {
+        while ((num_issued < BENCH_RATE_CHANGES) && (g_num_pending < max_pending))
+        {
+            status = clock_saturation_issue(clock_id);
+            if (status == SCMI_BUSY) {
+                num_busy++;
+                break;
+            }
+            if (status != SCMI_SUCCESS) {
+                val_compare_status(status, SCMI_SUCCESS);
+                return VAL_STATUS_FAIL;
+            }
+            num_issued++;
+            clock_id = (clock_id + 1) % num_clocks;
+        }
+
+        if (g_num_pending == 0) {
+            val_print(VAL_PRINT_ERR, "\n       BUSY with no change pending");
+            return VAL_STATUS_FAIL;
+        }
+        if (clock_saturation_complete() != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        num_completed++;
+    }
+    elapsed = val_get_time_ns() - start;
+
+    val_print(VAL_PRINT_ERR, "\n       %d changes over %d clocks, %d pending at most",
+              num_completed, num_clocks, max_pending);
+    val_print(VAL_PRINT_ERR, "\n         elapsed          %10llu us",
+              (unsigned long long)(elapsed / NS_PER_US));
+    val_print(VAL_PRINT_ERR, "\n         throughput       %10llu changes per s",
+              (unsigned long long)(elapsed ? (num_completed * NS_PER_SEC) / elapsed : 0));
+    val_print(VAL_PRINT_ERR, "\n         BUSY retries     %10d", num_busy);
+    val_print(VAL_PRINT_ERR, "\n         out of order     %10d", g_num_reordered);
+    val_print(VAL_PRINT_ERR, "\n         completion       p50 %llu p99 %llu max %llu ns",
+              (unsigned long long)val_hist_percentile(&g_completion_latency, 50),
+              (unsigned long long)val_hist_percentile(&g_completion_latency, 99),
+              (unsigned long long)g_completion_latency.max);
+
+    return VAL_STATUS_PASS;
+}
+
+uint32_t clock_rate_set_async_saturation_check(void)
+{
+    uint32_t num_clocks, max_pending, clock_id, result;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    max_pending = val_clock_get_info(CLOCK_MAX_PENDING_ASYNC_CMD, 0);
+    if (max_pending == 0) {
+        val_print(VAL_PRINT_ERR, "\n       Async rate change is not supported          ");
+        return VAL_STATUS_SKIP;
+    }
+    if (max_pending > MAX_PENDING_TRACKED)
+        max_pending = MAX_PENDING_TRACKED;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No time source, saturation skipped          ");
+        return VAL_STATUS_SKIP;
+    }
+
+    num_clocks = val_clock_get_info(NUM_CLOCKS, 0);
+    if (num_clocks == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Clock found                              ");
+        return VAL_STATUS_SKIP;
+    }
+    if (num_clocks > MAX_NUM_OF_CLOCKS)
+        num_clocks = MAX_NUM_OF_CLOCKS;
+    val_print(VAL_PRINT_DEBUG, "\n       NUM CLOCKS     : %d", num_clocks);
+    val_print(VAL_PRINT_DEBUG, "\n       MAX PENDING    : %d", max_pending);
+
+    for (clock_id = 0; clock_id < num_clocks; clock_id++)
+    {
+        if (val_compare_status(clock_saturation_get_rate(clock_id, &g_saved_rate[clock_id]),
+                               SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        g_next_highest[clock_id] =
+            (g_saved_rate[clock_id] == val_clock_get_rate(CLOCK_LOWEST_RATE, clock_id));
+    }
+
+    g_num_pending = 0;
+    g_num_reordered = 0;
+    val_hist_reset(&g_completion_latency);
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 1] Issue async rate changes past the limit");
+    val_bench_quiet_begin();
+    result = clock_saturation_burst(num_clocks, max_pending);
+    val_bench_quiet_end();
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 2] Match delayed responses to requests");
+    val_bench_quiet_begin();
+    if (clock_saturation_drain() != VAL_STATUS_PASS)
+        result = VAL_STATUS_FAIL;
+    val_bench_quiet_end();
+
+    if (result == VAL_STATUS_PASS) {
+        val_print(VAL_PRINT_TEST, "\n     [Check 3] Completion throughput at the limit");
+        val_bench_quiet_begin();
+        if ((clock_saturation_bench(num_clocks, max_pending) != VAL_STATUS_PASS) ||
+            (clock_saturation_drain() != VAL_STATUS_PASS))
+            result = VAL_STATUS_FAIL;
+        val_bench_quiet_end();
+    }
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 4] Restore the default rates");
+    for (clock_id = 0; clock_id < num_clocks; clock_id++)
+    {
+        if (val_compare_status(clock_saturation_set_rate(CLOCK_SET_SYNC_MODE, clock_id,
+                               g_saved_rate[clock_id]), SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+    }
+
+    return result;
+}
@@ -17,6 +17,7 @@
 
 #include "val_interface.h"
 #include "val_performance.h"
+#include "val_schema.h"
 
 #define TEST_NUM  (SCMI_PERFORMANCE_TEST_NUM_BASE + 2)
 #define TEST_DESC "Performance protocol attributes check        "
@@ -30,7 +31,8 @@ uint32_t performance_query_protocol_attributes(void)
     size_t   return_value_count;
     uint32_t return_values[MAX_RETURNS_SIZE];
     uint32_t *parameters;
-    uint32_t attributes, num_perf_domains, stats_addr_low, stats_addr_high, stats_len;
+    uint32_t num_perf_domains;
+    PROTOCOL_ATTRIBUTES_STATS_VIEW_s *attr;
 
     if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
         return VAL_STATUS_SKIP;
@@ -54,38 +56,39 @@ uint32_t performance_query_protocol_attributes(void)
 
     val_print_return_values(return_value_count, return_values);
 
-    attributes = return_values[ATTRIBUTE_OFFSET];
-    if (val_reserved_bits_check_is_zero(VAL_EXTRACT_BITS(attributes, 17, 31) != VAL_STATUS_PASS))
+    attr = val_decode_response(rsp_msg_hdr, return_value_count, return_values);
+    if (attr == NULL)
         return VAL_STATUS_FAIL;
 
-    val_print(VAL_PRINT_INFO, "\n       PWR VAL in Mw  : %d", VAL_EXTRACT_BITS(attributes, 16, 16));
+    val_print(VAL_PRINT_INFO, "\n       PWR VAL in Mw  : %d",
+              VAL_SCHEMA_BITS(attr->attributes, PERF_ATTR_POWER_MW));
+    val_performance_save_info(PERF_POWER_VALUES_MW, 0x00,
+                              VAL_SCHEMA_BITS(attr->attributes, PERF_ATTR_POWER_MW));
 
     /* Compare & save the number of performance domains */
-    num_perf_domains = VAL_EXTRACT_BITS(attributes, 0, 15);
+    num_perf_domains = VAL_SCHEMA_BITS(attr->attributes, PERF_ATTR_NUM_DOMAINS);
     if (val_compare("NUM PERF DOMAINS", num_perf_domains,
                      val_performance_get_expected_num_domains()))
         return VAL_STATUS_FAIL;
-    val_performance_save_info(NUM_PERF_DOMAINS, 0x00, VAL_EXTRACT_BITS(attributes, 0, 15));
+    val_performance_save_info(NUM_PERF_DOMAINS, 0x00, num_perf_domains);
 
     /* Compare & save  the performance statistics memory lower address */
-    stats_addr_low = return_values[STATS_ADDR_LOW_OFFSET];
-    if (val_compare("STATS ADDR LOW  ", stats_addr_low,
+    if (val_compare("STATS ADDR LOW  ", attr->stats_addr_low,
                     val_performance_get_expected_stats_addr_low()))
         return VAL_STATUS_FAIL;
-    val_performance_save_info(PERF_STATS_ADDR_LOW, 0x00, stats_addr_low);
+    val_performance_save_info(PERF_STATS_ADDR_LOW, 0x00, attr->stats_addr_low);
 
     /* Compare & save the performance statistics memory higher address */
-    stats_addr_high = return_values[STATS_ADDR_HIGH_OFFSET];
-    if (val_compare("STATS ADDR HIGH ", stats_addr_high,
+    if (val_compare("STATS ADDR HIGH ", attr->stats_addr_high,
                      val_performance_get_expected_stats_addr_high()))
         return VAL_STATUS_FAIL;
-    val_performance_save_info(PERF_STATS_ADDR_HIGH, 0x00, stats_addr_high);
+    val_performance_save_info(PERF_STATS_ADDR_HIGH, 0x00, attr->stats_addr_high);
 
     /* Compare & save the performance statistics memory length */
-    stats_len = return_values[STATS_LENGTH_OFFSET];
-    if (val_compare("STATS ADDR LEN  ", stats_len, val_performance_get_expected_stats_addr_len()))
+    if (val_compare("STATS ADDR LEN  ", attr->stats_len,
+                    val_performance_get_expected_stats_addr_len()))
         return VAL_STATUS_FAIL;
-    val_performance_save_info(PERF_STATS_ADDR_LEN, 0x00, stats_len);
+    val_performance_save_info(PERF_STATS_ADDR_LEN, 0x00, attr->stats_len);
 
     return VAL_STATUS_PASS;
 }
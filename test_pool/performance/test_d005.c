@@ -17,6 +17,7 @@
 
 #include "val_interface.h"
 #include "val_performance.h"
+#include "val_schema.h"
 
 #define TEST_NUM  (SCMI_PERFORMANCE_TEST_NUM_BASE + 5)
 #define TEST_DESC "Performance domain attributes check          "
@@ -30,6 +31,7 @@ uint32_t performance_query_domain_attributes(void)
     size_t   return_value_count;
     uint32_t return_values[MAX_RETURNS_SIZE];
     uint32_t domain_id, num_domains, attribute;
+    PERF_DOMAIN_ATTRIBUTES_VIEW_s *attr;
 
     if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
         return VAL_STATUS_SKIP;
@@ -62,47 +64,48 @@ uint32_t performance_query_domain_attributes(void)
 
         val_print_return_values(return_value_count, return_values);
 
-        attribute = return_values[ATTRIBUTE_OFFSET];
-        if (val_reserved_bits_check_is_zero(VAL_EXTRACT_BITS(attribute, 0, 26)) != VAL_STATUS_PASS)
+        attr = val_decode_response(rsp_msg_hdr, return_value_count, return_values);
+        if (attr == NULL)
             return VAL_STATUS_FAIL;
 
+        attribute = attr->attributes;
+
         val_print(VAL_PRINT_INFO, "\n       SET LIMIT SUPPORT         : %d",
-                                   VAL_EXTRACT_BITS(attribute, 31, 31));
+                                   VAL_SCHEMA_BITS(attribute, PERF_DOMAIN_ATTR_SET_LIMIT));
         val_performance_save_info(PERF_DOMAIN_SET_PERFORMANCE_LIMIT_SUPPORT, domain_id,
-                                  VAL_EXTRACT_BITS(attribute, 31, 31));
+                                  VAL_SCHEMA_BITS(attribute, PERF_DOMAIN_ATTR_SET_LIMIT));
 
         val_print(VAL_PRINT_INFO, "\n       SET LEVEL SUPPORT         : %d",
-                                   VAL_EXTRACT_BITS(attribute, 30, 30));
+                                   VAL_SCHEMA_BITS(attribute, PERF_DOMAIN_ATTR_SET_LEVEL));
         val_performance_save_info(PERF_DOMAIN_SET_PERFORMANCE_LEVEL_SUPPORT, domain_id,
-                                  VAL_EXTRACT_BITS(attribute, 30, 30));
+                                  VAL_SCHEMA_BITS(attribute, PERF_DOMAIN_ATTR_SET_LEVEL));
 
         val_print(VAL_PRINT_INFO, "\n       LIMIT CHANGE NOTIFY SUPPORT: %d",
-                                   VAL_EXTRACT_BITS(attribute, 29, 29));
+                                   VAL_SCHEMA_BITS(attribute, PERF_DOMAIN_ATTR_LIMIT_NOTIFY));
         val_performance_save_info(PERF_DOMAIN_LIMIT_CHANGE_NTFY_SUPPORT, domain_id,
-                                  VAL_EXTRACT_BITS(attribute, 29, 29));
+                                  VAL_SCHEMA_BITS(attribute, PERF_DOMAIN_ATTR_LIMIT_NOTIFY));
 
         val_print(VAL_PRINT_INFO, "\n       LEVEL CHANGE NOTIFY SUPPORT: %d",
-                                   VAL_EXTRACT_BITS(attribute, 28, 28));
+                                   VAL_SCHEMA_BITS(attribute, PERF_DOMAIN_ATTR_LEVEL_NOTIFY));
         val_performance_save_info(PERF_DOMAIN_LVL_CHANGE_NTFY_SUPPORT, domain_id,
-                                  VAL_EXTRACT_BITS(attribute, 28, 28));
+                                  VAL_SCHEMA_BITS(attribute, PERF_DOMAIN_ATTR_LEVEL_NOTIFY));
 
         val_print(VAL_PRINT_INFO, "\n       FAST CHANNEL SUPPORT       : %d",
-                                   VAL_EXTRACT_BITS(attribute, 27, 27));
+                                   VAL_SCHEMA_BITS(attribute, PERF_DOMAIN_ATTR_FAST_CHANNEL));
         val_performance_save_info(PERF_DOMAIN_FAST_CH_SUPPORT, domain_id,
-                                  VAL_EXTRACT_BITS(attribute, 27, 27));
-
-        if (val_reserved_bits_check_is_zero(
-            VAL_EXTRACT_BITS(return_values[RATE_LIMIT_OFFSET], 20, 31)) != VAL_STATUS_PASS)
-            return VAL_STATUS_FAIL;
+                                  VAL_SCHEMA_BITS(attribute, PERF_DOMAIN_ATTR_FAST_CHANNEL));
 
         val_print(VAL_PRINT_INFO, "\n       RATE LIMIT                : %d",
-                                   VAL_EXTRACT_BITS(return_values[RATE_LIMIT_OFFSET], 0, 19));
+                                   VAL_SCHEMA_BITS(attr->rate_limit, PERF_RATE_LIMIT));
         val_print(VAL_PRINT_INFO, "\n       SUSTAINED FREQENCY        : %d",
-                                   return_values[FREQUENCY_OFFSET]);
+                                   attr->sustained_freq);
+        val_performance_save_info(PERF_DOMAIN_SUSTAINED_FREQ, domain_id, attr->sustained_freq);
         val_print(VAL_PRINT_INFO, "\n       SUSTAINED LEVEL           : %d",
-                                   return_values[SUSTAINED_LEVEL_OFFSET]);
+                                   attr->sustained_level);
+        val_performance_save_info(PERF_DOMAIN_SUSTAINED_LEVEL, domain_id, attr->sustained_level);
+        val_performance_save_name(domain_id, attr->name);
 
-        if (val_compare_str("DOMAIN NAME", (char *)&return_values[NAME_OFFSET],
+        if (val_compare_str("DOMAIN NAME", (char *)attr->name,
                         (char *)val_performance_get_expected_name(domain_id), SCMI_NAME_STR_SIZE))
             return VAL_STATUS_FAIL;
     }
@@ -94,8 +94,13 @@ uint32_t performance_query_domain_attributes_v1(void)
                                    VAL_EXTRACT_BITS(return_values[RATE_LIMIT_OFFSET], 0, 19));
         val_print(VAL_PRINT_INFO, "\n       SUSTAINED FREQENCY        : %d",
                                    return_values[FREQUENCY_OFFSET]);
+        val_performance_save_info(PERF_DOMAIN_SUSTAINED_FREQ, domain_id,
+                                  return_values[FREQUENCY_OFFSET]);
         val_print(VAL_PRINT_INFO, "\n       SUSTAINED LEVEL           : %d",
                                    return_values[SUSTAINED_LEVEL_OFFSET]);
+        val_performance_save_info(PERF_DOMAIN_SUSTAINED_LEVEL, domain_id,
+                                  return_values[SUSTAINED_LEVEL_OFFSET]);
+        val_performance_save_name(domain_id, (uint8_t *)&return_values[NAME_OFFSET]);
 
         if (val_compare_str("DOMAIN NAME", (char *)&return_values[NAME_OFFSET],
                         (char *)val_performance_get_expected_name(domain_id), SCMI_NAME_STR_SIZE))
@@ -17,12 +17,12 @@
 
 #include "val_interface.h"
 #include "val_performance.h"
+#include "val_schema.h"
 
 #define TEST_NUM  (SCMI_PERFORMANCE_TEST_NUM_BASE + 7)
 #define TEST_DESC "Performance describe levels check            "
 
 #define PARAMETER_SIZE 2
-#define PERF_LEVEL_ARRAY_COUNT 3
 
 uint32_t performance_query_describe_levels(void)
 {
@@ -36,7 +36,7 @@ uint32_t performance_query_describe_levels(void)
     uint32_t i, perf_level, power_cost, latency, level_index, interm_level;
     uint32_t min_perf_level, max_perf_level;
     uint32_t parameters[PARAMETER_SIZE];
-    uint32_t *perf_level_array;
+    PERF_DESCRIBE_LEVELS_VIEW_s *levels;
 
     if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
         return VAL_STATUS_SKIP;
@@ -80,21 +80,20 @@ uint32_t performance_query_describe_levels(void)
 
             val_print_return_values(return_value_count, return_values);
 
-            num_remaining_levels = VAL_EXTRACT_BITS(return_values[NUM_LEVEL_OFFSET], 16, 31);
+            levels = val_decode_response(rsp_msg_hdr, return_value_count, return_values);
+            if (levels == NULL)
+                return VAL_STATUS_FAIL;
+
+            num_remaining_levels = VAL_SCHEMA_BITS(levels->num_levels, PERF_LEVELS_REMAINING);
             val_print(VAL_PRINT_DEBUG, "\n       NUM OF REMAINING LEVELS: %d",
                                          num_remaining_levels);
 
-            if (val_reserved_bits_check_is_zero(
-                VAL_EXTRACT_BITS(return_values[NUM_LEVEL_OFFSET], 12, 15)) != VAL_STATUS_PASS)
-                return VAL_STATUS_FAIL;
-
-            num_levels_retured = VAL_EXTRACT_BITS(return_values[NUM_LEVEL_OFFSET], 0, 11);
+            num_levels_retured = VAL_SCHEMA_BITS(levels->num_levels, PERF_LEVELS_RETURNED);
             val_print(VAL_PRINT_DEBUG, "\n       NUM OF LEVELS RETURNED : %d", num_levels_retured);
 
-            perf_level_array = &return_values[PERF_LEVEL_ARRAY_OFFSET];
             for (i = 0; i < num_levels_retured; i++)
             {
-                perf_level = perf_level_array[i*PERF_LEVEL_ARRAY_COUNT];
+                perf_level = levels->entry[i].level;
                 val_print(VAL_PRINT_DEBUG, "\n       PERFORMANCE LEVEL[%d]      : %08x",
                                             level_index + i, perf_level);
 
@@ -111,7 +110,7 @@ uint32_t performance_query_describe_levels(void)
                          * When only two levels are available, pick the
                          * minimum.
                          */
-                        interm_level = perf_level_array[0];
+                        interm_level = levels->entry[0].level;
                     } else {
                         interm_level = perf_level;
                     }
@@ -120,18 +119,15 @@ uint32_t performance_query_describe_levels(void)
                                                interm_level);
                 }
 
-                power_cost = perf_level_array[1 + (i * PERF_LEVEL_ARRAY_COUNT)];
+                power_cost = levels->entry[i].power_cost;
                 val_print(VAL_PRINT_DEBUG, "\n       PERFORMANCE POWER COST[%d] : %08x",
                                             level_index + i, power_cost);
 
-                latency = VAL_EXTRACT_BITS(perf_level_array[2 + (i * PERF_LEVEL_ARRAY_COUNT)],
-                                                           0, 15);
+                latency = VAL_SCHEMA_BITS(levels->entry[i].latency, PERF_LEVEL_LATENCY);
                 val_print(VAL_PRINT_DEBUG, "\n       PERFORMANCE LATENCY[%d]    : %08x",
                                             level_index + i, latency);
-
-                if (val_reserved_bits_check_is_zero(VAL_EXTRACT_BITS(
-                    perf_level_array[2 + (i * PERF_LEVEL_ARRAY_COUNT)], 16, 31)) != VAL_STATUS_PASS)
-                    return VAL_STATUS_FAIL;
+                val_performance_save_level(domain_id, level_index + i, perf_level,
+                                           power_cost, latency);
             }
         } while (num_remaining_levels > 0);
 
@@ -139,6 +135,8 @@ uint32_t performance_query_describe_levels(void)
                         val_performance_get_expected_number_of_level(domain_id)))
             return VAL_STATUS_FAIL;
 
+        val_performance_save_info(PERF_DOMAIN_NUM_LEVELS, domain_id,
+                                  level_index + num_levels_retured);
         val_performance_save_info(PERF_DOMAIN_MAX_LEVEL, domain_id, max_perf_level);
         val_performance_save_info(PERF_DOMAIN_MIN_LEVEL, domain_id, min_perf_level);
 
@@ -0,0 +1,105 @@
+/** @file
+ * Copyright (c) 2020, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_performance.h"
+#include "val_energy_model.h"
+
+#define TEST_NUM  (SCMI_PERFORMANCE_TEST_NUM_BASE + 30)
+#define TEST_DESC "Performance energy model export check        "
+
+/********* TEST ALGO ********************
+ * For each performance domain
+ *   Take the name, sustained frequency and sustained level saved from
+ *   PERFORMANCE_DOMAIN_ATTRIBUTES
+ *   Add every level, power cost and latency saved from
+ *   PERFORMANCE_DESCRIBE_LEVELS to the energy model, with its frequency
+ * Derive capacity and cost per OPP and flag OPPs whose power does not
+ * rise with the level, or that cost as much energy as a faster OPP.
+ * Flagged OPPs are reported, they are not a compliance failure.
+ * Print the model and export it as JSON and as a Linux energy model table
+ * if the app asked for it
+*****************************************/
+
+static ENERGY_MODEL_s g_energy_model;
+
+static uint32_t energy_model_add_domain(uint32_t domain_id)
+{
+    uint32_t num_levels, level, i;
+
+    val_energy_model_set_domain(&g_energy_model, domain_id, val_performance_get_name(domain_id),
+                                val_performance_get_info(PERF_DOMAIN_SUSTAINED_FREQ, domain_id),
+                                val_performance_get_info(PERF_DOMAIN_SUSTAINED_LEVEL, domain_id));
+
+    num_levels = val_performance_get_info(PERF_DOMAIN_NUM_LEVELS, domain_id);
+    if (num_levels == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No levels saved for domain %d", domain_id);
+        return VAL_STATUS_FAIL;
+    }
+    if (num_levels > MAX_PERFORMANCE_LEVELS) {
+        val_print(VAL_PRINT_ERR, "\n       More than %d levels, rest left out",
+                  MAX_PERFORMANCE_LEVELS);
+        num_levels = MAX_PERFORMANCE_LEVELS;
+    }
+
+    for (i = 0; i < num_levels; i++)
+    {
+        level = val_performance_get_level(domain_id, i);
+        val_energy_model_add_opp(&g_energy_model, domain_id, level,
+                                 val_performance_level_to_khz(domain_id, level),
+                                 val_performance_get_level_power(domain_id, i),
+                                 val_performance_get_level_latency(domain_id, i));
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+uint32_t performance_energy_model_export(void)
+{
+    uint32_t num_domains, domain_id, num_flagged;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    num_domains = val_performance_get_info(NUM_PERF_DOMAINS, 0x00);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No performance domains found                ");
+        return VAL_STATUS_SKIP;
+    }
+    if (num_domains > MAX_PERFORMANCE_DOMAINS)
+        num_domains = MAX_PERFORMANCE_DOMAINS;
+
+    val_energy_model_init(&g_energy_model, val_performance_get_info(PERF_POWER_VALUES_MW, 0x00));
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 1] Collect the saved levels of every domain");
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        val_print(VAL_PRINT_DEBUG, "\n       PERFORMANCE DOMAIN ID: %d", domain_id);
+        if (energy_model_add_domain(domain_id) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+    }
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 2] Build and export the energy model");
+    num_flagged = val_energy_model_build(&g_energy_model);
+    val_energy_model_print(VAL_PRINT_ERR, &g_energy_model);
+    if (num_flagged)
+        val_print(VAL_PRINT_WARN, "\n       %d OPPs would be skipped by energy aware scheduling",
+                  num_flagged);
+    val_energy_model_export(&g_energy_model);
+
+    return VAL_STATUS_PASS;
+}
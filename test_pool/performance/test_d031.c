@@ -0,0 +1,342 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_performance.h"
+#include "val_benchmark.h"
+
+#define TEST_NUM  (SCMI_PERFORMANCE_TEST_NUM_BASE + 31)
+#define TEST_DESC "Performance request rate limit throttling    "
+
+#define PARAMETER_SIZE          3
+#define REQUESTS_PER_INTERVAL   32
+/* Window used to pace requests when the domain advertises no rate limit */
+#define DEFAULT_WINDOW_NS       (100 * NS_PER_US)
+/* Time allowed for the last coalesced request to be applied, in windows */
+#define SETTLE_WINDOWS          2
+
+/********* TEST ALGO ********************
+ * If there is no time source, skip the test
+ * For each domain that supports setting both level and limits
+ *   Read the advertised rate limit from PERFORMANCE_DOMAIN_ATTRIBUTES and
+ *   save the current level and limits
+ *   For request intervals from back to back up to 4 times the rate limit
+ *     Issue REQUESTS_PER_INTERVAL PERFORMANCE_LEVEL_SET alternating between
+ *     the lowest and highest level, reading the level back after each
+ *     Count requests honored at once, accepted but coalesced, and rejected,
+ *     and record the set latency
+ *     Wait SETTLE_WINDOWS rate limits and check the last accepted request
+ *     took effect
+ *   Repeat with PERFORMANCE_LIMITS_SET alternating the range max between
+ *   the lowest and highest level
+ *   Print a table per message and restore the saved level and limits
+*****************************************/
+
+/* Request intervals in quarters of the rate limit */
+static const uint32_t g_interval_quarters[] = {0, 1, 2, 4, 8, 16};
+
+typedef struct {
+    uint32_t num_honored;
+    uint32_t num_coalesced;
+    uint32_t num_rejected;
+    int32_t  reject_status;
+    VAL_HIST_s latency;
+} RATE_LIMIT_RESULT_s;
+
+static RATE_LIMIT_RESULT_s g_result;
+
+static void perf_rate_limit_wait(uint64_t start, uint64_t interval)
+{
+    while ((val_get_time_ns() - start) < interval)
+        ;
+}
+
+static int32_t perf_rate_limit_send(uint32_t message_id, uint32_t param_count,
+                                    uint32_t *parameters, uint32_t *return_values,
+                                    uint64_t *latency)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   return_value_count;
+    uint64_t start;
+
+    rsp_msg_hdr = 0;
+    return_value_count = 0;
+    status = SCMI_GENERIC_ERROR;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_PERFORMANCE, message_id, COMMAND_MSG);
+    start = val_get_time_ns();
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+    if (latency)
+        *latency = val_get_time_ns() - start;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+static int32_t perf_rate_limit_set(uint32_t message_id, uint32_t domain_id, uint32_t value,
+                                   uint32_t range_min, uint64_t *latency)
+{
+    uint32_t parameters[PARAMETER_SIZE];
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    parameters[0] = domain_id;
+    parameters[1] = value;
+    parameters[2] = range_min;
+
+    return perf_rate_limit_send(message_id, (message_id == PERFORMANCE_LIMITS_SET) ? 3 : 2,
+                                parameters, return_values, latency);
+}
+
+/* Read back the level, or the range max for limits */
+static int32_t perf_rate_limit_get(uint32_t message_id, uint32_t domain_id, uint32_t *value,
+                                   uint32_t *range_min)
+{
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    int32_t  status;
+
+    if (message_id == PERFORMANCE_LIMITS_SET) {
+        status = perf_rate_limit_send(PERFORMANCE_LIMITS_GET, 1, &domain_id, return_values,
+                                      NULL);
+        *value = return_values[RANGE_MAX_OFFSET];
+        if (range_min)
+            *range_min = return_values[RANGE_MIN_OFFSET];
+    } else {
+        status = perf_rate_limit_send(PERFORMANCE_LEVEL_GET, 1, &domain_id, return_values,
+                                      NULL);
+        *value = return_values[PERFORMANCE_LEVEL_OFFSET];
+    }
+
+    return status;
+}
+
+/* Issue paced requests alternating between two values and classify each */
+static uint32_t perf_rate_limit_run(uint32_t message_id, uint32_t domain_id,
+                                    uint32_t low, uint32_t high, uint64_t interval,
+                                    uint64_t window)
+{
+    uint32_t i, value, readback, last_accepted = 0, num_accepted = 0;
+    uint64_t start = 0, latency;
+    int32_t  status;
+
+    val_memset(&g_result, 0, sizeof(g_result));
+    val_hist_reset(&g_result.latency);
+
+    for (i = 0; i < REQUESTS_PER_INTERVAL; i++)
+    {
+        value = (i & 1) ? low : high;
+        if (i)
+            perf_rate_limit_wait(start, interval);
+        start = val_get_time_ns();
+
+        status = perf_rate_limit_set(message_id, domain_id, value, low, &latency);
+        val_hist_add(&g_result.latency, latency);
+        if (status != SCMI_SUCCESS) {
+            if (g_result.num_rejected++ == 0)
+                g_result.reject_status = status;
+            continue;
+        }
+        last_accepted = value;
+        num_accepted++;
+
+        if (val_compare_status(perf_rate_limit_get(message_id, domain_id, &readback, NULL),
+                               SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        if (readback == value)
+            g_result.num_honored++;
+        else
+            g_result.num_coalesced++;
+    }
+
+    if (num_accepted == 0)
+        return VAL_STATUS_PASS;
+
+    /* A coalesced request must not be lost, the latest one wins */
+    perf_rate_limit_wait(val_get_time_ns(), SETTLE_WINDOWS * window);
+    if (val_compare_status(perf_rate_limit_get(message_id, domain_id, &readback, NULL),
+                           SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+    if (readback != last_accepted) {
+        val_print(VAL_PRINT_ERR, "\n       CHECK SETTLED  : FAILED %d, last request %d",
+                  readback, last_accepted);
+        return VAL_STATUS_FAIL;
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t perf_rate_limit_sweep(uint32_t message_id, uint32_t domain_id,
+                                      uint32_t low, uint32_t high, uint64_t window)
+{
+    uint32_t i, result = VAL_STATUS_PASS;
+    uint64_t interval;
+
+    val_print(VAL_PRINT_ERR, "\n       %s, %d requests per interval",
+              (message_id == PERFORMANCE_LIMITS_SET) ? "LIMITS_SET" : "LEVEL_SET",
+              REQUESTS_PER_INTERVAL);
+    val_print(VAL_PRINT_ERR, "\n       interval_us  honored  coalesced  rejected     p50_ns"
+              "     p99_ns");
+
+    for (i = 0; i < NUM_ELEMS(g_interval_quarters); i++)
+    {
+        interval = (window * g_interval_quarters[i]) / 4;
+
+        val_bench_quiet_begin();
+        result = perf_rate_limit_run(message_id, domain_id, low, high, interval, window);
+        val_bench_quiet_end();
+
+        val_print(VAL_PRINT_ERR, "\n       %11llu  %7d  %9d  %8d %10llu %10llu",
+                  (unsigned long long)(interval / NS_PER_US), g_result.num_honored,
+                  g_result.num_coalesced, g_result.num_rejected,
+                  (unsigned long long)val_hist_percentile(&g_result.latency, 50),
+                  (unsigned long long)val_hist_percentile(&g_result.latency, 99));
+        if (g_result.num_rejected)
+            val_print(VAL_PRINT_ERR, "  first status %d", g_result.reject_status);
+        if (result != VAL_STATUS_PASS)
+            break;
+    }
+
+    return result;
+}
+
+/* Print the fast channel rate limit next to the message one where described */
+static void perf_rate_limit_print_fast_channel(uint32_t domain_id, uint32_t message_id)
+{
+    uint32_t parameters[PARAMETER_SIZE];
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    if ((val_performance_get_info(PERF_DOMAIN_FAST_CH_SUPPORT, domain_id) == 0) ||
+        (val_performance_get_info(PERF_MESSAGE_FAST_CH_SUPPORT, message_id) == 0))
+        return;
+
+    parameters[0] = domain_id;
+    parameters[1] = message_id;
+    if (perf_rate_limit_send(PERFORMANCE_DESCRIBE_FASTCHANNEL, 2, parameters, return_values,
+                             NULL) != SCMI_SUCCESS)
+        return;
+
+    val_print(VAL_PRINT_ERR, "\n       FAST CH RATE LIMIT : %d us",
+              return_values[FAST_CH_RATE_LIMIT_OFFSET]);
+}
+
+static uint32_t perf_rate_limit_domain(uint32_t domain_id)
+{
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t rate_limit, low, high, saved_level, saved_max, saved_min;
+    uint32_t result = VAL_STATUS_PASS;
+    uint64_t window;
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 1] Query rate limit and save current state");
+    if (val_compare_status(perf_rate_limit_send(PERFORMANCE_DOMAIN_ATTRIBUTES, 1, &domain_id,
+                           return_values, NULL), SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+    rate_limit = VAL_EXTRACT_BITS(return_values[RATE_LIMIT_OFFSET], 0, 19);
+    window = rate_limit ? (rate_limit * NS_PER_US) : DEFAULT_WINDOW_NS;
+
+    if ((val_compare_status(perf_rate_limit_get(PERFORMANCE_LEVEL_SET, domain_id, &saved_level,
+                            NULL), SCMI_SUCCESS) != VAL_STATUS_PASS) ||
+        (val_compare_status(perf_rate_limit_get(PERFORMANCE_LIMITS_SET, domain_id, &saved_max,
+                            &saved_min), SCMI_SUCCESS) != VAL_STATUS_PASS))
+        return VAL_STATUS_FAIL;
+
+    low = val_performance_get_info(PERF_DOMAIN_MIN_LEVEL, domain_id);
+    high = val_performance_get_info(PERF_DOMAIN_MAX_LEVEL, domain_id);
+    val_print(VAL_PRINT_ERR, "\n       DOMAIN %d RATE LIMIT : %d us, levels %d to %d", domain_id,
+              rate_limit, low, high);
+    perf_rate_limit_print_fast_channel(domain_id, PERFORMANCE_LEVEL_SET);
+
+    /* Open the limits so every level can be requested */
+    val_print(VAL_PRINT_TEST, "\n     [Check 2] Sweep PERFORMANCE_LEVEL_SET rate");
+    perf_rate_limit_wait(val_get_time_ns(), window);
+    if (val_compare_status(perf_rate_limit_set(PERFORMANCE_LIMITS_SET, domain_id, high, low,
+                           NULL), SCMI_SUCCESS) != VAL_STATUS_PASS)
+        result = VAL_STATUS_FAIL;
+
+    if (result == VAL_STATUS_PASS) {
+        perf_rate_limit_wait(val_get_time_ns(), window);
+        result = perf_rate_limit_sweep(PERFORMANCE_LEVEL_SET, domain_id, low, high, window);
+    }
+
+    if (result == VAL_STATUS_PASS) {
+        val_print(VAL_PRINT_TEST, "\n     [Check 3] Sweep PERFORMANCE_LIMITS_SET rate");
+        perf_rate_limit_print_fast_channel(domain_id, PERFORMANCE_LIMITS_SET);
+        if (val_compare_status(perf_rate_limit_set(PERFORMANCE_LEVEL_SET, domain_id, low, 0,
+                               NULL), SCMI_SUCCESS) != VAL_STATUS_PASS)
+            result = VAL_STATUS_FAIL;
+    }
+
+    if (result == VAL_STATUS_PASS) {
+        perf_rate_limit_wait(val_get_time_ns(), window);
+        result = perf_rate_limit_sweep(PERFORMANCE_LIMITS_SET, domain_id, low, high, window);
+    }
+
+    /* Restore even after a failure so later tests see the original state */
+    val_print(VAL_PRINT_TEST, "\n     [Check 4] Restore the saved level and limits");
+    perf_rate_limit_wait(val_get_time_ns(), SETTLE_WINDOWS * window);
+    if (val_compare_status(perf_rate_limit_set(PERFORMANCE_LIMITS_SET, domain_id, saved_max,
+                           saved_min, NULL), SCMI_SUCCESS) != VAL_STATUS_PASS)
+        result = VAL_STATUS_FAIL;
+    perf_rate_limit_wait(val_get_time_ns(), SETTLE_WINDOWS * window);
+    if (val_compare_status(perf_rate_limit_set(PERFORMANCE_LEVEL_SET, domain_id, saved_level, 0,
+                           NULL), SCMI_SUCCESS) != VAL_STATUS_PASS)
+        result = VAL_STATUS_FAIL;
+    perf_rate_limit_wait(val_get_time_ns(), SETTLE_WINDOWS * window);
+
+    return result;
+}
+
+uint32_t performance_rate_limit_throttling(void)
+{
+    uint32_t num_domains, domain_id, run_flag = 0;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No time source, throttling skipped          ");
+        return VAL_STATUS_SKIP;
+    }
+
+    num_domains = val_performance_get_info(NUM_PERF_DOMAINS, 0x00);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No performance domains found                ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM DOMAINS    : %d", num_domains);
+
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        if ((val_performance_get_info(PERF_DOMAIN_SET_PERFORMANCE_LEVEL_SUPPORT, domain_id) == 0) ||
+            (val_performance_get_info(PERF_DOMAIN_SET_PERFORMANCE_LIMIT_SUPPORT, domain_id) == 0))
+            continue;
+        run_flag = 1;
+
+        val_print(VAL_PRINT_TEST, "\n     PERFORMANCE DOMAIN ID: %d", domain_id);
+        if (perf_rate_limit_domain(domain_id) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+    }
+
+    if (run_flag == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No domain supports set level and limits     ");
+        return VAL_STATUS_SKIP;
+    }
+
+    return VAL_STATUS_PASS;
+}
@@ -0,0 +1,329 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+#include "val_interface.h"
+#include "val_performance.h"
+#include "val_perf_replay.h"
+#include "val_schema.h"
+
+#define TEST_NUM  (SCMI_PERFORMANCE_TEST_NUM_BASE + 32)
+#define TEST_DESC "Performance governor trace replay            "
+
+#define PARAMETER_SIZE 3
+
+/********* TEST ALGO ********************
+ * If there is no time source, skip the test
+ * Open the trace given to the app, or the built in schedutil like trace,
+ * keeping the requests for domains that can set their level
+ * For each domain in the trace
+ *   Save the current level and limits and open the limits to every level
+ *   Use the PERFORMANCE_LEVEL_SET fast channel if the domain describes one
+ *   without a doorbell and the agent can map it, else the mailbox
+ * For each request, wait until its time in the trace, then
+ *   Read back the level the previous request of the domain achieved
+ *   Map the requested frequency to the slowest level that meets it, as
+ *   cpufreq does, and write it to the fast channel or send
+ *   PERFORMANCE_LEVEL_SET, timing the command
+ * One tick after the trace ends read back the last request of every domain
+ * Report the requested, OPP and achieved frequency over the trace, the
+ * command latency per channel and how late requests were issued. Only
+ * rejected requests fail the test, requests the platform coalesced or has
+ * not applied yet are reported.
+ * Restore the saved level and limits
+*****************************************/
+
+typedef struct {
+    volatile uint32_t *fast_channel;
+    uint32_t saved_level;
+    uint32_t saved_max;
+    uint32_t saved_min;
+    uint32_t pending;
+    PERF_REPLAY_SAMPLE_s sample;
+} REPLAY_DOMAIN_s;
+
+static REPLAY_DOMAIN_s g_replay[MAX_PERFORMANCE_DOMAINS];
+
+static int32_t perf_replay_send(uint32_t message_id, uint32_t param_count, uint32_t *parameters,
+                                uint32_t *return_values, size_t *return_value_count,
+                                uint64_t *latency)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    uint64_t start;
+
+    rsp_msg_hdr = 0;
+    *return_value_count = 0;
+    status = SCMI_GENERIC_ERROR;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_PERFORMANCE, message_id, COMMAND_MSG);
+    start = val_get_time_ns();
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     return_value_count, return_values);
+    if (latency)
+        *latency = val_get_time_ns() - start;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+static int32_t perf_replay_get_level(uint32_t domain_id, uint32_t *level)
+{
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    size_t   return_value_count;
+    int32_t  status;
+
+    status = perf_replay_send(PERFORMANCE_LEVEL_GET, 1, &domain_id, return_values,
+                              &return_value_count, NULL);
+    *level = return_values[PERFORMANCE_LEVEL_OFFSET];
+
+    return status;
+}
+
+static int32_t perf_replay_set(uint32_t message_id, uint32_t domain_id, uint32_t value,
+                               uint32_t range_min, uint64_t *latency)
+{
+    uint32_t parameters[PARAMETER_SIZE];
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    size_t   return_value_count;
+
+    parameters[0] = domain_id;
+    parameters[1] = value;
+    parameters[2] = range_min;
+
+    return perf_replay_send(message_id, (message_id == PERFORMANCE_LIMITS_SET) ? 3 : 2,
+                            parameters, return_values, &return_value_count, latency);
+}
+
+/* Map the level set fast channel of a domain, NULL to use the mailbox */
+static volatile uint32_t *perf_replay_map_fast_channel(uint32_t domain_id)
+{
+    uint32_t parameters[PARAMETER_SIZE];
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    size_t   return_value_count;
+    PERF_DESCRIBE_FASTCHANNEL_VIEW_s *fast_channel;
+
+    if ((val_performance_get_info(PERF_DOMAIN_FAST_CH_SUPPORT, domain_id) == 0) ||
+        (val_performance_get_info(PERF_MESSAGE_FAST_CH_SUPPORT, PERFORMANCE_LEVEL_SET) == 0))
+        return NULL;
+
+    parameters[0] = domain_id;
+    parameters[1] = PERFORMANCE_LEVEL_SET;
+    if (perf_replay_send(PERFORMANCE_DESCRIBE_FASTCHANNEL, 2, parameters, return_values,
+                         &return_value_count, NULL) != SCMI_SUCCESS)
+        return NULL;
+
+    fast_channel = val_decode_response(val_msg_hdr_create(PROTOCOL_PERFORMANCE,
+                                           PERFORMANCE_DESCRIBE_FASTCHANNEL, COMMAND_MSG),
+                                       return_value_count, return_values);
+    if ((fast_channel == NULL) ||
+        VAL_SCHEMA_BITS(fast_channel->attributes, PERF_FC_ATTR_DOORBELL))
+        return NULL;
+
+    return val_fast_channel_map(PROTOCOL_PERFORMANCE, domain_id, PERFORMANCE_LEVEL_SET,
+                                ((uint64_t)fast_channel->chan_addr_high << 32) |
+                                fast_channel->chan_addr_low, fast_channel->chan_size);
+}
+
+static uint32_t perf_replay_prepare(uint32_t domain_id)
+{
+    REPLAY_DOMAIN_s *replay = &g_replay[domain_id];
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    size_t   return_value_count;
+    uint32_t max_level, min_level;
+
+    val_memset(replay, 0, sizeof(*replay));
+
+    if ((val_compare_status(perf_replay_get_level(domain_id, &replay->saved_level),
+                            SCMI_SUCCESS) != VAL_STATUS_PASS) ||
+        (val_compare_status(perf_replay_send(PERFORMANCE_LIMITS_GET, 1, &domain_id,
+                            return_values, &return_value_count, NULL),
+                            SCMI_SUCCESS) != VAL_STATUS_PASS))
+        return VAL_STATUS_FAIL;
+    replay->saved_max = return_values[RANGE_MAX_OFFSET];
+    replay->saved_min = return_values[RANGE_MIN_OFFSET];
+
+    /* A domain that cannot set limits keeps them, requests outside are rejected */
+    max_level = val_performance_get_info(PERF_DOMAIN_MAX_LEVEL, domain_id);
+    min_level = val_performance_get_info(PERF_DOMAIN_MIN_LEVEL, domain_id);
+    if (val_performance_get_info(PERF_DOMAIN_SET_PERFORMANCE_LIMIT_SUPPORT, domain_id) &&
+        (val_compare_status(perf_replay_set(PERFORMANCE_LIMITS_SET, domain_id, max_level,
+                            min_level, NULL), SCMI_SUCCESS) != VAL_STATUS_PASS))
+        return VAL_STATUS_FAIL;
+
+    replay->fast_channel = perf_replay_map_fast_channel(domain_id);
+    val_print(VAL_PRINT_TEST, "\n       DOMAIN %d: %d requests through the %s", domain_id,
+              val_perf_replay_num_requests(domain_id),
+              replay->fast_channel ? "fast channel" : "mailbox");
+
+    return VAL_STATUS_PASS;
+}
+
+/* Read back the level the last request of a domain achieved and record it */
+static uint32_t perf_replay_complete(uint32_t domain_id)
+{
+    REPLAY_DOMAIN_s *replay = &g_replay[domain_id];
+
+    if (!replay->pending)
+        return VAL_STATUS_PASS;
+    replay->pending = 0;
+
+    if (val_compare_status(perf_replay_get_level(domain_id, &replay->sample.achieved_level),
+                           SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    val_perf_replay_record(&replay->sample);
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t perf_replay_issue(PERF_REPLAY_EVENT_s *event, uint64_t start)
+{
+    REPLAY_DOMAIN_s *replay = &g_replay[event->domain_id];
+    PERF_REPLAY_SAMPLE_s *sample = &replay->sample;
+    uint64_t due, now;
+
+    due = start + (event->time_us * NS_PER_US);
+    while ((now = val_get_time_ns()) < due)
+        ;
+
+    if (perf_replay_complete(event->domain_id) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    sample->event = *event;
+    sample->opp_level = val_perf_replay_find_opp(event->domain_id, event->freq_khz);
+    sample->late_ns = val_get_time_ns() - due;
+
+    if (replay->fast_channel) {
+        sample->channel = PERF_REPLAY_FAST_CHANNEL;
+        now = val_get_time_ns();
+        *replay->fast_channel = sample->opp_level;
+        sample->latency_ns = val_get_time_ns() - now;
+        sample->status = SCMI_SUCCESS;
+    } else {
+        sample->channel = PERF_REPLAY_MAILBOX;
+        sample->status = perf_replay_set(PERFORMANCE_LEVEL_SET, event->domain_id,
+                                         sample->opp_level, 0, &sample->latency_ns);
+    }
+    replay->pending = 1;
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t perf_replay_restore(uint32_t num_domains)
+{
+    REPLAY_DOMAIN_s *replay;
+    uint32_t domain_id, result = VAL_STATUS_PASS;
+
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        if (val_perf_replay_num_requests(domain_id) == 0)
+            continue;
+        replay = &g_replay[domain_id];
+
+        if (val_performance_get_info(PERF_DOMAIN_SET_PERFORMANCE_LIMIT_SUPPORT, domain_id) &&
+            (val_compare_status(perf_replay_set(PERFORMANCE_LIMITS_SET, domain_id,
+                                replay->saved_max, replay->saved_min, NULL),
+                                SCMI_SUCCESS) != VAL_STATUS_PASS))
+            result = VAL_STATUS_FAIL;
+        if (val_compare_status(perf_replay_set(PERFORMANCE_LEVEL_SET, domain_id,
+                               replay->saved_level, 0, NULL), SCMI_SUCCESS) != VAL_STATUS_PASS)
+            result = VAL_STATUS_FAIL;
+    }
+
+    return result;
+}
+
+uint32_t performance_governor_trace_replay(void)
+{
+    PERF_REPLAY_EVENT_s event;
+    uint32_t num_domains, domain_id, status, num_rejected = 0;
+    uint32_t result = VAL_STATUS_PASS;
+    uint64_t start;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No time source, replay skipped              ");
+        return VAL_STATUS_SKIP;
+    }
+
+    num_domains = val_performance_get_info(NUM_PERF_DOMAINS, 0x00);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No performance domains found                ");
+        return VAL_STATUS_SKIP;
+    }
+    if (num_domains > MAX_PERFORMANCE_DOMAINS)
+        num_domains = MAX_PERFORMANCE_DOMAINS;
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 1] Open the trace and prepare its domains");
+    status = val_perf_replay_open(num_domains);
+    if (status == VAL_STATUS_SKIP) {
+        val_print(VAL_PRINT_ERR, "\n       No request for a domain that sets its level ");
+        val_perf_replay_close();
+        return VAL_STATUS_SKIP;
+    }
+    if (status != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        if (val_perf_replay_num_requests(domain_id) &&
+            (perf_replay_prepare(domain_id) != VAL_STATUS_PASS)) {
+            val_perf_replay_close();
+            return VAL_STATUS_FAIL;
+        }
+    }
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 2] Replay the requests at their trace time");
+    start = val_get_time_ns();
+    while (val_perf_replay_next(&event))
+    {
+        if (perf_replay_issue(&event, start) != VAL_STATUS_PASS) {
+            result = VAL_STATUS_FAIL;
+            break;
+        }
+        if (g_replay[event.domain_id].sample.status != SCMI_SUCCESS)
+            num_rejected++;
+    }
+
+    /* Give the last requests a tick to take effect */
+    start = val_get_time_ns();
+    while ((val_get_time_ns() - start) < (PERF_REPLAY_TICK_US * NS_PER_US))
+        ;
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        if (perf_replay_complete(domain_id) != VAL_STATUS_PASS)
+            result = VAL_STATUS_FAIL;
+    }
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 3] Report requested against achieved levels");
+    val_perf_replay_report(VAL_PRINT_ERR);
+    val_perf_replay_close();
+
+    if (num_rejected) {
+        val_print(VAL_PRINT_ERR, "\n       CHECK REJECTED : FAILED, %d requests",
+                  num_rejected);
+        result = VAL_STATUS_FAIL;
+    }
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 4] Restore the saved level and limits");
+    if (perf_replay_restore(num_domains) != VAL_STATUS_PASS)
+        result = VAL_STATUS_FAIL;
+
+    return result;
+}
@@ -72,6 +72,13 @@ uint32_t power_domain_query_domain_attributes(void)
                                     VAL_EXTRACT_BITS(attribute, 30, 30));
         val_print(VAL_PRINT_DEBUG, "\n     POWER SYNCHRONOUS SUPPORT: %d",
                                     VAL_EXTRACT_BITS(attribute, 29, 29));
+
+        val_power_domain_save_info(PD_STATE_CHANGE_NOTI_SUPPORT, domain_id,
+                                   VAL_EXTRACT_BITS(attribute, 31, 31));
+        val_power_domain_save_info(PD_STATE_ASYNC_SUPPORT, domain_id,
+                                   VAL_EXTRACT_BITS(attribute, 30, 30));
+        val_power_domain_save_info(PD_STATE_SYNC_SUPPORT, domain_id,
+                                   VAL_EXTRACT_BITS(attribute, 29, 29));
         val_print(VAL_PRINT_DEBUG, "\n     DOMAIN NAME: %s",
                                    (uint8_t *)&return_values[DOMAIN_NAME_OFFSET]);
     }
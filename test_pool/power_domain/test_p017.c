@@ -0,0 +1,353 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include"val_interface.h"
+#include"val_power_domain.h"
+#include"val_benchmark.h"
+
+#define TEST_NUM  (SCMI_POWER_DOMAIN_TEST_NUM_BASE + 17)
+#define TEST_DESC "Power state transition latency profiler      "
+
+#define PARAMETER_SIZE     3
+#define PROFILE_CYCLES     4
+#define SETTLE_TIMEOUT_NS  (1 * NS_PER_SEC)
+#define NUM_SET_MODES      2
+#define NUM_PROFILE_STATES 3
+#define PROFILE_RETENTION  2
+
+/********* TEST ALGO ********************
+ * For each power domain with sync or async POWER_STATE_SET support
+ *   Save the current power state and enable POWER_STATE_CHANGED if supported
+ *   In each supported set mode cycle the domain OFF, ON, RETENTION, ON
+ *     Time the POWER_STATE_SET command
+ *     Time the arrival of the POWER_STATE_CHANGED notification
+ *     Time until POWER_STATE_GET reports the requested state
+ *   Disable notifications, restore the original state, also after a
+ *   failed transition
+ *   Print the per state latency table of the domain
+*****************************************/
+
+static uint32_t g_profile_states[NUM_PROFILE_STATES] = {
+    POWER_STATE_OFF,
+    POWER_STATE_ON,
+    POWER_STATE_RETENTION
+};
+
+static char *g_profile_state_names[NUM_PROFILE_STATES] = {
+    "OFF",
+    "ON",
+    "RETENTION"
+};
+
+/* Cycle order, returning to ON between the low power states */
+static uint32_t g_profile_sequence[] = {0, 1, 2, 1};
+
+static VAL_HIST_s g_cmd_hist[NUM_SET_MODES][NUM_PROFILE_STATES];
+static VAL_HIST_s g_notify_hist[NUM_SET_MODES][NUM_PROFILE_STATES];
+static VAL_HIST_s g_settle_hist[NUM_SET_MODES][NUM_PROFILE_STATES];
+
+static uint32_t pd_profile_state_get(uint32_t domain_id, uint32_t *power_state)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    param_count++;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWER_DOMAIN, POWER_STATE_GET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, &domain_id, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    *power_state = return_values[POWER_STATE_OFFSET];
+    return VAL_STATUS_PASS;
+}
+
+static int32_t pd_profile_state_set(uint32_t domain_id, uint32_t flags, uint32_t power_state)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = flags;
+    parameters[param_count++] = domain_id;
+    parameters[param_count++] = power_state;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWER_DOMAIN, POWER_STATE_SET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+static int32_t pd_profile_notify(uint32_t domain_id, uint32_t notify_enable)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    parameters[param_count++] = notify_enable;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWER_DOMAIN, POWER_STATE_NOTIFY, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+static uint32_t pd_profile_wait_notification(uint32_t domain_id, uint32_t power_state)
+{
+    uint32_t rsp_msg_hdr;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    rsp_msg_hdr = 0;
+    return_value_count = 0;
+    val_receive_notification(&rsp_msg_hdr, &return_value_count, return_values);
+
+    if (val_compare("PROTOCOL ID", VAL_EXTRACT_BITS(rsp_msg_hdr, 10, 17),
+                    PROTOCOL_POWER_DOMAIN))
+        return VAL_STATUS_FAIL;
+    if (val_compare("MSG TYPE   ", VAL_EXTRACT_BITS(rsp_msg_hdr, 8, 9), NOTIFICATION_MSG))
+        return VAL_STATUS_FAIL;
+    if (val_compare("MSG ID     ", VAL_EXTRACT_BITS(rsp_msg_hdr, 0, 7), POWER_STATE_CHANGED))
+        return VAL_STATUS_FAIL;
+    if (val_compare("DOMAIN ID  ", return_values[NOTIFY_DOMAIN_ID_OFFSET], domain_id))
+        return VAL_STATUS_FAIL;
+    if (val_compare("POWER STATE", return_values[NOTIFY_POWER_STATE_OFFSET], power_state))
+        return VAL_STATUS_FAIL;
+
+    return VAL_STATUS_PASS;
+}
+
+/* Move the domain to one state and record the three latencies of the change */
+static uint32_t pd_profile_measure(uint32_t domain_id, uint32_t mode, uint32_t state_idx,
+                                   uint32_t notify, uint32_t *state_supported)
+{
+    uint64_t start_ns, now_ns;
+    uint32_t power_state = g_profile_states[state_idx];
+    uint32_t current_state = 0;
+    int32_t status;
+
+    start_ns = val_get_time_ns();
+    status = pd_profile_state_set(domain_id, mode, power_state);
+    now_ns = val_get_time_ns();
+
+    /* Retention ids are platform defined, a refused one is reported not profiled */
+    if (state_idx == PROFILE_RETENTION &&
+        (status == SCMI_INVALID_PARAMETERS || status == SCMI_NOT_SUPPORTED)) {
+        state_supported[state_idx] = 0;
+        return VAL_STATUS_PASS;
+    }
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    val_hist_add(&g_cmd_hist[mode][state_idx], now_ns - start_ns);
+
+    if (notify) {
+        if (pd_profile_wait_notification(domain_id, power_state) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        val_hist_add(&g_notify_hist[mode][state_idx], val_get_time_ns() - start_ns);
+    }
+
+    do {
+        if (pd_profile_state_get(domain_id, &current_state) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        now_ns = val_get_time_ns();
+    } while (current_state != power_state && (now_ns - start_ns) < SETTLE_TIMEOUT_NS);
+
+    if (current_state != power_state) {
+        val_print(VAL_PRINT_ERR, "\n       State 0x%08X not reached, read 0x%08X",
+                  power_state, current_state);
+        return VAL_STATUS_FAIL;
+    }
+
+    val_hist_add(&g_settle_hist[mode][state_idx], now_ns - start_ns);
+    return VAL_STATUS_PASS;
+}
+
+static void pd_profile_print_table(uint32_t domain_id, uint32_t *mode_supported,
+                                   uint32_t *state_supported)
+{
+    uint32_t mode, state_idx;
+    VAL_HIST_s *cmd, *notify, *settle;
+
+    val_print(VAL_PRINT_ERR, "\n       Domain %d latency (ns)  cmd p50/max   notify p50/max"
+              "   settle p50/max", domain_id);
+
+    for (mode = 0; mode < NUM_SET_MODES; mode++)
+    {
+        if (!mode_supported[mode])
+            continue;
+
+        for (state_idx = 0; state_idx < NUM_PROFILE_STATES; state_idx++)
+        {
+            if (!state_supported[state_idx]) {
+                val_print(VAL_PRINT_ERR, "\n       %-5s %-9s   not supported",
+                          (mode == ASYNC_POWER_STATE_CHANGE) ? "async" : "sync",
+                          g_profile_state_names[state_idx]);
+                continue;
+            }
+
+            cmd = &g_cmd_hist[mode][state_idx];
+            notify = &g_notify_hist[mode][state_idx];
+            settle = &g_settle_hist[mode][state_idx];
+            val_print(VAL_PRINT_ERR, "\n       %-5s %-9s %8llu/%-8llu",
+                      (mode == ASYNC_POWER_STATE_CHANGE) ? "async" : "sync",
+                      g_profile_state_names[state_idx],
+                      (unsigned long long)val_hist_percentile(cmd, 50),
+                      (unsigned long long)cmd->max);
+            if (notify->count)
+                val_print(VAL_PRINT_ERR, " %8llu/%-8llu",
+                          (unsigned long long)val_hist_percentile(notify, 50),
+                          (unsigned long long)notify->max);
+            else
+                val_print(VAL_PRINT_ERR, "        -/-       ");
+            val_print(VAL_PRINT_ERR, " %8llu/%-8llu",
+                      (unsigned long long)val_hist_percentile(settle, 50),
+                      (unsigned long long)settle->max);
+        }
+    }
+}
+
+uint32_t power_domain_state_transition_profile(void)
+{
+    uint32_t num_domains, domain_id, run_flag = 0;
+    uint32_t mode_supported[NUM_SET_MODES];
+    uint32_t state_supported[NUM_PROFILE_STATES];
+    uint32_t mode, state_idx, cycle, step, notify;
+    uint32_t original_state, result;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No platform time source for profiling       ");
+        return VAL_STATUS_SKIP;
+    }
+
+    num_domains = val_power_domain_get_info(0, NUM_POWER_DOMAIN);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No power domains found                      ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM DOMAINS    : %d", num_domains);
+
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        mode_supported[SYNC_POWER_STATE_CHANGE] =
+            val_power_domain_get_info(domain_id, PD_STATE_SYNC_SUPPORT);
+        mode_supported[ASYNC_POWER_STATE_CHANGE] =
+            val_power_domain_get_info(domain_id, PD_STATE_ASYNC_SUPPORT);
+        if (!mode_supported[SYNC_POWER_STATE_CHANGE] && !mode_supported[ASYNC_POWER_STATE_CHANGE])
+            continue;
+
+        run_flag = 1;
+        val_print(VAL_PRINT_TEST, "\n     POWER DOMAIN ID: %d", domain_id);
+
+        /* Save the state to restore once profiling is done */
+        val_print(VAL_PRINT_TEST, "\n     [Step 1] Save current power state");
+        if (pd_profile_state_get(domain_id, &original_state) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        val_print(VAL_PRINT_TEST, "\n       POWER STATE    : 0x%08X", original_state);
+
+        notify = 0;
+        if (val_power_domain_get_info(domain_id, PD_STATE_CHANGE_NOTI_SUPPORT)) {
+            val_print(VAL_PRINT_TEST, "\n     [Step 2] Enable power state change notification");
+            notify = (pd_profile_notify(domain_id, NOTIFY_ENABLE) == SCMI_SUCCESS);
+        }
+
+        for (mode = 0; mode < NUM_SET_MODES; mode++)
+            for (state_idx = 0; state_idx < NUM_PROFILE_STATES; state_idx++) {
+                val_hist_reset(&g_cmd_hist[mode][state_idx]);
+                val_hist_reset(&g_notify_hist[mode][state_idx]);
+                val_hist_reset(&g_settle_hist[mode][state_idx]);
+            }
+        for (state_idx = 0; state_idx < NUM_PROFILE_STATES; state_idx++)
+            state_supported[state_idx] = 1;
+
+        result = VAL_STATUS_PASS;
+        for (mode = 0; mode < NUM_SET_MODES && result == VAL_STATUS_PASS; mode++)
+        {
+            if (!mode_supported[mode])
+                continue;
+
+            val_print(VAL_PRINT_TEST, "\n     [Check 1] Cycle power states in %s mode",
+                      (mode == ASYNC_POWER_STATE_CHANGE) ? "async" : "sync");
+            val_bench_quiet_begin();
+            for (cycle = 0; cycle < PROFILE_CYCLES && result == VAL_STATUS_PASS; cycle++)
+                for (step = 0; step < sizeof(g_profile_sequence) / sizeof(g_profile_sequence[0]) &&
+                     result == VAL_STATUS_PASS; step++)
+                {
+                    state_idx = g_profile_sequence[step];
+                    if (!state_supported[state_idx])
+                        continue;
+                    result = pd_profile_measure(domain_id, mode, state_idx, notify,
+                                                state_supported);
+                }
+            val_bench_quiet_end();
+        }
+
+        /* Notifications off first so the restore does not leave one queued,
+         * both are done after a failed cycle too */
+        val_print(VAL_PRINT_TEST, "\n     [Step 3] Restore original power state");
+        if (notify && pd_profile_notify(domain_id, NOTIFY_DISABLE) != SCMI_SUCCESS)
+            result = VAL_STATUS_FAIL;
+
+        mode = mode_supported[SYNC_POWER_STATE_CHANGE] ? SYNC_POWER_STATE_CHANGE :
+                                                         ASYNC_POWER_STATE_CHANGE;
+        if (val_compare_status(pd_profile_state_set(domain_id, mode, original_state),
+                               SCMI_SUCCESS) != VAL_STATUS_PASS)
+            result = VAL_STATUS_FAIL;
+
+        if (result != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        pd_profile_print_table(domain_id, mode_supported, state_supported);
+    }
+
+    if (run_flag == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No domain support POWER STATE SET           ");
+        return VAL_STATUS_SKIP;
+    }
+
+    return VAL_STATUS_PASS;
+}
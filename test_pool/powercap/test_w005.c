@@ -0,0 +1,159 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_powercap.h"
+
+#define TEST_NUM  (SCMI_POWERCAP_TEST_NUM_BASE + 5)
+#define TEST_DESC "Powercap domain attributes check               "
+
+#define RETURN_VALUE_COUNT 14
+
+/********* TEST ALGO ********************
+ * For each powercap domain
+ *   Query the domain attributes
+ *   Check reserved bits, the domain name and the power unit
+ *   Check the PAI and cap ranges are ordered and walkable by their steps
+ *   Save the attributes and ranges for the later tests
+*****************************************/
+
+/* A range is walkable when it is a single value or has a step dividing it */
+static uint32_t powercap_check_range(char *name, uint32_t min, uint32_t max, uint32_t step)
+{
+    if (min > max) {
+        val_print(VAL_PRINT_ERR, "\n       %s min %d above max %d", name, min, max);
+        return VAL_STATUS_FAIL;
+    }
+
+    if (min == max)
+        return VAL_STATUS_PASS;
+
+    if ((step == 0) || ((max - min) % step)) {
+        val_print(VAL_PRINT_ERR, "\n       %s step %d does not divide %d..%d", name, step,
+                  min, max);
+        return VAL_STATUS_FAIL;
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+uint32_t powercap_query_domain_attributes(void)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t domain_id, num_domains, attributes, parent_id;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    /* Skip if no domains found */
+    num_domains = val_powercap_get_info(NUM_POWERCAP_DOMAINS, 0x0);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Powercap domains found                     ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM DOMAINS    : %d", num_domains);
+
+    /* Check powercap domain attributes for valid domain */
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        val_print(VAL_PRINT_TEST, "\n       POWERCAP DOMAIN: %d", domain_id);
+        val_print(VAL_PRINT_TEST, "\n     [Check 1] Query attributes");
+
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        param_count++;
+        cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWERCAP, POWERCAP_DOMAIN_ATTRIBUTES,
+                                         COMMAND_MSG);
+        val_send_message(cmd_msg_hdr, param_count, &domain_id, &rsp_msg_hdr, &status,
+                         &return_value_count, return_values);
+
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        val_print_return_values(return_value_count, return_values);
+
+        if (val_compare_return_count(return_value_count, RETURN_VALUE_COUNT))
+            return VAL_STATUS_FAIL;
+
+        attributes = return_values[DOMAIN_ATTRIBUTES_OFFSET];
+        if (val_reserved_bits_check_is_zero(VAL_EXTRACT_BITS(attributes, ATTRIBUTE_RESERVED_LOW,
+                                            ATTRIBUTE_RESERVED_HIGH)) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (val_compare_str("DOMAIN NAME", (char *)&return_values[DOMAIN_NAME_OFFSET],
+                            (char *)val_powercap_get_expected_name(domain_id),
+                            SCMI_NAME_STR_SIZE))
+            return VAL_STATUS_FAIL;
+
+        /* STEP 2 : Check the power unit and ranges */
+        val_print(VAL_PRINT_TEST, "\n     [Check 2] Check power unit and ranges");
+
+        if (VAL_EXTRACT_BITS(attributes, POWER_UNIT_LOW, POWER_UNIT_HIGH) > POWER_UNIT_MICROWATT) {
+            val_print(VAL_PRINT_ERR, "\n       Reserved power unit %d",
+                      VAL_EXTRACT_BITS(attributes, POWER_UNIT_LOW, POWER_UNIT_HIGH));
+            return VAL_STATUS_FAIL;
+        }
+
+        if (powercap_check_range("PAI", return_values[MIN_PAI_OFFSET],
+                                 return_values[MAX_PAI_OFFSET],
+                                 return_values[PAI_STEP_OFFSET]) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (powercap_check_range("CAP", return_values[MIN_CAP_OFFSET],
+                                 return_values[MAX_CAP_OFFSET],
+                                 return_values[CAP_STEP_OFFSET]) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        /* A domain without cap configuration has a fixed cap */
+        if (!VAL_EXTRACT_BITS(attributes, CAP_CONFIG_SUPPORT_BIT, CAP_CONFIG_SUPPORT_BIT) &&
+            val_compare("FIXED CAP  ", return_values[MIN_CAP_OFFSET],
+                        return_values[MAX_CAP_OFFSET]))
+            return VAL_STATUS_FAIL;
+
+        parent_id = return_values[PARENT_ID_OFFSET];
+        if ((parent_id != POWERCAP_NO_PARENT) && (parent_id >= num_domains)) {
+            val_print(VAL_PRINT_ERR, "\n       Parent domain %d not found", parent_id);
+            return VAL_STATUS_FAIL;
+        }
+
+        val_print(VAL_PRINT_TEST, "\n       CAP RANGE      : %d..%d step %d",
+                  return_values[MIN_CAP_OFFSET], return_values[MAX_CAP_OFFSET],
+                  return_values[CAP_STEP_OFFSET]);
+        val_print(VAL_PRINT_TEST, "\n       PAI RANGE      : %d..%d us step %d",
+                  return_values[MIN_PAI_OFFSET], return_values[MAX_PAI_OFFSET],
+                  return_values[PAI_STEP_OFFSET]);
+
+        val_powercap_save_info(POWERCAP_DOMAIN_ATTRIBUTE, domain_id, attributes);
+        val_powercap_save_info(POWERCAP_MIN_PAI, domain_id, return_values[MIN_PAI_OFFSET]);
+        val_powercap_save_info(POWERCAP_MAX_PAI, domain_id, return_values[MAX_PAI_OFFSET]);
+        val_powercap_save_info(POWERCAP_PAI_STEP, domain_id, return_values[PAI_STEP_OFFSET]);
+        val_powercap_save_info(POWERCAP_MIN_CAP, domain_id, return_values[MIN_CAP_OFFSET]);
+        val_powercap_save_info(POWERCAP_MAX_CAP, domain_id, return_values[MAX_CAP_OFFSET]);
+        val_powercap_save_info(POWERCAP_CAP_STEP, domain_id, return_values[CAP_STEP_OFFSET]);
+        val_powercap_save_info(POWERCAP_SUSTAINABLE_POWER, domain_id,
+                               return_values[SUSTAINABLE_POWER_OFFSET]);
+    }
+
+    return VAL_STATUS_PASS;
+}
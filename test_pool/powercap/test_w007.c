@@ -0,0 +1,84 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_powercap.h"
+
+#define TEST_NUM  (SCMI_POWERCAP_TEST_NUM_BASE + 7)
+#define TEST_DESC "Powercap cap get check                         "
+
+#define RETURN_VALUE_COUNT 1
+
+uint32_t powercap_query_cap_get(void)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t domain_id, num_domains, cap;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    num_domains = val_powercap_get_info(NUM_POWERCAP_DOMAINS, 0x0);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Powercap domains found                     ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM DOMAINS    : %d", num_domains);
+
+    /* Current cap of every domain should be within its cap range */
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        val_print(VAL_PRINT_TEST, "\n       POWERCAP DOMAIN: %d", domain_id);
+        val_print(VAL_PRINT_TEST, "\n     [Check 1] Query current cap");
+
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        param_count++;
+        cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWERCAP, POWERCAP_CAP_GET, COMMAND_MSG);
+        val_send_message(cmd_msg_hdr, param_count, &domain_id, &rsp_msg_hdr, &status,
+                         &return_value_count, return_values);
+
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        val_print_return_values(return_value_count, return_values);
+
+        if (val_compare_return_count(return_value_count, RETURN_VALUE_COUNT))
+            return VAL_STATUS_FAIL;
+
+        cap = return_values[ATTRIBUTE_OFFSET];
+        val_print(VAL_PRINT_TEST, "\n       CAP            : %d", cap);
+
+        if ((cap < val_powercap_get_info(POWERCAP_MIN_CAP, domain_id)) ||
+            (cap > val_powercap_get_info(POWERCAP_MAX_CAP, domain_id))) {
+            val_print(VAL_PRINT_ERR, "\n       Cap %d outside %d..%d", cap,
+                      val_powercap_get_info(POWERCAP_MIN_CAP, domain_id),
+                      val_powercap_get_info(POWERCAP_MAX_CAP, domain_id));
+            return VAL_STATUS_FAIL;
+        }
+
+        val_powercap_save_info(POWERCAP_CURRENT_CAP, domain_id, cap);
+    }
+
+    return VAL_STATUS_PASS;
+}
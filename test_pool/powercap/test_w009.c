@@ -0,0 +1,191 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_powercap.h"
+
+#define TEST_NUM  (SCMI_POWERCAP_TEST_NUM_BASE + 9)
+#define TEST_DESC "Powercap set new cap check                     "
+
+#define PARAMETER_SIZE     3
+
+/********* TEST ALGO ********************
+ * For each powercap domain
+ *   Without cap configuration support CAP_SET should be rejected
+ *   Otherwise pick the far end of the cap range from the current cap
+ *   Set it synchronously and check CAP_GET reports it
+ *   With async support set the current cap back asynchronously, check the
+ *   delayed response and CAP_GET
+ *   Restore the current cap
+*****************************************/
+
+static uint32_t powercap_cap_set(uint32_t domain_id, uint32_t flags, uint32_t cap,
+                                 int32_t expected_status)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    parameters[param_count++] = flags;
+    parameters[param_count++] = cap;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWERCAP, POWERCAP_CAP_SET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_status(status, expected_status) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    val_print_return_values(return_value_count, return_values);
+
+    if ((status != SCMI_SUCCESS) || !(flags & POWERCAP_SET_ASYNC_MODE))
+        return VAL_STATUS_PASS;
+
+    /* Async cap set completes with a delayed response */
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    val_receive_delayed_response(&rsp_msg_hdr, &status, &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    val_print_return_values(return_value_count, return_values);
+
+    if (val_compare("PROTOCOL ID", VAL_EXTRACT_BITS(rsp_msg_hdr, 10, 17), PROTOCOL_POWERCAP))
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("MSG TYPE   ", VAL_EXTRACT_BITS(rsp_msg_hdr, 8, 9), DELAYED_RESPONSE_MSG))
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("MSG ID     ", VAL_EXTRACT_BITS(rsp_msg_hdr, 0, 7),
+                    POWERCAP_CAP_SET_COMPLETE))
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("DOMAIN ID  ", return_values[DELAYED_RESP_DOMAIN_ID_OFFSET], domain_id))
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("POWER CAP  ", return_values[DELAYED_RESP_CAP_OFFSET], cap))
+        return VAL_STATUS_FAIL;
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t powercap_cap_check(uint32_t domain_id, uint32_t expected_cap)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    param_count++;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWERCAP, POWERCAP_CAP_GET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, &domain_id, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    val_print_return_values(return_value_count, return_values);
+
+    if (val_compare("POWER CAP  ", return_values[ATTRIBUTE_OFFSET], expected_cap))
+        return VAL_STATUS_FAIL;
+
+    return VAL_STATUS_PASS;
+}
+
+uint32_t powercap_set_cap(void)
+{
+    uint32_t domain_id, num_domains, attributes;
+    uint32_t current_cap, new_cap, min_cap, max_cap;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    num_domains = val_powercap_get_info(NUM_POWERCAP_DOMAINS, 0x0);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Powercap domains found                     ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM DOMAINS    : %d", num_domains);
+
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        val_print(VAL_PRINT_TEST, "\n       POWERCAP DOMAIN: %d", domain_id);
+
+        attributes = val_powercap_get_info(POWERCAP_DOMAIN_ATTRIBUTE, domain_id);
+        current_cap = val_powercap_get_info(POWERCAP_CURRENT_CAP, domain_id);
+        min_cap = val_powercap_get_info(POWERCAP_MIN_CAP, domain_id);
+        max_cap = val_powercap_get_info(POWERCAP_MAX_CAP, domain_id);
+
+        /* Fixed cap domains reject CAP_SET */
+        if (!VAL_EXTRACT_BITS(attributes, CAP_CONFIG_SUPPORT_BIT, CAP_CONFIG_SUPPORT_BIT)) {
+            val_print(VAL_PRINT_TEST, "\n     [Check 1] Set cap without cap configuration");
+            if (powercap_cap_set(domain_id, POWERCAP_SET_SYNC_MODE, current_cap,
+                                 SCMI_NOT_SUPPORTED) != VAL_STATUS_PASS)
+                return VAL_STATUS_FAIL;
+            continue;
+        }
+
+        /* STEP 1 : Set the far end of the range synchronously */
+        new_cap = (current_cap == min_cap) ? max_cap : min_cap;
+        val_print(VAL_PRINT_TEST, "\n     [Check 1] Set cap %d synchronously", new_cap);
+        if (powercap_cap_set(domain_id, POWERCAP_SET_SYNC_MODE, new_cap, SCMI_SUCCESS)
+            != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (powercap_cap_check(domain_id, new_cap) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        /* STEP 2 : Set the original cap back, asynchronously if supported */
+        if (VAL_EXTRACT_BITS(attributes, ASYNC_CAP_SET_SUPPORT_BIT, ASYNC_CAP_SET_SUPPORT_BIT)) {
+            val_print(VAL_PRINT_TEST, "\n     [Check 2] Set cap %d asynchronously", current_cap);
+            if (powercap_cap_set(domain_id, POWERCAP_SET_ASYNC_MODE, current_cap, SCMI_SUCCESS)
+                != VAL_STATUS_PASS)
+                return VAL_STATUS_FAIL;
+        }
+        else
+        {
+            val_print(VAL_PRINT_TEST, "\n     [Check 2] Async cap set not supported");
+            if (powercap_cap_set(domain_id, POWERCAP_SET_ASYNC_MODE, current_cap,
+                                 SCMI_NOT_SUPPORTED) != VAL_STATUS_PASS)
+                return VAL_STATUS_FAIL;
+
+            val_print(VAL_PRINT_TEST, "\n    [Step 3] Restore cap %d", current_cap);
+            if (powercap_cap_set(domain_id, POWERCAP_SET_SYNC_MODE, current_cap, SCMI_SUCCESS)
+                != VAL_STATUS_PASS)
+                return VAL_STATUS_FAIL;
+        }
+
+        if (powercap_cap_check(domain_id, current_cap) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+    }
+
+    return VAL_STATUS_PASS;
+}
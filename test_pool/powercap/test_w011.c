@@ -0,0 +1,132 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_powercap.h"
+
+#define TEST_NUM  (SCMI_POWERCAP_TEST_NUM_BASE + 11)
+#define TEST_DESC "Powercap set invalid cap check                 "
+
+#define PARAMETER_SIZE     3
+#define RESERVED_FLAGS     0x80000000
+
+/********* TEST ALGO ********************
+ * For each powercap domain with cap configuration support
+ *   Set a cap above the maximum cap, should fail with INVALID_PARAMETERS
+ *   Set a valid cap with a reserved flag bit, should fail with INVALID_PARAMETERS
+ *   Check the current cap is unchanged
+*****************************************/
+
+static uint32_t powercap_invalid_cap_set(uint32_t domain_id, uint32_t flags, uint32_t cap)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    parameters[param_count++] = flags;
+    parameters[param_count++] = cap;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWERCAP, POWERCAP_CAP_SET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_INVALID_PARAMETERS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    return VAL_STATUS_PASS;
+}
+
+uint32_t powercap_set_invalid_cap(void)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t domain_id, num_domains, attributes, current_cap, invalid_cap;
+    uint32_t tested = 0;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    num_domains = val_powercap_get_info(NUM_POWERCAP_DOMAINS, 0x0);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Powercap domains found                     ");
+        return VAL_STATUS_SKIP;
+    }
+
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        attributes = val_powercap_get_info(POWERCAP_DOMAIN_ATTRIBUTE, domain_id);
+        if (!VAL_EXTRACT_BITS(attributes, CAP_CONFIG_SUPPORT_BIT, CAP_CONFIG_SUPPORT_BIT))
+            continue;
+
+        tested++;
+        current_cap = val_powercap_get_info(POWERCAP_CURRENT_CAP, domain_id);
+        invalid_cap = val_powercap_get_info(POWERCAP_MAX_CAP, domain_id) +
+                      val_powercap_get_info(POWERCAP_CAP_STEP, domain_id) + 1;
+        val_print(VAL_PRINT_TEST, "\n       POWERCAP DOMAIN: %d", domain_id);
+
+        /* STEP 1 : Cap beyond the maximum cap */
+        val_print(VAL_PRINT_TEST, "\n     [Check 1] Set out of range cap %d", invalid_cap);
+        if (powercap_invalid_cap_set(domain_id, POWERCAP_SET_SYNC_MODE, invalid_cap)
+            != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        /* STEP 2 : Reserved flag bits set */
+        val_print(VAL_PRINT_TEST, "\n     [Check 2] Set cap with reserved flags 0x%08x",
+                  RESERVED_FLAGS);
+        if (powercap_invalid_cap_set(domain_id, RESERVED_FLAGS, current_cap) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        /* STEP 3 : Rejected requests leave the cap alone */
+        val_print(VAL_PRINT_TEST, "\n     [Check 3] Current cap unchanged");
+
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        param_count++;
+        cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWERCAP, POWERCAP_CAP_GET, COMMAND_MSG);
+        val_send_message(cmd_msg_hdr, param_count, &domain_id, &rsp_msg_hdr, &status,
+                         &return_value_count, return_values);
+
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        val_print_return_values(return_value_count, return_values);
+
+        if (val_compare("POWER CAP  ", return_values[ATTRIBUTE_OFFSET], current_cap))
+            return VAL_STATUS_FAIL;
+    }
+
+    if (tested == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No configurable Powercap domains found        ");
+        return VAL_STATUS_SKIP;
+    }
+
+    return VAL_STATUS_PASS;
+}
@@ -0,0 +1,102 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_powercap.h"
+
+#define TEST_NUM  (SCMI_POWERCAP_TEST_NUM_BASE + 12)
+#define TEST_DESC "Powercap measurements get check               "
+
+#define RETURN_VALUE_COUNT 2
+
+uint32_t powercap_query_measurements(void)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t domain_id, num_domains, attributes, pai;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    num_domains = val_powercap_get_info(NUM_POWERCAP_DOMAINS, 0x0);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Powercap domains found                     ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM DOMAINS    : %d", num_domains);
+
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        val_print(VAL_PRINT_TEST, "\n       POWERCAP DOMAIN: %d", domain_id);
+        attributes = val_powercap_get_info(POWERCAP_DOMAIN_ATTRIBUTE, domain_id);
+
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        param_count++;
+        cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWERCAP, POWERCAP_MEASUREMENTS_GET,
+                                         COMMAND_MSG);
+
+        /* Domains without monitoring support reject MEASUREMENTS_GET */
+        if (!VAL_EXTRACT_BITS(attributes, MONITORING_SUPPORT_BIT, MONITORING_SUPPORT_BIT)) {
+            val_print(VAL_PRINT_TEST, "\n     [Check 1] Measurements without monitoring");
+            val_send_message(cmd_msg_hdr, param_count, &domain_id, &rsp_msg_hdr, &status,
+                             &return_value_count, return_values);
+
+            if (val_compare_status(status, SCMI_NOT_SUPPORTED) != VAL_STATUS_PASS)
+                return VAL_STATUS_FAIL;
+
+            if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+                return VAL_STATUS_FAIL;
+            continue;
+        }
+
+        val_print(VAL_PRINT_TEST, "\n     [Check 1] Query measurements");
+        val_send_message(cmd_msg_hdr, param_count, &domain_id, &rsp_msg_hdr, &status,
+                         &return_value_count, return_values);
+
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        val_print_return_values(return_value_count, return_values);
+
+        if (val_compare_return_count(return_value_count, RETURN_VALUE_COUNT))
+            return VAL_STATUS_FAIL;
+
+        pai = return_values[MEASUREMENT_PAI_OFFSET];
+        val_print(VAL_PRINT_TEST, "\n       POWER          : %d",
+                  return_values[MEASUREMENT_POWER_OFFSET]);
+        val_print(VAL_PRINT_TEST, "\n       PAI            : %d us", pai);
+
+        /* STEP 2 : Averaging interval is one the domain can be configured with */
+        val_print(VAL_PRINT_TEST, "\n     [Check 2] PAI within range");
+        if ((pai < val_powercap_get_info(POWERCAP_MIN_PAI, domain_id)) ||
+            (pai > val_powercap_get_info(POWERCAP_MAX_PAI, domain_id))) {
+            val_print(VAL_PRINT_ERR, "\n       PAI %d outside %d..%d", pai,
+                      val_powercap_get_info(POWERCAP_MIN_PAI, domain_id),
+                      val_powercap_get_info(POWERCAP_MAX_PAI, domain_id));
+            return VAL_STATUS_FAIL;
+        }
+    }
+
+    return VAL_STATUS_PASS;
+}
@@ -0,0 +1,358 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_powercap.h"
+#include "val_benchmark.h"
+
+#define TEST_NUM  (SCMI_POWERCAP_TEST_NUM_BASE + 14)
+#define TEST_DESC "Powercap cap enforcement latency benchmark     "
+
+#define PARAMETER_SIZE      3
+#define BENCH_ITERATIONS    4
+#define ENFORCE_POLL_LIMIT  100000
+#define SETTLE_WINDOW_LIMIT 100
+#define SETTLE_TOLERANCE    100   /* readings one PAI apart within 1/100 */
+
+/********* TEST ALGO ********************
+ * For each powercap domain with cap configuration and monitoring support
+ *   Save the current cap
+ *   For sync mode, and async mode if the domain supports it
+ *     Repeat BENCH_ITERATIONS times
+ *       Lift the cap to the maximum and wait for measured power to settle,
+ *       that is to change by less than 1% over one averaging interval
+ *       Pick a cap on the cap grid halfway between the minimum cap and the
+ *       settled power
+ *       Time the CAP_SET command, the CAP_SET_COMPLETE delayed response in
+ *       async mode, and poll MEASUREMENTS_GET until measured power is at or
+ *       under the new cap
+ *   Restore the saved cap, also after a failed check
+*****************************************/
+
+static VAL_HIST_s g_cmd_hist;
+static VAL_HIST_s g_dresp_hist;
+static VAL_HIST_s g_enforce_hist;
+
+static uint32_t powercap_bench_measure(uint32_t domain_id, uint32_t *power, uint32_t *pai)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWERCAP, POWERCAP_MEASUREMENTS_GET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    *power = return_values[MEASUREMENT_POWER_OFFSET];
+    if (pai != NULL)
+        *pai = return_values[MEASUREMENT_PAI_OFFSET];
+
+    return VAL_STATUS_PASS;
+}
+
+/* Send CAP_SET, returning once the command, not the delayed response, is done */
+static uint32_t powercap_bench_cap_set(uint32_t domain_id, uint32_t mode, uint32_t cap)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    parameters[param_count++] = mode;
+    parameters[param_count++] = cap;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWERCAP, POWERCAP_CAP_SET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t powercap_bench_cap_set_complete(uint32_t domain_id, uint32_t cap)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    rsp_msg_hdr = 0;
+    return_value_count = 0;
+    status = SCMI_GENERIC_ERROR;
+    val_receive_delayed_response(&rsp_msg_hdr, &status, &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("MSG TYPE   ", VAL_EXTRACT_BITS(rsp_msg_hdr, 8, 9),
+                    DELAYED_RESPONSE_MSG))
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("MSG ID     ", VAL_EXTRACT_BITS(rsp_msg_hdr, 0, 7),
+                    POWERCAP_CAP_SET_COMPLETE))
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("DOMAIN ID  ", return_values[DELAYED_RESP_DOMAIN_ID_OFFSET], domain_id))
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("POWER CAP  ", return_values[DELAYED_RESP_CAP_OFFSET], cap))
+        return VAL_STATUS_FAIL;
+
+    return VAL_STATUS_PASS;
+}
+
+/* Wait until measured power holds still over one averaging interval */
+static uint32_t powercap_bench_settle(uint32_t domain_id, uint32_t *power)
+{
+    uint32_t window, reference, pai = 0, delta;
+    uint64_t window_start;
+
+    val_bench_quiet_begin();
+
+    if (powercap_bench_measure(domain_id, &reference, &pai) != VAL_STATUS_PASS) {
+        val_bench_quiet_end();
+        return VAL_STATUS_FAIL;
+    }
+
+    for (window = 0; window < SETTLE_WINDOW_LIMIT; window++)
+    {
+        window_start = val_get_time_ns();
+        do
+        {
+            if (powercap_bench_measure(domain_id, power, &pai) != VAL_STATUS_PASS) {
+                val_bench_quiet_end();
+                return VAL_STATUS_FAIL;
+            }
+        } while ((val_get_time_ns() - window_start) < (uint64_t)pai * 1000);
+
+        delta = (*power > reference) ? (*power - reference) : (reference - *power);
+        if ((uint64_t)delta * SETTLE_TOLERANCE <= reference) {
+            val_bench_quiet_end();
+            return VAL_STATUS_PASS;
+        }
+        reference = *power;
+    }
+
+    val_bench_quiet_end();
+    val_print(VAL_PRINT_ERR, "\n       Measured power did not settle, last read %d", *power);
+    return VAL_STATUS_FAIL;
+}
+
+/* Time one cap from the set command to measured power at or under it */
+static uint32_t powercap_bench_enforce(uint32_t domain_id, uint32_t mode, uint32_t max_cap,
+                                       uint32_t min_cap, uint32_t cap_step)
+{
+    uint64_t start_ns, cmd_ns, dresp_ns = 0, enforce_ns;
+    uint32_t poll, settled, cap, power = 0;
+
+    /* Untimed lift of the cap so the domain runs at its unconstrained load */
+    if (powercap_bench_cap_set(domain_id, POWERCAP_SET_SYNC_MODE, max_cap) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (powercap_bench_settle(domain_id, &settled) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (settled <= min_cap) {
+        val_print(VAL_PRINT_TEST, "\n       Load %d at or under the minimum cap, nothing to enforce",
+                  settled);
+        return VAL_STATUS_SKIP;
+    }
+
+    cap = min_cap;
+    if (cap_step)
+        cap += (((settled - min_cap) / 2) / cap_step) * cap_step;
+
+    val_bench_quiet_begin();
+
+    start_ns = val_get_time_ns();
+    if (powercap_bench_cap_set(domain_id, mode, cap) != VAL_STATUS_PASS) {
+        val_bench_quiet_end();
+        return VAL_STATUS_FAIL;
+    }
+    cmd_ns = val_get_time_ns() - start_ns;
+
+    if (mode == POWERCAP_SET_ASYNC_MODE) {
+        if (powercap_bench_cap_set_complete(domain_id, cap) != VAL_STATUS_PASS) {
+            val_bench_quiet_end();
+            return VAL_STATUS_FAIL;
+        }
+        dresp_ns = val_get_time_ns() - start_ns;
+    }
+
+    for (poll = 0; poll < ENFORCE_POLL_LIMIT; poll++)
+    {
+        if (powercap_bench_measure(domain_id, &power, NULL) != VAL_STATUS_PASS)
+            break;
+        if (power <= cap)
+            break;
+    }
+    enforce_ns = val_get_time_ns() - start_ns;
+
+    val_bench_quiet_end();
+
+    if (power > cap) {
+        val_print(VAL_PRINT_ERR, "\n       Cap %d not enforced, measured %d after %d polls",
+                  cap, power, poll);
+        return VAL_STATUS_FAIL;
+    }
+
+    val_hist_add(&g_cmd_hist, cmd_ns);
+    if (mode == POWERCAP_SET_ASYNC_MODE)
+        val_hist_add(&g_dresp_hist, dresp_ns);
+    val_hist_add(&g_enforce_hist, enforce_ns);
+
+    val_print(VAL_PRINT_TEST, "\n       %6d -> cap %6d  cmd %8llu ns  dresp %8llu ns  under cap %8llu ns  %d polls",
+              settled, cap, (unsigned long long)cmd_ns, (unsigned long long)dresp_ns,
+              (unsigned long long)enforce_ns, poll + 1);
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t powercap_bench_mode(uint32_t domain_id, uint32_t mode)
+{
+    uint32_t i, status = VAL_STATUS_PASS;
+    uint32_t min_cap = val_powercap_get_info(POWERCAP_MIN_CAP, domain_id);
+    uint32_t max_cap = val_powercap_get_info(POWERCAP_MAX_CAP, domain_id);
+    uint32_t cap_step = val_powercap_get_info(POWERCAP_CAP_STEP, domain_id);
+
+    val_hist_reset(&g_cmd_hist);
+    val_hist_reset(&g_dresp_hist);
+    val_hist_reset(&g_enforce_hist);
+
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        status = powercap_bench_enforce(domain_id, mode, max_cap, min_cap, cap_step);
+        if (status != VAL_STATUS_PASS)
+            break;
+    }
+
+    if (status == VAL_STATUS_FAIL)
+        return VAL_STATUS_FAIL;
+    if (g_enforce_hist.count == 0)
+        return VAL_STATUS_PASS;
+
+    val_print(VAL_PRINT_ERR, "\n       Domain %d %s : %d caps enforced", domain_id,
+              (mode == POWERCAP_SET_ASYNC_MODE) ? "async" : "sync ", g_enforce_hist.count);
+    val_hist_print(VAL_PRINT_ERR, "command ns", &g_cmd_hist);
+    if (mode == POWERCAP_SET_ASYNC_MODE)
+        val_hist_print(VAL_PRINT_ERR, "dresp ns", &g_dresp_hist);
+    val_hist_print(VAL_PRINT_ERR, "enforce ns", &g_enforce_hist);
+
+    return VAL_STATUS_PASS;
+}
+
+uint32_t powercap_cap_enforcement_benchmark(void)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t num_domains, domain_id, attributes, saved_cap;
+    uint32_t tested = 0, result;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No platform time source for benchmark      ");
+        return VAL_STATUS_SKIP;
+    }
+
+    num_domains = val_powercap_get_info(NUM_POWERCAP_DOMAINS, 0);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Powercap domains found                     ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM DOMAINS    : %d", num_domains);
+
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        attributes = val_powercap_get_info(POWERCAP_DOMAIN_ATTRIBUTE, domain_id);
+        if (!VAL_EXTRACT_BITS(attributes, CAP_CONFIG_SUPPORT_BIT, CAP_CONFIG_SUPPORT_BIT) ||
+            !VAL_EXTRACT_BITS(attributes, MONITORING_SUPPORT_BIT, MONITORING_SUPPORT_BIT))
+            continue;
+
+        tested++;
+        val_print(VAL_PRINT_TEST, "\n       POWERCAP DOMAIN: %d", domain_id);
+
+        /* STEP 1 : Save the current cap, the cap is untouched until it is saved */
+        val_print(VAL_PRINT_TEST, "\n    [Step 1] Save current cap");
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        param_count++;
+        cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_POWERCAP, POWERCAP_CAP_GET, COMMAND_MSG);
+        val_send_message(cmd_msg_hdr, param_count, &domain_id, &rsp_msg_hdr, &status,
+                         &return_value_count, return_values);
+
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        saved_cap = return_values[ATTRIBUTE_OFFSET];
+        val_print(VAL_PRINT_TEST, "\n       CAP            : %d", saved_cap);
+
+        /* STEP 2 : Enforce caps in each supported set mode */
+        val_print(VAL_PRINT_TEST, "\n    [Check 1] Enforce caps in sync mode");
+        result = powercap_bench_mode(domain_id, POWERCAP_SET_SYNC_MODE);
+
+        if (result == VAL_STATUS_PASS &&
+            VAL_EXTRACT_BITS(attributes, ASYNC_CAP_SET_SUPPORT_BIT, ASYNC_CAP_SET_SUPPORT_BIT)) {
+            val_print(VAL_PRINT_TEST, "\n    [Check 2] Enforce caps in async mode");
+            result = powercap_bench_mode(domain_id, POWERCAP_SET_ASYNC_MODE);
+        }
+
+        /* STEP 3 : Restore the saved cap, also after a failed check */
+        val_print(VAL_PRINT_TEST, "\n    [Step 3] Restore cap");
+        if (powercap_bench_cap_set(domain_id, POWERCAP_SET_SYNC_MODE, saved_cap)
+            != VAL_STATUS_PASS)
+            result = VAL_STATUS_FAIL;
+
+        if (result != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+    }
+
+    if (tested == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No capped and monitored domains found        ");
+        return VAL_STATUS_SKIP;
+    }
+
+    return VAL_STATUS_PASS;
+}
@@ -94,6 +94,7 @@ uint32_t reset_query_domain_attributes_scmi_v3(void)
         /* Save info for further tests*/
         val_reset_save_info(RESET_ASYNC_SUPPORT, domain_id, async_support);
         val_reset_save_info(RESET_NOTIFY_SUPPORT, domain_id, notification_support);
+        val_reset_save_info(RESET_DOMAIN_LATENCY, domain_id, latency);
 
         if (val_compare_str("DOMAIN NAME", (char *)&return_values[NAME_OFFSET],
                             (char *)val_reset_get_expected_name(domain_id), SCMI_NAME_STR_SIZE))
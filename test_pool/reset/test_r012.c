@@ -0,0 +1,301 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_reset.h"
+#include "val_benchmark.h"
+
+#define TEST_NUM  (SCMI_RESET_TEST_NUM_BASE + 12)
+#define TEST_DESC "Reset latency benchmark                      "
+
+#define PARAMETER_SIZE     3
+#define BENCH_ITERATIONS   4
+#define NUM_RESET_MODES    2
+#define NUM_RESET_OPS      3
+#define SYNC_RESET         0
+#define ASYNC_RESET        1
+
+/********* TEST ALGO ********************
+ * For each reset domain
+ *   Enable RESET_ISSUED notification if the domain supports it
+ *   In sync mode repeatedly issue an autonomous reset, an explicit
+ *     assert and an explicit deassert
+ *   If async mode is supported, repeatedly issue an async autonomous
+ *     reset, the only reset the async flag applies to
+ *   Time completion through the response in sync mode or the delayed
+ *   response in async mode, and the arrival of RESET_ISSUED
+ *   Disable notification
+ *   If a reset fails, deassert the domain and disable notification first
+ *   Compare the worst completion time with the advertised latency
+*****************************************/
+
+static char *g_reset_op_names[NUM_RESET_OPS] = {
+    "autonomous",
+    "assert",
+    "deassert"
+};
+
+static uint32_t g_reset_op_flags[NUM_RESET_OPS] = {
+    (1 << RESET_FLAG_AUTONOMOUS_RESET_BIT),
+    (1 << RESET_FLAG_EXPLICIT_SIGNAL_BIT),
+    EXPLICIT_SYNC_DEASSERT_RESET
+};
+
+static VAL_HIST_s g_done_hist[NUM_RESET_MODES][NUM_RESET_OPS];
+static VAL_HIST_s g_notify_hist[NUM_RESET_MODES][NUM_RESET_OPS];
+
+/* Async is only defined for autonomous resets, the first operation */
+static uint32_t reset_bench_num_ops(uint32_t mode)
+{
+    return (mode == ASYNC_RESET) ? 1 : NUM_RESET_OPS;
+}
+
+static int32_t reset_bench_notify(uint32_t domain_id, uint32_t notify_enable)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    parameters[param_count++] = notify_enable;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_RESET, RESET_PROTOCOL_NOTIFY, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+/* Release the domain from an explicit assert left behind by a failed step */
+static int32_t reset_bench_deassert(uint32_t domain_id)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    parameters[param_count++] = EXPLICIT_SYNC_DEASSERT_RESET;
+    parameters[param_count++] = ARCH_COLD_RESET;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_RESET, RESET_PROTOCOL_RESET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+/* Issue one reset and record its completion and notification times */
+static uint32_t reset_bench_measure(uint32_t domain_id, uint32_t mode, uint32_t op,
+                                    uint32_t notify)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+    uint64_t start_ns;
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    parameters[param_count++] = g_reset_op_flags[op] |
+                                ((mode == ASYNC_RESET) ? (1 << RESET_FLAG_ASYNC_RESET_BIT) : 0);
+    parameters[param_count++] = ARCH_COLD_RESET;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_RESET, RESET_PROTOCOL_RESET, COMMAND_MSG);
+
+    start_ns = val_get_time_ns();
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (mode == ASYNC_RESET) {
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        val_receive_delayed_response(&rsp_msg_hdr, &status, &return_value_count, return_values);
+
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        if (val_compare("MSG TYPE   ", VAL_EXTRACT_BITS(rsp_msg_hdr, 8, 9),
+                        DELAYED_RESPONSE_MSG))
+            return VAL_STATUS_FAIL;
+        if (val_compare("MSG ID     ", VAL_EXTRACT_BITS(rsp_msg_hdr, 0, 7), RESET_COMPLETE))
+            return VAL_STATUS_FAIL;
+        if (val_compare("DOMAIN ID  ", return_values[RESET_DELAYED_RESP_DOMAIN_OFFSET],
+                        domain_id))
+            return VAL_STATUS_FAIL;
+    }
+    val_hist_add(&g_done_hist[mode][op], val_get_time_ns() - start_ns);
+
+    /* RESET_ISSUED follows resets that are issued, a deassert only releases one */
+    if (notify && g_reset_op_flags[op] != EXPLICIT_SYNC_DEASSERT_RESET) {
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        val_receive_notification(&rsp_msg_hdr, &return_value_count, return_values);
+
+        if (val_compare("PROTOCOL ID", VAL_EXTRACT_BITS(rsp_msg_hdr, 10, 17), PROTOCOL_RESET))
+            return VAL_STATUS_FAIL;
+        if (val_compare("MSG TYPE   ", VAL_EXTRACT_BITS(rsp_msg_hdr, 8, 9), NOTIFICATION_MSG))
+            return VAL_STATUS_FAIL;
+        if (val_compare("MSG ID     ", VAL_EXTRACT_BITS(rsp_msg_hdr, 0, 7), RESET_ISSUED))
+            return VAL_STATUS_FAIL;
+        if (val_compare("DOMAIN ID  ", return_values[RESET_NOTIFY_DOMAIN_OFFSET], domain_id))
+            return VAL_STATUS_FAIL;
+        val_hist_add(&g_notify_hist[mode][op], val_get_time_ns() - start_ns);
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+static void reset_bench_print_table(uint32_t domain_id, uint32_t async_support,
+                                    uint32_t latency_us)
+{
+    uint32_t mode, op;
+    uint64_t latency_ns;
+    VAL_HIST_s *done, *notify;
+
+    if (latency_us == RESET_LATENCY_UNKNOWN)
+        val_print(VAL_PRINT_ERR, "\n       Domain %d advertised latency unknown", domain_id);
+    else
+        val_print(VAL_PRINT_ERR, "\n       Domain %d advertised latency %d us", domain_id,
+                  latency_us);
+    val_print(VAL_PRINT_ERR, "\n       mode  op           done p50/max (ns)  notify p50/max (ns)");
+
+    latency_ns = (uint64_t)latency_us * NS_PER_US;
+    for (mode = 0; mode < NUM_RESET_MODES; mode++)
+    {
+        if (mode == ASYNC_RESET && !async_support)
+            continue;
+
+        for (op = 0; op < reset_bench_num_ops(mode); op++)
+        {
+            done = &g_done_hist[mode][op];
+            notify = &g_notify_hist[mode][op];
+            val_print(VAL_PRINT_ERR, "\n       %-5s %-10s %9llu/%-9llu",
+                      (mode == ASYNC_RESET) ? "async" : "sync",
+                      g_reset_op_names[op],
+                      (unsigned long long)val_hist_percentile(done, 50),
+                      (unsigned long long)done->max);
+            if (notify->count)
+                val_print(VAL_PRINT_ERR, " %9llu/%-9llu",
+                          (unsigned long long)val_hist_percentile(notify, 50),
+                          (unsigned long long)notify->max);
+            else
+                val_print(VAL_PRINT_ERR, "         -/-         ");
+
+            if (latency_us != RESET_LATENCY_UNKNOWN && done->max > latency_ns)
+                val_print(VAL_PRINT_ERR, " exceeds advertised by %llu ns",
+                          (unsigned long long)(done->max - latency_ns));
+        }
+    }
+}
+
+uint32_t reset_latency_benchmark(void)
+{
+    uint32_t num_domains, domain_id;
+    uint32_t async_support, notify, latency;
+    uint32_t mode, op, iteration, result;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No platform time source for benchmark      ");
+        return VAL_STATUS_SKIP;
+    }
+
+    num_domains = val_reset_get_info(NUM_RESET_DOMAINS, 0x00);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No reset domains found                     ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM DOMAINS    : %d", num_domains);
+
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        val_print(VAL_PRINT_TEST, "\n     RESET DOMAIN ID: %d", domain_id);
+
+        async_support = val_reset_get_info(RESET_ASYNC_SUPPORT, domain_id);
+        latency = val_reset_get_info(RESET_DOMAIN_LATENCY, domain_id);
+
+        notify = 0;
+        if (val_reset_get_info(RESET_NOTIFY_SUPPORT, domain_id)) {
+            val_print(VAL_PRINT_TEST, "\n     [Step 1] Enable reset issued notification");
+            notify = (reset_bench_notify(domain_id, RESET_NOTIFY_ENABLE) == SCMI_SUCCESS);
+        }
+
+        for (mode = 0; mode < NUM_RESET_MODES; mode++)
+            for (op = 0; op < NUM_RESET_OPS; op++) {
+                val_hist_reset(&g_done_hist[mode][op]);
+                val_hist_reset(&g_notify_hist[mode][op]);
+            }
+
+        result = VAL_STATUS_PASS;
+        for (mode = 0; mode < NUM_RESET_MODES && result == VAL_STATUS_PASS; mode++)
+        {
+            if (mode == ASYNC_RESET && !async_support)
+                continue;
+
+            val_print(VAL_PRINT_TEST, "\n     [Check 1] Issue resets in %s mode",
+                      (mode == ASYNC_RESET) ? "async" : "sync");
+            val_bench_quiet_begin();
+            for (iteration = 0; iteration < BENCH_ITERATIONS && result == VAL_STATUS_PASS;
+                 iteration++)
+                for (op = 0; op < reset_bench_num_ops(mode) && result == VAL_STATUS_PASS;
+                     op++)
+                    result = reset_bench_measure(domain_id, mode, op, notify);
+            val_bench_quiet_end();
+        }
+
+        /* A failure between assert and deassert leaves the domain held in reset */
+        if (result != VAL_STATUS_PASS) {
+            val_print(VAL_PRINT_TEST, "\n       Deassert the domain after the failure");
+            reset_bench_deassert(domain_id);
+        }
+
+        if (notify) {
+            val_print(VAL_PRINT_TEST, "\n     [Step 2] Disable reset issued notification");
+            if (val_compare_status(reset_bench_notify(domain_id, RESET_NOTIFY_DISABLE),
+                                   SCMI_SUCCESS) != VAL_STATUS_PASS)
+                result = VAL_STATUS_FAIL;
+        }
+
+        if (result != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        reset_bench_print_table(domain_id, async_support, latency);
+    }
+
+    return VAL_STATUS_PASS;
+}
@@ -37,7 +37,7 @@ uint32_t sensor_query_description_get_scmi_v3(void)
     uint32_t total_sensors = 0;
     uint32_t i, desc_index = 0, sensor_id;
     uint32_t async_support, num_trip_points, cont_update_notify_support;
-    uint32_t timestamp_support, ext_attr_support;
+    uint32_t timestamp_support, timestamp_exponent, ext_attr_support;
     uint32_t *sensor_desc, num_sensor_flag;
     uint32_t num_axis, unit_exponent, axis_support;
     uint32_t sensor_type;
@@ -97,8 +97,8 @@ uint32_t sensor_query_description_get_scmi_v3(void)
                     sensor_desc[1 + (i * SENSOR_DESC_LEN)], 15, 29)) != VAL_STATUS_PASS)
                 return VAL_STATUS_FAIL;
 
-            val_print(VAL_PRINT_DEBUG, "\n       Timestamp exponent     : %d",
-                        VAL_EXTRACT_BITS(sensor_desc[1 + (i * SENSOR_DESC_LEN)], 10, 14));
+            timestamp_exponent = VAL_EXTRACT_BITS(sensor_desc[1 + (i * SENSOR_DESC_LEN)], 10, 14);
+            val_print(VAL_PRINT_DEBUG, "\n       Timestamp exponent     : %d", timestamp_exponent);
 
             timestamp_support = VAL_EXTRACT_BITS(sensor_desc[1 + (i * SENSOR_DESC_LEN)], 9, 9);
             val_print(VAL_PRINT_DEBUG, "\n       Time stamp support     : %d", timestamp_support);
@@ -170,6 +170,8 @@ uint32_t sensor_query_description_get_scmi_v3(void)
                                           sensor_id, cont_update_notify_support);
             val_sensor_ext_save_desc_info(SENSOR_TIMESTAMP_SUPPORT,
                                           sensor_id, timestamp_support);
+            val_sensor_ext_save_desc_info(SENSOR_TIMESTAMP_EXPONENT,
+                                          sensor_id, timestamp_exponent);
             val_sensor_ext_save_desc_info(SENSOR_NUM_OF_AXIS, sensor_id, num_axis);
             val_sensor_ext_save_desc_info(SENSOR_AXIS_SUPPORT, sensor_id, axis_support);
 
@@ -21,7 +21,7 @@
 #define TEST_NUM  (SCMI_SENSOR_TEST_NUM_BASE + 24)
 #define TEST_DESC "Sensor request sensor update notification check"
 
-#define MAX_PARAMETER_SIZE        1
+#define MAX_PARAMETER_SIZE        2
 
 uint32_t sensor_request_sensor_notification_check(void)
 {
@@ -106,6 +106,23 @@ uint32_t sensor_request_sensor_notification_check(void)
 
         val_print_return_values(return_value_count, return_values);
 
+        /* Leave no update stream running behind the test */
+        val_print(VAL_PRINT_TEST, "\n     [Check 3] Sensor disable update notification");
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        parameters[param_count++] = sensor_id;
+        notify_enable = val_get_notify_enable_config(DISABLED);
+        parameters[param_count++] = notify_enable;
+
+        val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                         &return_value_count, return_values);
+
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        val_print_return_values(return_value_count, return_values);
     }
 
     return VAL_STATUS_PASS;
@@ -0,0 +1,293 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_sensor.h"
+#include "val_benchmark.h"
+
+#define TEST_NUM  (SCMI_SENSOR_TEST_NUM_BASE + 26)
+#define TEST_DESC "Sensor multi-axis reading capture check       "
+
+#define MAX_PARAMETER_SIZE  2
+#define NUM_CAPTURE_SAMPLES SENSOR_CAPTURE_MAX_SAMPLES
+
+/********* TEST ALGO ********************
+ * For each sensor
+ *   Capture NUM_CAPTURE_SAMPLES synchronous readings, checking every
+ *   response holds one reading structure per axis
+ *   If continuous update notifications are supported, enable them,
+ *   capture the SENSOR_UPDATE notification that follows every reading,
+ *   matched by timestamp so stale updates are dropped, and disable them
+ *   again, dropping any update still queued
+ *   Check timestamps do not go backwards if the sensor reports them
+ *   Print min, max, mean and standard deviation per axis
+*****************************************/
+
+static SENSOR_CAPTURE_s g_capture;
+
+static int32_t sensor_capture_notify(uint32_t sensor_id, uint32_t notify_enable)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[MAX_PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = sensor_id;
+    parameters[param_count++] = val_get_notify_enable_config(notify_enable);
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_SENSOR, SENSOR_CONTINUOUS_UPDATE_NOTIFY,
+                                     COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+/*
+ * Disable update notifications and drop those still queued, such as updates
+ * that reads by another agent triggered during the capture
+ */
+static int32_t sensor_capture_stop(uint32_t sensor_id)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr, i;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    status = sensor_capture_notify(sensor_id, DISABLED);
+    for (i = 0; i < NUM_CAPTURE_SAMPLES; i++)
+    {
+        rsp_msg_hdr = 0;
+        val_receive_notification(&rsp_msg_hdr, &return_value_count, return_values);
+        if (rsp_msg_hdr == 0)
+            break;
+    }
+
+    return status;
+}
+
+/* Timestamp of the first axis of a reading, zero if the sensor has none */
+static uint64_t sensor_capture_timestamp(const uint32_t *readings)
+{
+    return ((uint64_t)readings[SENSOR_READING_TS_HIGH_OFFSET] << 32) |
+           readings[SENSOR_READING_TS_LOW_OFFSET];
+}
+
+/*
+ * Wait for the update carrying the reading taken at read_ts. Updates for
+ * other sensors and older ones, such as those triggered by another agent's
+ * reads, are dropped. A sensor without timestamps takes the first update.
+ */
+static uint32_t sensor_capture_update(uint32_t sensor_id, uint64_t read_ts)
+{
+    uint32_t rsp_msg_hdr, i;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    for (i = 0; i < NUM_CAPTURE_SAMPLES; i++)
+    {
+        rsp_msg_hdr = 0;
+        return_value_count = 0;
+        val_receive_notification(&rsp_msg_hdr, &return_value_count, return_values);
+        if (rsp_msg_hdr == 0)
+            break;
+
+        if ((VAL_EXTRACT_BITS(rsp_msg_hdr, 10, 17) != PROTOCOL_SENSOR) ||
+            (VAL_EXTRACT_BITS(rsp_msg_hdr, 8, 9) != NOTIFICATION_MSG) ||
+            (VAL_EXTRACT_BITS(rsp_msg_hdr, 0, 7) != SENSOR_UPDATE) ||
+            (return_value_count < SENSOR_UPDATE_READINGS_OFFSET + SENSOR_READING_WORDS) ||
+            (return_values[SENSOR_UPDATE_SENSOR_ID_OFFSET] != sensor_id))
+            continue;
+
+        if (sensor_capture_timestamp(&return_values[SENSOR_UPDATE_READINGS_OFFSET]) < read_ts)
+            continue;
+
+        if (val_sensor_capture_add(&g_capture, &return_values[SENSOR_UPDATE_READINGS_OFFSET],
+                                   return_value_count - SENSOR_UPDATE_READINGS_OFFSET)) {
+            val_compare("READING WORDS", return_value_count - SENSOR_UPDATE_READINGS_OFFSET,
+                        g_capture.num_axes * SENSOR_READING_WORDS);
+            return VAL_STATUS_FAIL;
+        }
+        return VAL_STATUS_PASS;
+    }
+
+    val_print(VAL_PRINT_ERR, "\n       No SENSOR_UPDATE for sensor %d after %d notifications",
+              sensor_id, i);
+    return VAL_STATUS_FAIL;
+}
+
+/* Read the sensor once, decoding the response or the update it triggers */
+static uint32_t sensor_capture_sample(uint32_t sensor_id, uint32_t from_notification)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[MAX_PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = sensor_id;
+    parameters[param_count++] = SENSOR_READ_SYNC_MODE;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_SENSOR, SENSOR_READING_GET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (from_notification) {
+        if (val_compare("READING WORDS", return_value_count,
+                        g_capture.num_axes * SENSOR_READING_WORDS))
+            return VAL_STATUS_FAIL;
+        return sensor_capture_update(sensor_id, sensor_capture_timestamp(return_values));
+    }
+
+    if (val_sensor_capture_add(&g_capture, return_values, return_value_count)) {
+        val_compare("READING WORDS", return_value_count,
+                    g_capture.num_axes * SENSOR_READING_WORDS);
+        return VAL_STATUS_FAIL;
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+/* Check prints are held back so a capture does not print every response */
+static uint32_t sensor_capture_run(uint32_t sensor_id, uint32_t num_axes,
+                                   uint32_t from_notification)
+{
+    uint32_t sample, result = VAL_STATUS_PASS;
+
+    val_sensor_capture_init(&g_capture, num_axes);
+
+    val_bench_quiet_begin();
+    for (sample = 0; sample < NUM_CAPTURE_SAMPLES; sample++)
+    {
+        result = sensor_capture_sample(sensor_id, from_notification);
+        if (result != VAL_STATUS_PASS)
+            break;
+    }
+    val_bench_quiet_end();
+
+    return result;
+}
+
+static uint32_t sensor_capture_check_timestamps(void)
+{
+    uint32_t axis, sample;
+
+    for (axis = 0; axis < g_capture.num_axes; axis++)
+    {
+        for (sample = 1; sample < g_capture.num_samples; sample++)
+        {
+            if (g_capture.timestamp[axis][sample] < g_capture.timestamp[axis][sample - 1]) {
+                val_print(VAL_PRINT_ERR, "\n       CHECK TIMESTAMP: FAILED axis %d sample %d",
+                          axis, sample);
+                return VAL_STATUS_FAIL;
+            }
+        }
+    }
+    val_print(VAL_PRINT_TEST, "\n       CHECK TIMESTAMP: PASSED [non decreasing]     ");
+
+    return VAL_STATUS_PASS;
+}
+
+static void sensor_capture_print_stats(const char *source)
+{
+    uint32_t axis;
+    SENSOR_AXIS_STATS_s stats;
+
+    val_print(VAL_PRINT_ERR, "\n       %s: %d samples, %d dropped", source,
+              g_capture.num_samples, g_capture.num_dropped);
+    val_print(VAL_PRINT_ERR, "\n       axis          min          max         mean       stddev");
+    for (axis = 0; axis < g_capture.num_axes; axis++)
+    {
+        val_sensor_capture_stats(&g_capture, axis, &stats);
+        val_print(VAL_PRINT_ERR, "\n       %4d %12lld %12lld %12lld %12llu", axis,
+                  (long long)stats.min, (long long)stats.max, (long long)stats.mean,
+                  (unsigned long long)stats.stddev);
+    }
+}
+
+uint32_t sensor_multi_axis_reading_capture(void)
+{
+    uint32_t num_sensors, sensor_id, num_axes;
+    uint32_t timestamp_support, notify_support;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    num_sensors = val_sensor_get_info(NUM_SENSORS);
+    if (num_sensors == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Sensor found                             ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM SENSORS     : %d", num_sensors);
+
+    for (sensor_id = 0; sensor_id < num_sensors; sensor_id++)
+    {
+        num_axes = 1;
+        if (val_sensor_ext_get_desc_info(SENSOR_AXIS_SUPPORT, sensor_id))
+            num_axes = val_sensor_ext_get_desc_info(SENSOR_NUM_OF_AXIS, sensor_id);
+        timestamp_support = val_sensor_ext_get_desc_info(SENSOR_TIMESTAMP_SUPPORT, sensor_id);
+        notify_support = val_sensor_ext_get_desc_info(SENSOR_CONT_NOTIFY_UPDATE_SUPPORT,
+                                                      sensor_id);
+
+        val_print(VAL_PRINT_TEST, "\n     SENSOR ID: %d", sensor_id);
+        val_print(VAL_PRINT_DEBUG, "\n       NUM AXES       : %d", num_axes);
+        if ((num_axes == 0) || (num_axes > SENSOR_CAPTURE_MAX_AXES)) {
+            val_print(VAL_PRINT_ERR, "\n       Sensor %d has %d axes, capture skipped",
+                      sensor_id, num_axes);
+            continue;
+        }
+
+        val_print(VAL_PRINT_TEST, "\n     [Check 1] Capture synchronous readings");
+        if (sensor_capture_run(sensor_id, num_axes, 0) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        if (timestamp_support && (sensor_capture_check_timestamps() != VAL_STATUS_PASS))
+            return VAL_STATUS_FAIL;
+        sensor_capture_print_stats("READING_GET");
+
+        if (!notify_support)
+            continue;
+
+        val_print(VAL_PRINT_TEST, "\n     [Check 2] Capture sensor update notifications");
+        if (val_compare_status(sensor_capture_notify(sensor_id, ENABLED), SCMI_SUCCESS))
+            return VAL_STATUS_FAIL;
+        if (sensor_capture_run(sensor_id, num_axes, 1) != VAL_STATUS_PASS) {
+            sensor_capture_stop(sensor_id);
+            return VAL_STATUS_FAIL;
+        }
+        if (val_compare_status(sensor_capture_stop(sensor_id), SCMI_SUCCESS))
+            return VAL_STATUS_FAIL;
+        if (timestamp_support && (sensor_capture_check_timestamps() != VAL_STATUS_PASS))
+            return VAL_STATUS_FAIL;
+        sensor_capture_print_stats("SENSOR_UPDATE");
+    }
+
+    return VAL_STATUS_PASS;
+}
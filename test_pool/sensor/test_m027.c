@@ -0,0 +1,237 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_sensor.h"
+#include "val_benchmark.h"
+#include "val_correlation.h"
+
+#define TEST_NUM  (SCMI_SENSOR_TEST_NUM_BASE + 27)
+#define TEST_DESC "Sensor timestamp clock correlation check      "
+
+#define MAX_PARAMETER_SIZE  2
+#define NUM_CORRELATION_SAMPLES CORRELATION_MAX_SAMPLES
+/* Drift beyond 1000 ppm suggests a wrong timestamp exponent, not a slow clock */
+#define MAX_EXPECTED_DRIFT_PPB  1000000
+/* Samples are paced over twice the drift span so the end quarters stay far enough apart */
+#define CORRELATION_SAMPLE_SPAN_NS  (2 * CORRELATION_MIN_DRIFT_SPAN_NS)
+/* Allowed error against a drift the platform declares */
+#define DRIFT_TOLERANCE_PPB     20000
+
+/********* TEST ALGO ********************
+ * If the agent has no time source, skip the test
+ * For each sensor that reports timestamps
+ *   Send NUM_CORRELATION_SAMPLES synchronous READING_GET commands spread
+ *   over CORRELATION_SAMPLE_SPAN_NS, noting the agent time before each is
+ *   sent and after its response arrives
+ *   Convert the axis 0 timestamp to ns with the descriptor exponent
+ *   Check timestamps do not go backwards
+ *   Estimate the platform clock offset, drift and one way latency
+ *   Print how stale the readings were when they reached the agent
+ *   If the platform declares its clock drift, check the estimate against it
+*****************************************/
+
+static CORRELATION_s g_correlation;
+static CORRELATION_RESULT_s g_correlation_result;
+
+static uint32_t sensor_correlation_sample(uint32_t sensor_id, uint32_t timestamp_exponent)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[MAX_PARAMETER_SIZE];
+    uint64_t send_ns, recv_ns, timestamp;
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = sensor_id;
+    parameters[param_count++] = SENSOR_READ_SYNC_MODE;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_SENSOR, SENSOR_READING_GET, COMMAND_MSG);
+    send_ns = val_get_time_ns();
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+    recv_ns = val_get_time_ns();
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (return_value_count < SENSOR_READING_WORDS) {
+        val_compare("READING WORDS", return_value_count, SENSOR_READING_WORDS);
+        return VAL_STATUS_FAIL;
+    }
+
+    timestamp = ((uint64_t)return_values[SENSOR_READING_TS_HIGH_OFFSET] << 32) |
+                return_values[SENSOR_READING_TS_LOW_OFFSET];
+    val_correlation_add(&g_correlation, send_ns, recv_ns,
+                        val_sensor_timestamp_to_ns(timestamp, timestamp_exponent));
+
+    return VAL_STATUS_PASS;
+}
+
+/* Spin until the agent time given, samples are too short apart to sleep between */
+static void sensor_correlation_wait(uint64_t until_ns)
+{
+    while (val_get_time_ns() < until_ns)
+        ;
+}
+
+static uint32_t sensor_correlation_check_drift(void)
+{
+    CORRELATION_RESULT_s *result = &g_correlation_result;
+    int32_t expected_ppb;
+    int64_t error_ppb;
+
+    if (!result->drift_valid) {
+        val_print(VAL_PRINT_ERR, "\n       Drift samples only %llu ns apart, need %llu ns",
+                  (unsigned long long)result->drift_span_ns,
+                  (unsigned long long)CORRELATION_MIN_DRIFT_SPAN_NS);
+        return VAL_STATUS_FAIL;
+    }
+
+    if (val_sensor_get_expected_clock_drift(&expected_ppb) != VAL_STATUS_PASS) {
+        if ((result->drift_ppb > MAX_EXPECTED_DRIFT_PPB) ||
+            (result->drift_ppb < -MAX_EXPECTED_DRIFT_PPB))
+            val_print(VAL_PRINT_WARN, "\n       WARNING: drift above %d ppm, check the "
+                      "timestamp exponent", MAX_EXPECTED_DRIFT_PPB / 1000);
+        return VAL_STATUS_PASS;
+    }
+
+    error_ppb = result->drift_ppb - expected_ppb;
+    if ((error_ppb > DRIFT_TOLERANCE_PPB) || (error_ppb < -DRIFT_TOLERANCE_PPB)) {
+        val_print(VAL_PRINT_ERR, "\n       CHECK DRIFT: FAILED %lld ppb, expected %d +/- %d",
+                  (long long)result->drift_ppb, expected_ppb, DRIFT_TOLERANCE_PPB);
+        return VAL_STATUS_FAIL;
+    }
+    val_print(VAL_PRINT_TEST, "\n       CHECK DRIFT: PASSED [%d ppb expected]", expected_ppb);
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t sensor_correlation_check_timestamps(void)
+{
+    uint32_t i;
+
+    for (i = 1; i < g_correlation.num_samples; i++)
+    {
+        if (g_correlation.platform_ns[i] < g_correlation.platform_ns[i - 1]) {
+            val_print(VAL_PRINT_ERR, "\n       CHECK TIMESTAMP: FAILED sample %d", i);
+            return VAL_STATUS_FAIL;
+        }
+    }
+    val_print(VAL_PRINT_TEST, "\n       CHECK TIMESTAMP: PASSED [non decreasing]     ");
+
+    return VAL_STATUS_PASS;
+}
+
+static void sensor_correlation_print(uint32_t sensor_id)
+{
+    CORRELATION_RESULT_s *result = &g_correlation_result;
+
+    val_print(VAL_PRINT_ERR, "\n       SENSOR %d: %d samples", sensor_id,
+              g_correlation.num_samples);
+    val_print(VAL_PRINT_ERR, "\n         offset     %20lld ns", (long long)result->offset_ns);
+    val_print(VAL_PRINT_ERR, "\n         drift      %20lld ppb over %llu ns",
+              (long long)result->drift_ppb, (unsigned long long)result->drift_span_ns);
+    val_print(VAL_PRINT_ERR, "\n         min rtt    %20llu ns",
+              (unsigned long long)result->min_rtt_ns);
+    val_print(VAL_PRINT_ERR, "\n         one way    %20llu ns",
+              (unsigned long long)result->one_way_ns);
+    val_print(VAL_PRINT_ERR, "\n         staleness  min %llu p50 %llu p99 %llu max %llu ns",
+              (unsigned long long)result->staleness.min,
+              (unsigned long long)val_hist_percentile(&result->staleness, 50),
+              (unsigned long long)val_hist_percentile(&result->staleness, 99),
+              (unsigned long long)result->staleness.max);
+    if (result->num_future)
+        val_print(VAL_PRINT_ERR, "\n         %d readings stamped after they arrived",
+                  result->num_future);
+}
+
+uint32_t sensor_timestamp_clock_correlation(void)
+{
+    uint32_t num_sensors, sensor_id, num_checked = 0;
+    uint32_t timestamp_exponent, sample, result;
+    uint64_t start_ns;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No time source, correlation skipped         ");
+        return VAL_STATUS_SKIP;
+    }
+
+    num_sensors = val_sensor_get_info(NUM_SENSORS);
+    if (num_sensors == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Sensor found                             ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM SENSORS     : %d", num_sensors);
+
+    for (sensor_id = 0; sensor_id < num_sensors; sensor_id++)
+    {
+        if (!val_sensor_ext_get_desc_info(SENSOR_TIMESTAMP_SUPPORT, sensor_id))
+            continue;
+        timestamp_exponent = val_sensor_ext_get_desc_info(SENSOR_TIMESTAMP_EXPONENT, sensor_id);
+
+        val_print(VAL_PRINT_TEST, "\n     SENSOR ID: %d", sensor_id);
+        val_print(VAL_PRINT_DEBUG, "\n       TIMESTAMP EXP  : %d", timestamp_exponent);
+
+        val_print(VAL_PRINT_TEST, "\n     [Check 1] Pair timestamps with agent times");
+        val_correlation_init(&g_correlation);
+        result = VAL_STATUS_PASS;
+        val_bench_quiet_begin();
+        start_ns = val_get_time_ns();
+        for (sample = 0; sample < NUM_CORRELATION_SAMPLES; sample++)
+        {
+            sensor_correlation_wait(start_ns + (CORRELATION_SAMPLE_SPAN_NS * sample) /
+                                    (NUM_CORRELATION_SAMPLES - 1));
+            result = sensor_correlation_sample(sensor_id, timestamp_exponent);
+            if (result != VAL_STATUS_PASS)
+                break;
+        }
+        val_bench_quiet_end();
+        if (result != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (sensor_correlation_check_timestamps() != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        val_print(VAL_PRINT_TEST, "\n     [Check 2] Estimate platform clock");
+        if (val_correlation_estimate(&g_correlation, &g_correlation_result) != VAL_STATUS_PASS) {
+            val_print(VAL_PRINT_ERR, "\n       Too few samples to correlate");
+            return VAL_STATUS_FAIL;
+        }
+        sensor_correlation_print(sensor_id);
+
+        val_print(VAL_PRINT_TEST, "\n     [Check 3] Compare drift with the platform");
+        if (sensor_correlation_check_drift() != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        num_checked++;
+    }
+
+    if (num_checked == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No sensor reports timestamps                ");
+        return VAL_STATUS_SKIP;
+    }
+
+    return VAL_STATUS_PASS;
+}
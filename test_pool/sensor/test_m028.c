@@ -0,0 +1,404 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_sensor.h"
+#include "val_benchmark.h"
+
+#define TEST_NUM  (SCMI_SENSOR_TEST_NUM_BASE + 28)
+#define TEST_DESC "Sensor trip point notification storm         "
+
+#define MAX_PARAMETER_SIZE  4
+#define STORM_PROBE_MS      2
+#define STORM_MAX_TRIP_POINTS 16
+/* A reading is taken every this many notification polls during the storm */
+#define STORM_READ_EVERY    64
+#define STORM_MAX_DRAIN     1024
+#define TRIP_POINT_DESC_ID_MASK  0xFF
+#define TRIP_POINT_DESC_DIR_UP   (1u << 16)
+#define TRIP_POINT_EVENT_SENSOR_ID_OFFSET 1
+#define TRIP_POINT_EVENT_DESC_OFFSET      2
+
+/********* TEST ALGO ********************
+ * If trip point config or notify is not supported, or there is no time
+ * source, skip the test
+ * For each sensor with trip points
+ *   Read the sensor for STORM_PROBE_MS to find the range it moves over
+ *   Arm every trip point, evenly spaced across that range, for crossings in
+ *   either direction and enable trip point notifications
+ *   For SENSOR_STORM_WINDOW_MS collect notifications, reading the sensor
+ *   every STORM_READ_EVERY polls to time commands under the storm and to
+ *   count the crossings the agent sees itself
+ *   Events of one trip point must alternate direction; a repeat means the
+ *   platform lost or coalesced the crossings in between
+ *   Disarm, drain the channel and check a command still completes
+*****************************************/
+
+typedef struct {
+    uint32_t num_trip_points;
+    int64_t  threshold[STORM_MAX_TRIP_POINTS];
+    uint32_t last_dir[STORM_MAX_TRIP_POINTS];   /* 0 until the first event */
+    uint32_t num_events;
+    uint32_t num_gaps;
+    uint32_t num_polled_crossings;
+    uint32_t num_drained;
+    uint32_t num_empty_polls;
+    uint64_t window_ns;
+    VAL_HIST_s cmd_latency;
+} STORM_STATS_s;
+
+static STORM_STATS_s g_storm;
+
+static uint32_t sensor_storm_supported(uint32_t message_id)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    param_count++;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_SENSOR, SENSOR_PROTOCOL_MESSAGE_ATTRIBUTES,
+                                     COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, &message_id, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    return (status == SCMI_SUCCESS);
+}
+
+static int32_t sensor_storm_command(uint32_t message_id, uint32_t param_count,
+                                    uint32_t *parameters, int64_t *value)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    rsp_msg_hdr = 0;
+    return_value_count = 0;
+    status = SCMI_GENERIC_ERROR;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_SENSOR, message_id, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    if ((status == SCMI_SUCCESS) && value) {
+        if (return_value_count <= SENSOR_READING_VAL_HIGH_OFFSET)
+            return SCMI_PROTOCOL_ERROR;
+        *value = (int64_t)(((uint64_t)return_values[SENSOR_READING_VAL_HIGH_OFFSET] << 32) |
+                           return_values[SENSOR_READING_VAL_LOW_OFFSET]);
+    }
+
+    return status;
+}
+
+static int32_t sensor_storm_read(uint32_t sensor_id, int64_t *value)
+{
+    uint32_t parameters[MAX_PARAMETER_SIZE];
+
+    parameters[0] = sensor_id;
+    parameters[1] = SENSOR_READ_SYNC_MODE;
+
+    return sensor_storm_command(SENSOR_READING_GET, 2, parameters, value);
+}
+
+static int32_t sensor_storm_notify(uint32_t sensor_id, uint32_t notify_enable)
+{
+    uint32_t parameters[MAX_PARAMETER_SIZE];
+
+    parameters[0] = sensor_id;
+    parameters[1] = notify_enable;
+
+    return sensor_storm_command(SENSOR_TRIP_POINT_NOTIFY, 2, parameters, NULL);
+}
+
+static int32_t sensor_storm_arm(uint32_t sensor_id, uint32_t trip_point_id, uint32_t ev_ctrl,
+                                int64_t threshold)
+{
+    uint32_t parameters[MAX_PARAMETER_SIZE];
+
+    parameters[0] = sensor_id;
+    parameters[1] = (trip_point_id << TRIP_POINT_ID_LOW) | ev_ctrl;
+    parameters[2] = (uint32_t)threshold;
+    parameters[3] = (uint32_t)((uint64_t)threshold >> 32);
+
+    return sensor_storm_command(SENSOR_TRIP_POINT_CONFIG, 4, parameters, NULL);
+}
+
+/* Count the thresholds the sensor moved across between two readings */
+static void sensor_storm_count_crossings(int64_t previous, int64_t value)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_storm.num_trip_points; i++)
+    {
+        if (((previous < g_storm.threshold[i]) && (value >= g_storm.threshold[i])) ||
+            ((previous >= g_storm.threshold[i]) && (value < g_storm.threshold[i])))
+            g_storm.num_polled_crossings++;
+    }
+}
+
+/*
+ * Poll the channel once. Returns VAL_STATUS_PASS if a trip point event for
+ * the sensor was taken, VAL_STATUS_SKIP if nothing was pending.
+ */
+static uint32_t sensor_storm_poll(uint32_t sensor_id)
+{
+    uint32_t rsp_msg_hdr = 0;
+    size_t   return_value_count = 0;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t trip_point_id, dir;
+
+    val_receive_notification(&rsp_msg_hdr, &return_value_count, return_values);
+    if (rsp_msg_hdr == 0)
+        return VAL_STATUS_SKIP;
+
+    if (val_compare("PROTOCOL ID", VAL_EXTRACT_BITS(rsp_msg_hdr, 10, 17), PROTOCOL_SENSOR))
+        return VAL_STATUS_FAIL;
+    if (val_compare("MSG TYPE   ", VAL_EXTRACT_BITS(rsp_msg_hdr, 8, 9), NOTIFICATION_MSG))
+        return VAL_STATUS_FAIL;
+    if (val_compare("MSG ID     ", VAL_EXTRACT_BITS(rsp_msg_hdr, 0, 7),
+                    SENSOR_TRIP_POINT_EVENT))
+        return VAL_STATUS_FAIL;
+    if (return_value_count <= TRIP_POINT_EVENT_DESC_OFFSET) {
+        val_compare("PAYLOAD WORDS", return_value_count, TRIP_POINT_EVENT_DESC_OFFSET + 1);
+        return VAL_STATUS_FAIL;
+    }
+    if (val_compare("SENSOR ID  ", return_values[TRIP_POINT_EVENT_SENSOR_ID_OFFSET], sensor_id))
+        return VAL_STATUS_FAIL;
+
+    trip_point_id = return_values[TRIP_POINT_EVENT_DESC_OFFSET] & TRIP_POINT_DESC_ID_MASK;
+    if (trip_point_id >= g_storm.num_trip_points) {
+        val_print(VAL_PRINT_ERR, "\n       Event for unarmed trip point %d", trip_point_id);
+        return VAL_STATUS_FAIL;
+    }
+
+    dir = (return_values[TRIP_POINT_EVENT_DESC_OFFSET] & TRIP_POINT_DESC_DIR_UP) ?
+          TRIP_POINT_CROSSED_POISTIVE_DIR : TRIP_POINT_CROSSED_NEGETIVE_DIR;
+    if (g_storm.last_dir[trip_point_id] == dir)
+        g_storm.num_gaps++;
+    g_storm.last_dir[trip_point_id] = dir;
+    g_storm.num_events++;
+
+    return VAL_STATUS_PASS;
+}
+
+/* Read the sensor for a while to find the range its value moves over */
+static uint32_t sensor_storm_probe(uint32_t sensor_id, int64_t *min, int64_t *max)
+{
+    uint64_t end;
+    int64_t value;
+
+    if (sensor_storm_read(sensor_id, &value) != SCMI_SUCCESS)
+        return VAL_STATUS_FAIL;
+    *min = value;
+    *max = value;
+
+    end = val_get_time_ns() + (STORM_PROBE_MS * NS_PER_MS);
+    while (val_get_time_ns() < end)
+    {
+        if (sensor_storm_read(sensor_id, &value) != SCMI_SUCCESS)
+            return VAL_STATUS_FAIL;
+        if (value < *min)
+            *min = value;
+        if (value > *max)
+            *max = value;
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t sensor_storm_run(uint32_t sensor_id)
+{
+    uint64_t start, end, send_ns;
+    uint32_t polls = 0, result;
+    int64_t previous, value;
+
+    if (sensor_storm_read(sensor_id, &previous) != SCMI_SUCCESS)
+        return VAL_STATUS_FAIL;
+
+    start = val_get_time_ns();
+    end = start + (SENSOR_STORM_WINDOW_MS * NS_PER_MS);
+    while (val_get_time_ns() < end)
+    {
+        result = sensor_storm_poll(sensor_id);
+        if (result == VAL_STATUS_FAIL)
+            return VAL_STATUS_FAIL;
+        if (result == VAL_STATUS_SKIP)
+            g_storm.num_empty_polls++;
+
+        if ((++polls % STORM_READ_EVERY) != 0)
+            continue;
+
+        send_ns = val_get_time_ns();
+        if (sensor_storm_read(sensor_id, &value) != SCMI_SUCCESS) {
+            val_print(VAL_PRINT_ERR, "\n       READING_GET failed during the storm");
+            return VAL_STATUS_FAIL;
+        }
+        val_hist_add(&g_storm.cmd_latency, val_get_time_ns() - send_ns);
+        sensor_storm_count_crossings(previous, value);
+        previous = value;
+    }
+    g_storm.window_ns = val_get_time_ns() - start;
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t sensor_storm_disarm(uint32_t sensor_id)
+{
+    uint32_t i, result;
+
+    if (sensor_storm_notify(sensor_id, TRIP_POINT_NFY_DISABLE) != SCMI_SUCCESS)
+        return VAL_STATUS_FAIL;
+    for (i = 0; i < g_storm.num_trip_points; i++)
+    {
+        if (sensor_storm_arm(sensor_id, i, TRIP_POINT_DISABLE, 0) != SCMI_SUCCESS)
+            return VAL_STATUS_FAIL;
+    }
+
+    /* Events raised before the disarm may still be on the way */
+    for (i = 0; i < STORM_MAX_DRAIN; i++)
+    {
+        result = sensor_storm_poll(sensor_id);
+        if (result == VAL_STATUS_FAIL)
+            return VAL_STATUS_FAIL;
+        if (result == VAL_STATUS_SKIP)
+            break;
+        g_storm.num_drained++;
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+static void sensor_storm_print(uint32_t sensor_id, int64_t min, int64_t max)
+{
+    uint64_t window_us = g_storm.window_ns / NS_PER_US;
+
+    val_print(VAL_PRINT_ERR, "\n       SENSOR %d: %d trip points over [%lld, %lld]", sensor_id,
+              g_storm.num_trip_points, (long long)min, (long long)max);
+    val_print(VAL_PRINT_ERR, "\n         window           %10llu us",
+              (unsigned long long)window_us);
+    val_print(VAL_PRINT_ERR, "\n         events           %10d (%llu per s)", g_storm.num_events,
+              (unsigned long long)(window_us ? (g_storm.num_events * 1000000ull) / window_us : 0));
+    val_print(VAL_PRINT_ERR, "\n         polled crossings %10d", g_storm.num_polled_crossings);
+    val_print(VAL_PRINT_ERR, "\n         direction gaps   %10d (lost or coalesced)",
+              g_storm.num_gaps);
+    val_print(VAL_PRINT_ERR, "\n         drained late     %10d", g_storm.num_drained);
+    val_print(VAL_PRINT_ERR, "\n         empty polls      %10d", g_storm.num_empty_polls);
+    val_print(VAL_PRINT_ERR, "\n         READING_GET      p50 %llu p99 %llu max %llu ns",
+              (unsigned long long)val_hist_percentile(&g_storm.cmd_latency, 50),
+              (unsigned long long)val_hist_percentile(&g_storm.cmd_latency, 99),
+              (unsigned long long)g_storm.cmd_latency.max);
+}
+
+uint32_t sensor_trip_point_notification_storm(void)
+{
+    uint32_t num_sensors, sensor_id, num_trip_points, i, result;
+    uint32_t num_checked = 0;
+    int64_t min, max, value;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No time source, storm skipped               ");
+        return VAL_STATUS_SKIP;
+    }
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 1] Query trip point config and notify support");
+    if (!sensor_storm_supported(SENSOR_TRIP_POINT_CONFIG) ||
+        !sensor_storm_supported(SENSOR_TRIP_POINT_NOTIFY)) {
+        val_print(VAL_PRINT_ERR, "\n       Trip point config or notify unsupported     ");
+        return VAL_STATUS_SKIP;
+    }
+
+    num_sensors = val_sensor_get_info(NUM_SENSORS);
+    if (num_sensors == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Sensor found                             ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       NUM SENSORS     : %d", num_sensors);
+
+    for (sensor_id = 0; sensor_id < num_sensors; sensor_id++)
+    {
+        num_trip_points = val_sensor_get_desc_info(SENSOR_NUM_OF_TRIP_POINTS, sensor_id);
+        if (num_trip_points == 0)
+            continue;
+        if (num_trip_points > STORM_MAX_TRIP_POINTS)
+            num_trip_points = STORM_MAX_TRIP_POINTS;
+
+        val_print(VAL_PRINT_TEST, "\n     SENSOR ID: %d", sensor_id);
+        val_memset(&g_storm, 0, sizeof(g_storm));
+        val_hist_reset(&g_storm.cmd_latency);
+        g_storm.num_trip_points = num_trip_points;
+
+        val_print(VAL_PRINT_TEST, "\n     [Check 2] Probe the sensor range");
+        val_bench_quiet_begin();
+        result = sensor_storm_probe(sensor_id, &min, &max);
+        val_bench_quiet_end();
+        if (result != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        if (min == max) {
+            val_print(VAL_PRINT_ERR, "\n       Sensor %d did not change, storm skipped",
+                      sensor_id);
+            continue;
+        }
+
+        val_print(VAL_PRINT_TEST, "\n     [Check 3] Arm %d trip points and collect events",
+                  num_trip_points);
+        val_bench_quiet_begin();
+        for (i = 0; i < num_trip_points; i++)
+        {
+            g_storm.threshold[i] = min + ((max - min) * (int64_t)(i + 1)) /
+                                   (int64_t)(num_trip_points + 1);
+            if (sensor_storm_arm(sensor_id, i, TRIP_POINT_CROSSED_EITHER_DIR,
+                                 g_storm.threshold[i]) != SCMI_SUCCESS)
+                break;
+        }
+        result = VAL_STATUS_FAIL;
+        if ((i == num_trip_points) &&
+            (sensor_storm_notify(sensor_id, TRIP_POINT_NFY_ENABLE) == SCMI_SUCCESS))
+            result = sensor_storm_run(sensor_id);
+        if (sensor_storm_disarm(sensor_id) != VAL_STATUS_PASS)
+            result = VAL_STATUS_FAIL;
+        val_bench_quiet_end();
+        if (result != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        sensor_storm_print(sensor_id, min, max);
+
+        val_print(VAL_PRINT_TEST, "\n     [Check 4] Channel responds after the storm");
+        if (val_compare_status(sensor_storm_read(sensor_id, &value), SCMI_SUCCESS))
+            return VAL_STATUS_FAIL;
+
+        if ((g_storm.num_events == 0) && g_storm.num_polled_crossings)
+            val_print(VAL_PRINT_WARN, "\n       WARNING: crossings seen but no event received");
+        num_checked++;
+    }
+
+    if (num_checked == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No sensor trip point exercised              ");
+        return VAL_STATUS_SKIP;
+    }
+
+    return VAL_STATUS_PASS;
+}
@@ -0,0 +1,250 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include"val_interface.h"
+#include"val_system_power.h"
+#include"val_benchmark.h"
+#include"val_watchdog.h"
+
+#define TEST_NUM  (SCMI_SYSTEM_POWER_TEST_NUM_BASE + 8)
+#define TEST_DESC "Sys pwr suspend/resume round trip latency    "
+
+#define PARAMETER_SIZE       2
+#define SUSPEND_CYCLES       4
+
+/* Progress saved in the checkpoint, the cycle and how far it got */
+#define PROGRESS_REQUESTED   0x1
+#define PROGRESS_RESUMED     0x2
+#define PROGRESS(cycle, stage) (((cycle) << 8) | (stage))
+
+/********* TEST ALGO ********************
+ * Skip if system suspend or power state notifications are not supported
+ * Enable SYSTEM_POWER_STATE_NOTIFIER
+ * For each cycle
+ *   Save the cycle in the checkpoint. If the suspend takes the agent down,
+ *   the rerun carries on with the next cycle.
+ *   Time a graceful SYSTEM_POWER_STATE_SET to SUSPEND
+ *   Time the notification of the SUSPEND state from the request
+ *   Time the notification of the POWER_UP state from the suspend
+ * Disable notifications and print the latency histograms
+*****************************************/
+
+static VAL_HIST_s g_cmd_hist;
+static VAL_HIST_s g_suspend_hist;
+static VAL_HIST_s g_resume_hist;
+static VAL_HIST_s g_round_trip_hist;
+
+static int32_t sys_suspend_notify(uint32_t notify_enable)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    param_count++;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_SYSTEM_POWER, SYSTEM_POWER_STATE_NOTIFY,
+                                     COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, &notify_enable, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+static int32_t sys_suspend_request(void)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = GRACEFUL_REQUEST;
+    parameters[param_count++] = SYSTEM_POWER_SUSPEND;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_SYSTEM_POWER, SYSTEM_POWER_STATE_SET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return SCMI_GENERIC_ERROR;
+
+    return status;
+}
+
+static uint32_t sys_suspend_wait_state(uint32_t system_state)
+{
+    uint32_t rsp_msg_hdr;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+
+    rsp_msg_hdr = 0;
+    return_value_count = 0;
+    val_receive_notification(&rsp_msg_hdr, &return_value_count, return_values);
+
+    if (val_compare("PROTOCOL ID ", VAL_EXTRACT_BITS(rsp_msg_hdr, 10, 17),
+                    PROTOCOL_SYSTEM_POWER))
+        return VAL_STATUS_FAIL;
+    if (val_compare("MSG TYPE    ", VAL_EXTRACT_BITS(rsp_msg_hdr, 8, 9), NOTIFICATION_MSG))
+        return VAL_STATUS_FAIL;
+    if (val_compare("MSG ID      ", VAL_EXTRACT_BITS(rsp_msg_hdr, 0, 7),
+                    SYSTEM_POWER_STATE_NOTIFIER))
+        return VAL_STATUS_FAIL;
+    if (val_compare("FLAGS       ", return_values[NOTIFY_FLAGS_OFFSET], GRACEFUL_REQUEST))
+        return VAL_STATUS_FAIL;
+    if (val_compare("SYSTEM STATE", return_values[NOTIFY_SYSTEM_STATE_OFFSET], system_state))
+        return VAL_STATUS_FAIL;
+
+    val_print(VAL_PRINT_DEBUG, "\n       AGENT ID       : %d", return_values[NOTIFY_AGENT_ID_OFFSET]);
+    return VAL_STATUS_PASS;
+}
+
+/* Request suspend and record the latencies up to the system being back up */
+static uint32_t sys_suspend_measure(int32_t *status)
+{
+    uint64_t start_ns, now_ns, suspended_ns;
+
+    start_ns = val_get_time_ns();
+    *status = sys_suspend_request();
+    now_ns = val_get_time_ns();
+
+    if (*status != SCMI_SUCCESS)
+        return VAL_STATUS_FAIL;
+    val_hist_add(&g_cmd_hist, now_ns - start_ns);
+
+    if (sys_suspend_wait_state(SYSTEM_POWER_SUSPEND) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+    suspended_ns = val_get_time_ns();
+    val_hist_add(&g_suspend_hist, suspended_ns - start_ns);
+
+    if (sys_suspend_wait_state(SYSTEM_POWER_POWER_UP) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+    now_ns = val_get_time_ns();
+    val_hist_add(&g_resume_hist, now_ns - suspended_ns);
+    val_hist_add(&g_round_trip_hist, now_ns - start_ns);
+
+    return VAL_STATUS_PASS;
+}
+
+uint32_t system_power_suspend_resume_latency(void)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t message_id;
+    uint32_t progress, cycle, first_cycle = 0;
+    uint32_t result;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No platform time source for profiling       ");
+        return VAL_STATUS_SKIP;
+    }
+
+    if (!val_system_power_get_info(SYSTEM_SUSPEND_SUPPORT)) {
+        val_print(VAL_PRINT_ERR, "\n       System suspend not supported                ");
+        return VAL_STATUS_SKIP;
+    }
+
+    /* The platform reports the suspend and the resume through notifications */
+    val_print(VAL_PRINT_TEST, "\n     [Check 1] Query system power state notify cmd support");
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    message_id = SYSTEM_POWER_STATE_NOTIFY;
+    param_count++;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_SYSTEM_POWER,
+                                     SYSTEM_POWER_PROTOCOL_MESSAGE_ATTRIBUTES, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, &message_id, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (status != SCMI_SUCCESS) {
+        val_print(VAL_PRINT_ERR, "\n       SYSTEM POWER STATE NOTIFY not supported     ");
+        return VAL_STATUS_SKIP;
+    }
+
+    /* A run the suspend took down carries on after the cycle it was in */
+    progress = val_checkpoint_get_progress();
+    if (progress) {
+        first_cycle = (progress >> 8) + 1;
+        if ((progress & 0xFF) == PROGRESS_REQUESTED)
+            val_print(VAL_PRINT_ERR, "\n       Agent restarted in suspend cycle %d, not timed",
+                      progress >> 8);
+    }
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 2] Enable system power state notification");
+    if (val_compare_status(sys_suspend_notify(NOTIFY_ENABLE), SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    val_hist_reset(&g_cmd_hist);
+    val_hist_reset(&g_suspend_hist);
+    val_hist_reset(&g_resume_hist);
+    val_hist_reset(&g_round_trip_hist);
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 3] Suspend and resume the system %d times",
+              SUSPEND_CYCLES);
+    for (cycle = first_cycle; cycle < SUSPEND_CYCLES; cycle++)
+    {
+        val_checkpoint_save_progress(PROGRESS(cycle, PROGRESS_REQUESTED));
+        val_bench_quiet_begin();
+        result = sys_suspend_measure(&status);
+        val_bench_quiet_end();
+        if (result == VAL_STATUS_PASS) {
+            val_checkpoint_save_progress(PROGRESS(cycle, PROGRESS_RESUMED));
+            continue;
+        }
+
+        /* Agents other than the one managing the system may not suspend it */
+        if ((cycle == first_cycle) &&
+            ((status == SCMI_DENIED) || (status == SCMI_NOT_SUPPORTED))) {
+            val_print(VAL_PRINT_ERR, "\n       System suspend not permitted to this agent  ");
+            sys_suspend_notify(NOTIFY_DISABLE);
+            return VAL_STATUS_SKIP;
+        }
+
+        val_compare_status(status, SCMI_SUCCESS);
+        sys_suspend_notify(NOTIFY_DISABLE);
+        return VAL_STATUS_FAIL;
+    }
+
+    val_print(VAL_PRINT_TEST, "\n     [Check 4] Disable system power state notification");
+    if (val_compare_status(sys_suspend_notify(NOTIFY_DISABLE), SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (g_round_trip_hist.count == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No suspend cycle left to time               ");
+        return VAL_STATUS_PASS;
+    }
+
+    val_hist_print(VAL_PRINT_ERR, "command ns", &g_cmd_hist);
+    val_hist_print(VAL_PRINT_ERR, "suspend ns", &g_suspend_hist);
+    val_hist_print(VAL_PRINT_ERR, "resume ns", &g_resume_hist);
+    val_hist_print(VAL_PRINT_ERR, "round trip ns", &g_round_trip_hist);
+
+    return VAL_STATUS_PASS;
+}
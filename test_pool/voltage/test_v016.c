@@ -0,0 +1,415 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_voltage.h"
+#include "val_benchmark.h"
+
+#define TEST_NUM  (SCMI_VOLTAGE_TEST_NUM_BASE + 16)
+#define TEST_DESC "Voltage level ramp latency benchmark           "
+
+#define PARAMETER_SIZE     3
+#define SETTLE_POLL_LIMIT  10000
+
+/********* TEST ALGO ********************
+ * For each voltage domain
+ *   Save the current operating mode and voltage level
+ *   Switch the domain on if it is not already operating
+ *   Discover the levels with DESCRIBE_LEVELS, sampling the grid for triplets
+ *   For sync mode, and async mode if the domain supports it
+ *     Step up through every level and back down again
+ *     Time the LEVEL_SET command and poll LEVEL_GET until it reports the
+ *     requested level, giving the per-step settle time and ramp slope
+ *   Restore the original voltage level and operating mode, also on failure
+*****************************************/
+
+static VAL_HIST_s g_cmd_hist;
+static VAL_HIST_s g_settle_hist;
+
+static uint32_t voltage_bench_level_get(uint32_t domain_id, int32_t *level)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_VOLTAGE, VOLTAGE_LEVEL_GET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    *level = (int32_t)return_values[ATTRIBUTE_OFFSET];
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t voltage_bench_level_set(uint32_t domain_id, uint32_t mode, int32_t level)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    parameters[param_count++] = mode;
+    parameters[param_count++] = (uint32_t)level;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_VOLTAGE, VOLTAGE_LEVEL_SET, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (mode != VOLTAGE_SET_ASYNC_MODE)
+        return VAL_STATUS_PASS;
+
+    /* Async level set completes with a delayed response */
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    val_receive_delayed_response(&rsp_msg_hdr, &status, &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("MSG TYPE   ", VAL_EXTRACT_BITS(rsp_msg_hdr, 8, 9),
+                    DELAYED_RESPONSE_MSG))
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("MSG ID     ", VAL_EXTRACT_BITS(rsp_msg_hdr, 0, 7),
+                    VOLTAGE_LEVEL_SET_COMPLETE))
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("DOMAIN ID  ", return_values[DELAYED_RESP_DOMAIN_ID_OFFSET], domain_id))
+        return VAL_STATUS_FAIL;
+
+    if (val_compare("VOLTAGE    ", return_values[DELAYED_RESP_LEVEL_OFFSET], (uint32_t)level))
+        return VAL_STATUS_FAIL;
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t voltage_bench_config(uint32_t domain_id, uint32_t msg_id, uint32_t *config)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    parameters[param_count++] = domain_id;
+    if (msg_id == VOLTAGE_CONFIG_SET)
+        parameters[param_count++] = *config;
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_VOLTAGE, msg_id, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+
+    if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    if (msg_id == VOLTAGE_CONFIG_GET)
+        *config = return_values[ATTRIBUTE_OFFSET];
+
+    return VAL_STATUS_PASS;
+}
+
+/* Collect the levels to step through, sampling the grid of triplet domains */
+static uint32_t voltage_bench_get_levels(uint32_t domain_id, int32_t *levels,
+                                         uint32_t *num_levels)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+    uint32_t level_index = 0, num_returned, num_remaining, format, i;
+    uint32_t grid_steps, stride;
+    int32_t start, end, step;
+
+    *num_levels = 0;
+    do
+    {
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        parameters[param_count++] = domain_id;
+        parameters[param_count++] = level_index;
+        cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_VOLTAGE, VOLTAGE_DESCRIBE_LEVELS, COMMAND_MSG);
+        val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                         &return_value_count, return_values);
+
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        num_returned = VAL_EXTRACT_BITS(return_values[LEVEL_FLAG_OFFSET], 0, 11);
+        format = VAL_EXTRACT_BITS(return_values[LEVEL_FLAG_OFFSET], 12, 12);
+        num_remaining = VAL_EXTRACT_BITS(return_values[LEVEL_FLAG_OFFSET], 16, 31);
+
+        if (format == LEVEL_FORMAT_TRIPLET)
+        {
+            start = (int32_t)return_values[LEVEL_ARRAY_OFFSET + LEVEL_START_OFFSET];
+            end = (int32_t)return_values[LEVEL_ARRAY_OFFSET + LEVEL_END_OFFSET];
+            step = (int32_t)return_values[LEVEL_ARRAY_OFFSET + LEVEL_STEP_OFFSET];
+            if (step <= 0 || end < start)
+                return VAL_STATUS_FAIL;
+
+            grid_steps = (uint32_t)((end - start) / step);
+            stride = (grid_steps + MAX_NUMBER_VOLTAGE_LEVELS - 2) /
+                     (MAX_NUMBER_VOLTAGE_LEVELS - 1);
+            if (stride == 0)
+                stride = 1;
+
+            for (i = 0; i <= grid_steps && *num_levels < MAX_NUMBER_VOLTAGE_LEVELS; i += stride)
+                levels[(*num_levels)++] = start + (int32_t)i * step;
+            return VAL_STATUS_PASS;
+        }
+
+        for (i = 0; i < num_returned && *num_levels < MAX_NUMBER_VOLTAGE_LEVELS; i++)
+            levels[(*num_levels)++] = (int32_t)return_values[LEVEL_ARRAY_OFFSET + i];
+
+        level_index += num_returned;
+    } while (num_remaining > 0 && num_returned > 0 && *num_levels < MAX_NUMBER_VOLTAGE_LEVELS);
+
+    return VAL_STATUS_PASS;
+}
+
+/* Time one level transition from set command to a matching level get */
+static uint32_t voltage_bench_step(uint32_t domain_id, uint32_t mode, int32_t from, int32_t to)
+{
+    uint64_t start_ns, cmd_ns, settle_ns, slope;
+    uint32_t poll;
+    int32_t level = 0;
+    int64_t delta_uv;
+
+    val_bench_quiet_begin();
+
+    start_ns = val_get_time_ns();
+    if (voltage_bench_level_set(domain_id, mode, to) != VAL_STATUS_PASS) {
+        val_bench_quiet_end();
+        return VAL_STATUS_FAIL;
+    }
+    cmd_ns = val_get_time_ns() - start_ns;
+
+    for (poll = 0; poll < SETTLE_POLL_LIMIT; poll++)
+    {
+        if (voltage_bench_level_get(domain_id, &level) != VAL_STATUS_PASS)
+            break;
+        if (level == to)
+            break;
+    }
+    settle_ns = val_get_time_ns() - start_ns;
+
+    val_bench_quiet_end();
+
+    if (level != to) {
+        val_print(VAL_PRINT_ERR, "\n       Level %d uV did not settle, read %d uV", to, level);
+        return VAL_STATUS_FAIL;
+    }
+
+    val_hist_add(&g_cmd_hist, cmd_ns);
+    val_hist_add(&g_settle_hist, settle_ns);
+
+    /* Slope in mV/us is uV/ns, kept as thousandths for integer printing */
+    delta_uv = (int64_t)to - from;
+    if (delta_uv < 0)
+        delta_uv = -delta_uv;
+    slope = settle_ns ? ((uint64_t)delta_uv * 1000) / settle_ns : 0;
+
+    val_print(VAL_PRINT_TEST, "\n       %8d -> %8d uV  cmd %8llu ns  settle %8llu ns  %llu.%03llu mV/us",
+              from, to, (unsigned long long)cmd_ns, (unsigned long long)settle_ns,
+              (unsigned long long)(slope / 1000), (unsigned long long)(slope % 1000));
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t voltage_bench_ramp(uint32_t domain_id, uint32_t mode, int32_t *levels,
+                                   uint32_t num_levels)
+{
+    uint32_t i;
+    uint64_t total_uv = 0, total_ns;
+
+    val_hist_reset(&g_cmd_hist);
+    val_hist_reset(&g_settle_hist);
+
+    /* Untimed move to the bottom of the sweep */
+    if (voltage_bench_level_set(domain_id, mode, levels[0]) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    for (i = 1; i < num_levels; i++) {
+        if (voltage_bench_step(domain_id, mode, levels[i - 1], levels[i]) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        total_uv += (uint64_t)(levels[i] - levels[i - 1]);
+    }
+
+    for (i = num_levels - 1; i > 0; i--) {
+        if (voltage_bench_step(domain_id, mode, levels[i], levels[i - 1]) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        total_uv += (uint64_t)(levels[i] - levels[i - 1]);
+    }
+
+    total_ns = g_settle_hist.sum;
+    val_print(VAL_PRINT_ERR, "\n       Domain %d %s : %d steps, %llu.%03llu mV/us average slope",
+              domain_id, (mode == VOLTAGE_SET_ASYNC_MODE) ? "async" : "sync ",
+              g_settle_hist.count,
+              (unsigned long long)(total_ns ? (total_uv * 1000 / total_ns) / 1000 : 0),
+              (unsigned long long)(total_ns ? (total_uv * 1000 / total_ns) % 1000 : 0));
+    val_hist_print(VAL_PRINT_ERR, "command ns", &g_cmd_hist);
+    val_hist_print(VAL_PRINT_ERR, "settle ns", &g_settle_hist);
+
+    return VAL_STATUS_PASS;
+}
+
+static uint32_t voltage_bench_sweep(uint32_t domain_id, uint32_t async_support)
+{
+    int32_t levels[MAX_NUMBER_VOLTAGE_LEVELS];
+    uint32_t num_levels, mode;
+
+    /* STEP 3 : Discover the levels to step through */
+    val_print(VAL_PRINT_TEST, "\n    [Step 3] Describe voltage levels");
+    if (voltage_bench_get_levels(domain_id, levels, &num_levels) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+
+    val_print(VAL_PRINT_TEST, "\n       Levels sampled : %d", num_levels);
+    if (num_levels < 2) {
+        val_print(VAL_PRINT_TEST, "\n       Single level domain, nothing to ramp");
+    }
+    else
+    {
+        /* STEP 4 : Sweep the levels in each supported set mode */
+        for (mode = VOLTAGE_SET_SYNC_MODE; mode <= VOLTAGE_SET_ASYNC_MODE; mode++)
+        {
+            if (mode == VOLTAGE_SET_ASYNC_MODE && !async_support)
+                break;
+
+            val_print(VAL_PRINT_TEST, "\n    [Check 1] Ramp levels in %s mode",
+                      (mode == VOLTAGE_SET_ASYNC_MODE) ? "async" : "sync");
+            if (voltage_bench_ramp(domain_id, mode, levels, num_levels) != VAL_STATUS_PASS)
+                return VAL_STATUS_FAIL;
+        }
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+uint32_t voltage_level_ramp_benchmark(void)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint32_t parameters[PARAMETER_SIZE];
+    uint32_t num_domains, domain_id, async_support;
+    uint32_t config, on_config, result;
+    int32_t default_level;
+
+    if (val_test_initialize(TEST_NUM, TEST_DESC) != VAL_STATUS_PASS)
+        return VAL_STATUS_SKIP;
+
+    if (val_get_time_ns() == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No platform time source for benchmark      ");
+        return VAL_STATUS_SKIP;
+    }
+
+    num_domains = val_voltage_get_info(NUM_VOLTAGE_DOMAINS, 0);
+    if (num_domains == 0) {
+        val_print(VAL_PRINT_ERR, "\n       No Voltage Domains found                   ");
+        return VAL_STATUS_SKIP;
+    }
+    val_print(VAL_PRINT_DEBUG, "\n       Voltage Domains: %d", num_domains);
+
+    for (domain_id = 0; domain_id < num_domains; domain_id++)
+    {
+        val_print(VAL_PRINT_TEST, "\n       Voltage ID     : %d", domain_id);
+
+        /* STEP 1 : Check async level set support of the domain */
+        val_print(VAL_PRINT_TEST, "\n    [Step 1] Query domain attributes");
+        VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+        parameters[param_count++] = domain_id;
+        cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_VOLTAGE, VOLTAGE_DOMAIN_ATTRIBUTES, COMMAND_MSG);
+        val_send_message(cmd_msg_hdr, param_count, parameters, &rsp_msg_hdr, &status,
+                         &return_value_count, return_values);
+
+        if (val_compare_status(status, SCMI_SUCCESS) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (val_compare_msg_hdr(cmd_msg_hdr, rsp_msg_hdr) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        async_support = VAL_EXTRACT_BITS(return_values[ATTRIBUTE_OFFSET],
+                                         ASYNC_LEVEL_SET_SUPPORT_BIT,
+                                         ASYNC_LEVEL_SET_SUPPORT_BIT);
+
+        /* STEP 2 : Save operating mode and level, switch the domain on */
+        val_print(VAL_PRINT_TEST, "\n    [Step 2] Save operating mode and level");
+        if (voltage_bench_config(domain_id, VOLTAGE_CONFIG_GET, &config) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        if (voltage_bench_level_get(domain_id, &default_level) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+
+        val_print(VAL_PRINT_TEST, "\n       Config         : 0x%08X", config);
+        val_print(VAL_PRINT_TEST, "\n       Voltage        : %d uV", default_level);
+
+        on_config = val_voltage_operating_mode_create(ARCHITECTURAL_MODE, 0x7);
+        result = VAL_STATUS_PASS;
+        if (config != on_config)
+            result = voltage_bench_config(domain_id, VOLTAGE_CONFIG_SET, &on_config);
+
+        if (result == VAL_STATUS_PASS)
+            result = voltage_bench_sweep(domain_id, async_support);
+
+        /* STEP 5 : Restore the original level and operating mode, also after a failure */
+        val_print(VAL_PRINT_TEST, "\n    [Step 5] Restore level and operating mode");
+        if (voltage_bench_level_set(domain_id, VOLTAGE_SET_SYNC_MODE, default_level)
+            != VAL_STATUS_PASS)
+            result = VAL_STATUS_FAIL;
+
+        if (config != on_config &&
+            voltage_bench_config(domain_id, VOLTAGE_CONFIG_SET, &config) != VAL_STATUS_PASS)
+            result = VAL_STATUS_FAIL;
+
+        if (result != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+    }
+
+    return VAL_STATUS_PASS;
+}
@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+# Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+# SPDX-License-Identifier : Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Decode the deferred log of a baremetal build made with LOG_DEFERRED=1.
+
+The target records the address of each format string and the raw argument
+values in arm_scmi_log_ring (see platform/baremetal/include/pal_platform.h).
+This script reads the format strings back from the linked image and formats
+the records on the host.
+
+A string free build (STRING_IDS=1) records the file id and line of each print
+instead, and of each check name and test description printed. Their text is
+read from the manifest written by the build, scmi_string_ids.json.
+
+Usage: scmi_log_decode.py <image.elf> <ring.bin> [--load-offset N] [--level N]
+                          [--manifest scmi_string_ids.json]
+
+ring.bin is a dump of sizeof(arm_scmi_log_ring) bytes from the address of
+arm_scmi_log_ring, for example from gdb:
+    dump binary memory ring.bin &arm_scmi_log_ring (&arm_scmi_log_ring)+1
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+LOG_RING_MAGIC = 0x474C4353
+RING_HEADER_WORDS = 5
+LOG_RECORD_STRING_ID = 0x8000
+LOG_STRING_ID_LENGTH = 0xFFFFFFFF
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+# Same conversions as pal_log_record(): flags, width, precision, length, type
+CONVERSION = re.compile(r"%(%|[-+ #0]*(\*|[0-9]*)(?:\.(\*|[0-9]*))?"
+                        r"([hlzjtL]*)([diuxXocpsfFeEgG]?))")
+
+
+class Image:
+    """Allocated sections of an ELF image, addressed as on the target"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF":
+            sys.exit("%s: not an ELF image" % path)
+        is_64 = data[4] == 2
+        self.endian = "<" if data[5] == 1 else ">"
+        if is_64:
+            shoff, = struct.unpack_from(self.endian + "Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from(self.endian + "HH", data, 0x3A)
+            section = self.endian + "IIQQQQ"
+        else:
+            shoff, = struct.unpack_from(self.endian + "I", data, 0x20)
+            shentsize, shnum = struct.unpack_from(self.endian + "HH", data, 0x2E)
+            section = self.endian + "IIIIII"
+
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = \
+                struct.unpack_from(section, data, shoff + i * shentsize)
+            if (flags & SHF_ALLOC) and sh_type != SHT_NOBITS and size:
+                self.sections.append((addr, data[offset:offset + size]))
+
+    def string(self, addr):
+        for base, contents in self.sections:
+            if base <= addr < base + len(contents):
+                end = contents.find(b"\0", addr - base)
+                if end < 0:
+                    end = len(contents)
+                return contents[addr - base:end].decode("ascii", "replace")
+        return None
+
+
+def sign_extend(value, bits):
+    value &= (1 << bits) - 1
+    if value & (1 << (bits - 1)):
+        value -= 1 << bits
+    return value
+
+
+def value_bits(length):
+    if length == "hh":
+        return 8
+    if length == "h":
+        return 16
+    if length == "":
+        return 32
+    return 64
+
+
+class Manifest:
+    """Text of the call sites of a string free build"""
+
+    def __init__(self, path):
+        self.strings = {}
+        if path is None:
+            return
+        with open(path) as f:
+            self.strings = json.load(f)["strings"]
+
+    def string(self, file_id, line):
+        return self.strings.get("0x%08x:%d" % (file_id, line))
+
+
+def format_record(fmt, words, endian, manifest):
+    """Rebuild the text of one record from its format and argument words"""
+    index = [0]
+
+    def take64():
+        if index[0] + 2 > len(words):
+            raise IndexError
+        lo, hi = words[index[0]], words[index[0] + 1]
+        index[0] += 2
+        return lo | (hi << 32)
+
+    def take_string():
+        if index[0] >= len(words):
+            raise IndexError
+        length = words[index[0]]
+        if length == LOG_STRING_ID_LENGTH:
+            if index[0] + 3 > len(words):
+                raise IndexError
+            file_id, line = words[index[0] + 1:index[0] + 3]
+            index[0] += 3
+            text = manifest.string(file_id, line)
+            return "<string 0x%08x:%d>" % (file_id, line) if text is None else text
+        num_words = (length + 3) // 4
+        raw = struct.pack(endian + "%dI" % num_words,
+                          *words[index[0] + 1:index[0] + 1 + num_words])
+        index[0] += 1 + num_words
+        return raw[:length].decode("ascii", "replace")
+
+    out = []
+    pos = 0
+    for match in CONVERSION.finditer(fmt):
+        out.append(fmt[pos:match.start()])
+        pos = match.end()
+        if match.group(1) == "%":
+            out.append("%")
+            continue
+
+        spec = match.group(0)
+        width, precision, length, conv = match.group(2, 3, 4, 5)
+        if not conv:
+            # pal_log_record() stops recording at an unknown conversion
+            out.append(fmt[match.start():])
+            pos = len(fmt)
+            break
+        try:
+            if width == "*":
+                spec = spec.replace("*", str(sign_extend(take64(), 32)), 1)
+            if precision == "*":
+                spec = spec.replace(".*", "." + str(sign_extend(take64(), 32)), 1)
+            spec = spec[:len(spec) - len(length) - 1] + conv
+            if conv == "s":
+                out.append(spec % take_string())
+            elif conv in "fFeEgG":
+                out.append(spec % struct.unpack("<d", struct.pack("<Q", take64()))[0])
+            elif conv == "p":
+                out.append("0x%x" % take64())
+            elif conv == "c":
+                out.append(spec % chr(take64() & 0xFF))
+            elif conv in "di":
+                out.append(spec % sign_extend(take64(), value_bits(length)))
+            else:
+                out.append(spec % (take64() & ((1 << value_bits(length)) - 1)))
+        except IndexError:
+            out.append("<truncated>")
+            pos = len(fmt)
+            break
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image", help="linked image holding libscmi_test.a")
+    parser.add_argument("ring", help="binary dump of arm_scmi_log_ring")
+    parser.add_argument("--load-offset", type=lambda v: int(v, 0), default=0,
+                        help="run time address minus link time address")
+    parser.add_argument("--level", type=int, default=None,
+                        help="only print records at or below this print level")
+    parser.add_argument("--manifest", default=None,
+                        help="string manifest of a STRING_IDS=1 build")
+    args = parser.parse_args()
+
+    image = Image(args.image)
+    manifest = Manifest(args.manifest)
+    with open(args.ring, "rb") as f:
+        raw = f.read()
+    if len(raw) < RING_HEADER_WORDS * 4:
+        sys.exit("%s: ring dump too short" % args.ring)
+
+    magic, size_words, head, tail, num_dropped = \
+        struct.unpack_from(image.endian + "5I", raw, 0)
+    if magic != LOG_RING_MAGIC:
+        sys.exit("%s: bad magic 0x%08x, not arm_scmi_log_ring" % (args.ring, magic))
+    data = struct.unpack_from(image.endian + "%dI" % size_words, raw,
+                              RING_HEADER_WORDS * 4)
+
+    if num_dropped:
+        sys.stderr.write("%d oldest records were overwritten\n" % num_dropped)
+
+    offset = tail
+    while offset < head:
+        header = data[offset % size_words]
+        num_words, level = header >> 16, header & 0x7FFF
+        if num_words < 3 or offset + num_words > head:
+            sys.exit("corrupt record at word %d" % offset)
+        record = [data[(offset + i) % size_words] for i in range(num_words)]
+        offset += num_words
+
+        if args.level is not None and level > args.level:
+            continue
+        if header & LOG_RECORD_STRING_ID:
+            fmt = manifest.string(record[1], record[2])
+            if fmt is None:
+                sys.stdout.write("\n<unknown format 0x%08x:%d>" % (record[1], record[2]))
+                continue
+        else:
+            address = (record[1] | (record[2] << 32)) - args.load_offset
+            fmt = image.string(address)
+            if fmt is None:
+                sys.stdout.write("\n<unknown format at 0x%x>" % address)
+                continue
+        sys.stdout.write(format_record(fmt, record[3:], image.endian, manifest))
+    sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()
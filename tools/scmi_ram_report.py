@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+# Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+# SPDX-License-Identifier : Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Report the static RAM of libscmi_test.a per module.
+
+Reads the ELF objects of the library archive (or object files given one by
+one) and sums the writable allocated sections of each: .data as DATA and
+.bss plus common symbols as BSS. Objects are grouped into modules: val_*.o
+and pal_*.o by file, tests by the test_pool protocol directory they are built
+from, anything else by file.
+
+Usage: scmi_ram_report.py <libscmi_test.a | objects...> [--symbols N]
+                          [--budget BYTES] [--compare <other libscmi_test.a>]
+
+With --budget the script exits with status 1 when DATA plus BSS of all
+modules is above BYTES, for use in CI of constrained targets. With --compare
+the totals of another build, for example the normal build of a STRING_IDS=1
+library, are printed below with the change against them.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+SHF_WRITE = 0x1
+SHF_ALLOC = 0x2
+SHF_EXECINSTR = 0x4
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+SHN_COMMON = 0xFFF2
+STT_OBJECT = 1
+
+TEST_POOL = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "test_pool")
+
+
+class Object:
+    """Section sizes and RAM symbols of one relocatable ELF object"""
+
+    def __init__(self, name, data):
+        self.name = name
+        self.text = self.rodata = self.data = self.bss = 0
+        self.symbols = []
+        if data[:4] != b"\x7fELF":
+            return
+        is_64 = data[4] == 2
+        endian = "<" if data[5] == 1 else ">"
+        if is_64:
+            shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x3A)
+            section = endian + "IIQQQQIIQQ"
+            symbol, symsize = endian + "IBBHQQ", 24
+        else:
+            shoff, = struct.unpack_from(endian + "I", data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x2E)
+            section = endian + "IIIIIIIIII"
+            symbol, symsize = endian + "IIIBBH", 16
+
+        headers = [struct.unpack_from(section, data, shoff + i * shentsize)
+                   for i in range(shnum)]
+        ram = set()
+        for index, (_, sh_type, flags, _, _, size, _, _, _, _) in enumerate(headers):
+            if not flags & SHF_ALLOC:
+                continue
+            if sh_type == SHT_NOBITS:
+                self.bss += size
+                ram.add(index)
+            elif flags & SHF_WRITE:
+                self.data += size
+                ram.add(index)
+            elif flags & SHF_EXECINSTR:
+                self.text += size
+            else:
+                self.rodata += size
+
+        for _, sh_type, _, _, offset, size, link, _, _, _ in headers:
+            if sh_type != SHT_SYMTAB:
+                continue
+            strtab = headers[link]
+            for i in range(1, size // symsize):
+                fields = struct.unpack_from(symbol, data, offset + i * symsize)
+                if is_64:
+                    st_name, st_info, _, st_shndx, _, st_size = fields
+                else:
+                    st_name, _, st_size, st_info, _, st_shndx = fields
+                if (st_info & 0xF) != STT_OBJECT or not st_size:
+                    continue
+                if st_shndx == SHN_COMMON:
+                    self.bss += st_size
+                elif st_shndx not in ram:
+                    continue
+                start = strtab[4] + st_name
+                name = data[start:data.index(b"\0", start)].decode("ascii", "replace")
+                self.symbols.append((st_size, name))
+
+
+def read_archive(path):
+    """Members of a System V / GNU ar archive as (name, data) pairs"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"!<arch>\n":
+        return [(os.path.basename(path), data)]
+    members = []
+    long_names = b""
+    offset = 8
+    while offset + 60 <= len(data):
+        name = data[offset:offset + 16].decode("ascii").rstrip()
+        size = int(data[offset + 48:offset + 58].decode("ascii"))
+        body = data[offset + 60:offset + 60 + size]
+        offset += 60 + size + (size & 1)
+        if name == "//":
+            long_names = body
+            continue
+        if name in ("/", "/SYM64/"):
+            continue
+        if name.startswith("/") and name[1:].isdigit():
+            start = int(name[1:])
+            name = long_names[start:long_names.index(b"/\n", start)].decode("ascii")
+        members.append((name.rstrip("/"), body))
+    return members
+
+
+def test_protocols():
+    """Test file stem to protocol, from the test_pool tree next to this script"""
+    protocols = {}
+    if os.path.isdir(TEST_POOL):
+        for protocol in os.listdir(TEST_POOL):
+            directory = os.path.join(TEST_POOL, protocol)
+            if os.path.isdir(directory):
+                for name in os.listdir(directory):
+                    protocols[os.path.splitext(name)[0]] = protocol
+    return protocols
+
+
+def module_of(name, protocols):
+    stem = os.path.splitext(name)[0]
+    if stem.startswith("test_"):
+        return "tests/" + protocols.get(stem, "other")
+    return stem
+
+
+def collect(paths, protocols):
+    """Section totals per module and RAM symbols of the given inputs"""
+    modules = {}
+    symbols = []
+    for path in paths:
+        for name, data in read_archive(path):
+            obj = Object(name, data)
+            totals = modules.setdefault(module_of(name, protocols), [0, 0, 0, 0])
+            totals[0] += obj.data
+            totals[1] += obj.bss
+            totals[2] += obj.rodata
+            totals[3] += obj.text
+            symbols.extend((size, sym, name) for size, sym in obj.symbols)
+    return modules, symbols
+
+
+def print_total(label, total):
+    print("%-28s %8d %8d %8d %8d %8d" % (label, total[0], total[1], total[0] + total[1],
+                                         total[2], total[3]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("inputs", nargs="+", help="libscmi_test.a or object files")
+    parser.add_argument("--symbols", type=int, default=10,
+                        help="list this many of the largest RAM symbols")
+    parser.add_argument("--budget", type=lambda v: int(v, 0), default=None,
+                        help="fail when DATA plus BSS is above this many bytes")
+    parser.add_argument("--compare", default=None,
+                        help="library of another build to compare the totals with")
+    args = parser.parse_args()
+
+    protocols = test_protocols()
+    modules, symbols = collect(args.inputs, protocols)
+
+    rows = sorted(modules.items(), key=lambda item: (-(item[1][0] + item[1][1]), item[0]))
+    print("%-28s %8s %8s %8s %8s %8s" % ("MODULE", "DATA", "BSS", "RAM", "RODATA", "TEXT"))
+    total = [0, 0, 0, 0]
+    for module, (data, bss, rodata, text) in rows:
+        print("%-28s %8d %8d %8d %8d %8d" % (module, data, bss, data + bss, rodata, text))
+        total = [a + b for a, b in zip(total, (data, bss, rodata, text))]
+    print_total("TOTAL", total)
+
+    if args.compare:
+        other = [0, 0, 0, 0]
+        for totals in collect([args.compare], protocols)[0].values():
+            other = [a + b for a, b in zip(other, totals)]
+        print_total("COMPARED", other)
+        print_total("CHANGE", [a - b for a, b in zip(total, other)])
+
+    if args.symbols > 0 and symbols:
+        print("\nLargest RAM symbols")
+        for size, sym, name in sorted(symbols, reverse=True)[:args.symbols]:
+            print("%8d  %-32s %s" % (size, sym, name))
+
+    ram = total[0] + total[1]
+    if args.budget is not None and ram > args.budget:
+        sys.stderr.write("static RAM %d bytes is over the budget of %d\n" % (ram, args.budget))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
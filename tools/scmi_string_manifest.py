@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+# Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+# SPDX-License-Identifier : Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Write the string manifest of a STRING_IDS=1 baremetal build.
+
+A string free build leaves print formats, check names and test descriptions
+out of the image. Each one is recorded on target by the id of the file it is
+written in and the line of the call (see val/include/val_string_ids.h). This
+script finds the same calls in the sources and writes the text of each call
+site, for tools/scmi_log_decode.py --manifest.
+
+The file id is the POSIX cksum of the file name, as computed by the
+makefiles. Calls whose text is not a string literal, or a macro defined as
+one in the same file, cannot be mapped and fail the script.
+
+Usage: scmi_string_manifest.py --output <manifest.json> <source dirs...>
+"""
+
+import argparse
+import codecs
+import json
+import os
+import re
+import sys
+
+# Calls whose text is left out of the image, and the index of the text argument
+TEXT_ARGUMENT = {
+    "val_print": 1,
+    "val_compare": 0,
+    "val_compare_str": 0,
+    "val_test_initialize": 1,
+}
+
+# VAL_LOG_MAX_ARGS of val/include/val_string_ids.h
+LOG_MAX_ARGS = 12
+
+CALL = re.compile(r"\b(%s)\s*\(" % "|".join(TEXT_ARGUMENT))
+STRING_DEFINE = re.compile(r"^[ \t]*#[ \t]*define[ \t]+(\w+)[ \t]+((?:\"(?:[^\"\\\n]|\\.)*\"[ \t]*)+)$",
+                           re.M)
+DIRECTIVE = re.compile(r"^[ \t]*#(?:[^\n\\]|\\.)*", re.M | re.S)
+STRING_LITERAL = re.compile(r"\"((?:[^\"\\\n]|\\.)*)\"")
+
+
+def crc_table():
+    table = []
+    for i in range(256):
+        crc = i << 24
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x04C11DB7) if crc & 0x80000000 else (crc << 1)
+        table.append(crc & 0xFFFFFFFF)
+    return table
+
+
+CRC_TABLE = crc_table()
+
+
+def cksum(data):
+    """POSIX cksum of data, the CRC of the bytes followed by their length"""
+    crc = 0
+    for byte in data:
+        crc = ((crc << 8) & 0xFFFFFFFF) ^ CRC_TABLE[(crc >> 24) ^ byte]
+    length = len(data)
+    while length:
+        crc = ((crc << 8) & 0xFFFFFFFF) ^ CRC_TABLE[(crc >> 24) ^ (length & 0xFF)]
+        length >>= 8
+    return ~crc & 0xFFFFFFFF
+
+
+def strip_comments(text):
+    """Blank out comments, keeping string literals and line numbers"""
+    out = []
+    i = 0
+    while i < len(text):
+        if text.startswith("/*", i):
+            end = text.find("*/", i + 2)
+            end = len(text) if end < 0 else end + 2
+            out.append(re.sub(r"[^\n]", " ", text[i:end]))
+            i = end
+        elif text.startswith("//", i):
+            end = text.find("\n", i)
+            end = len(text) if end < 0 else end
+            out.append(" " * (end - i))
+            i = end
+        elif text[i] in "\"'":
+            end = i + 1
+            while end < len(text) and text[end] != text[i]:
+                end += 2 if text[end] == "\\" else 1
+            out.append(text[i:end + 1])
+            i = end + 1
+        else:
+            out.append(text[i])
+            i += 1
+    return "".join(out)
+
+
+def split_arguments(text, start):
+    """Arguments of the call whose opening parenthesis is at start"""
+    args = []
+    depth = 0
+    current = start + 1
+    i = start
+    while i < len(text):
+        c = text[i]
+        if c in "\"'":
+            i += 1
+            while i < len(text) and text[i] != c:
+                i += 2 if text[i] == "\\" else 1
+        elif c in "([{":
+            depth += 1
+        elif c in ")]}":
+            depth -= 1
+            if depth == 0:
+                args.append(text[current:i].strip())
+                return args
+        elif c == "," and depth == 1:
+            args.append(text[current:i].strip())
+            current = i + 1
+        i += 1
+    return None
+
+
+def literal_text(arg, defines):
+    """Text of an argument made of string literals, or of a macro defined as one"""
+    arg = re.sub(r"\\\n", " ", defines.get(arg, arg))
+    if not STRING_LITERAL.sub("", arg).strip() == "" or not arg.startswith("\""):
+        return None
+    return "".join(codecs.decode(part, "unicode_escape")
+                   for part in STRING_LITERAL.findall(arg))
+
+
+def scan(path, strings, errors):
+    with open(path, encoding="latin-1") as f:
+        text = strip_comments(f.read())
+    file_id = cksum(os.path.basename(path).encode())
+    defines = {m.group(1): m.group(2).strip() for m in STRING_DEFINE.finditer(text)}
+    # Directives are blanked so that a call is never read as following one
+    text = DIRECTIVE.sub(lambda m: re.sub(r"[^\n]", " ", m.group(0)), text)
+
+    for match in CALL.finditer(text):
+        before = text[:match.start()].rstrip()
+        word = re.search(r"(\w+)$", before)
+        if word and word.group(1) not in ("return", "else"):
+            continue        # declaration or definition
+        line = text.count("\n", 0, match.start()) + 1
+        where = "%s:%d" % (path, line)
+        args = split_arguments(text, match.end() - 1)
+        index = TEXT_ARGUMENT[match.group(1)]
+        if args is None or len(args) <= index:
+            errors.append("%s: cannot parse %s call" % (where, match.group(1)))
+            continue
+        if match.group(1) == "val_print" and len(args) - 2 > LOG_MAX_ARGS:
+            errors.append("%s: more than %d print arguments" % (where, LOG_MAX_ARGS))
+            continue
+        value = literal_text(args[index], defines)
+        if value is None:
+            errors.append("%s: %s text is not a string literal" % (where, match.group(1)))
+            continue
+        key = "0x%08x:%d" % (file_id, line)
+        if strings.get(key, value) != value:
+            errors.append("%s: more than one %s call on the line" % (where, match.group(1)))
+        strings[key] = value
+    return file_id
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dirs", nargs="+", help="source directories built into the library")
+    parser.add_argument("--output", required=True, help="manifest to write")
+    args = parser.parse_args()
+
+    files = {}
+    strings = {}
+    errors = []
+    for directory in args.dirs:
+        for name in sorted(os.listdir(directory)):
+            if not name.endswith(".c"):
+                continue
+            path = os.path.join(directory, name)
+            file_id = scan(path, strings, errors)
+            key = "0x%08x" % file_id
+            if key in files and os.path.basename(files[key]) != name:
+                errors.append("%s: file id 0x%08x already used by %s" % (path, file_id, files[key]))
+            files[key] = path
+
+    if errors:
+        sys.exit("\n".join(errors))
+
+    with open(args.output, "w") as f:
+        json.dump({"files": files, "strings": strings}, f, indent=1, sort_keys=True)
+        f.write("\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -40,6 +40,41 @@
 #define PAL_STATUS_PASS 0x0
 #define PAL_STATUS_NO_TESTS 0x1
 
+/* Status a transport returns when the platform did not answer, the SCMI COMMS_ERROR value */
+#define PAL_COMMS_ERROR (-7)
+
+/* Command completion modes, see pal_set_completion_mode */
+#define PAL_COMPLETION_INTERRUPT 0  /* sleep until the platform signals completion. DEFAULT */
+#define PAL_COMPLETION_POLLED    1  /* spin on the channel until it is free */
+#define PAL_COMPLETION_ADAPTIVE  2  /* spin for a transport defined time, then sleep */
+
+/* Agent side counters read around every message, see pal_counters_enable */
+#define PAL_COUNTER_CYCLES           0
+#define PAL_COUNTER_INSTRUCTIONS     1
+#define PAL_COUNTER_CONTEXT_SWITCHES 2
+#define PAL_COUNTER_PAGE_FAULTS      3
+#define PAL_NUM_COUNTERS             4
+#define PAL_COUNTERS_RUSAGE          (1 << PAL_NUM_COUNTERS) /* switches and faults from getrusage */
+
+/* Argument kinds of a print recorded by call site, PAL_LOG_ARG_BITS each from bit 0 */
+#define PAL_LOG_ARG_BITS             4
+#define PAL_LOG_ARG_END              0
+#define PAL_LOG_ARG_INT              1
+#define PAL_LOG_ARG_LONG             2
+#define PAL_LOG_ARG_LONG_LONG        3
+#define PAL_LOG_ARG_DOUBLE           4
+#define PAL_LOG_ARG_POINTER          5
+#define PAL_LOG_ARG_STRING           6
+#define PAL_LOG_ARG_STRING_ID        7  /* PAL_STRING_ID_s */
+
+/* Call site of a string left out of the image, file id << 32 | line */
+typedef struct {
+    uint64_t site;
+} PAL_STRING_ID_s;
+
+/* Stack painted below the suite on hosted platforms, whose stacks grow on demand */
+#define PAL_STACK_WINDOW             (256 * 1024)
+
 #define SCMI_NAME_STR_SIZE 16
 #define NUM_ELEMS(x) (sizeof(x) / sizeof((x)[0]))
 #define MAX_RETURNS_SIZE 32
@@ -51,7 +86,28 @@ void pal_send_message(uint32_t message_header_send, size_t parameter_count,
         const uint32_t *parameters, uint32_t *message_header_rcv, int32_t *status,
         size_t *return_values_count, uint32_t *return_values);
 void pal_print(uint32_t level, const char *string, va_list args);
+void pal_print_id(uint32_t level, uint32_t file_id, uint32_t line, uint64_t arg_kinds,
+                  va_list args);
 void *pal_memcpy(void *dest, const void *src, size_t size);
+uint64_t pal_get_time_ns(void);
+uint64_t pal_get_cpu_time_ns(void);
+uint32_t pal_set_completion_mode(uint32_t mode);
+void *pal_fast_channel_map(uint32_t protocol_id, uint32_t domain_id, uint32_t message_id,
+                           uint64_t chan_addr, uint32_t chan_size);
+uint32_t pal_counters_enable(uint32_t enable);
+void pal_counters_read(uint64_t *values);
+uint64_t pal_get_stack_limit(void);
+void pal_reset_channel(void);
+uint32_t pal_checkpoint_load(const char *file, uint32_t *test_num, uint32_t *outcome,
+                             uint32_t max_entries);
+void pal_checkpoint_append(const char *file, uint32_t test_num, uint32_t outcome);
+void pal_checkpoint_remove(const char *file);
+void *pal_file_open(const char *file);
+void *pal_file_open_append(const char *file);
+void *pal_file_open_read(const char *file);
+uint32_t pal_file_read_line(void *handle, char *line, uint32_t size);
+void pal_file_print(void *handle, const char *format, va_list args);
+void pal_file_close(void *handle);
 
 void pal_receive_delayed_response(uint32_t *message_header_rcv, int32_t *status,
         size_t *return_values_count, uint32_t *return_values);
@@ -83,6 +139,7 @@ uint32_t pal_sensor_get_expected_num_sensors(void);
 uint32_t pal_sensor_get_expected_stats_addr_low(void);
 uint32_t pal_sensor_get_expected_stats_addr_high(void);
 uint32_t pal_sensor_get_expected_stats_addr_len(void);
+uint32_t pal_sensor_get_expected_clock_drift(int32_t *drift_ppb);
 #endif
 
 /* PERFORMANCE protocol specific API's */
@@ -114,4 +171,9 @@ uint32_t pal_voltage_get_expected_num_domains(void);
 uint8_t *pal_voltage_get_expected_name(uint32_t domain_id);
 #endif
 
+#ifdef POWERCAP_PROTOCOL
+uint32_t pal_powercap_get_expected_num_domains(void);
+uint8_t *pal_powercap_get_expected_name(uint32_t domain_id);
+#endif
+
 #endif
@@ -66,6 +66,8 @@ uint32_t base_set_protocol_permissions_check(void);
 uint32_t base_reset_agent_configuration_check(void);
 uint32_t base_deny_restore_protocol_access(void);
 uint32_t base_restore_protocol_access_with_reset_agent_configuration(void);
+uint32_t base_permission_matrix_sweep(void);
+uint32_t base_completion_mode_latency(void);
 uint32_t base_deny_restore_device_access(void);
 uint32_t base_restore_device_access_with_reset_agent_configuration(void);
 
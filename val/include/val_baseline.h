@@ -0,0 +1,52 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __VAL_BASELINE_H__
+#define __VAL_BASELINE_H__
+
+#include "val_benchmark.h"
+
+/* p50 or p99 rise over the baseline flagged as a regression */
+#define BASELINE_DEFAULT_THRESHOLD      25
+
+/* Rises smaller than this are timer and scheduling noise, whatever the percentage */
+#define BASELINE_MIN_DELTA_NS           1000
+
+/* Messages sent fewer times than this in either run are listed but not judged */
+#define BASELINE_MIN_SAMPLES            4
+
+/* Longest record, a message line with every histogram bucket in use */
+#ifndef BASELINE_LINE_SIZE
+#define BASELINE_LINE_SIZE              4096
+#endif
+
+typedef struct {
+    const char *save_file;          /* add this run to the store, NULL to skip */
+    const char *compare_file;       /* compare this run against the store, NULL to skip */
+    uint32_t threshold_pct;
+} BASELINE_CONFIG_s;
+
+typedef struct {
+    uint8_t  vendor_name[SCMI_NAME_STR_SIZE];
+    uint32_t implementation_version;
+} BASELINE_PLATFORM_s;
+
+void     val_baseline_get_default_config(BASELINE_CONFIG_s *config);
+void     val_baseline_start(BASELINE_CONFIG_s *config);
+uint32_t val_baseline_complete(void);
+
+#endif
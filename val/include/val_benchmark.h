@@ -0,0 +1,76 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __VAL_BENCHMARK_H__
+#define __VAL_BENCHMARK_H__
+
+#define NS_PER_US                   1000ull
+#define NS_PER_MS                   1000000ull
+#define NS_PER_SEC                  1000000000ull
+
+/* Log-linear histogram, 4 sub-buckets per power of two, values up to 2^48 ns by default */
+#define VAL_HIST_SUB_BUCKET_BITS    2
+#define VAL_HIST_SUB_BUCKETS        (1 << VAL_HIST_SUB_BUCKET_BITS)
+#ifndef VAL_HIST_MAX_VALUE_BITS
+#define VAL_HIST_MAX_VALUE_BITS     48
+#endif
+#define VAL_HIST_NUM_BUCKETS        ((VAL_HIST_MAX_VALUE_BITS - VAL_HIST_SUB_BUCKET_BITS + 1) * \
+                                     VAL_HIST_SUB_BUCKETS)
+#define VAL_HIST_BAR_WIDTH          40
+
+#define VAL_NUM_PROTOCOLS           (PROTOCOL_MAX - PROTOCOL_BASE)
+
+/* Per message latency, message ids above the limit share the protocol figures only */
+#define VAL_LATENCY_MAX_MSG_ID      32
+#ifndef VAL_LATENCY_MAX_MSGS
+#define VAL_LATENCY_MAX_MSGS        128
+#endif
+
+#define VAL_COMPLETION_INTERRUPT    PAL_COMPLETION_INTERRUPT
+#define VAL_COMPLETION_POLLED       PAL_COMPLETION_POLLED
+#define VAL_COMPLETION_ADAPTIVE     PAL_COMPLETION_ADAPTIVE
+
+typedef struct {
+    uint32_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+    uint32_t bucket[VAL_HIST_NUM_BUCKETS];
+} VAL_HIST_s;
+
+uint64_t val_get_time_ns(void);
+uint64_t val_get_cpu_time_ns(void);
+uint32_t val_set_completion_mode(uint32_t mode);
+void     val_bench_quiet_begin(void);
+void     val_bench_quiet_end(void);
+
+void     val_hist_reset(VAL_HIST_s *hist);
+void     val_hist_add(VAL_HIST_s *hist, uint64_t value);
+void     val_hist_merge(VAL_HIST_s *dst, VAL_HIST_s *src);
+uint64_t val_hist_mean(VAL_HIST_s *hist);
+uint64_t val_hist_percentile(VAL_HIST_s *hist, uint32_t percent);
+void     val_hist_print(uint32_t print_level, char *name, VAL_HIST_s *hist);
+void     val_hist_print_buckets(uint32_t print_level, VAL_HIST_s *hist);
+
+void     val_latency_record_enable(uint32_t enable);
+void     val_latency_record(uint32_t msg_hdr, uint64_t latency_ns);
+void     val_latency_reset(void);
+VAL_HIST_s *val_latency_get_protocol_hist(uint32_t protocol_id);
+VAL_HIST_s *val_latency_get_msg_hist(uint32_t protocol_id, uint32_t msg_id);
+void     val_latency_merge(uint32_t protocol_id, uint32_t msg_id, VAL_HIST_s *hist);
+
+#endif
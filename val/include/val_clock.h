@@ -76,6 +76,7 @@ uint32_t clock_rate_get_invalid_clock_id_check(void);
 uint32_t clock_config_set_invalid_attr_check(void);
 uint32_t clock_config_set_invalid_clock_id_check(void);
 uint32_t clock_config_set_check(void);
+uint32_t clock_rate_set_async_saturation_check(void);
 
 /* expected values */
 uint32_t val_clock_get_expected_num_clocks(void);
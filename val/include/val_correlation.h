@@ -0,0 +1,61 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __VAL_CORRELATION_H__
+#define __VAL_CORRELATION_H__
+
+#include "val_benchmark.h"
+
+#ifndef CORRELATION_MAX_SAMPLES
+#define CORRELATION_MAX_SAMPLES         256
+#endif
+#define CORRELATION_MIN_SAMPLES         2
+/* Fraction of the samples at each end searched for the drift estimate */
+#define CORRELATION_DRIFT_WINDOW_DIV    4
+/* Shortest span between the drift samples; round trip jitter swamps shorter ones */
+#ifndef CORRELATION_MIN_DRIFT_SPAN_NS
+#define CORRELATION_MIN_DRIFT_SPAN_NS   500000000ull
+#endif
+#define PPB_PER_UNIT                    1000000000ll
+
+/* Agent send and receive times bracketing one platform timestamp */
+typedef struct {
+    uint32_t num_samples;
+    uint64_t send_ns[CORRELATION_MAX_SAMPLES];
+    uint64_t recv_ns[CORRELATION_MAX_SAMPLES];
+    uint64_t platform_ns[CORRELATION_MAX_SAMPLES];
+} CORRELATION_s;
+
+typedef struct {
+    int64_t  offset_ns;         /* platform minus agent clock at the reference time */
+    uint64_t reference_ns;      /* agent time the offset applies to */
+    int64_t  drift_ppb;         /* platform clock rate error against the agent clock */
+    uint64_t drift_span_ns;     /* agent time between the two drift samples */
+    uint32_t drift_valid;       /* drift_span_ns reached CORRELATION_MIN_DRIFT_SPAN_NS */
+    uint64_t min_rtt_ns;
+    uint64_t one_way_ns;        /* half the minimum round trip, symmetric paths assumed */
+    uint32_t num_future;        /* readings stamped after they reached the agent */
+    VAL_HIST_s staleness;       /* reading age when it reaches the agent */
+} CORRELATION_RESULT_s;
+
+void     val_correlation_init(CORRELATION_s *corr);
+void     val_correlation_add(CORRELATION_s *corr, uint64_t send_ns, uint64_t recv_ns,
+                             uint64_t platform_ns);
+uint32_t val_correlation_estimate(CORRELATION_s *corr, CORRELATION_RESULT_s *result);
+int64_t  val_correlation_offset_at(CORRELATION_RESULT_s *result, uint64_t agent_ns);
+
+#endif
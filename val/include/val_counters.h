@@ -0,0 +1,42 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __VAL_COUNTERS_H__
+#define __VAL_COUNTERS_H__
+
+/* Distinct protocol, message and message type combinations counted */
+#ifndef VAL_COUNTERS_MAX_ENTRIES
+#define VAL_COUNTERS_MAX_ENTRIES    128
+#endif
+
+/* Message type of the per protocol total in the report */
+#define VAL_COUNTERS_ALL_TYPES      0xFF
+
+typedef struct {
+    uint32_t protocol_id;
+    uint32_t msg_id;
+    uint32_t msg_type;              /* command, delayed response or notification */
+    uint32_t count;
+    uint64_t total[PAL_NUM_COUNTERS];
+} VAL_COUNTERS_ENTRY_s;
+
+uint32_t val_counters_enable(uint32_t enable);
+void     val_counters_start(void);
+void     val_counters_stop(uint32_t msg_hdr);
+void     val_counters_report(void);
+
+#endif
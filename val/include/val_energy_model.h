@@ -0,0 +1,64 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __VAL_ENERGY_MODEL_H__
+#define __VAL_ENERGY_MODEL_H__
+
+#include "val_performance.h"
+
+/* Capacity of the fastest OPP across all domains, as in the Linux scheduler */
+#define EM_CAPACITY_SCALE               1024
+
+/* OPP flags */
+#define EM_OPP_NON_MONOTONIC            (1 << 0)    /* power does not rise with the level */
+#define EM_OPP_INEFFICIENT              (1 << 1)    /* a faster OPP costs no more energy */
+
+typedef struct {
+    uint32_t level;
+    uint32_t power;                 /* mW or abstract units, as reported */
+    uint32_t latency_us;
+    uint64_t freq_khz;
+    uint32_t capacity;
+    uint64_t cost;                  /* power * fmax / freq, energy per unit of work */
+    uint32_t flags;
+} ENERGY_MODEL_OPP_s;
+
+typedef struct {
+    uint8_t  name[SCMI_NAME_STR_SIZE];
+    uint32_t sustained_freq_khz;
+    uint32_t sustained_level;
+    uint32_t num_opps;
+    ENERGY_MODEL_OPP_s opp[MAX_PERFORMANCE_LEVELS];
+} ENERGY_MODEL_DOMAIN_s;
+
+typedef struct {
+    uint32_t power_values_mw;
+    uint32_t num_domains;
+    ENERGY_MODEL_DOMAIN_s domain[MAX_PERFORMANCE_DOMAINS];
+} ENERGY_MODEL_s;
+
+void     val_energy_model_set_files(const char *json_file, const char *em_table_file);
+void     val_energy_model_init(ENERGY_MODEL_s *model, uint32_t power_values_mw);
+void     val_energy_model_set_domain(ENERGY_MODEL_s *model, uint32_t domain_id, uint8_t *name,
+                                     uint32_t sustained_freq_khz, uint32_t sustained_level);
+uint32_t val_energy_model_add_opp(ENERGY_MODEL_s *model, uint32_t domain_id, uint32_t level,
+                                  uint64_t freq_khz, uint32_t power, uint32_t latency_us);
+uint32_t val_energy_model_build(ENERGY_MODEL_s *model);
+void     val_energy_model_print(uint32_t print_level, ENERGY_MODEL_s *model);
+void     val_energy_model_export(ENERGY_MODEL_s *model);
+
+#endif
@@ -19,8 +19,12 @@
 #define __VAL_INTERFACE_H__
 
 #include "pal_interface.h"
+#include "val_watchdog.h"
 
 #define RUN_TEST(x) val_report_status(x)
+/* For tests whose discovered information is used by later tests */
+#define RUN_SETUP_TEST(x) (val_watchdog_set_setup_test(), val_report_status(x))
+#define RUN_SOAK_TEST(x) ((x) == VAL_STATUS_FAIL)
 
 #define PROTOCOL_VERSION_1 0x00010000
 #define PROTOCOL_VERSION_2 0x00020000
@@ -34,6 +38,7 @@
 #define SCMI_SENSOR_TEST_NUM_BASE       600
 #define SCMI_RESET_TEST_NUM_BASE        700
 #define SCMI_VOLTAGE_TEST_NUM_BASE      800
+#define SCMI_POWERCAP_TEST_NUM_BASE     900
 
 #define BASE_PROTOCOL_VERSION_1         0x00010000
 #define BASE_PROTOCOL_VERSION_2         0x00020000
@@ -73,6 +78,13 @@
 
 /* GENERIC VAL APIs */
 
+/* Name printed by a check or test, with STRING_IDS the call site naming it */
+#ifdef STRING_IDS
+typedef PAL_STRING_ID_s VAL_TEXT_s;
+#else
+typedef char *VAL_TEXT_s;
+#endif
+
 typedef enum {
     SCMI_SUCCESS =              0,
     SCMI_NOT_SUPPORTED =        -1,
@@ -104,6 +116,7 @@ typedef enum {
     PROTOCOL_SENSOR,
     PROTOCOL_RESET,
     PROTOCOL_VOLTAGE,
+    PROTOCOL_POWERCAP,
     PROTOCOL_MAX
 } PROTOCOL_IDENTIFIER;
 
@@ -113,6 +126,17 @@ uint32_t val_compare_msg_hdr(uint32_t sent_msg_hdr, uint32_t rsp_msg_hdr);
 uint32_t val_protocol_version_check(uint32_t exp_version, uint32_t version);
 uint32_t val_reserved_bits_check_is_zero(uint32_t reserved_bits);
 void val_print(uint32_t level, const char *string, ...);
+void val_print_id(uint32_t site, uint32_t file_id, uint64_t arg_kinds, ...);
+uint32_t val_set_print_level(uint32_t print_level);
+uint32_t val_set_param_check(uint32_t enable);
+void *val_file_open(const char *file);
+void *val_file_open_append(const char *file);
+void *val_file_open_read(const char *file);
+uint32_t val_file_read_line(void *handle, char *line, uint32_t size);
+void val_file_print(void *handle, const char *format, ...);
+void val_file_close(void *handle);
+void *val_fast_channel_map(uint32_t protocol_id, uint32_t domain_id, uint32_t message_id,
+                           uint64_t chan_addr, uint32_t chan_size);
 void val_memset(void *ptr, int value, size_t length);
 uint32_t val_msg_hdr_create(uint32_t protoco_id, uint32_t msg_id, uint32_t msg_type);
 char *val_get_result_string(uint32_t test_status);
@@ -126,7 +150,7 @@ void val_receive_delayed_response(uint32_t *message_header_rcv, int32_t *status,
 void val_receive_notification(uint32_t *message_header_rcv, size_t *return_values_count,
                               uint32_t *return_values);
 uint32_t val_initialize_system(void *info);
-uint32_t val_test_initialize(uint32_t test_num, char *test_desc);
+uint32_t val_test_initialize(uint32_t test_num, VAL_TEXT_s test_desc);
 void val_print_return_values(uint32_t count, uint32_t *values);
 uint32_t val_compare_status(int32_t status, int32_t expected_status);
 uint32_t val_agent_get_accessible_device(uint32_t agent_id);
@@ -139,8 +163,9 @@ uint32_t val_report_status(uint32_t status);
 uint32_t val_get_test_passed(void);
 uint32_t val_get_test_failed(void);
 uint32_t val_get_test_skipped(void);
-uint32_t val_compare(char *parameter, uint32_t rcvd_val, uint32_t exp_val);
-uint32_t val_compare_str(char *parameter, char *rcvd_val, char *exp_val, uint32_t len);
+uint32_t val_get_test_timed_out(void);
+uint32_t val_compare(VAL_TEXT_s parameter, uint32_t rcvd_val, uint32_t exp_val);
+uint32_t val_compare_str(VAL_TEXT_s parameter, char *rcvd_val, char *exp_val, uint32_t len);
 
 /* BASE VAL APIs */
 
@@ -178,6 +203,7 @@ void val_base_save_info(uint32_t param_identifier, uint32_t param_value);
 void val_base_save_name(uint32_t param_identifier, uint8_t *vendor_name);
 uint32_t val_base_get_info(uint32_t param_identifier);
 uint32_t val_base_execute_tests(void);
+uint32_t val_base_execute_soak_tests(void);
 
 /* POWER DOMAIN VAL APIs */
 
@@ -213,6 +239,7 @@ uint32_t val_power_domain_get_info(uint32_t pd_id, uint32_t param_identifier);
 void val_power_domain_save_info(uint32_t param_identifier, uint32_t domain_id,
                                 uint32_t param_value);
 uint32_t val_power_domain_execute_tests(void);
+uint32_t val_power_domain_execute_soak_tests(void);
 
 /* SYSTEM POWER VAL APIs */
 
@@ -245,7 +272,9 @@ typedef enum {
 } SYSTEM_POWER_STATES;
 
 void val_system_power_save_info(uint32_t param_identifier, uint32_t param_value);
+uint32_t val_system_power_get_info(uint32_t param_identifier);
 uint32_t val_system_power_execute_tests(void);
+uint32_t val_system_power_execute_soak_tests(void);
 
 /* PERFORMANCE VAL APIs */
 
@@ -275,6 +304,7 @@ typedef enum {
     PERF_STATS_ADDR_LOW,
     PERF_STATS_ADDR_HIGH,
     PERF_STATS_ADDR_LEN,
+    PERF_POWER_VALUES_MW,
     PERF_DOMAIN_NAME,
     PERF_MESSAGE_FAST_CH_SUPPORT,
     PERF_DOMAIN_FAST_CH_SUPPORT,
@@ -285,11 +315,23 @@ typedef enum {
     PERF_DOMAIN_MAX_LEVEL,
     PERF_DOMAIN_MIN_LEVEL,
     PERF_DOMAIN_INTERMEDIATE_LEVEL,
+    PERF_DOMAIN_SUSTAINED_FREQ,
+    PERF_DOMAIN_SUSTAINED_LEVEL,
+    PERF_DOMAIN_NUM_LEVELS,
 } PERFORMANCE_DOMAIN_INFO;
 
 void val_performance_save_info(uint32_t param_identifier, uint32_t perf_id, uint32_t param_value);
 uint32_t val_performance_get_info(uint32_t param_identifier, uint32_t perf_id);
+void val_performance_save_level(uint32_t perf_id, uint32_t level_index, uint32_t level,
+                                uint32_t power, uint32_t latency_us);
+uint32_t val_performance_get_level(uint32_t perf_id, uint32_t level_index);
+uint32_t val_performance_get_level_power(uint32_t perf_id, uint32_t level_index);
+uint32_t val_performance_get_level_latency(uint32_t perf_id, uint32_t level_index);
+uint64_t val_performance_level_to_khz(uint32_t perf_id, uint32_t level);
+void val_performance_save_name(uint32_t perf_id, uint8_t *name);
+uint8_t *val_performance_get_name(uint32_t perf_id);
 uint32_t val_performance_execute_tests(void);
+uint32_t val_performance_execute_soak_tests(void);
 
 /* CLOCK VAL APIs */
 
@@ -324,6 +366,7 @@ void val_clock_save_name(uint32_t param_identifier, uint32_t clock_id, uint8_t *
 uint32_t val_clock_get_info(uint32_t param_identifier, uint32_t clock_id);
 uint64_t val_clock_get_rate(uint32_t param_identifier, uint32_t clock_id);
 uint32_t val_clock_execute_tests(void);
+uint32_t val_clock_execute_soak_tests(void);
 
 /* SENSOR VAL APIs */
 
@@ -348,7 +391,8 @@ typedef enum {
 } SENSOR_DELAYED_RESPONSE;
 
 typedef enum {
-    SENSOR_TRIP_POINT_EVENT = 0x0
+    SENSOR_TRIP_POINT_EVENT = 0x0,
+    SENSOR_UPDATE = 0x1
 } SENSOR_NOTIFICATIONS;
 
 typedef enum {
@@ -363,6 +407,7 @@ typedef enum {
     SENSOR_NUM_OF_AXIS,
     SENSOR_AXIS_SUPPORT,
     SENSOR_STATE,
+    SENSOR_TIMESTAMP_EXPONENT,
 } SENSOR_INFO;
 
 void val_sensor_save_info(uint32_t param_identifier, uint32_t param_value);
@@ -371,6 +416,7 @@ void val_sensor_save_desc_info(uint32_t param_identifier, uint32_t sensor_id,
         uint32_t param_value);
 uint32_t val_sensor_get_desc_info(uint32_t param_identifier, uint32_t sensor_id);
 uint32_t val_sensor_execute_tests(void);
+uint32_t val_sensor_execute_soak_tests(void);
 void val_sensor_ext_save_desc_info(uint32_t param_identifier, uint32_t sensor_id,
         uint32_t param_value);
 uint32_t val_sensor_ext_get_desc_info(uint32_t param_identifier, uint32_t sensor_id);
@@ -400,12 +446,14 @@ typedef enum {
 typedef enum {
     NUM_RESET_DOMAINS,
     RESET_ASYNC_SUPPORT,
-    RESET_NOTIFY_SUPPORT
+    RESET_NOTIFY_SUPPORT,
+    RESET_DOMAIN_LATENCY
 } RESET_INFO;
 
 void val_reset_save_info(uint32_t param_identifier, uint32_t domain_id, uint32_t param_value);
 uint32_t val_reset_get_info(uint32_t param_identifier, uint32_t domain_id);
 uint32_t val_reset_execute_tests(void);
+uint32_t val_reset_execute_soak_tests(void);
 
 /* VOLTAGE VAL APIs */
 
@@ -422,6 +470,10 @@ typedef enum {
     VOLTAGE_INVALID_COMMAND
 } VOLTAGE_COMMANDS;
 
+typedef enum {
+    VOLTAGE_LEVEL_SET_COMPLETE = 0x7
+} VOLTAGE_DELAYED_RESPONSE;
+
 typedef enum {
     NUM_VOLTAGE_DOMAINS,
     VOLTAGE_DOMAIN_CONFIG,
@@ -433,10 +485,54 @@ typedef enum {
 } VOLTAGE_INFO;
 
 uint32_t val_voltage_execute_tests(void);
+uint32_t val_voltage_execute_soak_tests(void);
 void val_voltage_save_info(uint32_t param_identifier, uint32_t domain_id, uint32_t param_value);
 void val_voltage_save_level(uint32_t domain_id, uint32_t level_index, uint32_t voltage);
 uint32_t val_voltage_get_level(uint32_t domain_id, uint32_t level_index);
 uint32_t val_voltage_get_info(uint32_t param_identifier, uint32_t domain_id);
 uint32_t val_voltage_operating_mode_create(uint32_t mode_type, uint32_t mode_id);
 
+/* POWERCAP VAL APIs */
+
+typedef enum {
+    POWERCAP_PROTOCOL_VERSION = 0x0,
+    POWERCAP_PROTOCOL_ATTRIBUTES,
+    POWERCAP_PROTOCOL_MESSAGE_ATTRIBUTES,
+    POWERCAP_DOMAIN_ATTRIBUTES,
+    POWERCAP_CAP_GET,
+    POWERCAP_CAP_SET,
+    POWERCAP_PAI_GET,
+    POWERCAP_PAI_SET,
+    POWERCAP_DOMAIN_NAME_GET,
+    POWERCAP_MEASUREMENTS_GET,
+    POWERCAP_CAP_NOTIFY,
+    POWERCAP_MEASUREMENTS_NOTIFY,
+    POWERCAP_DESCRIBE_FASTCHANNEL,
+    POWERCAP_INVALID_COMMAND
+} POWERCAP_COMMANDS;
+
+typedef enum {
+    POWERCAP_CAP_SET_COMPLETE = 0x5
+} POWERCAP_DELAYED_RESPONSE;
+
+typedef enum {
+    NUM_POWERCAP_DOMAINS,
+    POWERCAP_DOMAIN_ATTRIBUTE,
+    POWERCAP_MIN_PAI,
+    POWERCAP_MAX_PAI,
+    POWERCAP_PAI_STEP,
+    POWERCAP_MIN_CAP,
+    POWERCAP_MAX_CAP,
+    POWERCAP_CAP_STEP,
+    POWERCAP_SUSTAINABLE_POWER,
+    POWERCAP_CURRENT_CAP
+} POWERCAP_INFO;
+
+uint32_t val_powercap_execute_tests(void);
+uint32_t val_powercap_execute_soak_tests(void);
+void val_powercap_save_info(uint32_t param_identifier, uint32_t domain_id, uint32_t param_value);
+uint32_t val_powercap_get_info(uint32_t param_identifier, uint32_t domain_id);
+
+#include "val_string_ids.h"
+
 #endif
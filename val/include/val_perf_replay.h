@@ -0,0 +1,80 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+#ifndef __VAL_PERF_REPLAY_H__
+#define __VAL_PERF_REPLAY_H__
+
+#include "val_benchmark.h"
+#include "val_performance.h"
+
+/* Built in trace, a schedutil like governor reevaluating every scheduler tick */
+#define PERF_REPLAY_TICK_US             4000
+#define PERF_REPLAY_BUILTIN_TICKS       48
+
+/* schedutil asks for 1.25 times the frequency the utilization needs */
+#define PERF_REPLAY_UTIL_SCALE          1024
+#define PERF_REPLAY_HEADROOM_PCT        125
+
+/* Periods of the trace the requested and achieved frequency are averaged over */
+#define PERF_REPLAY_NUM_SLICES          8
+
+/* Longest trace line, a timestamp, a domain and a frequency */
+#ifndef PERF_REPLAY_LINE_SIZE
+#define PERF_REPLAY_LINE_SIZE           128
+#endif
+
+/* Channel a request was issued through */
+#define PERF_REPLAY_MAILBOX             0
+#define PERF_REPLAY_FAST_CHANNEL        1
+#define PERF_REPLAY_NUM_CHANNELS        2
+
+typedef struct {
+    uint64_t time_us;               /* from the first request of the trace */
+    uint32_t domain_id;
+    uint32_t freq_khz;              /* frequency the governor asked for */
+} PERF_REPLAY_EVENT_s;
+
+typedef struct {
+    PERF_REPLAY_EVENT_s event;
+    uint32_t opp_level;             /* level the request was mapped to */
+    uint32_t achieved_level;        /* level read back before the next request */
+    uint32_t channel;
+    int32_t  status;
+    uint64_t latency_ns;
+    uint64_t late_ns;               /* issued this long after its time in the trace */
+} PERF_REPLAY_SAMPLE_s;
+
+typedef struct {
+    uint32_t num_requests;
+    uint32_t num_fast_channel;
+    uint32_t num_achieved;          /* OPP in effect by the next request */
+    uint32_t num_rejected;
+    uint32_t slice_count[PERF_REPLAY_NUM_SLICES];
+    uint64_t slice_requested_khz[PERF_REPLAY_NUM_SLICES];
+    uint64_t slice_opp_khz[PERF_REPLAY_NUM_SLICES];
+    uint64_t slice_achieved_khz[PERF_REPLAY_NUM_SLICES];
+} PERF_REPLAY_DOMAIN_s;
+
+void     val_perf_replay_set_files(const char *trace_file, const char *report_file);
+uint32_t val_perf_replay_open(uint32_t num_domains);
+uint32_t val_perf_replay_next(PERF_REPLAY_EVENT_s *event);
+void     val_perf_replay_close(void);
+uint32_t val_perf_replay_num_requests(uint32_t domain_id);
+uint32_t val_perf_replay_find_opp(uint32_t domain_id, uint32_t freq_khz);
+void     val_perf_replay_record(PERF_REPLAY_SAMPLE_s *sample);
+void     val_perf_replay_report(uint32_t print_level);
+
+#endif
@@ -73,6 +73,12 @@ typedef struct {
     uint32_t  maximum_level;
     uint32_t  minimum_level;
     uint32_t  intermediate_level;
+    uint32_t  sustained_freq;
+    uint32_t  sustained_level;
+    uint32_t  num_levels;
+    uint32_t  level[MAX_PERFORMANCE_LEVELS];
+    uint32_t  level_power[MAX_PERFORMANCE_LEVELS];
+    uint32_t  level_latency_us[MAX_PERFORMANCE_LEVELS];
 } PERFORMANCE_DOMAIN_INFO_s;
 
 typedef struct {
@@ -80,6 +86,7 @@ typedef struct {
     uint32_t perf_stats_addr_low;
     uint8_t  perf_stats_addr_high;
     uint8_t  perf_stats_addr_len;
+    uint8_t  power_values_mw;
     PERFORMANCE_CMD_FAST_CH_SUPPORT_s perf_fast_cmd_ch_support;
     PERFORMANCE_DOMAIN_INFO_s perf_domain_info[MAX_PERFORMANCE_DOMAINS];
 } PERFORMANCE_INFO_s;
@@ -105,6 +112,9 @@ uint32_t performance_query_notify_limit_invalid_domain(void);
 uint32_t performance_query_notify_limit_invalid_parameters(void);
 uint32_t performance_limit_set_async(void);
 uint32_t performance_level_set_async(void);
+uint32_t performance_energy_model_export(void);
+uint32_t performance_rate_limit_throttling(void);
+uint32_t performance_governor_trace_replay(void);
 
 /* V1 Tests */
 uint32_t performance_query_mandatory_command_support_v1(void);
@@ -27,13 +27,22 @@
 #define STATS_LENGTH_OFFSET                    3
 #define DOMAIN_NAME_OFFSET                     1
 #define POWER_STATE_OFFSET                     0
+#define NOTIFY_DOMAIN_ID_OFFSET                1
+#define NOTIFY_POWER_STATE_OFFSET              2
 
 #define INVALID_SYNC_FLAG                      0xF
 #define INVALID_ASYNC_FLAG                     0xE
 #define POWER_STATE_ON                         0
 #define INVALID_POWER_STATE                    0xFF000000
+#define POWER_STATE_OFF                        0x40000000
+/* Retention state ids are platform defined, override for the target */
+#ifndef POWER_STATE_RETENTION
+#define POWER_STATE_RETENTION                  0x00000001
+#endif
 #define SYNC_POWER_STATE_CHANGE                0
+#define ASYNC_POWER_STATE_CHANGE               1
 #define NOTIFY_ENABLE                          1
+#define NOTIFY_DISABLE                         0
 #define INVALID_NOTIFY_ENABLE                  0xF
 
 typedef struct {
@@ -70,6 +79,9 @@ uint32_t power_domain_power_state_change_requested_notify_invalid_domain_check(v
 /* scmi v3 Tests */
 uint32_t power_domain_query_domain_attributes_scmi_v3(void);
 
+/* Benchmarks */
+uint32_t power_domain_state_transition_profile(void);
+
 uint32_t val_power_get_expected_num_domains(void);
 uint32_t val_power_get_expected_stats_addr_low(void);
 uint32_t val_power_get_expected_stats_addr_high(void);
@@ -0,0 +1,99 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+#ifndef __VAL_POWERCAP_H__
+#define __VAL_POWERCAP_H__
+
+#define VERSION_OFFSET                       0
+#define ATTRIBUTE_OFFSET                     0
+#define CAP_CHANGE_NOTIFY_SUPPORT_BIT        31
+#define MEASUREMENTS_NOTIFY_SUPPORT_BIT      30
+#define ASYNC_CAP_SET_SUPPORT_BIT            29
+#define CAP_CONFIG_SUPPORT_BIT               28
+#define MONITORING_SUPPORT_BIT               27
+#define PAI_CONFIG_SUPPORT_BIT               26
+#define POWER_UNIT_LOW                       23
+#define POWER_UNIT_HIGH                      24
+#define ATTRIBUTE_RESERVED_LOW               0
+#define ATTRIBUTE_RESERVED_HIGH              20
+#define POWERCAP_NO_PARENT                   0xFFFFFFFF
+
+#define DOMAIN_ATTRIBUTES_OFFSET             0
+#define DOMAIN_NAME_OFFSET                   1
+#define MIN_PAI_OFFSET                       5
+#define MAX_PAI_OFFSET                       6
+#define PAI_STEP_OFFSET                      7
+#define MIN_CAP_OFFSET                       8
+#define MAX_CAP_OFFSET                       9
+#define CAP_STEP_OFFSET                      10
+#define SUSTAINABLE_POWER_OFFSET             11
+#define ACCURACY_OFFSET                      12
+#define PARENT_ID_OFFSET                     13
+#define MEASUREMENT_POWER_OFFSET             0
+#define MEASUREMENT_PAI_OFFSET               1
+#define DELAYED_RESP_DOMAIN_ID_OFFSET        0
+#define DELAYED_RESP_CAP_OFFSET              1
+
+#define POWERCAP_SET_SYNC_MODE               0x0
+#define POWERCAP_SET_ASYNC_MODE              0x2
+#define POWERCAP_SET_IGNORE_DRESP            0x1
+
+#ifndef MAX_NUM_OF_POWERCAP_DOMAINS
+#define MAX_NUM_OF_POWERCAP_DOMAINS          32
+#endif
+
+typedef enum {
+    POWER_UNIT_ABSTRACT,
+    POWER_UNIT_MILLIWATT,
+    POWER_UNIT_MICROWATT
+} POWERCAP_POWER_UNIT;
+
+typedef struct {
+    uint32_t attributes;
+    uint32_t min_pai;
+    uint32_t max_pai;
+    uint32_t pai_step;
+    uint32_t min_cap;
+    uint32_t max_cap;
+    uint32_t cap_step;
+    uint32_t sustainable_power;
+    uint32_t current_cap;
+} POWERCAP_DOMAIN_INFO_s;
+
+typedef struct {
+    uint32_t num_domains;
+    POWERCAP_DOMAIN_INFO_s domain_info[MAX_NUM_OF_POWERCAP_DOMAINS];
+} POWERCAP_INFO_s;
+
+/* Common Tests */
+uint32_t powercap_query_protocol_version(uint32_t *version);
+uint32_t powercap_query_protocol_attributes(void);
+uint32_t powercap_query_mandatory_command_support(void);
+uint32_t powercap_invalid_messageid_call(void);
+uint32_t powercap_query_domain_attributes(void);
+uint32_t powercap_query_domain_attributes_invalid_id(void);
+uint32_t powercap_query_cap_get(void);
+uint32_t powercap_query_cap_get_invalid_id(void);
+uint32_t powercap_set_cap(void);
+uint32_t powercap_set_cap_invalid_domain(void);
+uint32_t powercap_set_invalid_cap(void);
+uint32_t powercap_query_measurements(void);
+uint32_t powercap_query_measurements_invalid_id(void);
+uint32_t powercap_cap_enforcement_benchmark(void);
+
+uint32_t val_powercap_get_expected_num_domains(void);
+uint8_t *val_powercap_get_expected_name(uint32_t domain_id);
+#endif
@@ -30,16 +30,23 @@
 #define INVALID_FLAG_VAL                         0xF8
 #define RESET_FLAG_ASYNC_RESET_BIT               0x2
 #define RESET_FLAG_AUTONOMOUS_RESET_BIT          0x0
+#define RESET_FLAG_EXPLICIT_SIGNAL_BIT           0x1
 #define RESET_TYPE_BIT                           31
 #define RESET_TYPE_ARCHITECTURAL                 0x0
 #define RESET_ARCHITECTURAL_INVALID_ID           0xFF
 #define RESET_NOTIFY_DISABLE                     0x0
 #define RESET_INVALID_NOTIFY_ENABLE              0xF
+#define RESET_NOTIFY_ENABLE                      0x1
+#define RESET_LATENCY_UNKNOWN                    0xFFFFFFFF
+#define RESET_DELAYED_RESP_DOMAIN_OFFSET         0
+#define RESET_NOTIFY_DOMAIN_OFFSET               1
+#define RESET_NOTIFY_STATE_OFFSET                2
 
 
 typedef struct {
     uint32_t async_support;
     uint32_t notify_support;
+    uint32_t latency;
 } RESET_DOMAIN_INFO_s;
 
 typedef struct {
@@ -63,6 +70,9 @@ uint32_t reset_query_invalid_notify_enable(void);
 /* scmi v3 Tests */
 uint32_t reset_query_domain_attributes_scmi_v3(void);
 
+/* Benchmarks */
+uint32_t reset_latency_benchmark(void);
+
 uint32_t val_reset_get_expected_num_domains(void);
 uint8_t *val_reset_get_expected_name(uint32_t domain_id);
 
@@ -0,0 +1,209 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __VAL_SCHEMA_H__
+#define __VAL_SCHEMA_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Message schemas. Each message the suite decodes has one entry giving its
+ * parameter count, its return words, the entries that follow them and the
+ * bits of every word that must be zero. val_schema_decode checks the return
+ * count and all reserved bits in one pass, after which the return values are
+ * read through the view of the message, and val_schema_check_params checks
+ * the parameter count of a command before it is sent. The schema table depends on nothing
+ * else in VAL, so the mocker checks its own responses against it as well.
+ * Layouts are those of the newest protocol version the suite covers.
+ */
+
+/* Bitfields are "low, high" bit pairs */
+#define VAL_SCHEMA_BITS(value, field)       VAL_SCHEMA_BITS_(value, field)
+#define VAL_SCHEMA_BITS_(value, low, high) \
+    (((value) >> (low)) & (uint32_t)((1ull << ((high) - (low) + 1)) - 1))
+#define VAL_SCHEMA_MASK(field)              VAL_SCHEMA_MASK_(field)
+#define VAL_SCHEMA_MASK_(low, high) \
+    ((uint32_t)(((1ull << ((high) - (low) + 1)) - 1) << (low)))
+
+/* Messages are looked up by header without the token */
+#define VAL_SCHEMA_HDR(protocol_id, msg_type, msg_id) \
+    (((protocol_id) << 10) | ((msg_type) << 8) | (msg_id))
+#define VAL_SCHEMA_HDR_MASK                 0x3FFFF
+
+#define VAL_SCHEMA_NAME_SIZE                16
+
+typedef struct {
+    uint32_t msg_hdr;
+    uint8_t  num_params;            /* command parameters, 0 for other message types */
+    uint8_t  num_returns;           /* fixed return words, ahead of any entries */
+    uint8_t  entry_words;           /* words per entry, 0 if there are no entries */
+    uint8_t  count_word;            /* fixed word holding the number of entries */
+    uint8_t  count_low;
+    uint8_t  count_high;
+    const uint32_t *reserved;       /* reserved bits of each fixed word, NULL if none */
+    const uint32_t *entry_reserved; /* reserved bits of each entry word, NULL if none */
+} VAL_SCHEMA_MSG_s;
+
+/* Decoder outcome */
+#define VAL_SCHEMA_OK                       0
+#define VAL_SCHEMA_UNKNOWN                  1
+#define VAL_SCHEMA_BAD_COUNT                2
+#define VAL_SCHEMA_RESERVED_SET             3
+
+typedef struct {
+    uint32_t error;
+    uint32_t expected_count;        /* return words the schema asks for */
+    uint32_t num_entries;
+    uint32_t word;                  /* first word with reserved bits set */
+    uint32_t reserved_bits;         /* and those bits */
+} VAL_SCHEMA_RESULT_s;
+
+/* Views of the return values, fields in the order of the schema */
+typedef struct {
+    uint32_t version;
+} PROTOCOL_VERSION_VIEW_s;
+
+typedef struct {
+    uint32_t attributes;
+} PROTOCOL_ATTRIBUTES_VIEW_s;
+
+/* Attributes of the base, clock, reset, voltage and powercap protocols */
+#define BASE_ATTR_NUM_PROTOCOLS             0, 7
+#define BASE_ATTR_NUM_AGENTS                8, 15
+#define BASE_ATTR_RESERVED                  16, 31
+#define CLOCK_ATTR_NUM_CLOCKS               0, 15
+#define CLOCK_ATTR_MAX_PENDING              16, 23
+#define CLOCK_ATTR_RESERVED                 24, 31
+#define PROTOCOL_ATTR_NUM_DOMAINS           0, 15
+#define PROTOCOL_ATTR_RESERVED              16, 31
+
+/* Power domain, performance and sensor protocol attributes */
+typedef struct {
+    uint32_t attributes;
+    uint32_t stats_addr_low;
+    uint32_t stats_addr_high;
+    uint32_t stats_len;
+} PROTOCOL_ATTRIBUTES_STATS_VIEW_s;
+
+#define PERF_ATTR_NUM_DOMAINS               0, 15
+#define PERF_ATTR_POWER_MW                  16, 16
+#define PERF_ATTR_RESERVED                  17, 31
+#define SENSOR_ATTR_NUM_SENSORS             0, 15
+#define SENSOR_ATTR_MAX_PENDING             16, 23
+#define SENSOR_ATTR_RESERVED                24, 31
+
+typedef struct {
+    uint32_t attributes;
+} MESSAGE_ATTRIBUTES_VIEW_s;
+
+#define PERF_MSG_ATTR_FAST_CHANNEL          0, 0
+#define PERF_MSG_ATTR_RESERVED              1, 31
+
+typedef struct {
+    uint32_t attributes;
+    uint32_t rate_limit;
+    uint32_t sustained_freq;
+    uint32_t sustained_level;
+    uint8_t  name[VAL_SCHEMA_NAME_SIZE];
+} PERF_DOMAIN_ATTRIBUTES_VIEW_s;
+
+#define PERF_DOMAIN_ATTR_SET_LIMIT          31, 31
+#define PERF_DOMAIN_ATTR_SET_LEVEL          30, 30
+#define PERF_DOMAIN_ATTR_LIMIT_NOTIFY       29, 29
+#define PERF_DOMAIN_ATTR_LEVEL_NOTIFY       28, 28
+#define PERF_DOMAIN_ATTR_FAST_CHANNEL       27, 27
+#define PERF_DOMAIN_ATTR_RESERVED           0, 26
+#define PERF_RATE_LIMIT                     0, 19
+#define PERF_RATE_LIMIT_RESERVED            20, 31
+
+typedef struct {
+    uint32_t level;
+    uint32_t power_cost;
+    uint32_t latency;
+} PERF_LEVEL_ENTRY_VIEW_s;
+
+typedef struct {
+    uint32_t num_levels;
+    PERF_LEVEL_ENTRY_VIEW_s entry[];
+} PERF_DESCRIBE_LEVELS_VIEW_s;
+
+#define PERF_LEVELS_RETURNED                0, 11
+#define PERF_LEVELS_RESERVED                12, 15
+#define PERF_LEVELS_REMAINING               16, 31
+#define PERF_LEVEL_LATENCY                  0, 15
+#define PERF_LEVEL_LATENCY_RESERVED         16, 31
+
+typedef struct {
+    uint32_t range_max;
+    uint32_t range_min;
+} PERF_LIMITS_GET_VIEW_s;
+
+typedef struct {
+    uint32_t level;
+} PERF_LEVEL_GET_VIEW_s;
+
+typedef struct {
+    uint32_t attributes;
+    uint32_t rate_limit;
+    uint32_t chan_addr_low;
+    uint32_t chan_addr_high;
+    uint32_t chan_size;
+    uint32_t doorbell_addr_low;
+    uint32_t doorbell_addr_high;
+    uint32_t doorbell_mask_low;
+    uint32_t doorbell_mask_high;
+    uint32_t doorbell_preserve_low;
+    uint32_t doorbell_preserve_high;
+} PERF_DESCRIBE_FASTCHANNEL_VIEW_s;
+
+#define PERF_FC_ATTR_DOORBELL               0, 0
+#define PERF_FC_ATTR_DOORBELL_WIDTH         1, 2
+#define PERF_FC_ATTR_RESERVED               3, 31
+
+typedef struct {
+    uint32_t agent_id;
+    uint32_t domain_id;
+    uint32_t range_max;
+    uint32_t range_min;
+} PERF_LIMITS_CHANGED_VIEW_s;
+
+typedef struct {
+    uint32_t agent_id;
+    uint32_t domain_id;
+    uint32_t level;
+} PERF_LEVEL_CHANGED_VIEW_s;
+
+typedef struct {
+    uint32_t agent_id;
+    uint32_t flags;
+    uint32_t system_state;
+} SYSTEM_POWER_STATE_NOTIFIER_VIEW_s;
+
+#define SYSTEM_POWER_SET_ATTR_WARM_RESET    31, 31
+#define SYSTEM_POWER_SET_ATTR_SUSPEND       30, 30
+#define SYSTEM_POWER_SET_ATTR_RESERVED      0, 29
+
+const VAL_SCHEMA_MSG_s *val_schema_find(uint32_t msg_hdr);
+uint32_t val_schema_check_params(uint32_t msg_hdr, size_t num_params);
+uint32_t val_schema_decode(uint32_t msg_hdr, size_t num_returns, const uint32_t *returns,
+                           VAL_SCHEMA_RESULT_s *result);
+
+/* VAL side, reports the outcome and hands back the view */
+void    *val_decode_response(uint32_t msg_hdr, size_t num_returns, uint32_t *returns);
+
+#endif
@@ -18,7 +18,9 @@
 #ifndef __VAL_SENSOR_H__
 #define __VAL_SENSOR_H__
 
+#ifndef MAX_NUM_OF_SENSORS
 #define MAX_NUM_OF_SENSORS                  32
+#endif
 
 #define VERSION_OFFSET                      0
 #define ATTRIBUTE_OFFSET                    0
@@ -36,12 +38,39 @@
 #define INTERVAL_END_OFFSET                 1
 #define INTERVAL_STEP_OFFSET                2
 #define LEVEL_ARRAY_OFFSET                  1
-#define SENSOR_CONFIG_OFFSET                1
+#define SENSOR_CONFIG_OFFSET                0
 #define SENSOR_STATE_OFFSET                 0
 
 #define DELAYED_RESP_SENSOR_ID_OFFSET       0
 #define DELAYED_RESP_SENSOR_VAL_LOW_OFFSET  1
 #define DELAYED_RESP_SENSOR_VAL_HIGH_OFFSET 2
+#define DELAYED_RESP_SENSOR_READINGS_OFFSET 1
+
+/* SENSOR_UPDATE notification payload */
+#define SENSOR_UPDATE_AGENT_ID_OFFSET       0
+#define SENSOR_UPDATE_SENSOR_ID_OFFSET      1
+#define SENSOR_UPDATE_READINGS_OFFSET       2
+
+/* Sensor reading structure of protocol version 2, one per axis */
+#define SENSOR_READING_WORDS                4
+#define SENSOR_READING_VAL_LOW_OFFSET       0
+#define SENSOR_READING_VAL_HIGH_OFFSET      1
+#define SENSOR_READING_TS_LOW_OFFSET        2
+#define SENSOR_READING_TS_HIGH_OFFSET       3
+
+/* Timestamp exponent of the sensor descriptor, signed power of ten in seconds */
+#define SENSOR_TIMESTAMP_EXP_BITS           5
+#define SENSOR_TIMESTAMP_EXP_NS             (-9)
+
+#define SENSOR_CAPTURE_MAX_AXES             (MAX_RETURNS_SIZE / SENSOR_READING_WORDS)
+#ifndef SENSOR_CAPTURE_MAX_SAMPLES
+#define SENSOR_CAPTURE_MAX_SAMPLES          128
+#endif
+
+/* Time the trip point notification storm runs for on each sensor */
+#ifndef SENSOR_STORM_WINDOW_MS
+#define SENSOR_STORM_WINDOW_MS              50
+#endif
 
 #define INVALID_FLAG_VAL                    0xF
 #define SENSOR_READ_ASYNC_MODE              0x1
@@ -78,6 +107,7 @@ typedef struct {
     uint32_t num_axis;
     uint32_t axis_support;
     uint32_t sensor_state;
+    uint32_t timestamp_exponent;
 } SENSOR_EXTEND_INFO_s;
 
 typedef struct {
@@ -89,6 +119,22 @@ typedef struct {
     SENSOR_EXTEND_INFO_s ext_desc_info[MAX_NUM_OF_SENSORS];
 } SENSOR_INFO_s;
 
+/* Decoded readings, one contiguous array per axis */
+typedef struct {
+    uint32_t num_axes;
+    uint32_t num_samples;
+    uint32_t num_dropped;           /* samples received once the capture was full */
+    int64_t  value[SENSOR_CAPTURE_MAX_AXES][SENSOR_CAPTURE_MAX_SAMPLES];
+    uint64_t timestamp[SENSOR_CAPTURE_MAX_AXES][SENSOR_CAPTURE_MAX_SAMPLES];
+} SENSOR_CAPTURE_s;
+
+typedef struct {
+    int64_t  min;
+    int64_t  max;
+    int64_t  mean;
+    uint64_t stddev;
+} SENSOR_AXIS_STATS_s;
+
 /* Common Tests */
 uint32_t sensor_query_protocol_version(uint32_t *version);
 uint32_t sensor_query_protocol_attributes(void);
@@ -117,11 +163,22 @@ uint32_t sensor_request_sensor_notification_check(void);
 uint32_t sensor_request_notification_invalid_id_check(void);
 
 uint32_t sensor_query_description_get_scmi_v3(void);
+uint32_t sensor_multi_axis_reading_capture(void);
+uint32_t sensor_timestamp_clock_correlation(void);
+uint32_t sensor_trip_point_notification_storm(void);
 
 uint32_t val_sensor_get_expected_num_sensors(void);
 uint32_t val_sensor_get_expected_stats_addr_low(void);
 uint32_t val_sensor_get_expected_stats_addr_high(void);
 uint32_t val_sensor_get_expected_stats_addr_len(void);
+uint32_t val_sensor_get_expected_clock_drift(int32_t *drift_ppb);
 uint32_t val_get_notify_enable_config(uint32_t notify_enable_flag);
 
+void     val_sensor_capture_init(SENSOR_CAPTURE_s *capture, uint32_t num_axes);
+uint32_t val_sensor_capture_add(SENSOR_CAPTURE_s *capture, const uint32_t *readings,
+                                uint32_t num_words);
+void     val_sensor_capture_stats(const SENSOR_CAPTURE_s *capture, uint32_t axis,
+                                  SENSOR_AXIS_STATS_s *stats);
+uint64_t val_sensor_timestamp_to_ns(uint64_t timestamp, uint32_t timestamp_exponent);
+
 #endif
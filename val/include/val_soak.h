@@ -0,0 +1,57 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __VAL_SOAK_H__
+#define __VAL_SOAK_H__
+
+/* Build time defaults, overridden on the command line of hosted apps */
+#ifndef SOAK_DURATION_SEC
+#define SOAK_DURATION_SEC               0
+#endif
+#ifndef SOAK_INTERVAL_SEC
+#define SOAK_INTERVAL_SEC               60
+#endif
+#ifndef SOAK_MAX_ITERATIONS
+#define SOAK_MAX_ITERATIONS             0
+#endif
+
+#define SOAK_DEFAULT_DRIFT_WINDOW       6
+#define SOAK_DEFAULT_DRIFT_THRESHOLD    20
+#define SOAK_MAX_DRIFT_WINDOW           16
+#define SOAK_MIN_DRIFT_WINDOW           3
+
+/* Slot after the per protocol entries holding the all protocol figures */
+#define SOAK_ALL_PROTOCOLS              VAL_NUM_PROTOCOLS
+
+typedef struct {
+    uint32_t duration_sec;          /* 0 disables soak mode */
+    uint32_t interval_sec;          /* report period */
+    uint32_t max_iterations;        /* 0 for no iteration limit */
+    uint32_t drift_window;          /* intervals inspected for drift */
+    uint32_t drift_threshold_pct;   /* rise over the window flagged as drift */
+} SOAK_CONFIG_s;
+
+typedef struct {
+    uint64_t mean[SOAK_MAX_DRIFT_WINDOW];   /* exact interval mean */
+    uint64_t p99[SOAK_MAX_DRIFT_WINDOW];    /* upper bound of the p99 bucket */
+    uint32_t num_entries;
+} SOAK_DRIFT_HISTORY_s;
+
+void     val_soak_get_default_config(SOAK_CONFIG_s *config);
+uint32_t val_soak_execute(SOAK_CONFIG_s *config);
+
+#endif
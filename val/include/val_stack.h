@@ -0,0 +1,32 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __VAL_STACK_H__
+#define __VAL_STACK_H__
+
+/* Word the unused stack is painted with before each test */
+#define VAL_STACK_PAINT_WORD        0x4B545350u
+
+/* Stack left unpainted below the painting function, for its own frame */
+#define VAL_STACK_GUARD_BYTES       256
+
+void     val_stack_init(void);
+void     val_stack_paint(uint32_t test_num);
+uint32_t val_stack_measure(void);
+void     val_stack_report(void);
+
+#endif
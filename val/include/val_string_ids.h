@@ -0,0 +1,108 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __VAL_STRING_IDS_H__
+#define __VAL_STRING_IDS_H__
+
+/*
+ * String free build, enabled with STRING_IDS on baremetal. Print formats,
+ * check names and test descriptions are not compiled in: each print is
+ * recorded with the id of the file it is written in (VAL_FILE_ID, the cksum
+ * of the file name, set per file by the makefiles) and its line, and the
+ * host decoder looks the text up in the manifest written by
+ * tools/scmi_string_manifest.py. Arguments are recorded as in the deferred
+ * log, their kinds taken from their types at compile time.
+ */
+#ifdef STRING_IDS
+
+#define VAL_TEXT_ID                 ((VAL_TEXT_s){((uint64_t)VAL_FILE_ID << 32) | __LINE__})
+
+/* Print arguments supported per call */
+#define VAL_LOG_MAX_ARGS            12
+
+#define VAL_LOG_NTH(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, n, ...) n
+
+/* Kind of an argument after the default argument promotions, not evaluated */
+#define VAL_LOG_KIND(x) ((uint64_t)_Generic((x), \
+    _Bool: PAL_LOG_ARG_INT, \
+    char: PAL_LOG_ARG_INT, \
+    signed char: PAL_LOG_ARG_INT, \
+    unsigned char: PAL_LOG_ARG_INT, \
+    short: PAL_LOG_ARG_INT, \
+    unsigned short: PAL_LOG_ARG_INT, \
+    int: PAL_LOG_ARG_INT, \
+    unsigned int: PAL_LOG_ARG_INT, \
+    long: PAL_LOG_ARG_LONG, \
+    unsigned long: PAL_LOG_ARG_LONG, \
+    long long: PAL_LOG_ARG_LONG_LONG, \
+    unsigned long long: PAL_LOG_ARG_LONG_LONG, \
+    float: PAL_LOG_ARG_DOUBLE, \
+    double: PAL_LOG_ARG_DOUBLE, \
+    char *: PAL_LOG_ARG_STRING, \
+    const char *: PAL_LOG_ARG_STRING, \
+    unsigned char *: PAL_LOG_ARG_STRING, \
+    const unsigned char *: PAL_LOG_ARG_STRING, \
+    uint32_t *: PAL_LOG_ARG_STRING,     /* names kept in response words */ \
+    const uint32_t *: PAL_LOG_ARG_STRING, \
+    VAL_TEXT_s: PAL_LOG_ARG_STRING_ID, \
+    default: PAL_LOG_ARG_POINTER))
+
+#define VAL_LOG_KINDS_0()           0
+#define VAL_LOG_KINDS_1(a)          VAL_LOG_KIND(a)
+#define VAL_LOG_KINDS_2(a, ...)     (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_1(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+#define VAL_LOG_KINDS_3(a, ...)     (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_2(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+#define VAL_LOG_KINDS_4(a, ...)     (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_3(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+#define VAL_LOG_KINDS_5(a, ...)     (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_4(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+#define VAL_LOG_KINDS_6(a, ...)     (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_5(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+#define VAL_LOG_KINDS_7(a, ...)     (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_6(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+#define VAL_LOG_KINDS_8(a, ...)     (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_7(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+#define VAL_LOG_KINDS_9(a, ...)     (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_8(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+#define VAL_LOG_KINDS_10(a, ...)    (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_9(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+#define VAL_LOG_KINDS_11(a, ...)    (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_10(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+#define VAL_LOG_KINDS_12(a, ...)    (VAL_LOG_KIND(a) | (VAL_LOG_KINDS_11(__VA_ARGS__) << PAL_LOG_ARG_BITS))
+
+/* Kinds of all arguments as one constant, PAL_LOG_ARG_END after the last */
+#define VAL_LOG_KINDS(...) \
+    VAL_LOG_NTH(_, ##__VA_ARGS__, VAL_LOG_KINDS_12, VAL_LOG_KINDS_11, VAL_LOG_KINDS_10, \
+                VAL_LOG_KINDS_9, VAL_LOG_KINDS_8, VAL_LOG_KINDS_7, VAL_LOG_KINDS_6, \
+                VAL_LOG_KINDS_5, VAL_LOG_KINDS_4, VAL_LOG_KINDS_3, VAL_LOG_KINDS_2, \
+                VAL_LOG_KINDS_1, VAL_LOG_KINDS_0)(__VA_ARGS__)
+
+/* Print level and line in one word, one constant less to load per print */
+#define VAL_LOG_LINE_BITS           24
+#define VAL_LOG_SITE(level)         (((uint32_t)(level) << VAL_LOG_LINE_BITS) | __LINE__)
+
+#define val_print(level, format, ...) \
+    val_print_id(VAL_LOG_SITE(level), VAL_FILE_ID, VAL_LOG_KINDS(__VA_ARGS__), ##__VA_ARGS__)
+
+#define val_compare(parameter, rcvd_val, exp_val) \
+    val_compare(VAL_TEXT_ID, (rcvd_val), (exp_val))
+#define val_compare_str(parameter, rcvd_val, exp_val, len) \
+    val_compare_str(VAL_TEXT_ID, (rcvd_val), (exp_val), (len))
+#define val_test_initialize(test_num, test_desc) \
+    val_test_initialize((test_num), VAL_TEXT_ID)
+
+/* Report files need a file system, which string free targets do not have */
+static inline void val_file_discard(void *handle, ...)
+{
+}
+
+#define val_file_print(handle, format, ...) val_file_discard((handle), ##__VA_ARGS__)
+
+#endif /* STRING_IDS */
+
+#endif
@@ -24,6 +24,15 @@
 #define INVALID_FLAG_VAL                    0xF
 #define INVALID_NOTIFY_EN_VAL               0xF
 
+#define NOTIFY_ENABLE                       1
+#define NOTIFY_DISABLE                      0
+#define GRACEFUL_REQUEST                    0x1
+
+/* SYSTEM_POWER_STATE_NOTIFIER payload */
+#define NOTIFY_AGENT_ID_OFFSET              0
+#define NOTIFY_FLAGS_OFFSET                 1
+#define NOTIFY_SYSTEM_STATE_OFFSET          2
+
 typedef struct {
     uint32_t system_power_reset_support;
     uint32_t system_power_suspend_support;
@@ -37,5 +46,6 @@ uint32_t system_power_invalid_messageid_call(void);
 uint32_t system_power_state_get_check(void);
 uint32_t system_power_state_set_invalid_parameters(void);
 uint32_t system_power_state_notify_invalid_parameters(void);
+uint32_t system_power_suspend_resume_latency(void);
 
 #endif
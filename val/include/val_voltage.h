@@ -26,9 +26,18 @@
 #define LEVEL_STEP_OFFSET             2
 #define START_LEVEL_INDEX             0
 #define SECOND_LEVEL_INDEX            1
+#define ASYNC_LEVEL_SET_SUPPORT_BIT   31
+#define VOLTAGE_SET_SYNC_MODE         0x0
+#define VOLTAGE_SET_ASYNC_MODE        0x1
+#define DELAYED_RESP_DOMAIN_ID_OFFSET 0
+#define DELAYED_RESP_LEVEL_OFFSET     1
 
+#ifndef MAX_NUM_OF_VOLTAGE_DOMAINS
 #define MAX_NUM_OF_VOLTAGE_DOMAINS   32
+#endif
+#ifndef MAX_NUMBER_VOLTAGE_LEVELS
 #define MAX_NUMBER_VOLTAGE_LEVELS    32
+#endif
 
 typedef enum {
     ARCHITECTURAL_MODE,
@@ -71,6 +80,7 @@ uint32_t voltage_set_voltage_level(void);
 uint32_t voltage_set_voltage_invalid_domain(void);
 uint32_t voltage_set_invalid_voltage_level(void);
 uint32_t voltage_query_current_level(void);
+uint32_t voltage_level_ramp_benchmark(void);
 
 uint32_t val_voltage_get_expected_num_domains(void);
 uint8_t *val_voltage_get_expected_name(uint32_t domain_id);
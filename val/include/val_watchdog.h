@@ -0,0 +1,65 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#ifndef __VAL_WATCHDOG_H__
+#define __VAL_WATCHDOG_H__
+
+/* Build time default, overridden on the command line of hosted apps */
+#ifndef TEST_TIMEOUT_MS
+#define TEST_TIMEOUT_MS                 60000
+#endif
+
+#ifndef CHECKPOINT_MAX_ENTRIES
+#define CHECKPOINT_MAX_ENTRIES          512
+#endif
+
+/*
+ * A test number can run more than once in a pass, so records are keyed by the
+ * position of the test in the run and its number, (ordinal << shift) | test num
+ */
+#define CHECKPOINT_ORDINAL_SHIFT        16
+#define CHECKPOINT_KEY(ordinal, test_num) \
+    (((ordinal) << CHECKPOINT_ORDINAL_SHIFT) | (test_num))
+
+/* Test outcomes recorded in the checkpoint file, one "<test key> <outcome>" per line */
+#define CHECKPOINT_STARTED              0
+#define CHECKPOINT_PASSED               1
+#define CHECKPOINT_FAILED               2
+#define CHECKPOINT_SKIPPED              3
+#define CHECKPOINT_TIMED_OUT            4
+#define CHECKPOINT_ABORTED              5   /* started but never finished, e.g. a crash */
+
+/* Outcomes from here up hold the progress a test saved before going down */
+#define CHECKPOINT_PROGRESS             0x100
+
+typedef struct {
+    uint32_t test_timeout_ms;       /* per test budget, 0 disables the watchdog */
+    const char *checkpoint_file;    /* NULL disables checkpoint and resume */
+} WATCHDOG_CONFIG_s;
+
+void     val_watchdog_get_default_config(WATCHDOG_CONFIG_s *config);
+uint32_t val_watchdog_init(WATCHDOG_CONFIG_s *config);
+void     val_watchdog_run_complete(void);
+void     val_watchdog_set_setup_test(void);
+uint32_t val_watchdog_start(uint32_t test_num);
+uint32_t val_watchdog_expired(void);
+void     val_watchdog_expire(void);
+uint32_t val_watchdog_stop(uint32_t status);
+void     val_checkpoint_save_progress(uint32_t progress);
+uint32_t val_checkpoint_get_progress(void);
+
+#endif
@@ -31,21 +31,21 @@ uint32_t val_base_execute_tests(void)
 
     val_memset((void *)&g_base_info_table, 0, sizeof(g_base_info_table));
 
-    if (RUN_TEST(base_query_protocol_version(&version)))
+    if (RUN_SETUP_TEST(base_query_protocol_version(&version)))
         return VAL_STATUS_FAIL;
 
-    RUN_TEST(base_query_protocol_attributes());
+    RUN_SETUP_TEST(base_query_protocol_attributes());
     RUN_TEST(base_query_mandatory_command_support());
     RUN_TEST(base_invalid_messageid_call());
-    RUN_TEST(base_query_vendor_name());
-    RUN_TEST(base_query_subvendor_info());
+    RUN_SETUP_TEST(base_query_vendor_name());
+    RUN_SETUP_TEST(base_query_subvendor_info());
     RUN_TEST(base_query_implementation_version());
-    RUN_TEST(base_query_protocol_list());
+    RUN_SETUP_TEST(base_query_protocol_list());
     if (version == BASE_PROTOCOL_VERSION_1) {
         RUN_TEST(base_discover_agent_v1());
     }
     if (version == BASE_PROTOCOL_VERSION_2) {
-        RUN_TEST(base_discover_agent());
+        RUN_SETUP_TEST(base_discover_agent());
     }
     RUN_TEST(base_query_notify_error_support());
 
@@ -57,11 +57,44 @@ uint32_t val_base_execute_tests(void)
         RUN_TEST(base_reset_agent_configuration_check());
         RUN_TEST(base_restore_device_access_with_reset_agent_configuration());
         RUN_TEST(base_restore_protocol_access_with_reset_agent_configuration());
+        RUN_TEST(base_permission_matrix_sweep());
     }
+    RUN_TEST(base_completion_mode_latency());
 
     return VAL_STATUS_PASS;
 }
 
+/**
+  @brief   This API is called from soak runs to execute the state restoring
+           subset of base tests. Info table is kept from the compliance run.
+  @param   none
+  @return  number of failed tests
+**/
+uint32_t val_base_execute_soak_tests(void)
+{
+    uint32_t version = 0;
+    uint32_t num_fail = 0;
+
+    if (RUN_SOAK_TEST(base_query_protocol_version(&version)))
+        return 1;
+
+    num_fail += RUN_SOAK_TEST(base_query_protocol_attributes());
+    num_fail += RUN_SOAK_TEST(base_query_mandatory_command_support());
+    num_fail += RUN_SOAK_TEST(base_invalid_messageid_call());
+    num_fail += RUN_SOAK_TEST(base_query_vendor_name());
+    num_fail += RUN_SOAK_TEST(base_query_subvendor_info());
+    num_fail += RUN_SOAK_TEST(base_query_implementation_version());
+    num_fail += RUN_SOAK_TEST(base_query_protocol_list());
+    num_fail += RUN_SOAK_TEST(base_query_notify_error_support());
+
+    if (version == BASE_PROTOCOL_VERSION_2) {
+        num_fail += RUN_SOAK_TEST(base_deny_restore_device_access());
+        num_fail += RUN_SOAK_TEST(base_deny_restore_protocol_access());
+    }
+
+    return num_fail;
+}
+
 /**
   @brief   This API is used to set base protocol info
            1. Caller       -  Test Suite.
@@ -0,0 +1,508 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_base.h"
+#include "val_baseline.h"
+
+/* Baseline store records, one per line. A platform line starts the latency
+ * records of one run, later runs of the same platform replace earlier ones.
+ *   platform <implementation version> <vendor name>
+ *   msg <protocol id> <message id> <count> <sum> <min> <max> <bucket>:<samples> ...
+ */
+
+static BASELINE_CONFIG_s g_baseline_config;
+static char g_baseline_line[BASELINE_LINE_SIZE];
+static uint8_t g_baseline_seen[VAL_NUM_PROTOCOLS][VAL_LATENCY_MAX_MSG_ID];
+
+/**
+  @brief   This API fills a baseline configuration with the defaults
+           1. Caller       -  App layer.
+  @param   config  baseline configuration
+  @return  none
+**/
+void val_baseline_get_default_config(BASELINE_CONFIG_s *config)
+{
+    config->save_file = NULL;
+    config->compare_file = NULL;
+    config->threshold_pct = BASELINE_DEFAULT_THRESHOLD;
+}
+
+/**
+  @brief   This API starts recording the latency of every message sent, if
+           the run is to be saved to or compared against a baseline store
+           1. Caller       -  App layer, before the first test.
+  @param   config  baseline configuration
+  @return  none
+**/
+void val_baseline_start(BASELINE_CONFIG_s *config)
+{
+    g_baseline_config = *config;
+
+    if ((config->save_file == NULL) && (config->compare_file == NULL))
+        return;
+
+    val_latency_reset();
+    val_latency_record_enable(1);
+}
+
+/**
+  @brief   This function reads the vendor name and implementation version
+           the baseline records are keyed by
+  @param   platform  platform identity
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL if the platform did not answer
+**/
+static uint32_t val_baseline_query_platform(BASELINE_PLATFORM_s *platform)
+{
+    int32_t  status;
+    uint32_t rsp_msg_hdr;
+    uint32_t cmd_msg_hdr;
+    size_t   param_count;
+    size_t   return_value_count;
+    uint32_t return_values[MAX_RETURNS_SIZE];
+    uint8_t  *name;
+    uint32_t i;
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_BASE, BASE_DISCOVER_VENDOR, COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, NULL, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+    if (status != SCMI_SUCCESS)
+        return VAL_STATUS_FAIL;
+
+    name = (uint8_t *)&return_values[VENDOR_ID_OFFSET];
+    val_memset(platform->vendor_name, 0, SCMI_NAME_STR_SIZE);
+    for (i = 0; (i < (SCMI_NAME_STR_SIZE - 1)) && name[i]; i++)
+        platform->vendor_name[i] = name[i];
+
+    VAL_INIT_TEST_PARAM(param_count, rsp_msg_hdr, return_value_count, status);
+    cmd_msg_hdr = val_msg_hdr_create(PROTOCOL_BASE, BASE_DISCOVER_IMPLEMENTATION_VERSION,
+                                     COMMAND_MSG);
+    val_send_message(cmd_msg_hdr, param_count, NULL, &rsp_msg_hdr, &status,
+                     &return_value_count, return_values);
+    if (status != SCMI_SUCCESS)
+        return VAL_STATUS_FAIL;
+
+    platform->implementation_version = return_values[IMPLEMENTATION_VERSION_OFFSET];
+
+    return VAL_STATUS_PASS;
+}
+
+/**
+  @brief   This function compares two vendor names
+  @param   name1  first name
+  @param   name2  second name
+  @return  1 if both are the same, else 0
+**/
+static uint32_t val_baseline_name_equal(const uint8_t *name1, const uint8_t *name2)
+{
+    uint32_t i;
+
+    for (i = 0; i < SCMI_NAME_STR_SIZE; i++)
+    {
+        if (name1[i] != name2[i])
+            return 0;
+        if (name1[i] == '\0')
+            break;
+    }
+
+    return 1;
+}
+
+/**
+  @brief   This function adds the recorded latencies of this run to the store
+  @param   file      baseline store
+  @param   platform  platform identity
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL if the file cannot be written
+**/
+static uint32_t val_baseline_save(const char *file, BASELINE_PLATFORM_s *platform)
+{
+    void *handle;
+    uint32_t protocol_id, msg_id, i, num_msgs = 0;
+    VAL_HIST_s *hist;
+
+    handle = val_file_open_append(file);
+    if (handle == NULL) {
+        val_print(VAL_PRINT_ERR, "\n     Cannot write baseline %s", file);
+        return VAL_STATUS_FAIL;
+    }
+
+    val_file_print(handle, "platform 0x%08x %s\n", platform->implementation_version,
+                   (char *)platform->vendor_name);
+
+    for (protocol_id = PROTOCOL_BASE; protocol_id < PROTOCOL_MAX; protocol_id++)
+    {
+        for (msg_id = 0; msg_id < VAL_LATENCY_MAX_MSG_ID; msg_id++)
+        {
+            hist = val_latency_get_msg_hist(protocol_id, msg_id);
+            if ((hist == NULL) || (hist->count == 0))
+                continue;
+
+            val_file_print(handle, "msg 0x%02x 0x%02x %u %llu %llu %llu", protocol_id, msg_id,
+                           hist->count, (unsigned long long)hist->sum,
+                           (unsigned long long)hist->min, (unsigned long long)hist->max);
+            for (i = 0; i < VAL_HIST_NUM_BUCKETS; i++)
+            {
+                if (hist->bucket[i])
+                    val_file_print(handle, " %u:%u", i, hist->bucket[i]);
+            }
+            val_file_print(handle, "\n");
+            num_msgs++;
+        }
+    }
+    val_file_close(handle);
+
+    val_print(VAL_PRINT_ERR, "\n     SAVED       : %d messages to %s", num_msgs, file);
+
+    return VAL_STATUS_PASS;
+}
+
+/**
+  @brief   This function checks a record starts with a keyword and moves past it
+  @param   cursor   position in the record
+  @param   keyword  expected keyword
+  @return  1 if the keyword was found, else 0
+**/
+static uint32_t val_baseline_parse_keyword(char **cursor, const char *keyword)
+{
+    char *pos = *cursor;
+
+    while (*keyword)
+    {
+        if (*pos++ != *keyword++)
+            return 0;
+    }
+    if ((*pos != ' ') && (*pos != '\0'))
+        return 0;
+
+    *cursor = pos;
+    return 1;
+}
+
+/**
+  @brief   This function reads a decimal or 0x prefixed hexadecimal number
+  @param   cursor  position in the record, moved past the number
+  @param   value   number read
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL if there is no number
+**/
+static uint32_t val_baseline_parse_number(char **cursor, uint64_t *value)
+{
+    char *pos = *cursor;
+    uint32_t base = 10, digit, num_digits = 0;
+
+    while (*pos == ' ')
+        pos++;
+
+    if ((pos[0] == '0') && ((pos[1] == 'x') || (pos[1] == 'X'))) {
+        base = 16;
+        pos += 2;
+    }
+
+    *value = 0;
+    while (1)
+    {
+        if ((*pos >= '0') && (*pos <= '9'))
+            digit = *pos - '0';
+        else if ((base == 16) && (*pos >= 'a') && (*pos <= 'f'))
+            digit = *pos - 'a' + 10;
+        else if ((base == 16) && (*pos >= 'A') && (*pos <= 'F'))
+            digit = *pos - 'A' + 10;
+        else
+            break;
+
+        *value = (*value * base) + digit;
+        num_digits++;
+        pos++;
+    }
+
+    *cursor = pos;
+    return num_digits ? VAL_STATUS_PASS : VAL_STATUS_FAIL;
+}
+
+/**
+  @brief   This function reads the identity from a platform record
+  @param   cursor    position after the keyword
+  @param   platform  platform identity read
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL on a malformed record
+**/
+static uint32_t val_baseline_parse_platform(char *cursor, BASELINE_PLATFORM_s *platform)
+{
+    uint64_t value;
+    uint32_t i;
+
+    if (val_baseline_parse_number(&cursor, &value) != VAL_STATUS_PASS)
+        return VAL_STATUS_FAIL;
+    platform->implementation_version = (uint32_t)value;
+
+    if (*cursor == ' ')
+        cursor++;
+    val_memset(platform->vendor_name, 0, SCMI_NAME_STR_SIZE);
+    for (i = 0; (i < (SCMI_NAME_STR_SIZE - 1)) && cursor[i]; i++)
+        platform->vendor_name[i] = cursor[i];
+
+    return VAL_STATUS_PASS;
+}
+
+/**
+  @brief   This function reads the histogram from a message record
+  @param   cursor       position after the keyword
+  @param   protocol_id  protocol identifier read
+  @param   msg_id       message identifier read
+  @param   hist         histogram read
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL on a malformed record
+**/
+static uint32_t val_baseline_parse_msg(char *cursor, uint32_t *protocol_id, uint32_t *msg_id,
+                                       VAL_HIST_s *hist)
+{
+    uint64_t value[6], bucket, samples;
+    uint32_t i;
+
+    for (i = 0; i < NUM_ELEMS(value); i++)
+    {
+        if (val_baseline_parse_number(&cursor, &value[i]) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+    }
+
+    *protocol_id = (uint32_t)value[0];
+    *msg_id = (uint32_t)value[1];
+    val_hist_reset(hist);
+    hist->count = (uint32_t)value[2];
+    hist->sum = value[3];
+    hist->min = value[4];
+    hist->max = value[5];
+
+    while (val_baseline_parse_number(&cursor, &bucket) == VAL_STATUS_PASS)
+    {
+        if ((*cursor++ != ':') || (bucket >= VAL_HIST_NUM_BUCKETS))
+            return VAL_STATUS_FAIL;
+        if (val_baseline_parse_number(&cursor, &samples) != VAL_STATUS_PASS)
+            return VAL_STATUS_FAIL;
+        hist->bucket[bucket] = (uint32_t)samples;
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+/**
+  @brief   This function picks the records to compare against: the latest run
+           of the same platform, else of the newest earlier implementation
+           version from the same vendor, such as the previous firmware drop
+  @param   file      baseline store
+  @param   platform  identity of the platform under test
+  @param   selected  identity of the chosen records
+  @return  number of the chosen platform record counting from 1, 0 if none
+**/
+static uint32_t val_baseline_select(const char *file, BASELINE_PLATFORM_s *platform,
+                                    BASELINE_PLATFORM_s *selected)
+{
+    void *handle;
+    char *cursor;
+    uint32_t section = 0, selected_section = 0;
+    BASELINE_PLATFORM_s entry;
+
+    handle = val_file_open_read(file);
+    if (handle == NULL)
+        return 0;
+
+    while (val_file_read_line(handle, g_baseline_line, sizeof(g_baseline_line)))
+    {
+        cursor = g_baseline_line;
+        if (!val_baseline_parse_keyword(&cursor, "platform"))
+            continue;
+        section++;
+
+        if (val_baseline_parse_platform(cursor, &entry) != VAL_STATUS_PASS)
+            continue;
+        if (!val_baseline_name_equal(entry.vendor_name, platform->vendor_name))
+            continue;
+        if (entry.implementation_version > platform->implementation_version)
+            continue;
+        if (selected_section &&
+            (entry.implementation_version < selected->implementation_version))
+            continue;
+
+        *selected = entry;
+        selected_section = section;
+    }
+    val_file_close(handle);
+
+    return selected_section;
+}
+
+/**
+  @brief   This function prints the comparison of one message and judges it
+  @param   protocol_id  protocol identifier
+  @param   msg_id       message identifier
+  @param   base         baseline histogram
+  @param   run          histogram of this run
+  @return  1 if p50 or p99 regressed beyond the threshold, else 0
+**/
+static uint32_t val_baseline_compare_msg(uint32_t protocol_id, uint32_t msg_id,
+                                         VAL_HIST_s *base, VAL_HIST_s *run)
+{
+    uint64_t base_p50 = 0, base_p99 = 0, run_p50 = 0, run_p99 = 0;
+    uint32_t threshold = 100 + g_baseline_config.threshold_pct;
+    const char *verdict;
+    uint32_t regressed = 0;
+
+    if (base != NULL) {
+        base_p50 = val_hist_percentile(base, 50);
+        base_p99 = val_hist_percentile(base, 99);
+    }
+    if (run != NULL) {
+        run_p50 = val_hist_percentile(run, 50);
+        run_p99 = val_hist_percentile(run, 99);
+    }
+
+    if (run == NULL) {
+        verdict = "not sent";
+    } else if (base == NULL) {
+        verdict = "new";
+    } else if ((base->count < BASELINE_MIN_SAMPLES) || (run->count < BASELINE_MIN_SAMPLES)) {
+        verdict = "few samples";
+    } else if ((((run_p50 * 100) > (base_p50 * threshold)) &&
+                (run_p50 > (base_p50 + BASELINE_MIN_DELTA_NS))) ||
+               (((run_p99 * 100) > (base_p99 * threshold)) &&
+                (run_p99 > (base_p99 + BASELINE_MIN_DELTA_NS)))) {
+        verdict = "REGRESSED";
+        regressed = 1;
+    } else {
+        verdict = "ok";
+    }
+
+    val_print(regressed ? VAL_PRINT_ERR : VAL_PRINT_TEST,
+              "\n     0x%02x  0x%02x %6d %10llu %10llu %10llu %10llu  %s", protocol_id, msg_id,
+              (run != NULL) ? run->count : 0, (unsigned long long)base_p50,
+              (unsigned long long)run_p50, (unsigned long long)base_p99,
+              (unsigned long long)run_p99, verdict);
+
+    return regressed;
+}
+
+/**
+  @brief   This function compares the recorded latencies of this run against
+           the chosen records of the store
+  @param   file      baseline store
+  @param   platform  platform identity
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL on a regression or missing baseline
+**/
+static uint32_t val_baseline_compare(const char *file, BASELINE_PLATFORM_s *platform)
+{
+    void *handle;
+    char *cursor;
+    uint32_t section = 0, selected_section, protocol_id, msg_id;
+    uint32_t num_compared = 0, num_regressed = 0;
+    BASELINE_PLATFORM_s selected;
+    VAL_HIST_s base;
+    VAL_HIST_s *run;
+
+    selected_section = val_baseline_select(file, platform, &selected);
+    if (selected_section == 0) {
+        val_print(VAL_PRINT_ERR, "\n     No baseline for %s 0x%08x in %s",
+                  (char *)platform->vendor_name, platform->implementation_version, file);
+        return VAL_STATUS_FAIL;
+    }
+
+    val_print(VAL_PRINT_ERR, "\n     BASELINE    : %s 0x%08x from %s",
+              (char *)selected.vendor_name, selected.implementation_version, file);
+    val_print(VAL_PRINT_ERR, "\n     THRESHOLD   : %d%% and %d ns on p50 and p99",
+              g_baseline_config.threshold_pct, BASELINE_MIN_DELTA_NS);
+    val_print(VAL_PRINT_TEST, "\n     PROT   MSG  COUNT   BASE P50    RUN P50   BASE P99    RUN P99");
+
+    handle = val_file_open_read(file);
+    if (handle == NULL)
+        return VAL_STATUS_FAIL;
+
+    val_memset(g_baseline_seen, 0, sizeof(g_baseline_seen));
+    while (val_file_read_line(handle, g_baseline_line, sizeof(g_baseline_line)))
+    {
+        cursor = g_baseline_line;
+        if (val_baseline_parse_keyword(&cursor, "platform")) {
+            section++;
+            continue;
+        }
+        if ((section != selected_section) || !val_baseline_parse_keyword(&cursor, "msg"))
+            continue;
+
+        if ((val_baseline_parse_msg(cursor, &protocol_id, &msg_id, &base) != VAL_STATUS_PASS) ||
+            (protocol_id < PROTOCOL_BASE) || (protocol_id >= PROTOCOL_MAX) ||
+            (msg_id >= VAL_LATENCY_MAX_MSG_ID)) {
+            val_print(VAL_PRINT_WARN, "\n     Malformed baseline record skipped");
+            continue;
+        }
+
+        g_baseline_seen[protocol_id - PROTOCOL_BASE][msg_id] = 1;
+        num_regressed += val_baseline_compare_msg(protocol_id, msg_id, &base,
+                                                  val_latency_get_msg_hist(protocol_id, msg_id));
+        num_compared++;
+    }
+    val_file_close(handle);
+
+    for (protocol_id = PROTOCOL_BASE; protocol_id < PROTOCOL_MAX; protocol_id++)
+    {
+        for (msg_id = 0; msg_id < VAL_LATENCY_MAX_MSG_ID; msg_id++)
+        {
+            run = val_latency_get_msg_hist(protocol_id, msg_id);
+            if ((run == NULL) || (run->count == 0) ||
+                g_baseline_seen[protocol_id - PROTOCOL_BASE][msg_id])
+                continue;
+            val_baseline_compare_msg(protocol_id, msg_id, NULL, run);
+        }
+    }
+
+    val_print(VAL_PRINT_ERR, "\n     COMPARED    : %d messages, %d regressed", num_compared,
+              num_regressed);
+
+    return num_regressed ? VAL_STATUS_FAIL : VAL_STATUS_PASS;
+}
+
+/**
+  @brief   This API stops latency recording and saves the run to, and compares
+           it against, the baseline store
+           1. Caller       -  App layer, after the last test.
+  @param   none
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL if a message regressed or the run
+           could not be compared
+**/
+uint32_t val_baseline_complete(void)
+{
+    BASELINE_PLATFORM_s platform;
+    uint32_t status = VAL_STATUS_PASS;
+
+    if ((g_baseline_config.save_file == NULL) && (g_baseline_config.compare_file == NULL))
+        return VAL_STATUS_PASS;
+
+    val_latency_record_enable(0);
+
+    val_print(VAL_PRINT_ERR, "\n\n          *** Latency baseline ***");
+    if (val_baseline_query_platform(&platform) != VAL_STATUS_PASS) {
+        val_print(VAL_PRINT_ERR, "\n     Platform identity not available");
+        return VAL_STATUS_FAIL;
+    }
+    val_print(VAL_PRINT_ERR, "\n     PLATFORM    : %s 0x%08x", (char *)platform.vendor_name,
+              platform.implementation_version);
+
+    /* Compare first, so a store holding this very run is not compared to itself */
+    if (g_baseline_config.compare_file != NULL)
+        status = val_baseline_compare(g_baseline_config.compare_file, &platform);
+
+    if ((g_baseline_config.save_file != NULL) &&
+        (val_baseline_save(g_baseline_config.save_file, &platform) != VAL_STATUS_PASS))
+        status = VAL_STATUS_FAIL;
+
+    return status;
+}
@@ -0,0 +1,457 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_benchmark.h"
+
+static VAL_HIST_s g_msg_latency[VAL_NUM_PROTOCOLS];
+static uint32_t g_latency_record_enable;
+
+/* Message histograms are taken from a pool as messages are first seen, slot + 1 */
+static VAL_HIST_s g_msg_id_latency[VAL_LATENCY_MAX_MSGS];
+static uint8_t g_msg_id_slot[VAL_NUM_PROTOCOLS][VAL_LATENCY_MAX_MSG_ID];
+static uint32_t g_msg_id_num_slots;
+
+static uint32_t g_bench_quiet_depth;
+static uint32_t g_bench_print_level;
+
+/**
+  @brief   This API is used to read the agent monotonic time
+           1. Caller       -  Test Suite.
+  @param   none
+  @return  time in nanoseconds
+**/
+uint64_t val_get_time_ns(void)
+{
+    return pal_get_time_ns();
+}
+
+/**
+  @brief   This API is used to read the CPU time used by the agent
+           1. Caller       -  Test Suite.
+  @param   none
+  @return  time in nanoseconds, 0 if the platform cannot tell
+**/
+uint64_t val_get_cpu_time_ns(void)
+{
+    return pal_get_cpu_time_ns();
+}
+
+/**
+  @brief   This API starts a timed section of a benchmark. Check prints below
+           VAL_PRINT_ERR are suppressed until the section ends, so they do not
+           add to the latencies. Sections may nest.
+           1. Caller       -  Test Suite.
+  @param   none
+  @return  none
+**/
+void val_bench_quiet_begin(void)
+{
+    if (g_bench_quiet_depth++ == 0)
+        g_bench_print_level = val_set_print_level(VAL_PRINT_ERR);
+}
+
+/**
+  @brief   This API ends a timed section started by val_bench_quiet_begin and
+           restores the print level once the outermost section ends
+           1. Caller       -  Test Suite.
+  @param   none
+  @return  none
+**/
+void val_bench_quiet_end(void)
+{
+    if (g_bench_quiet_depth && (--g_bench_quiet_depth == 0))
+        val_set_print_level(g_bench_print_level);
+}
+
+/**
+  @brief   This API selects how the transport waits for command completion
+           1. Caller       -  Test Suite.
+  @param   mode  VAL_COMPLETION_INTERRUPT, VAL_COMPLETION_POLLED or
+                 VAL_COMPLETION_ADAPTIVE
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL if the transport does not support it
+**/
+uint32_t val_set_completion_mode(uint32_t mode)
+{
+    return (pal_set_completion_mode(mode) == PAL_STATUS_PASS) ? VAL_STATUS_PASS :
+                                                                VAL_STATUS_FAIL;
+}
+
+/**
+  @brief   This function returns the index of the most significant set bit
+  @param   value  non zero value
+  @return  bit index
+**/
+static uint32_t val_hist_msb(uint64_t value)
+{
+    uint32_t msb = 0;
+
+    while (value >>= 1)
+        msb++;
+
+    return msb;
+}
+
+/**
+  @brief   This function maps a value to its log-linear histogram bucket
+  @param   value  sample value
+  @return  bucket index
+**/
+static uint32_t val_hist_bucket_index(uint64_t value)
+{
+    uint32_t msb, sub, index;
+
+    if (value < VAL_HIST_SUB_BUCKETS)
+        return (uint32_t)value;
+
+    msb = val_hist_msb(value);
+    sub = (value >> (msb - VAL_HIST_SUB_BUCKET_BITS)) & (VAL_HIST_SUB_BUCKETS - 1);
+    index = ((msb - VAL_HIST_SUB_BUCKET_BITS + 1) * VAL_HIST_SUB_BUCKETS) + sub;
+
+    if (index >= VAL_HIST_NUM_BUCKETS)
+        index = VAL_HIST_NUM_BUCKETS - 1;
+
+    return index;
+}
+
+/**
+  @brief   This function returns the lowest value held by a histogram bucket
+  @param   index  bucket index
+  @return  bucket lower bound
+**/
+static uint64_t val_hist_bucket_low(uint32_t index)
+{
+    uint32_t msb, sub;
+
+    if (index < VAL_HIST_SUB_BUCKETS)
+        return index;
+
+    msb = (index / VAL_HIST_SUB_BUCKETS) + VAL_HIST_SUB_BUCKET_BITS - 1;
+    sub = index % VAL_HIST_SUB_BUCKETS;
+
+    return ((uint64_t)(VAL_HIST_SUB_BUCKETS + sub)) << (msb - VAL_HIST_SUB_BUCKET_BITS);
+}
+
+/**
+  @brief   This function returns the highest value held by a histogram bucket
+  @param   index  bucket index
+  @return  bucket upper bound
+**/
+static uint64_t val_hist_bucket_high(uint32_t index)
+{
+    uint32_t msb;
+
+    if (index < VAL_HIST_SUB_BUCKETS)
+        return index;
+
+    msb = (index / VAL_HIST_SUB_BUCKETS) + VAL_HIST_SUB_BUCKET_BITS - 1;
+
+    return val_hist_bucket_low(index) + (1ull << (msb - VAL_HIST_SUB_BUCKET_BITS)) - 1;
+}
+
+/**
+  @brief   This API clears all samples from a histogram
+           1. Caller       -  Test Suite.
+  @param   hist  histogram
+  @return  none
+**/
+void val_hist_reset(VAL_HIST_s *hist)
+{
+    val_memset((void *)hist, 0, sizeof(VAL_HIST_s));
+    hist->min = UINT64_MAX;
+}
+
+/**
+  @brief   This API adds one sample to a histogram
+           1. Caller       -  Test Suite.
+  @param   hist   histogram
+  @param   value  sample value
+  @return  none
+**/
+void val_hist_add(VAL_HIST_s *hist, uint64_t value)
+{
+    hist->count++;
+    hist->sum += value;
+    if (value < hist->min)
+        hist->min = value;
+    if (value > hist->max)
+        hist->max = value;
+    hist->bucket[val_hist_bucket_index(value)]++;
+}
+
+/**
+  @brief   This API accumulates the samples of one histogram into another
+           1. Caller       -  Test Suite.
+  @param   dst  destination histogram
+  @param   src  source histogram
+  @return  none
+**/
+void val_hist_merge(VAL_HIST_s *dst, VAL_HIST_s *src)
+{
+    uint32_t i;
+
+    if (src->count == 0)
+        return;
+
+    dst->count += src->count;
+    dst->sum += src->sum;
+    if (src->min < dst->min)
+        dst->min = src->min;
+    if (src->max > dst->max)
+        dst->max = src->max;
+    for (i = 0; i < VAL_HIST_NUM_BUCKETS; i++)
+        dst->bucket[i] += src->bucket[i];
+}
+
+/**
+  @brief   This API returns the mean of the histogram samples
+           1. Caller       -  Test Suite.
+  @param   hist  histogram
+  @return  mean value
+**/
+uint64_t val_hist_mean(VAL_HIST_s *hist)
+{
+    if (hist->count == 0)
+        return 0;
+
+    return hist->sum / hist->count;
+}
+
+/**
+  @brief   This API returns the given percentile of the histogram samples.
+           Result is the upper bound of the matching bucket clamped to the
+           observed min/max, so it is never below the true percentile.
+           1. Caller       -  Test Suite.
+  @param   hist     histogram
+  @param   percent  percentile in range 0-100
+  @return  percentile value
+**/
+uint64_t val_hist_percentile(VAL_HIST_s *hist, uint32_t percent)
+{
+    uint64_t rank, seen = 0, value;
+    uint32_t i;
+
+    if (hist->count == 0)
+        return 0;
+
+    rank = (((uint64_t)hist->count * percent) + 99) / 100;
+    if (rank == 0)
+        rank = 1;
+
+    for (i = 0; i < VAL_HIST_NUM_BUCKETS; i++) {
+        seen += hist->bucket[i];
+        if (seen >= rank)
+            break;
+    }
+
+    value = val_hist_bucket_high(i);
+    if (value > hist->max)
+        value = hist->max;
+    if (value < hist->min)
+        value = hist->min;
+
+    return value;
+}
+
+/**
+  @brief   This API prints a one line summary of a latency histogram in ns
+           1. Caller       -  Test Suite.
+  @param   print_level  print verbosity
+  @param   name         histogram name
+  @param   hist         histogram
+  @return  none
+**/
+void val_hist_print(uint32_t print_level, char *name, VAL_HIST_s *hist)
+{
+    if (hist->count == 0) {
+        val_print(print_level, "\n       %-12s: no samples", name);
+        return;
+    }
+
+    val_print(print_level, "\n       %-12s: n=%d min=%llu p50=%llu p99=%llu max=%llu",
+              name, hist->count,
+              (unsigned long long)hist->min,
+              (unsigned long long)val_hist_percentile(hist, 50),
+              (unsigned long long)val_hist_percentile(hist, 99),
+              (unsigned long long)hist->max);
+}
+
+/**
+  @brief   This API prints the populated buckets of a histogram as a bar chart
+           1. Caller       -  Test Suite.
+  @param   print_level  print verbosity
+  @param   hist         histogram
+  @return  none
+**/
+void val_hist_print_buckets(uint32_t print_level, VAL_HIST_s *hist)
+{
+    uint32_t i, j, bar, peak = 0;
+    char bar_str[VAL_HIST_BAR_WIDTH + 1];
+
+    for (i = 0; i < VAL_HIST_NUM_BUCKETS; i++) {
+        if (hist->bucket[i] > peak)
+            peak = hist->bucket[i];
+    }
+
+    if (peak == 0)
+        return;
+
+    for (i = 0; i < VAL_HIST_NUM_BUCKETS; i++) {
+        if (hist->bucket[i] == 0)
+            continue;
+
+        bar = (uint32_t)(((uint64_t)hist->bucket[i] * VAL_HIST_BAR_WIDTH + peak - 1) / peak);
+        for (j = 0; j < bar; j++)
+            bar_str[j] = '#';
+        bar_str[bar] = '\0';
+
+        val_print(print_level, "\n       %10llu-%-10llu %8d %s",
+                  (unsigned long long)val_hist_bucket_low(i),
+                  (unsigned long long)val_hist_bucket_high(i),
+                  hist->bucket[i], bar_str);
+    }
+}
+
+/**
+  @brief   This API enables or disables per protocol message latency recording
+           1. Caller       -  Test Suite.
+  @param   enable  1 to record latency of every sent message, 0 to stop
+  @return  none
+**/
+void val_latency_record_enable(uint32_t enable)
+{
+    g_latency_record_enable = enable;
+}
+
+/**
+  @brief   This function returns the histogram of a message, taking a free
+           one from the pool the first time the message is seen
+  @param   protocol_id  protocol identifier
+  @param   msg_id       message identifier
+  @param   create       1 to take a histogram if the message has none
+  @return  histogram or NULL
+**/
+static VAL_HIST_s *val_latency_msg_hist(uint32_t protocol_id, uint32_t msg_id, uint32_t create)
+{
+    uint8_t *slot;
+
+    if ((protocol_id < PROTOCOL_BASE) || (protocol_id >= PROTOCOL_MAX) ||
+        (msg_id >= VAL_LATENCY_MAX_MSG_ID))
+        return NULL;
+
+    slot = &g_msg_id_slot[protocol_id - PROTOCOL_BASE][msg_id];
+    if (*slot == 0) {
+        if (!create || (g_msg_id_num_slots >= VAL_LATENCY_MAX_MSGS))
+            return NULL;
+        val_hist_reset(&g_msg_id_latency[g_msg_id_num_slots]);
+        *slot = ++g_msg_id_num_slots;
+    }
+
+    return &g_msg_id_latency[*slot - 1];
+}
+
+/**
+  @brief   This API records the round trip latency of one command message
+           1. Caller       -  VAL.
+  @param   msg_hdr     command message header
+  @param   latency_ns  time from send to response in ns
+  @return  none
+**/
+void val_latency_record(uint32_t msg_hdr, uint64_t latency_ns)
+{
+    uint32_t protocol_id;
+    VAL_HIST_s *hist;
+
+    if (!g_latency_record_enable)
+        return;
+
+    protocol_id = VAL_EXTRACT_BITS(msg_hdr, 10, 17);
+    if ((protocol_id < PROTOCOL_BASE) || (protocol_id >= PROTOCOL_MAX))
+        return;
+
+    val_hist_add(&g_msg_latency[protocol_id - PROTOCOL_BASE], latency_ns);
+
+    hist = val_latency_msg_hist(protocol_id, VAL_EXTRACT_BITS(msg_hdr, 0, 7), 1);
+    if (hist != NULL)
+        val_hist_add(hist, latency_ns);
+}
+
+/**
+  @brief   This API clears the recorded message latencies of all protocols
+           1. Caller       -  Test Suite.
+  @param   none
+  @return  none
+**/
+void val_latency_reset(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < VAL_NUM_PROTOCOLS; i++)
+        val_hist_reset(&g_msg_latency[i]);
+
+    val_memset(g_msg_id_slot, 0, sizeof(g_msg_id_slot));
+    g_msg_id_num_slots = 0;
+}
+
+/**
+  @brief   This API returns the recorded message latency histogram of a protocol
+           1. Caller       -  Test Suite.
+  @param   protocol_id  protocol identifier
+  @return  histogram or NULL for an unknown protocol
+**/
+VAL_HIST_s *val_latency_get_protocol_hist(uint32_t protocol_id)
+{
+    if ((protocol_id < PROTOCOL_BASE) || (protocol_id >= PROTOCOL_MAX))
+        return NULL;
+
+    return &g_msg_latency[protocol_id - PROTOCOL_BASE];
+}
+
+/**
+  @brief   This API returns the recorded latency histogram of one message
+           1. Caller       -  Test Suite, App layer.
+  @param   protocol_id  protocol identifier
+  @param   msg_id       message identifier
+  @return  histogram or NULL if the message has not been recorded
+**/
+VAL_HIST_s *val_latency_get_msg_hist(uint32_t protocol_id, uint32_t msg_id)
+{
+    return val_latency_msg_hist(protocol_id, msg_id, 0);
+}
+
+/**
+  @brief   This API adds latencies recorded elsewhere, such as in a worker
+           process, to those of a message and its protocol
+           1. Caller       -  App layer.
+  @param   protocol_id  protocol identifier
+  @param   msg_id       message identifier
+  @param   hist         recorded histogram
+  @return  none
+**/
+void val_latency_merge(uint32_t protocol_id, uint32_t msg_id, VAL_HIST_s *hist)
+{
+    VAL_HIST_s *msg_hist;
+
+    if ((protocol_id < PROTOCOL_BASE) || (protocol_id >= PROTOCOL_MAX))
+        return;
+
+    val_hist_merge(&g_msg_latency[protocol_id - PROTOCOL_BASE], hist);
+
+    msg_hist = val_latency_msg_hist(protocol_id, msg_id, 1);
+    if (msg_hist != NULL)
+        val_hist_merge(msg_hist, hist);
+}
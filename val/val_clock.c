@@ -33,15 +33,15 @@ uint32_t val_clock_execute_tests(void)
     val_memset((void *)&g_clock_info_table, 0, sizeof(g_clock_info_table));
 
     if (val_agent_check_protocol_support(PROTOCOL_CLOCK)) {
-        if (RUN_TEST(clock_query_protocol_version(&version)))
+        if (RUN_SETUP_TEST(clock_query_protocol_version(&version)))
             return VAL_STATUS_FAIL;
 
-        RUN_TEST(clock_query_protocol_attributes());
+        RUN_SETUP_TEST(clock_query_protocol_attributes());
         RUN_TEST(clock_query_mandatory_command_support());
         RUN_TEST(clock_invalid_messageid_call());
-        RUN_TEST(clock_attributes_check());
+        RUN_SETUP_TEST(clock_attributes_check());
         RUN_TEST(clock_attributes_check_invalid_clock_id());
-        RUN_TEST(clock_query_describe_rates());
+        RUN_SETUP_TEST(clock_query_describe_rates());
         RUN_TEST(clock_query_describe_rates_invalid_clock_id());
         RUN_TEST(clock_rate_set_sync_check());
         RUN_TEST(clock_rate_set_async_check());
@@ -52,6 +52,7 @@ uint32_t val_clock_execute_tests(void)
         RUN_TEST(clock_config_set_invalid_attr_check());
         RUN_TEST(clock_config_set_invalid_clock_id_check());
         RUN_TEST(clock_config_set_check());
+        RUN_TEST(clock_rate_set_async_saturation_check());
     }
     else
         val_print(VAL_PRINT_ERR, "\n Calling agent have no access to CLOCK protocol");
@@ -59,6 +60,33 @@ uint32_t val_clock_execute_tests(void)
     return VAL_STATUS_PASS;
 }
 
+/**
+  @brief   This API is called from soak runs to execute the state restoring
+           subset of clock tests. Info table is kept from the compliance run.
+  @param   none
+  @return  number of failed tests
+**/
+uint32_t val_clock_execute_soak_tests(void)
+{
+    uint32_t version = 0;
+    uint32_t num_fail = 0;
+
+    if (val_agent_check_protocol_support(PROTOCOL_CLOCK)) {
+        if (RUN_SOAK_TEST(clock_query_protocol_version(&version)))
+            return 1;
+
+        num_fail += RUN_SOAK_TEST(clock_query_protocol_attributes());
+        num_fail += RUN_SOAK_TEST(clock_attributes_check());
+        num_fail += RUN_SOAK_TEST(clock_query_describe_rates());
+        num_fail += RUN_SOAK_TEST(clock_rate_set_sync_check());
+        num_fail += RUN_SOAK_TEST(clock_rate_set_async_check());
+        num_fail += RUN_SOAK_TEST(clock_rate_get_check());
+        num_fail += RUN_SOAK_TEST(clock_config_set_check());
+    }
+
+    return num_fail;
+}
+
 /**
   @brief   This API is used to save clock protocol info
            1. Caller       -  Test Suite.
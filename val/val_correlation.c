@@ -0,0 +1,172 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_correlation.h"
+
+/**
+  @brief   This API clears a correlation sample set
+           1. Caller       -  Test Suite.
+  @param   corr  sample set
+  @return  none
+**/
+void val_correlation_init(CORRELATION_s *corr)
+{
+    corr->num_samples = 0;
+}
+
+/**
+  @brief   This API records one platform timestamp together with the agent
+           monotonic times the request was sent and the response received.
+           Samples beyond CORRELATION_MAX_SAMPLES are ignored.
+           1. Caller       -  Test Suite.
+  @param   corr         sample set
+  @param   send_ns      agent time before the request was sent
+  @param   recv_ns      agent time after the response was received
+  @param   platform_ns  platform timestamp carried by the response, in ns
+  @return  none
+**/
+void val_correlation_add(CORRELATION_s *corr, uint64_t send_ns, uint64_t recv_ns,
+                         uint64_t platform_ns)
+{
+    uint32_t i = corr->num_samples;
+
+    if ((i == CORRELATION_MAX_SAMPLES) || (recv_ns < send_ns))
+        return;
+
+    corr->send_ns[i] = send_ns;
+    corr->recv_ns[i] = recv_ns;
+    corr->platform_ns[i] = platform_ns;
+    corr->num_samples++;
+}
+
+/**
+  @brief   This function returns the sample with the smallest round trip in a
+           range. Its platform timestamp is the best bounded in agent time.
+  @param   corr   sample set
+  @param   first  first sample of the range
+  @param   last   sample after the range
+  @return  index of the sample
+**/
+static uint32_t val_correlation_min_rtt(CORRELATION_s *corr, uint32_t first, uint32_t last)
+{
+    uint32_t i, best = first;
+
+    for (i = first + 1; i < last; i++)
+    {
+        if ((corr->recv_ns[i] - corr->send_ns[i]) < (corr->recv_ns[best] - corr->send_ns[best]))
+            best = i;
+    }
+
+    return best;
+}
+
+/**
+  @brief   This function returns the agent time half way through a round trip,
+           the best guess of when the platform took the timestamp
+  @param   corr  sample set
+  @param   i     sample index
+  @return  agent time in ns
+**/
+static uint64_t val_correlation_mid(CORRELATION_s *corr, uint32_t i)
+{
+    return corr->send_ns[i] + ((corr->recv_ns[i] - corr->send_ns[i]) / 2);
+}
+
+/**
+  @brief   This API returns the platform minus agent clock offset at an agent
+           time, following the estimated drift
+           1. Caller       -  Test Suite.
+  @param   result    correlation estimate
+  @param   agent_ns  agent time
+  @return  offset in ns
+**/
+int64_t val_correlation_offset_at(CORRELATION_RESULT_s *result, uint64_t agent_ns)
+{
+    int64_t elapsed = (int64_t)(agent_ns - result->reference_ns);
+
+    /* Split whole seconds off so drift times elapsed cannot overflow */
+    return result->offset_ns + ((elapsed / PPB_PER_UNIT) * result->drift_ppb) +
+           (((elapsed % PPB_PER_UNIT) * result->drift_ppb) / PPB_PER_UNIT);
+}
+
+/**
+  @brief   This API estimates the platform clock against the agent clock. The
+           sample with the smallest round trip gives the offset and the one way
+           latency. The drift is the change in offset between the best samples
+           of the first and last quarter of the run. It is only reported when
+           those samples are at least CORRELATION_MIN_DRIFT_SPAN_NS apart,
+           otherwise round trip jitter dominates it and it is left at zero.
+           Each reading is then mapped to agent time to measure how old it was
+           on arrival.
+           1. Caller       -  Test Suite.
+  @param   corr    sample set
+  @param   result  correlation estimate
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL if there are too few samples
+**/
+uint32_t val_correlation_estimate(CORRELATION_s *corr, CORRELATION_RESULT_s *result)
+{
+    uint32_t i, n = corr->num_samples, window, first, last;
+    int64_t offset_delta, stamped_ns;
+    uint64_t span;
+
+    val_memset(result, 0, sizeof(*result));
+    val_hist_reset(&result->staleness);
+    if (n < CORRELATION_MIN_SAMPLES)
+        return VAL_STATUS_FAIL;
+
+    i = val_correlation_min_rtt(corr, 0, n);
+    result->min_rtt_ns = corr->recv_ns[i] - corr->send_ns[i];
+    result->one_way_ns = result->min_rtt_ns / 2;
+    result->reference_ns = val_correlation_mid(corr, i);
+    result->offset_ns = (int64_t)(corr->platform_ns[i] - result->reference_ns);
+
+    window = n / CORRELATION_DRIFT_WINDOW_DIV;
+    if (window == 0)
+        window = 1;
+    first = val_correlation_min_rtt(corr, 0, window);
+    last = val_correlation_min_rtt(corr, n - window, n);
+    span = val_correlation_mid(corr, last) - val_correlation_mid(corr, first);
+    result->drift_span_ns = span;
+    if ((last != first) && (span >= CORRELATION_MIN_DRIFT_SPAN_NS)) {
+        offset_delta = (int64_t)(corr->platform_ns[last] - corr->platform_ns[first]) -
+                       (int64_t)span;
+        /* Scale both down together until the ppb product fits in 64 bits */
+        while ((offset_delta > (INT64_MAX / PPB_PER_UNIT)) ||
+               (offset_delta < -(INT64_MAX / PPB_PER_UNIT))) {
+            offset_delta /= 2;
+            span /= 2;
+        }
+        if (span) {
+            result->drift_ppb = (offset_delta * PPB_PER_UNIT) / (int64_t)span;
+            result->drift_valid = 1;
+        }
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        stamped_ns = (int64_t)(corr->platform_ns[i] -
+                     (uint64_t)val_correlation_offset_at(result, corr->recv_ns[i]));
+        if (stamped_ns > (int64_t)corr->recv_ns[i]) {
+            result->num_future++;
+            val_hist_add(&result->staleness, 0);
+        } else
+            val_hist_add(&result->staleness, corr->recv_ns[i] - (uint64_t)stamped_ns);
+    }
+
+    return VAL_STATUS_PASS;
+}
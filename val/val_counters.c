@@ -0,0 +1,225 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_counters.h"
+
+static uint32_t g_counters_mask;
+static uint64_t g_counters_start[PAL_NUM_COUNTERS];
+static VAL_COUNTERS_ENTRY_s g_counters_entry[VAL_COUNTERS_MAX_ENTRIES];
+static uint32_t g_counters_num_entries;
+static uint32_t g_counters_dropped;
+
+/**
+  @brief   This API opens or closes the agent side counters read around every
+           message sent and every wait for a delayed response or notification
+           1. Caller       -  App layer.
+  @param   enable  1 to open the counters and clear the totals, 0 to close them
+  @return  mask of the available PAL_COUNTER_* counters
+**/
+uint32_t val_counters_enable(uint32_t enable)
+{
+    g_counters_mask = pal_counters_enable(enable);
+
+    if (enable) {
+        g_counters_num_entries = 0;
+        g_counters_dropped = 0;
+    }
+
+    return g_counters_mask;
+}
+
+/**
+  @brief   This API takes the counter values a message is measured from
+           1. Caller       -  VAL message APIs, before the transport call.
+  @param   none
+  @return  none
+**/
+void val_counters_start(void)
+{
+    if (g_counters_mask)
+        pal_counters_read(g_counters_start);
+}
+
+/**
+  @brief   This function returns the totals of a message, taking a free entry
+           the first time the message is seen
+  @param   protocol_id  protocol identifier
+  @param   msg_id       message identifier
+  @param   msg_type     message type
+  @return  entry or NULL if all entries are taken
+**/
+static VAL_COUNTERS_ENTRY_s *val_counters_find(uint32_t protocol_id, uint32_t msg_id,
+                                               uint32_t msg_type)
+{
+    VAL_COUNTERS_ENTRY_s *entry;
+    uint32_t i;
+
+    for (i = 0; i < g_counters_num_entries; i++)
+    {
+        entry = &g_counters_entry[i];
+        if ((entry->protocol_id == protocol_id) && (entry->msg_id == msg_id) &&
+            (entry->msg_type == msg_type))
+            return entry;
+    }
+
+    if (g_counters_num_entries >= VAL_COUNTERS_MAX_ENTRIES)
+        return NULL;
+
+    entry = &g_counters_entry[g_counters_num_entries++];
+    val_memset(entry, 0, sizeof(*entry));
+    entry->protocol_id = protocol_id;
+    entry->msg_id = msg_id;
+    entry->msg_type = msg_type;
+
+    return entry;
+}
+
+/**
+  @brief   This API adds the counts since val_counters_start to a message
+           1. Caller       -  VAL message APIs, after the transport call.
+  @param   msg_hdr  header of the command sent or of the message received
+  @return  none
+**/
+void val_counters_stop(uint32_t msg_hdr)
+{
+    uint64_t now[PAL_NUM_COUNTERS];
+    VAL_COUNTERS_ENTRY_s *entry;
+    uint32_t protocol_id, i;
+
+    if (!g_counters_mask)
+        return;
+
+    pal_counters_read(now);
+
+    /* A wait that timed out has no header to charge it to */
+    protocol_id = VAL_EXTRACT_BITS(msg_hdr, 10, 17);
+    if ((protocol_id < PROTOCOL_BASE) || (protocol_id >= PROTOCOL_MAX))
+        return;
+
+    entry = val_counters_find(protocol_id, VAL_EXTRACT_BITS(msg_hdr, 0, 7),
+                              VAL_EXTRACT_BITS(msg_hdr, 8, 9));
+    if (entry == NULL) {
+        g_counters_dropped++;
+        return;
+    }
+
+    entry->count++;
+    for (i = 0; i < PAL_NUM_COUNTERS; i++)
+        entry->total[i] += now[i] - g_counters_start[i];
+}
+
+/**
+  @brief   This function prints one row of the counter report
+  @param   entry  counter totals, msg_type VAL_COUNTERS_ALL_TYPES for the
+                  protocol total
+  @return  none
+**/
+static void val_counters_print_row(VAL_COUNTERS_ENTRY_s *entry)
+{
+    static const char *type_name[] = {"cmd", "", "dly", "ntf"};
+    uint64_t cycles = entry->total[PAL_COUNTER_CYCLES];
+    uint64_t instructions = entry->total[PAL_COUNTER_INSTRUCTIONS];
+    uint32_t ipc = cycles ? (uint32_t)((instructions * 100) / cycles) : 0;
+
+    if (entry->msg_type == VAL_COUNTERS_ALL_TYPES)
+        val_print(VAL_PRINT_ERR, "\n     0x%02x   all     ", entry->protocol_id);
+    else
+        val_print(VAL_PRINT_ERR, "\n     0x%02x  0x%02x %4s", entry->protocol_id, entry->msg_id,
+                  type_name[entry->msg_type & 0x3]);
+
+    val_print(VAL_PRINT_ERR, " %7d %10llu %10llu %2d.%02d %8llu %7llu", entry->count,
+              (unsigned long long)(entry->count ? cycles / entry->count : 0),
+              (unsigned long long)(entry->count ? instructions / entry->count : 0),
+              ipc / 100, ipc % 100,
+              (unsigned long long)entry->total[PAL_COUNTER_CONTEXT_SWITCHES],
+              (unsigned long long)entry->total[PAL_COUNTER_PAGE_FAULTS]);
+}
+
+/**
+  @brief   This function sorts the entries by protocol, message type and message
+  @param   none
+  @return  none
+**/
+static void val_counters_sort(void)
+{
+    VAL_COUNTERS_ENTRY_s entry;
+    uint32_t i, j, key;
+
+    for (i = 1; i < g_counters_num_entries; i++)
+    {
+        entry = g_counters_entry[i];
+        key = (entry.protocol_id << 16) | (entry.msg_type << 8) | entry.msg_id;
+        for (j = i; j > 0; j--)
+        {
+            if (((g_counters_entry[j - 1].protocol_id << 16) |
+                 (g_counters_entry[j - 1].msg_type << 8) |
+                 g_counters_entry[j - 1].msg_id) <= key)
+                break;
+            g_counters_entry[j] = g_counters_entry[j - 1];
+        }
+        g_counters_entry[j] = entry;
+    }
+}
+
+/**
+  @brief   This API prints the counters per message and per protocol, with
+           cycles and instructions averaged per message and context switches
+           and page faults in total, then closes the counters
+           1. Caller       -  App layer, after the test summary.
+  @param   none
+  @return  none
+**/
+void val_counters_report(void)
+{
+    VAL_COUNTERS_ENTRY_s *entry, total;
+    uint32_t i, j, k;
+
+    if (!g_counters_mask)
+        return;
+
+    val_print(VAL_PRINT_ERR, "\n\n          *** Agent side counters ***");
+    if (!(g_counters_mask & ((1 << PAL_COUNTER_CYCLES) | (1 << PAL_COUNTER_INSTRUCTIONS))))
+        val_print(VAL_PRINT_ERR, "\n     Cycles and instructions not available, shown as 0");
+    if (g_counters_mask & PAL_COUNTERS_RUSAGE)
+        val_print(VAL_PRINT_ERR, "\n     Context switches and page faults from getrusage");
+    if (g_counters_dropped)
+        val_print(VAL_PRINT_ERR, "\n     %d messages not counted, table full", g_counters_dropped);
+    val_print(VAL_PRINT_ERR, "\n     PROT   MSG TYPE   COUNT CYCLES/MSG  INSTR/MSG   IPC SWITCHES  FAULTS");
+
+    val_counters_sort();
+    for (i = 0; i < g_counters_num_entries; i = j)
+    {
+        val_memset(&total, 0, sizeof(total));
+        total.protocol_id = g_counters_entry[i].protocol_id;
+        total.msg_type = VAL_COUNTERS_ALL_TYPES;
+
+        for (j = i; (j < g_counters_num_entries) &&
+             (g_counters_entry[j].protocol_id == total.protocol_id); j++)
+        {
+            entry = &g_counters_entry[j];
+            val_counters_print_row(entry);
+
+            total.count += entry->count;
+            for (k = 0; k < PAL_NUM_COUNTERS; k++)
+                total.total[k] += entry->total[k];
+        }
+        val_counters_print_row(&total);
+    }
+
+    val_counters_enable(0);
+}
@@ -0,0 +1,348 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_energy_model.h"
+
+static const char *g_json_file;
+static const char *g_em_table_file;
+
+/**
+  @brief   This API sets the files the energy model is exported to
+           1. Caller       -  App layer.
+  @param   json_file      JSON model, NULL to skip it
+  @param   em_table_file  Linux energy model table, NULL to skip it
+  @return  none
+**/
+void val_energy_model_set_files(const char *json_file, const char *em_table_file)
+{
+    g_json_file = json_file;
+    g_em_table_file = em_table_file;
+}
+
+/**
+  @brief   This API clears an energy model
+           1. Caller       -  Test Suite.
+  @param   model            energy model
+  @param   power_values_mw  1 if the platform reports power in mW, 0 if abstract
+  @return  none
+**/
+void val_energy_model_init(ENERGY_MODEL_s *model, uint32_t power_values_mw)
+{
+    val_memset(model, 0, sizeof(*model));
+    model->power_values_mw = power_values_mw;
+}
+
+/**
+  @brief   This API records the name and level to frequency scale of a domain,
+           the scale is only exported
+           1. Caller       -  Test Suite.
+  @param   model               energy model
+  @param   domain_id           performance domain
+  @param   name                domain name
+  @param   sustained_freq_khz  sustained frequency
+  @param   sustained_level     performance level of the sustained frequency
+  @return  none
+**/
+void val_energy_model_set_domain(ENERGY_MODEL_s *model, uint32_t domain_id, uint8_t *name,
+                                 uint32_t sustained_freq_khz, uint32_t sustained_level)
+{
+    ENERGY_MODEL_DOMAIN_s *domain = &model->domain[domain_id];
+    uint32_t i;
+
+    for (i = 0; (i < (SCMI_NAME_STR_SIZE - 1)) && name[i]; i++)
+        domain->name[i] = name[i];
+    domain->name[i] = '\0';
+    domain->sustained_freq_khz = sustained_freq_khz;
+    domain->sustained_level = sustained_level;
+    if (model->num_domains <= domain_id)
+        model->num_domains = domain_id + 1;
+}
+
+/**
+  @brief   This API adds one OPP from PERFORMANCE_DESCRIBE_LEVELS to a domain
+           1. Caller       -  Test Suite.
+  @param   model       energy model
+  @param   domain_id   performance domain
+  @param   level       performance level
+  @param   freq_khz    frequency of the level
+  @param   power       power cost
+  @param   latency_us  worst case transition latency
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL if the domain is full
+**/
+uint32_t val_energy_model_add_opp(ENERGY_MODEL_s *model, uint32_t domain_id, uint32_t level,
+                                  uint64_t freq_khz, uint32_t power, uint32_t latency_us)
+{
+    ENERGY_MODEL_DOMAIN_s *domain = &model->domain[domain_id];
+    ENERGY_MODEL_OPP_s *opp;
+
+    if (domain->num_opps >= MAX_PERFORMANCE_LEVELS)
+        return VAL_STATUS_FAIL;
+
+    opp = &domain->opp[domain->num_opps++];
+    val_memset(opp, 0, sizeof(*opp));
+    opp->level = level;
+    opp->freq_khz = freq_khz;
+    opp->power = power;
+    opp->latency_us = latency_us;
+
+    return VAL_STATUS_PASS;
+}
+
+/**
+  @brief   This function sorts the OPPs of a domain by ascending level
+  @param   domain  energy model domain
+  @return  none
+**/
+static void val_energy_model_sort(ENERGY_MODEL_DOMAIN_s *domain)
+{
+    ENERGY_MODEL_OPP_s opp;
+    uint32_t i, j;
+
+    for (i = 1; i < domain->num_opps; i++)
+    {
+        opp = domain->opp[i];
+        for (j = i; (j > 0) && (domain->opp[j - 1].level > opp.level); j--)
+            domain->opp[j] = domain->opp[j - 1];
+        domain->opp[j] = opp;
+    }
+}
+
+/**
+  @brief   This API derives capacity and cost of every OPP and flags the OPPs
+           energy aware scheduling would reject or skip. Capacity is relative
+           to the fastest OPP of all domains. An OPP is inefficient when a faster OPP of the
+           same domain has the same or a lower cost.
+           1. Caller       -  Test Suite.
+  @param   model  energy model
+  @return  number of flagged OPPs
+**/
+uint32_t val_energy_model_build(ENERGY_MODEL_s *model)
+{
+    ENERGY_MODEL_DOMAIN_s *domain;
+    ENERGY_MODEL_OPP_s *opp;
+    uint64_t fmax_khz, system_fmax_khz = 0, min_cost;
+    uint32_t domain_id, i, num_flagged = 0;
+
+    for (domain_id = 0; domain_id < model->num_domains; domain_id++)
+    {
+        domain = &model->domain[domain_id];
+        val_energy_model_sort(domain);
+        for (i = 0; i < domain->num_opps; i++)
+        {
+            opp = &domain->opp[i];
+            if (opp->freq_khz > system_fmax_khz)
+                system_fmax_khz = opp->freq_khz;
+        }
+    }
+
+    for (domain_id = 0; domain_id < model->num_domains; domain_id++)
+    {
+        domain = &model->domain[domain_id];
+        if (domain->num_opps == 0)
+            continue;
+
+        fmax_khz = domain->opp[domain->num_opps - 1].freq_khz;
+        for (i = 0; i < domain->num_opps; i++)
+        {
+            opp = &domain->opp[i];
+            opp->flags = 0;
+            opp->capacity = system_fmax_khz ?
+                            (uint32_t)((opp->freq_khz * EM_CAPACITY_SCALE) / system_fmax_khz) : 0;
+            opp->cost = opp->freq_khz ? ((uint64_t)opp->power * fmax_khz) / opp->freq_khz : 0;
+            if ((i > 0) && ((opp->power <= domain->opp[i - 1].power) ||
+                            (opp->freq_khz == domain->opp[i - 1].freq_khz)))
+                opp->flags |= EM_OPP_NON_MONOTONIC;
+        }
+
+        min_cost = domain->opp[domain->num_opps - 1].cost;
+        for (i = domain->num_opps - 1; i-- > 0;)
+        {
+            opp = &domain->opp[i];
+            if (opp->cost >= min_cost)
+                opp->flags |= EM_OPP_INEFFICIENT;
+            else
+                min_cost = opp->cost;
+        }
+
+        for (i = 0; i < domain->num_opps; i++)
+        {
+            if (domain->opp[i].flags)
+                num_flagged++;
+        }
+    }
+
+    return num_flagged;
+}
+
+/**
+  @brief   This function returns the flag names of an OPP
+  @param   flags  OPP flags
+  @return  flag string
+**/
+static const char *val_energy_model_flag_str(uint32_t flags)
+{
+    switch (flags & (EM_OPP_NON_MONOTONIC | EM_OPP_INEFFICIENT))
+    {
+    case EM_OPP_NON_MONOTONIC:
+        return "non-monotonic";
+    case EM_OPP_INEFFICIENT:
+        return "inefficient";
+    case EM_OPP_NON_MONOTONIC | EM_OPP_INEFFICIENT:
+        return "non-monotonic,inefficient";
+    default:
+        return "";
+    }
+}
+
+/**
+  @brief   This API prints the energy model as a table
+           1. Caller       -  Test Suite.
+  @param   print_level  print verbosity
+  @param   model        energy model
+  @return  none
+**/
+void val_energy_model_print(uint32_t print_level, ENERGY_MODEL_s *model)
+{
+    ENERGY_MODEL_DOMAIN_s *domain;
+    ENERGY_MODEL_OPP_s *opp;
+    uint32_t domain_id, i;
+
+    val_print(print_level, "\n       Power values in %s",
+              model->power_values_mw ? "mW" : "abstract units");
+    for (domain_id = 0; domain_id < model->num_domains; domain_id++)
+    {
+        domain = &model->domain[domain_id];
+        val_print(print_level, "\n       %s", domain->name);
+        val_print(print_level, "\n            level     freq kHz  cap    power         cost  flags");
+        for (i = 0; i < domain->num_opps; i++)
+        {
+            opp = &domain->opp[i];
+            val_print(print_level, "\n       %10u %12llu %4u %8u %12llu  %s", opp->level,
+                      (unsigned long long)opp->freq_khz, opp->capacity, opp->power,
+                      (unsigned long long)opp->cost, val_energy_model_flag_str(opp->flags));
+        }
+    }
+}
+
+/**
+  @brief   This function writes the energy model as JSON
+  @param   handle  file handle
+  @param   model   energy model
+  @return  none
+**/
+static void val_energy_model_write_json(void *handle, ENERGY_MODEL_s *model)
+{
+    ENERGY_MODEL_DOMAIN_s *domain;
+    ENERGY_MODEL_OPP_s *opp;
+    uint32_t domain_id, i;
+
+    val_file_print(handle, "{\n  \"power_unit\": \"%s\",\n  \"capacity_scale\": %d,\n",
+                   model->power_values_mw ? "mW" : "abstract", EM_CAPACITY_SCALE);
+    val_file_print(handle, "  \"domains\": [");
+    for (domain_id = 0; domain_id < model->num_domains; domain_id++)
+    {
+        domain = &model->domain[domain_id];
+        val_file_print(handle, "%s\n    {\n      \"id\": %u,\n      \"name\": \"%s\",\n",
+                       domain_id ? "," : "", domain_id, domain->name);
+        val_file_print(handle, "      \"sustained_freq_khz\": %u,\n"
+                       "      \"sustained_level\": %u,\n      \"opps\": [",
+                       domain->sustained_freq_khz, domain->sustained_level);
+        for (i = 0; i < domain->num_opps; i++)
+        {
+            opp = &domain->opp[i];
+            val_file_print(handle, "%s\n        {\"level\": %u, \"freq_khz\": %llu, "
+                           "\"capacity\": %u, \"power\": %u, \"latency_us\": %u, ",
+                           i ? "," : "", opp->level, (unsigned long long)opp->freq_khz,
+                           opp->capacity, opp->power, opp->latency_us);
+            val_file_print(handle, "\"cost\": %llu, \"efficiency_khz_per_power\": %llu, "
+                           "\"non_monotonic\": %s, \"inefficient\": %s}",
+                           (unsigned long long)opp->cost,
+                           (unsigned long long)(opp->power ? opp->freq_khz / opp->power : 0),
+                           (opp->flags & EM_OPP_NON_MONOTONIC) ? "true" : "false",
+                           (opp->flags & EM_OPP_INEFFICIENT) ? "true" : "false");
+        }
+        val_file_print(handle, "\n      ]\n    }");
+    }
+    val_file_print(handle, "\n  ]\n}\n");
+}
+
+/**
+  @brief   This function writes the energy model as a Linux energy model
+           table, one performance state per line with the fields of
+           /sys/kernel/debug/energy_model. Power in mW is written in uW.
+  @param   handle  file handle
+  @param   model   energy model
+  @return  none
+**/
+static void val_energy_model_write_em_table(void *handle, ENERGY_MODEL_s *model)
+{
+    ENERGY_MODEL_DOMAIN_s *domain;
+    ENERGY_MODEL_OPP_s *opp;
+    uint32_t domain_id, i, scale;
+
+    scale = model->power_values_mw ? 1000 : 1;
+    val_file_print(handle, "# power in %s\n", model->power_values_mw ? "uW" : "abstract units");
+    for (domain_id = 0; domain_id < model->num_domains; domain_id++)
+    {
+        domain = &model->domain[domain_id];
+        val_file_print(handle, "pd%u %s\n", domain_id, domain->name);
+        val_file_print(handle, "# frequency power cost inefficient\n");
+        for (i = 0; i < domain->num_opps; i++)
+        {
+            opp = &domain->opp[i];
+            val_file_print(handle, "ps:%llu %llu %llu %d\n", (unsigned long long)opp->freq_khz,
+                           (unsigned long long)opp->power * scale,
+                           (unsigned long long)opp->cost * scale,
+                           (opp->flags & EM_OPP_INEFFICIENT) ? 1 : 0);
+        }
+    }
+}
+
+/**
+  @brief   This API writes the energy model to the files set by the app
+           1. Caller       -  Test Suite.
+  @param   model  energy model
+  @return  none
+**/
+void val_energy_model_export(ENERGY_MODEL_s *model)
+{
+    void *handle;
+
+    if (g_json_file != NULL) {
+        handle = val_file_open(g_json_file);
+        if (handle == NULL) {
+            val_print(VAL_PRINT_ERR, "\n       Cannot write %s", g_json_file);
+        } else {
+            val_energy_model_write_json(handle, model);
+            val_file_close(handle);
+            val_print(VAL_PRINT_TEST, "\n       Energy model written to %s", g_json_file);
+        }
+    }
+
+    if (g_em_table_file != NULL) {
+        handle = val_file_open(g_em_table_file);
+        if (handle == NULL) {
+            val_print(VAL_PRINT_ERR, "\n       Cannot write %s", g_em_table_file);
+        } else {
+            val_energy_model_write_em_table(handle, model);
+            val_file_close(handle);
+            val_print(VAL_PRINT_TEST, "\n       Energy model table written to %s",
+                      g_em_table_file);
+        }
+    }
+}
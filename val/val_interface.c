@@ -16,15 +16,35 @@
 **/
 
 #include "val_interface.h"
+#include "val_benchmark.h"
+#include "val_counters.h"
+#include "val_stack.h"
+#include "val_schema.h"
+
+/* Defined here under their own names, callers pass the call site with STRING_IDS */
+#ifdef STRING_IDS
+#undef val_compare
+#undef val_compare_str
+#undef val_test_initialize
+#undef val_file_print
+#endif
 
 #define MAX_STRCPY_SIZE 100
 
 static uint64_t g_test_pass;
 static uint64_t g_test_fail;
 static uint64_t g_test_skip;
+static uint64_t g_test_timeout;
 
 static uint32_t g_protocol_list;
 
+static uint32_t g_print_level = VERBOSE_LEVEL;
+
+static uint32_t g_param_check = 1;
+static uint32_t g_param_errors;
+static uint32_t g_param_checked_hdr = 0xFFFFFFFF;
+static size_t   g_param_checked_count;
+
 /**
   @brief   This function forms the command message header
            1. Caller       -  ACK.
@@ -55,6 +75,10 @@ uint32_t val_initialize_system(void *info)
     g_test_pass = 0;
     g_test_fail = 0;
     g_test_skip = 0;
+    g_test_timeout = 0;
+#ifdef STACK_USAGE
+    val_stack_init();
+#endif
     return pal_initialize_system(info);
 }
 
@@ -63,14 +87,41 @@ uint32_t val_initialize_system(void *info)
            1. Caller       -  ACK.
   @param   test_num  test number
   @param   test_desc test description
-  @return  test status
+  @return  test status, VAL_STATUS_SKIP if the result is restored from a checkpoint
 **/
-uint32_t val_test_initialize(uint32_t test_num, char *test_desc)
+uint32_t val_test_initialize(uint32_t test_num, VAL_TEXT_s test_desc)
 {
     val_print(VAL_PRINT_ERR, "\n%3d: %s ", test_num, test_desc);
-    return VAL_STATUS_PASS;
+    g_param_errors = 0;
+#ifdef STACK_USAGE
+    val_stack_paint(test_num);
+#endif
+    return val_watchdog_start(test_num);
 }
 
+#ifdef STRING_IDS
+/**
+  @brief   This is val print function of string free builds, the print is
+           recorded by call site and decoded on the host with the manifest
+           1. Caller       -  val_print macro.
+  @param   site         VAL_LOG_SITE of the call, print level and line
+  @param   file_id      VAL_FILE_ID of the calling file
+  @param   arg_kinds    PAL_LOG_ARG_* kind of each argument, first in the low bits
+  @return  none
+**/
+void val_print_id(uint32_t site, uint32_t file_id, uint64_t arg_kinds, ...)
+{
+    uint32_t print_level = site >> VAL_LOG_LINE_BITS;
+    va_list args;
+
+    if (print_level <= g_print_level) {
+        va_start(args, arg_kinds);
+        pal_print_id(print_level, file_id, VAL_EXTRACT_BITS(site, 0, VAL_LOG_LINE_BITS - 1),
+                     arg_kinds, args);
+        va_end(args);
+    }
+}
+#else
 /**
   @brief   This is val print function
            1. Caller       -  ACK.
@@ -82,12 +133,141 @@ void val_print(uint32_t print_level, const char *format, ...)
 {
     va_list args;
 
-    if (print_level <= VERBOSE_LEVEL) {
+    if (print_level <= g_print_level) {
         va_start(args, format);
         pal_print(print_level, format, args);
         va_end(args);
     }
 }
+#endif
+
+/**
+  @brief   This API creates a report file, replacing an earlier one
+           1. Caller       -  Test Suite.
+  @param   file  file name
+  @return  file handle, NULL if the platform cannot write files
+**/
+void *val_file_open(const char *file)
+{
+    return pal_file_open(file);
+}
+
+/**
+  @brief   This API opens a file to add records to, creating it if needed
+           1. Caller       -  Test Suite.
+  @param   file  file name
+  @return  file handle, NULL if the platform cannot write files
+**/
+void *val_file_open_append(const char *file)
+{
+    return pal_file_open_append(file);
+}
+
+/**
+  @brief   This API opens a file to read back
+           1. Caller       -  Test Suite.
+  @param   file  file name
+  @return  file handle, NULL if the file cannot be read
+**/
+void *val_file_open_read(const char *file)
+{
+    return pal_file_open_read(file);
+}
+
+/**
+  @brief   This API reads the next line of a file, without the line end
+           1. Caller       -  Test Suite.
+  @param   handle  file handle from val_file_open_read
+  @param   line    buffer for the line, longer lines are cut
+  @param   size    size of the buffer
+  @return  1 if a line was read, 0 at the end of the file
+**/
+uint32_t val_file_read_line(void *handle, char *line, uint32_t size)
+{
+    if ((handle == NULL) || (size == 0))
+        return 0;
+
+    return pal_file_read_line(handle, line, size);
+}
+
+/**
+  @brief   This API appends formatted text to a report file
+           1. Caller       -  Test Suite.
+  @param   handle  file handle from val_file_open
+  @param   format  print data and format
+  @return  none
+**/
+void val_file_print(void *handle, const char *format, ...)
+{
+    va_list args;
+
+    if (handle == NULL)
+        return;
+
+    va_start(args, format);
+    pal_file_print(handle, format, args);
+    va_end(args);
+}
+
+/**
+  @brief   This API closes a report file
+           1. Caller       -  Test Suite.
+  @param   handle  file handle from val_file_open
+  @return  none
+**/
+void val_file_close(void *handle)
+{
+    if (handle != NULL)
+        pal_file_close(handle);
+}
+
+/**
+  @brief   This API maps a fast channel described by the platform
+           1. Caller       -  Test Suite.
+  @param   protocol_id  protocol of the channel
+  @param   domain_id    domain of the channel
+  @param   message_id   message carried by the channel
+  @param   chan_addr    channel address from DESCRIBE_FASTCHANNEL
+  @param   chan_size    channel size in bytes
+  @return  pointer to the channel, NULL if the agent cannot access it
+**/
+void *val_fast_channel_map(uint32_t protocol_id, uint32_t domain_id, uint32_t message_id,
+                           uint64_t chan_addr, uint32_t chan_size)
+{
+    return pal_fast_channel_map(protocol_id, domain_id, message_id, chan_addr, chan_size);
+}
+
+/**
+  @brief   This API overrides the print verbosity at run time. Levels above
+           the build time VERBOSE_LEVEL are clamped to it.
+           1. Caller       -  ACK.
+  @param   print_level  new print level, 0 silences all prints
+  @return  previous print level
+**/
+uint32_t val_set_print_level(uint32_t print_level)
+{
+    uint32_t prev_level = g_print_level;
+
+    g_print_level = (print_level > VERBOSE_LEVEL) ? VERBOSE_LEVEL : print_level;
+
+    return prev_level;
+}
+
+/**
+  @brief   This API turns the schema check of command parameter counts on or
+           off, for tests that send malformed commands on purpose.
+           1. Caller       -  Test Suite.
+  @param   enable  0 to skip the check, any other value to run it
+  @return  previous setting
+**/
+uint32_t val_set_param_check(uint32_t enable)
+{
+    uint32_t prev_enable = g_param_check;
+
+    g_param_check = (enable != 0);
+
+    return prev_enable;
+}
 
 /**
   @brief   This is val memset function
@@ -185,7 +365,7 @@ uint32_t val_compare_msg_hdr(uint32_t sent_msg_hdr, uint32_t rcvd_msg_hdr)
   @param   exp_val   expected value using pal expected file
   @return  status
 **/
-uint32_t val_compare(char *parameter, uint32_t rcvd_val, uint32_t exp_val)
+uint32_t val_compare(VAL_TEXT_s parameter, uint32_t rcvd_val, uint32_t exp_val)
 {
     if (rcvd_val != exp_val) {
         val_print(VAL_PRINT_ERR, "\n       CHECK %s: FAILED", parameter);
@@ -207,7 +387,7 @@ uint32_t val_compare(char *parameter, uint32_t rcvd_val, uint32_t exp_val)
   @param   len       length of string
   @return  status
 **/
-uint32_t val_compare_str(char *parameter, char *rcvd_val, char *exp_val, uint32_t len)
+uint32_t val_compare_str(VAL_TEXT_s parameter, char *rcvd_val, char *exp_val, uint32_t len)
 {
     if (val_strcmp((uint8_t *)rcvd_val, (uint8_t *)exp_val, len)) {
         val_print(VAL_PRINT_ERR, "\n       CHECK %s: FAILED", parameter);
@@ -262,22 +442,41 @@ uint32_t val_reserved_bits_check_is_zero(uint32_t reserved_bits)
 **/
 uint32_t val_report_status(uint32_t status)
 {
-    switch (status)
+#ifdef STACK_USAGE
+    uint32_t stack_used = val_stack_measure();
+
+    if (stack_used)
+        val_print(VAL_PRINT_TEST, "\n       STACK HIGH-WATER: %d bytes", stack_used);
+#endif
+
+    /* A command sent with the wrong parameter count fails a test that passed */
+    if (g_param_errors && (status == VAL_STATUS_PASS))
+        status = VAL_STATUS_FAIL;
+
+    switch (val_watchdog_stop(status))
     {
-        case VAL_STATUS_PASS:
+        case CHECKPOINT_PASSED:
               g_test_pass++;
               val_print(VAL_PRINT_ERR, "          : CONFORMANT");
-              break;
-        case VAL_STATUS_FAIL:
-              g_test_fail++;
-              val_print(VAL_PRINT_ERR, "          : NON CONFORMANT");
-              break;
-        case VAL_STATUS_SKIP:
+              return VAL_STATUS_PASS;
+        case CHECKPOINT_SKIPPED:
               g_test_skip++;
               val_print(VAL_PRINT_ERR, "          : SKIPPED");
-              break;
+              return VAL_STATUS_SKIP;
+        case CHECKPOINT_TIMED_OUT:
+              g_test_fail++;
+              g_test_timeout++;
+              val_print(VAL_PRINT_ERR, "          : TIMED OUT");
+              return VAL_STATUS_FAIL;
+        case CHECKPOINT_ABORTED:
+              g_test_fail++;
+              val_print(VAL_PRINT_ERR, "          : ABORTED");
+              return VAL_STATUS_FAIL;
+        default:
+              g_test_fail++;
+              val_print(VAL_PRINT_ERR, "          : NON CONFORMANT");
+              return VAL_STATUS_FAIL;
     }
-    return status;
 }
 
 /**
@@ -345,6 +544,39 @@ char *val_get_status_string(int32_t status)
 }
 
 
+/**
+  @brief   This API is used to get protocol name string
+           1. Caller       -  Test Suite.
+  @param   protocol_id  protocol identifier
+  @return  string       protocol name
+**/
+char *val_get_protocol_str(uint32_t protocol_id)
+{
+    switch (protocol_id)
+    {
+    case PROTOCOL_BASE:
+        return "BASE";
+    case PROTOCOL_POWER_DOMAIN:
+        return "POWER DOMAIN";
+    case PROTOCOL_SYSTEM_POWER:
+        return "SYSTEM POWER";
+    case PROTOCOL_PERFORMANCE:
+        return "PERFORMANCE";
+    case PROTOCOL_CLOCK:
+        return "CLOCK";
+    case PROTOCOL_SENSOR:
+        return "SENSOR";
+    case PROTOCOL_RESET:
+        return "RESET";
+    case PROTOCOL_VOLTAGE:
+        return "VOLTAGE";
+    case PROTOCOL_POWERCAP:
+        return "POWERCAP";
+    default:
+        return "UNKNOWN";
+    }
+}
+
 /**
   @brief   This API is used to compare expected status with return status
            1. Caller       -  Test Suite.
@@ -389,6 +621,71 @@ uint32_t val_compare_return_count(uint32_t received, uint32_t expected)
     return VAL_STATUS_PASS;
 }
 
+/**
+  @brief   This function checks the return values of a successful message
+           against its schema, replacing the separate count and reserved bit
+           checks of a test
+           1. Caller       - Test Suite.
+  @param   msg_hdr      header of the message received
+  @param   num_returns  number of return values received
+  @param   returns      return values
+  @return  view of the return values, NULL if they break the schema
+**/
+void *val_decode_response(uint32_t msg_hdr, size_t num_returns, uint32_t *returns)
+{
+    VAL_SCHEMA_RESULT_s result;
+
+    switch (val_schema_decode(msg_hdr, num_returns, returns, &result))
+    {
+    case VAL_SCHEMA_OK:
+        val_print(VAL_PRINT_DEBUG, "\n       CHECK SCHEMA   : PASSED [%d words]      ",
+                  (uint32_t)num_returns);
+        return returns;
+    case VAL_SCHEMA_BAD_COUNT:
+        val_print(VAL_PRINT_ERR, "\n       CHECK COUNT    : FAILED");
+        val_print(VAL_PRINT_ERR, "\n         EXPECTED   : %d                ",
+                  result.expected_count);
+        val_print(VAL_PRINT_ERR, "\n         RECEIVED   : %d                ",
+                  (uint32_t)num_returns);
+        break;
+    case VAL_SCHEMA_RESERVED_SET:
+        val_print(VAL_PRINT_ERR, "\n       CHECK RSVD BITS: FAILED [0x%08x] in RETURN[%02d]",
+                  result.reserved_bits, result.word);
+        break;
+    default:
+        val_print(VAL_PRINT_ERR, "\n       CHECK SCHEMA   : FAILED, none for 0x%08x",
+                  msg_hdr & VAL_SCHEMA_HDR_MASK);
+        break;
+    }
+
+    return NULL;
+}
+
+/**
+  @brief   This function checks the parameter count of a command against its
+           schema. Benchmarks send one command in a loop, so the last command
+           that passed is not looked up again.
+  @param   msg_hdr        command message header
+  @param   num_parameter  number of parameters sent
+  @return  none
+**/
+static void val_check_param_count(uint32_t msg_hdr, size_t num_parameter)
+{
+    msg_hdr &= VAL_SCHEMA_HDR_MASK;
+    if ((msg_hdr == g_param_checked_hdr) && (num_parameter == g_param_checked_count))
+        return;
+
+    if (val_schema_check_params(msg_hdr, num_parameter) == VAL_SCHEMA_BAD_COUNT) {
+        val_print(VAL_PRINT_ERR, "\n       CHECK PARAMS   : FAILED [%d for 0x%08x, schema has %d]",
+                  (uint32_t)num_parameter, msg_hdr, val_schema_find(msg_hdr)->num_params);
+        g_param_errors++;
+        return;
+    }
+
+    g_param_checked_hdr = msg_hdr;
+    g_param_checked_count = num_parameter;
+}
+
 /**
   @brief   This function is used to send command data to platform and receive response
            1. Caller       - Test Suite.
@@ -406,6 +703,7 @@ void val_send_message(uint32_t msg_hdr, size_t num_parameter, uint32_t *paramete
                       uint32_t *rcvd_buffer)
 {
     uint32_t i;
+    uint64_t start_time, latency;
 
     val_print(VAL_PRINT_DEBUG, "\n       MSG HDR        : 0x%08x", msg_hdr);
     val_print(VAL_PRINT_DEBUG, "\n       NUM PARAM      : %d", num_parameter);
@@ -415,8 +713,25 @@ void val_send_message(uint32_t msg_hdr, size_t num_parameter, uint32_t *paramete
         val_print(VAL_PRINT_DEBUG, "\n       PARAMETER[%02d]  : 0x%08x", i, parameter_buffer[i]);
     }
 
+    if (g_param_check)
+        val_check_param_count(msg_hdr, num_parameter);
+
+    if (val_watchdog_expired()) {
+        *status = SCMI_COMMS_ERROR;
+        return;
+    }
+
+    /* Counters are read outside the timed window so they do not add to the latency */
+    val_counters_start();
+    start_time = val_get_time_ns();
     pal_send_message(msg_hdr, num_parameter, parameter_buffer, rcvd_msg_hdr, status,
                      rcvd_buffer_size, rcvd_buffer);
+    latency = val_get_time_ns() - start_time;
+    val_counters_stop(msg_hdr);
+    val_latency_record(msg_hdr, latency);
+
+    if (*status == SCMI_COMMS_ERROR)
+        val_watchdog_expire();
 }
 
 /**
@@ -429,7 +744,12 @@ void val_send_message(uint32_t msg_hdr, size_t num_parameter, uint32_t *paramete
 void val_receive_notification(uint32_t *message_header_rcv, size_t *return_values_count,
                               uint32_t *return_values)
 {
+    if (val_watchdog_expired())
+        return;
+
+    val_counters_start();
     pal_receive_notification(message_header_rcv, return_values_count, return_values);
+    val_counters_stop(*message_header_rcv);
 }
 
 /**
@@ -443,7 +763,17 @@ void val_receive_notification(uint32_t *message_header_rcv, size_t *return_value
 void val_receive_delayed_response(uint32_t *message_header_rcv, int32_t *status,
         size_t *return_values_count, uint32_t *return_values)
 {
+    if (val_watchdog_expired()) {
+        *status = SCMI_COMMS_ERROR;
+        return;
+    }
+
+    val_counters_start();
     pal_receive_delayed_response(message_header_rcv, status, return_values_count, return_values);
+    val_counters_stop(*message_header_rcv);
+
+    if (*status == SCMI_COMMS_ERROR)
+        val_watchdog_expire();
 }
 
 /**
@@ -537,3 +867,12 @@ uint32_t val_get_test_skipped(void)
 {
     return g_test_skip;
 }
+
+/**
+  @brief   This API returns num of test timed out, included in the failed count
+  @return num of test timed out
+**/
+uint32_t val_get_test_timed_out(void)
+{
+    return g_test_timeout;
+}
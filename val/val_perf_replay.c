@@ -0,0 +1,565 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+#include "val_interface.h"
+#include "val_perf_replay.h"
+
+static const char *g_trace_file;
+static const char *g_report_file;
+
+/**
+  @brief   This API sets the trace to replay and the file the replay is
+           written to, request by request
+           1. Caller       -  App layer.
+  @param   trace_file   CSV of time, domain and frequency, NULL for the built
+                        in trace
+  @param   report_file  CSV of every request replayed, NULL to skip it
+  @return  none
+**/
+void val_perf_replay_set_files(const char *trace_file, const char *report_file)
+{
+    g_trace_file = trace_file;
+    g_report_file = report_file;
+}
+
+#ifdef PERFORMANCE_PROTOCOL
+
+/* Outcome of parsing a trace line */
+#define PERF_REPLAY_LINE_IGNORED        0
+#define PERF_REPLAY_LINE_VALID          1
+#define PERF_REPLAY_LINE_MALFORMED      2
+
+#define US_PER_SEC                      1000000ull
+
+static char g_replay_line[PERF_REPLAY_LINE_SIZE];
+static void *g_trace_handle;
+static void *g_report_handle;
+static uint32_t g_num_domains;
+
+/* Position in the trace, the first request is time 0 */
+static uint32_t g_started;
+static uint64_t g_first_us;
+static uint64_t g_last_us;
+static uint32_t g_builtin_tick;
+static uint32_t g_builtin_domain;
+static uint32_t g_builtin_last_level[MAX_PERFORMANCE_DOMAINS];
+
+/* Found by the first pass over the trace */
+static uint32_t g_first_pass;
+static uint64_t g_duration_us;
+static uint32_t g_num_events;
+static uint32_t g_num_skipped;
+static uint32_t g_domain_requests[MAX_PERFORMANCE_DOMAINS];
+
+static PERF_REPLAY_DOMAIN_s g_replay_domain[MAX_PERFORMANCE_DOMAINS];
+static VAL_HIST_s g_latency[PERF_REPLAY_NUM_CHANNELS];
+static VAL_HIST_s g_lateness;
+
+/**
+  @brief   This API maps a frequency to the slowest level that meets it, the
+           way cpufreq resolves a governor request, or to the fastest level
+           if none does
+           1. Caller       -  Test Suite.
+  @param   domain_id  performance domain
+  @param   freq_khz   requested frequency
+  @return  performance level
+**/
+uint32_t val_perf_replay_find_opp(uint32_t domain_id, uint32_t freq_khz)
+{
+    uint32_t num_levels, i, level, found = 0;
+    uint32_t best_level = 0, top_level = 0;
+    uint64_t khz, best_khz = 0, top_khz = 0;
+
+    num_levels = val_performance_get_info(PERF_DOMAIN_NUM_LEVELS, domain_id);
+    if (num_levels > MAX_PERFORMANCE_LEVELS)
+        num_levels = MAX_PERFORMANCE_LEVELS;
+
+    for (i = 0; i < num_levels; i++)
+    {
+        level = val_performance_get_level(domain_id, i);
+        khz = val_performance_level_to_khz(domain_id, level);
+
+        if ((khz >= freq_khz) && (!found || (khz < best_khz))) {
+            best_level = level;
+            best_khz = khz;
+            found = 1;
+        }
+        if ((i == 0) || (khz > top_khz)) {
+            top_level = level;
+            top_khz = khz;
+        }
+    }
+
+    return found ? best_level : top_level;
+}
+
+/**
+  @brief   This function checks requests for a domain can be replayed
+  @param   domain_id  performance domain
+  @return  1 if the domain can set its level and its levels are known, else 0
+**/
+static uint32_t val_perf_replay_domain_usable(uint32_t domain_id)
+{
+    return (domain_id < g_num_domains) &&
+           val_performance_get_info(PERF_DOMAIN_SET_PERFORMANCE_LEVEL_SUPPORT, domain_id) &&
+           val_performance_get_info(PERF_DOMAIN_NUM_LEVELS, domain_id);
+}
+
+/**
+  @brief   This function reads one comma separated decimal field
+  @param   cursor   position in the line, moved past the field
+  @param   value    number read
+  @param   is_time  1 for the time field, which is in seconds when it has a
+                    fraction, as ftrace prints it, and in microseconds if not
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL if the field is not a number or
+           does not fit in 64 bits
+**/
+static uint32_t val_perf_replay_parse_field(char **cursor, uint64_t *value, uint32_t is_time)
+{
+    char *pos = *cursor;
+    uint32_t num_digits = 0;
+    uint64_t frac_us = 0, scale = US_PER_SEC;
+
+    while ((*pos == ' ') || (*pos == '\t'))
+        pos++;
+
+    *value = 0;
+    while ((*pos >= '0') && (*pos <= '9'))
+    {
+        if (*value > ((UINT64_MAX - 9) / 10))
+            return VAL_STATUS_FAIL;
+        *value = (*value * 10) + (*pos++ - '0');
+        num_digits++;
+    }
+
+    if (is_time && (*pos == '.')) {
+        pos++;
+        while ((*pos >= '0') && (*pos <= '9'))
+        {
+            scale /= 10;
+            frac_us += (*pos++ - '0') * scale;
+        }
+        if (*value > ((UINT64_MAX - US_PER_SEC) / US_PER_SEC))
+            return VAL_STATUS_FAIL;
+        *value = (*value * US_PER_SEC) + frac_us;
+    }
+
+    while ((*pos == ' ') || (*pos == '\t') || (*pos == '\r'))
+        pos++;
+    if (*pos == ',')
+        pos++;
+    else if (*pos != '\0')
+        return VAL_STATUS_FAIL;
+
+    *cursor = pos;
+    return num_digits ? VAL_STATUS_PASS : VAL_STATUS_FAIL;
+}
+
+/**
+  @brief   This function parses a trace line of time, domain and frequency in
+           kHz. Lines that do not start with a digit are headers and comments.
+           A frequency that does not fit in 32 bits of kHz is malformed.
+  @param   line      trace line
+  @param   time_us   request time
+  @param   domain_id performance domain
+  @param   freq_khz  requested frequency
+  @return  PERF_REPLAY_LINE_VALID, _IGNORED or _MALFORMED
+**/
+static uint32_t val_perf_replay_parse_line(char *line, uint64_t *time_us, uint32_t *domain_id,
+                                           uint32_t *freq_khz)
+{
+    char *cursor = line;
+    uint64_t value;
+
+    while ((*cursor == ' ') || (*cursor == '\t'))
+        cursor++;
+    if ((*cursor < '0') || (*cursor > '9'))
+        return PERF_REPLAY_LINE_IGNORED;
+
+    if (val_perf_replay_parse_field(&cursor, time_us, 1) != VAL_STATUS_PASS)
+        return PERF_REPLAY_LINE_MALFORMED;
+
+    if (val_perf_replay_parse_field(&cursor, &value, 0) != VAL_STATUS_PASS)
+        return PERF_REPLAY_LINE_MALFORMED;
+    *domain_id = (value > MAX_PERFORMANCE_DOMAINS) ? MAX_PERFORMANCE_DOMAINS : (uint32_t)value;
+
+    if ((val_perf_replay_parse_field(&cursor, &value, 0) != VAL_STATUS_PASS) ||
+        (value > 0xFFFFFFFF))
+        return PERF_REPLAY_LINE_MALFORMED;
+    *freq_khz = (uint32_t)value;
+
+    return (*cursor == '\0') ? PERF_REPLAY_LINE_VALID : PERF_REPLAY_LINE_MALFORMED;
+}
+
+/**
+  @brief   This function reads the next request of the trace file. Malformed
+           lines, requests out of time order and requests for a domain that
+           cannot set its level are counted and left out.
+  @param   event  request read
+  @return  1 if a request was read, 0 at the end of the trace
+**/
+static uint32_t val_perf_replay_next_file(PERF_REPLAY_EVENT_s *event)
+{
+    uint64_t time_us;
+    uint32_t domain_id, freq_khz, result;
+
+    while (val_file_read_line(g_trace_handle, g_replay_line, sizeof(g_replay_line)))
+    {
+        result = val_perf_replay_parse_line(g_replay_line, &time_us, &domain_id, &freq_khz);
+        if (result == PERF_REPLAY_LINE_IGNORED)
+            continue;
+
+        if ((result == PERF_REPLAY_LINE_MALFORMED) || (g_started && (time_us < g_last_us)) ||
+            !val_perf_replay_domain_usable(domain_id)) {
+            if (g_first_pass)
+                g_num_skipped++;
+            continue;
+        }
+
+        if (!g_started) {
+            g_first_us = time_us;
+            g_started = 1;
+        }
+        g_last_us = time_us;
+
+        event->time_us = time_us - g_first_us;
+        event->domain_id = domain_id;
+        event->freq_khz = freq_khz;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+  @brief   This function gives the utilization of a domain in the built in
+           trace. Domains are offset in time so their phases differ.
+  @param   tick       scheduler tick
+  @param   domain_id  performance domain
+  @return  utilization out of PERF_REPLAY_UTIL_SCALE
+**/
+static uint32_t val_perf_replay_builtin_util(uint32_t tick, uint32_t domain_id)
+{
+    uint32_t phase = (tick + (domain_id * 3)) % PERF_REPLAY_BUILTIN_TICKS;
+    uint32_t util, i;
+
+    /* Idle, ramp up, busy, decay as the load tracking signal does, bursty */
+    if (phase < 8)
+        return PERF_REPLAY_UTIL_SCALE / 16;
+    if (phase < 16)
+        return ((phase - 7) * PERF_REPLAY_UTIL_SCALE) / 8;
+    if (phase < 24)
+        return PERF_REPLAY_UTIL_SCALE;
+    if (phase < 32) {
+        util = PERF_REPLAY_UTIL_SCALE;
+        for (i = 24; i <= phase; i++)
+            util = (util * 15) / 16;
+        return util;
+    }
+
+    return (phase & 1) ? (PERF_REPLAY_UTIL_SCALE * 4) / 5 : PERF_REPLAY_UTIL_SCALE / 8;
+}
+
+/**
+  @brief   This function produces the next request of the built in trace, a
+           schedutil like governor that asks for 1.25 times the frequency the
+           utilization needs every tick and sends the request only when it
+           resolves to another level
+  @param   event  request produced
+  @return  1 if a request was produced, 0 at the end of the trace
+**/
+static uint32_t val_perf_replay_next_builtin(PERF_REPLAY_EVENT_s *event)
+{
+    uint32_t tick, domain_id, max_level, level;
+    uint64_t freq_khz, fmax_khz;
+
+    while (g_builtin_tick < PERF_REPLAY_BUILTIN_TICKS)
+    {
+        tick = g_builtin_tick;
+        domain_id = g_builtin_domain++;
+        if (g_builtin_domain >= g_num_domains) {
+            g_builtin_domain = 0;
+            g_builtin_tick++;
+        }
+
+        if (!val_perf_replay_domain_usable(domain_id))
+            continue;
+
+        max_level = val_performance_get_info(PERF_DOMAIN_MAX_LEVEL, domain_id);
+        fmax_khz = val_performance_level_to_khz(domain_id, max_level);
+        /* Events carry 32 bit kHz, as trace lines do */
+        if (fmax_khz > 0xFFFFFFFF)
+            continue;
+        freq_khz = (fmax_khz * PERF_REPLAY_HEADROOM_PCT *
+                    val_perf_replay_builtin_util(tick, domain_id)) /
+                   (100 * PERF_REPLAY_UTIL_SCALE);
+        if (freq_khz > fmax_khz)
+            freq_khz = fmax_khz;
+
+        level = val_perf_replay_find_opp(domain_id, (uint32_t)freq_khz);
+        if ((tick > 0) && (level == g_builtin_last_level[domain_id]))
+            continue;
+        g_builtin_last_level[domain_id] = level;
+
+        event->time_us = (uint64_t)tick * PERF_REPLAY_TICK_US;
+        event->domain_id = domain_id;
+        event->freq_khz = (uint32_t)freq_khz;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+  @brief   This API gives the next request of the trace
+           1. Caller       -  Test Suite.
+  @param   event  request
+  @return  1 if a request was read, 0 at the end of the trace
+**/
+uint32_t val_perf_replay_next(PERF_REPLAY_EVENT_s *event)
+{
+    if (g_trace_file != NULL)
+        return val_perf_replay_next_file(event);
+
+    return val_perf_replay_next_builtin(event);
+}
+
+/**
+  @brief   This function goes back to the start of the trace
+  @param   none
+  @return  VAL_STATUS_PASS, VAL_STATUS_FAIL if the trace file cannot be read
+**/
+static uint32_t val_perf_replay_rewind(void)
+{
+    g_started = 0;
+    g_first_us = 0;
+    g_last_us = 0;
+    g_builtin_tick = 0;
+    g_builtin_domain = 0;
+
+    if (g_trace_file == NULL)
+        return VAL_STATUS_PASS;
+
+    if (g_trace_handle != NULL)
+        val_file_close(g_trace_handle);
+    g_trace_handle = val_file_open_read(g_trace_file);
+
+    return (g_trace_handle != NULL) ? VAL_STATUS_PASS : VAL_STATUS_FAIL;
+}
+
+/**
+  @brief   This API opens the trace and goes through it once to find its
+           length and the requests of every domain, then clears the results
+           1. Caller       -  Test Suite.
+  @param   num_domains  number of performance domains
+  @return  VAL_STATUS_PASS, VAL_STATUS_SKIP if no request can be replayed,
+           VAL_STATUS_FAIL if the trace file cannot be read
+**/
+uint32_t val_perf_replay_open(uint32_t num_domains)
+{
+    PERF_REPLAY_EVENT_s event;
+    uint32_t i;
+
+    g_num_domains = (num_domains > MAX_PERFORMANCE_DOMAINS) ? MAX_PERFORMANCE_DOMAINS :
+                                                              num_domains;
+    g_duration_us = 0;
+    g_num_events = 0;
+    g_num_skipped = 0;
+    val_memset(g_domain_requests, 0, sizeof(g_domain_requests));
+    val_memset(g_replay_domain, 0, sizeof(g_replay_domain));
+    for (i = 0; i < PERF_REPLAY_NUM_CHANNELS; i++)
+        val_hist_reset(&g_latency[i]);
+    val_hist_reset(&g_lateness);
+
+    if (val_perf_replay_rewind() != VAL_STATUS_PASS) {
+        val_print(VAL_PRINT_ERR, "\n       Cannot read trace %s", g_trace_file);
+        return VAL_STATUS_FAIL;
+    }
+
+    g_first_pass = 1;
+    while (val_perf_replay_next(&event))
+    {
+        g_num_events++;
+        g_domain_requests[event.domain_id]++;
+        g_duration_us = event.time_us;
+    }
+    g_first_pass = 0;
+
+    if (val_perf_replay_rewind() != VAL_STATUS_PASS) {
+        val_print(VAL_PRINT_ERR, "\n       Cannot read trace %s", g_trace_file);
+        return VAL_STATUS_FAIL;
+    }
+
+    if (g_num_events == 0)
+        return VAL_STATUS_SKIP;
+
+    if (g_report_file != NULL) {
+        g_report_handle = val_file_open(g_report_file);
+        if (g_report_handle == NULL)
+            val_print(VAL_PRINT_ERR, "\n       Cannot write replay report %s", g_report_file);
+        val_file_print(g_report_handle, "time_us,domain,requested_khz,opp_khz,achieved_khz,"
+                       "channel,status,latency_ns,late_ns\n");
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+/**
+  @brief   This API closes the trace and the replay report
+           1. Caller       -  Test Suite.
+  @param   none
+  @return  none
+**/
+void val_perf_replay_close(void)
+{
+    val_file_close(g_trace_handle);
+    g_trace_handle = NULL;
+    val_file_close(g_report_handle);
+    g_report_handle = NULL;
+}
+
+/**
+  @brief   This API returns the number of requests the trace has for a domain
+           1. Caller       -  Test Suite.
+  @param   domain_id  performance domain
+  @return  number of requests
+**/
+uint32_t val_perf_replay_num_requests(uint32_t domain_id)
+{
+    return (domain_id < MAX_PERFORMANCE_DOMAINS) ? g_domain_requests[domain_id] : 0;
+}
+
+/**
+  @brief   This API adds a replayed request to the results once the level it
+           achieved has been read back
+           1. Caller       -  Test Suite.
+  @param   sample  request, its outcome and timing
+  @return  none
+**/
+void val_perf_replay_record(PERF_REPLAY_SAMPLE_s *sample)
+{
+    PERF_REPLAY_DOMAIN_s *domain = &g_replay_domain[sample->event.domain_id];
+    uint32_t slice;
+    uint64_t opp_khz, achieved_khz;
+
+    opp_khz = val_performance_level_to_khz(sample->event.domain_id, sample->opp_level);
+    achieved_khz = val_performance_level_to_khz(sample->event.domain_id, sample->achieved_level);
+
+    domain->num_requests++;
+    if (sample->channel == PERF_REPLAY_FAST_CHANNEL)
+        domain->num_fast_channel++;
+    if (sample->status != SCMI_SUCCESS)
+        domain->num_rejected++;
+    else if (sample->achieved_level == sample->opp_level)
+        domain->num_achieved++;
+
+    slice = (uint32_t)((sample->event.time_us * PERF_REPLAY_NUM_SLICES) / (g_duration_us + 1));
+    domain->slice_count[slice]++;
+    domain->slice_requested_khz[slice] += sample->event.freq_khz;
+    domain->slice_opp_khz[slice] += opp_khz;
+    domain->slice_achieved_khz[slice] += achieved_khz;
+
+    val_hist_add(&g_latency[sample->channel], sample->latency_ns);
+    val_hist_add(&g_lateness, sample->late_ns);
+
+    val_file_print(g_report_handle, "%llu,%u,%u,%llu,%llu,%s,%d,%llu,%llu\n",
+                   (unsigned long long)sample->event.time_us, sample->event.domain_id,
+                   sample->event.freq_khz, (unsigned long long)opp_khz,
+                   (unsigned long long)achieved_khz,
+                   (sample->channel == PERF_REPLAY_FAST_CHANNEL) ? "fast" : "mailbox",
+                   sample->status, (unsigned long long)sample->latency_ns,
+                   (unsigned long long)sample->late_ns);
+}
+
+/**
+  @brief   This function prints one row of mean frequencies per period
+  @param   print_level  print verbosity
+  @param   name         row name
+  @param   count        requests per period
+  @param   sum_khz      frequencies added up per period
+  @return  none
+**/
+static void val_perf_replay_print_slices(uint32_t print_level, char *name, uint32_t *count,
+                                         uint64_t *sum_khz)
+{
+    uint32_t i;
+
+    val_print(print_level, "\n         %-10s", name);
+    for (i = 0; i < PERF_REPLAY_NUM_SLICES; i++)
+    {
+        if (count[i] == 0)
+            val_print(print_level, "        -");
+        else
+            val_print(print_level, " %8llu",
+                      (unsigned long long)(sum_khz[i] / count[i] / 1000));
+    }
+}
+
+/**
+  @brief   This API prints the requests replayed per domain, the mean
+           requested, OPP and achieved frequency over the trace, the command
+           latency per channel and how late requests were issued
+           1. Caller       -  Test Suite.
+  @param   print_level  print verbosity
+  @return  none
+**/
+void val_perf_replay_report(uint32_t print_level)
+{
+    PERF_REPLAY_DOMAIN_s *domain;
+    uint32_t domain_id, i;
+
+    val_print(print_level, "\n       TRACE          : %s, %d requests over %llu ms",
+              g_trace_file ? g_trace_file : "built in", g_num_events,
+              (unsigned long long)(g_duration_us / 1000));
+    if (g_num_skipped)
+        val_print(print_level, ", %d lines left out", g_num_skipped);
+
+    val_print(print_level, "\n       DOMAIN  REQUESTS  FAST CH  ACHIEVED  REJECTED");
+    for (domain_id = 0; domain_id < g_num_domains; domain_id++)
+    {
+        domain = &g_replay_domain[domain_id];
+        if (domain->num_requests == 0)
+            continue;
+        val_print(print_level, "\n       %6d  %8d  %7d  %8d  %8d", domain_id,
+                  domain->num_requests, domain->num_fast_channel, domain->num_achieved,
+                  domain->num_rejected);
+    }
+
+    val_print(print_level, "\n       Mean MHz from  ");
+    for (i = 0; i < PERF_REPLAY_NUM_SLICES; i++)
+        val_print(print_level, " %6llums",
+                  (unsigned long long)((g_duration_us * i) / PERF_REPLAY_NUM_SLICES / 1000));
+
+    for (domain_id = 0; domain_id < g_num_domains; domain_id++)
+    {
+        domain = &g_replay_domain[domain_id];
+        if (domain->num_requests == 0)
+            continue;
+        val_print(print_level, "\n       DOMAIN %d", domain_id);
+        val_perf_replay_print_slices(print_level, "requested", domain->slice_count,
+                                     domain->slice_requested_khz);
+        val_perf_replay_print_slices(print_level, "OPP", domain->slice_count,
+                                     domain->slice_opp_khz);
+        val_perf_replay_print_slices(print_level, "achieved", domain->slice_count,
+                                     domain->slice_achieved_khz);
+    }
+
+    val_hist_print(print_level, "mailbox ns", &g_latency[PERF_REPLAY_MAILBOX]);
+    val_hist_print(print_level, "fast ch ns", &g_latency[PERF_REPLAY_FAST_CHANNEL]);
+    val_hist_print(print_level, "late ns", &g_lateness);
+}
+
+#endif
@@ -33,24 +33,24 @@ uint32_t val_performance_execute_tests(void)
     val_memset((void *)&g_performance_info_table, 0, sizeof(g_performance_info_table));
 
     if (val_agent_check_protocol_support(PROTOCOL_PERFORMANCE)) {
-        if (RUN_TEST(performance_query_protocol_version(&version)))
+        if (RUN_SETUP_TEST(performance_query_protocol_version(&version)))
             return VAL_STATUS_FAIL;
 
-        RUN_TEST(performance_query_protocol_attributes());
+        RUN_SETUP_TEST(performance_query_protocol_attributes());
 
         if (version == PERFORMANCE_PROTOCOL_VERSION_1) {
             RUN_TEST(performance_query_mandatory_command_support_v1());
             RUN_TEST(performance_invalid_messageid_call());
-            RUN_TEST(performance_query_domain_attributes_v1());
+            RUN_SETUP_TEST(performance_query_domain_attributes_v1());
         }
 
         if (version == PERFORMANCE_PROTOCOL_VERSION_2) {
-            RUN_TEST(performance_query_mandatory_command_support());
+            RUN_SETUP_TEST(performance_query_mandatory_command_support());
             RUN_TEST(performance_invalid_messageid_call());
-            RUN_TEST(performance_query_domain_attributes());
+            RUN_SETUP_TEST(performance_query_domain_attributes());
         }
         RUN_TEST(performance_query_domain_attributes_invalid_domain());
-        RUN_TEST(performance_query_describe_levels());
+        RUN_SETUP_TEST(performance_query_describe_levels());
         RUN_TEST(performance_query_describe_levels_invalid_domain());
         RUN_TEST(performance_query_set_limit());
         RUN_TEST(performance_query_set_limit_invalid_range());
@@ -74,6 +74,9 @@ uint32_t val_performance_execute_tests(void)
         }
         RUN_TEST(performance_limit_set_async());
         RUN_TEST(performance_level_set_async());
+        RUN_TEST(performance_energy_model_export());
+        RUN_TEST(performance_rate_limit_throttling());
+        RUN_TEST(performance_governor_trace_replay());
 
         if (version == PERFORMANCE_PROTOCOL_VERSION_2) {
             RUN_TEST(performance_level_get_fast_channel());
@@ -86,6 +89,44 @@ uint32_t val_performance_execute_tests(void)
     return VAL_STATUS_PASS;
 }
 
+/**
+  @brief   This API is called from soak runs to execute the state restoring
+           subset of performance tests. Info table is kept from the compliance run.
+  @param   none
+  @return  number of failed tests
+**/
+uint32_t val_performance_execute_soak_tests(void)
+{
+    uint32_t version = 0;
+    uint32_t num_fail = 0;
+
+    if (val_agent_check_protocol_support(PROTOCOL_PERFORMANCE)) {
+        if (RUN_SOAK_TEST(performance_query_protocol_version(&version)))
+            return 1;
+
+        num_fail += RUN_SOAK_TEST(performance_query_protocol_attributes());
+        if (version == PERFORMANCE_PROTOCOL_VERSION_1)
+            num_fail += RUN_SOAK_TEST(performance_query_domain_attributes_v1());
+        if (version == PERFORMANCE_PROTOCOL_VERSION_2)
+            num_fail += RUN_SOAK_TEST(performance_query_domain_attributes());
+
+        num_fail += RUN_SOAK_TEST(performance_query_describe_levels());
+        num_fail += RUN_SOAK_TEST(performance_query_set_limit());
+        num_fail += RUN_SOAK_TEST(performance_query_set_level());
+        num_fail += RUN_SOAK_TEST(performance_query_notify_limit_invalid_parameters());
+        num_fail += RUN_SOAK_TEST(performance_query_notify_level_invalid_parameters());
+        num_fail += RUN_SOAK_TEST(performance_limit_set_async());
+        num_fail += RUN_SOAK_TEST(performance_level_set_async());
+
+        if (version == PERFORMANCE_PROTOCOL_VERSION_2) {
+            num_fail += RUN_SOAK_TEST(performance_level_get_fast_channel());
+            num_fail += RUN_SOAK_TEST(performance_limits_get_fast_channel());
+        }
+    }
+
+    return num_fail;
+}
+
 /**
   @brief   This API is used to set performance protocol info
            1. Caller       -  Test Suite.
@@ -112,6 +153,9 @@ void val_performance_save_info(uint32_t param_identifier, uint32_t perf_id, uint
     case PERF_STATS_ADDR_LEN:
         g_performance_info_table.perf_stats_addr_len = param_value;
         break;
+    case PERF_POWER_VALUES_MW:
+        g_performance_info_table.power_values_mw = param_value;
+        break;
     case PERF_DOMAIN_FAST_CH_SUPPORT:
         g_performance_info_table.perf_domain_info[perf_id].fast_ch_support = param_value;
         break;
@@ -140,15 +184,24 @@ void val_performance_save_info(uint32_t param_identifier, uint32_t perf_id, uint
     case PERF_DOMAIN_INTERMEDIATE_LEVEL:
        g_performance_info_table.perf_domain_info[perf_id].intermediate_level = param_value;
        break;
+    case PERF_DOMAIN_SUSTAINED_FREQ:
+       g_performance_info_table.perf_domain_info[perf_id].sustained_freq = param_value;
+       break;
+    case PERF_DOMAIN_SUSTAINED_LEVEL:
+       g_performance_info_table.perf_domain_info[perf_id].sustained_level = param_value;
+       break;
+    case PERF_DOMAIN_NUM_LEVELS:
+       g_performance_info_table.perf_domain_info[perf_id].num_levels = param_value;
+       break;
     case PERF_MESSAGE_FAST_CH_SUPPORT:
          switch (perf_id)
          {
          case PERFORMANCE_LIMITS_SET:
-             g_performance_info_table.perf_fast_cmd_ch_support.performance_level_set =
+             g_performance_info_table.perf_fast_cmd_ch_support.performance_limits_set =
                      param_value;
              break;
          case PERFORMANCE_LIMITS_GET:
-             g_performance_info_table.perf_fast_cmd_ch_support.performance_level_get =
+             g_performance_info_table.perf_fast_cmd_ch_support.performance_limits_get =
                      param_value;
              break;
          case PERFORMANCE_LEVEL_SET:
@@ -194,6 +247,9 @@ uint32_t val_performance_get_info(uint32_t param_identifier, uint32_t perf_id)
     case PERF_STATS_ADDR_LEN:
         param_value =  g_performance_info_table.perf_stats_addr_len;
         break;
+    case PERF_POWER_VALUES_MW:
+        param_value = g_performance_info_table.power_values_mw;
+        break;
     case PERF_DOMAIN_FAST_CH_SUPPORT:
         param_value = g_performance_info_table.perf_domain_info[perf_id].fast_ch_support;
         break;
@@ -222,14 +278,23 @@ uint32_t val_performance_get_info(uint32_t param_identifier, uint32_t perf_id)
     case PERF_DOMAIN_INTERMEDIATE_LEVEL:
        param_value = g_performance_info_table.perf_domain_info[perf_id].intermediate_level;
        break;
+    case PERF_DOMAIN_SUSTAINED_FREQ:
+       param_value = g_performance_info_table.perf_domain_info[perf_id].sustained_freq;
+       break;
+    case PERF_DOMAIN_SUSTAINED_LEVEL:
+       param_value = g_performance_info_table.perf_domain_info[perf_id].sustained_level;
+       break;
+    case PERF_DOMAIN_NUM_LEVELS:
+       param_value = g_performance_info_table.perf_domain_info[perf_id].num_levels;
+       break;
     case PERF_MESSAGE_FAST_CH_SUPPORT:
          switch (perf_id)
          {
          case PERFORMANCE_LIMITS_SET:
-             param_value = g_performance_info_table.perf_fast_cmd_ch_support.performance_level_set;
+             param_value = g_performance_info_table.perf_fast_cmd_ch_support.performance_limits_set;
              break;
          case PERFORMANCE_LIMITS_GET:
-             param_value = g_performance_info_table.perf_fast_cmd_ch_support.performance_level_get;
+             param_value = g_performance_info_table.perf_fast_cmd_ch_support.performance_limits_get;
              break;
          case PERFORMANCE_LEVEL_SET:
              param_value = g_performance_info_table.perf_fast_cmd_ch_support.performance_level_set;
@@ -249,6 +314,130 @@ uint32_t val_performance_get_info(uint32_t param_identifier, uint32_t perf_id)
     return param_value;
 }
 
+/**
+  @brief   This API is used to save a level from PERFORMANCE_DESCRIBE_LEVELS
+           1. Caller       -  Test Suite.
+           2. Prerequisite -  Performance protocol info table.
+  @param   perf_id      Performance domain identifier
+  @param   level_index  index of the level, levels past MAX_PERFORMANCE_LEVELS
+                        are not kept
+  @param   level        performance level
+  @param   power        power cost of the level
+  @param   latency_us   worst case transition latency to the level
+  @return  none
+**/
+void val_performance_save_level(uint32_t perf_id, uint32_t level_index, uint32_t level,
+                                uint32_t power, uint32_t latency_us)
+{
+    PERFORMANCE_DOMAIN_INFO_s *domain = &g_performance_info_table.perf_domain_info[perf_id];
+
+    if (level_index >= MAX_PERFORMANCE_LEVELS)
+        return;
+
+    domain->level[level_index] = level;
+    domain->level_power[level_index] = power;
+    domain->level_latency_us[level_index] = latency_us;
+}
+
+/**
+  @brief   This API is used to get a level saved from PERFORMANCE_DESCRIBE_LEVELS
+           1. Caller       -  Test Suite.
+           2. Prerequisite -  Performance protocol info table.
+  @param   perf_id      Performance domain identifier
+  @param   level_index  index of the level
+  @return  performance level, 0 if it was not kept
+**/
+uint32_t val_performance_get_level(uint32_t perf_id, uint32_t level_index)
+{
+    if (level_index >= MAX_PERFORMANCE_LEVELS)
+        return 0;
+
+    return g_performance_info_table.perf_domain_info[perf_id].level[level_index];
+}
+
+/**
+  @brief   This API is used to get the power cost of a saved level
+           1. Caller       -  Test Suite.
+           2. Prerequisite -  Performance protocol info table.
+  @param   perf_id      Performance domain identifier
+  @param   level_index  index of the level
+  @return  power cost, 0 if it was not kept
+**/
+uint32_t val_performance_get_level_power(uint32_t perf_id, uint32_t level_index)
+{
+    if (level_index >= MAX_PERFORMANCE_LEVELS)
+        return 0;
+
+    return g_performance_info_table.perf_domain_info[perf_id].level_power[level_index];
+}
+
+/**
+  @brief   This API is used to get the transition latency of a saved level
+           1. Caller       -  Test Suite.
+           2. Prerequisite -  Performance protocol info table.
+  @param   perf_id      Performance domain identifier
+  @param   level_index  index of the level
+  @return  latency in us, 0 if it was not kept
+**/
+uint32_t val_performance_get_level_latency(uint32_t perf_id, uint32_t level_index)
+{
+    if (level_index >= MAX_PERFORMANCE_LEVELS)
+        return 0;
+
+    return g_performance_info_table.perf_domain_info[perf_id].level_latency_us[level_index];
+}
+
+/**
+  @brief   This API converts a performance level to a frequency with the
+           saved sustained frequency and level of the domain, as the Linux
+           SCMI driver does. A domain that reports neither has levels taken
+           as kHz.
+           1. Caller       -  Test Suite.
+           2. Prerequisite -  Performance protocol info table.
+  @param   perf_id  Performance domain identifier
+  @param   level    performance level
+  @return  frequency in kHz
+**/
+uint64_t val_performance_level_to_khz(uint32_t perf_id, uint32_t level)
+{
+    PERFORMANCE_DOMAIN_INFO_s *domain = &g_performance_info_table.perf_domain_info[perf_id];
+
+    if (domain->sustained_freq && domain->sustained_level)
+        return ((uint64_t)level * domain->sustained_freq) / domain->sustained_level;
+
+    return level;
+}
+
+/**
+  @brief   This API is used to save the name of a performance domain
+           1. Caller       -  Test Suite.
+           2. Prerequisite -  Performance protocol info table.
+  @param   perf_id  Performance domain identifier
+  @param   name     domain name
+  @return  none
+**/
+void val_performance_save_name(uint32_t perf_id, uint8_t *name)
+{
+    uint8_t *saved = g_performance_info_table.perf_domain_info[perf_id].name;
+    uint32_t i;
+
+    for (i = 0; (i < (SCMI_NAME_STR_SIZE - 1)) && name[i]; i++)
+        saved[i] = name[i];
+    saved[i] = '\0';
+}
+
+/**
+  @brief   This API is used to get the saved name of a performance domain
+           1. Caller       -  Test Suite.
+           2. Prerequisite -  Performance protocol info table.
+  @param   perf_id  Performance domain identifier
+  @return  domain name
+**/
+uint8_t *val_performance_get_name(uint32_t perf_id)
+{
+    return g_performance_info_table.perf_domain_info[perf_id].name;
+}
+
 /**
   @brief   This API is used for checking number of perf domains
   @param   none
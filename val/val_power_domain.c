@@ -33,13 +33,13 @@ uint32_t val_power_domain_execute_tests(void)
     val_memset((void *)&g_power_domain_info_table, 0, sizeof(g_power_domain_info_table));
 
     if (val_agent_check_protocol_support(PROTOCOL_POWER_DOMAIN)) {
-        if (RUN_TEST(power_domain_query_protocol_version(&version)))
+        if (RUN_SETUP_TEST(power_domain_query_protocol_version(&version)))
             return VAL_STATUS_FAIL;
 
-        RUN_TEST(power_domain_query_protocol_attributes());
+        RUN_SETUP_TEST(power_domain_query_protocol_attributes());
         RUN_TEST(power_domain_query_mandatory_command_support());
         RUN_TEST(power_domain_invalid_messageid_call());
-        RUN_TEST(power_domain_query_domain_attributes());
+        RUN_SETUP_TEST(power_domain_query_domain_attributes());
         RUN_TEST(power_domain_query_domain_attributes_invalid_doamin());
         RUN_TEST(power_domain_set_power_state_check());
         RUN_TEST(power_domain_set_power_state_unsupported_domain_check());
@@ -55,8 +55,9 @@ uint32_t val_power_domain_execute_tests(void)
             RUN_TEST(power_domain_power_state_change_requested_notify_invalid_domain_check());
         }
         if (version == POWER_PROTOCOL_VERSION_2_1) {
-            RUN_TEST(power_domain_query_domain_attributes_scmi_v3());
+            RUN_SETUP_TEST(power_domain_query_domain_attributes_scmi_v3());
         }
+        RUN_TEST(power_domain_state_transition_profile());
     }
     else
         val_print(VAL_PRINT_ERR, "\n Calling agent have no access to POWER DOMAIN protocol");
@@ -64,6 +65,34 @@ uint32_t val_power_domain_execute_tests(void)
     return VAL_STATUS_PASS;
 }
 
+/**
+  @brief   This API is called from soak runs to execute the state restoring
+           subset of power domain tests. Info table is kept from the compliance run.
+  @param   none
+  @return  number of failed tests
+**/
+uint32_t val_power_domain_execute_soak_tests(void)
+{
+    uint32_t version = 0;
+    uint32_t num_fail = 0;
+
+    if (val_agent_check_protocol_support(PROTOCOL_POWER_DOMAIN)) {
+        if (RUN_SOAK_TEST(power_domain_query_protocol_version(&version)))
+            return 1;
+
+        num_fail += RUN_SOAK_TEST(power_domain_query_protocol_attributes());
+        num_fail += RUN_SOAK_TEST(power_domain_query_domain_attributes());
+        num_fail += RUN_SOAK_TEST(power_domain_set_power_state_check());
+        num_fail += RUN_SOAK_TEST(power_domain_get_power_state_check());
+        num_fail += RUN_SOAK_TEST(power_domain_power_state_notify_check());
+
+        if (version == POWER_PROTOCOL_VERSION_2)
+            num_fail += RUN_SOAK_TEST(power_domain_power_state_change_requested_notify_check());
+    }
+
+    return num_fail;
+}
+
 /**
   @brief   This API is used to set power_domain protocol info
            1. Caller       -  Test Suite.
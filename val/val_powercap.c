@@ -0,0 +1,202 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+#ifdef POWERCAP_PROTOCOL
+
+#include "val_interface.h"
+#include "val_powercap.h"
+
+static POWERCAP_INFO_s g_powercap_info_table;
+
+/**
+  @brief   This API is called from app layer to execute powercap tests
+  @param   none
+  @return  test execution result
+**/
+uint32_t val_powercap_execute_tests(void)
+{
+    uint32_t version = 0;
+
+    if (val_agent_check_protocol_support(PROTOCOL_POWERCAP)) {
+        if (RUN_SETUP_TEST(powercap_query_protocol_version(&version)))
+            return VAL_STATUS_FAIL;
+
+        RUN_SETUP_TEST(powercap_query_protocol_attributes());
+        RUN_TEST(powercap_query_mandatory_command_support());
+        RUN_TEST(powercap_invalid_messageid_call());
+        RUN_SETUP_TEST(powercap_query_domain_attributes());
+        RUN_TEST(powercap_query_domain_attributes_invalid_id());
+        RUN_SETUP_TEST(powercap_query_cap_get());
+        RUN_TEST(powercap_query_cap_get_invalid_id());
+        RUN_TEST(powercap_set_cap());
+        RUN_TEST(powercap_set_cap_invalid_domain());
+        RUN_TEST(powercap_set_invalid_cap());
+        RUN_TEST(powercap_query_measurements());
+        RUN_TEST(powercap_query_measurements_invalid_id());
+        RUN_TEST(powercap_cap_enforcement_benchmark());
+    }
+    else
+        val_print(VAL_PRINT_ERR, "\n Calling agent have no access to Powercap protocol");
+
+    return VAL_STATUS_PASS;
+}
+
+/**
+  @brief   This API is called from soak runs to execute the state restoring
+           subset of powercap tests. Info table is kept from the compliance run.
+  @param   none
+  @return  number of failed tests
+**/
+uint32_t val_powercap_execute_soak_tests(void)
+{
+    uint32_t version = 0;
+    uint32_t num_fail = 0;
+
+    if (val_agent_check_protocol_support(PROTOCOL_POWERCAP)) {
+        if (RUN_SOAK_TEST(powercap_query_protocol_version(&version)))
+            return 1;
+
+        num_fail += RUN_SOAK_TEST(powercap_query_protocol_attributes());
+        num_fail += RUN_SOAK_TEST(powercap_query_domain_attributes());
+        num_fail += RUN_SOAK_TEST(powercap_query_cap_get());
+        num_fail += RUN_SOAK_TEST(powercap_set_cap());
+        num_fail += RUN_SOAK_TEST(powercap_query_measurements());
+    }
+
+    return num_fail;
+}
+
+/**
+  @brief   This API is used for checking num of powercap domain
+  @param   none
+  @return  num of powercap domain
+**/
+uint32_t val_powercap_get_expected_num_domains(void)
+{
+    return pal_powercap_get_expected_num_domains();
+}
+
+/**
+  @brief   This API is used for checking powercap domain name
+  @param   domain id
+  @return  powercap domain name
+**/
+uint8_t *val_powercap_get_expected_name(uint32_t domain_id)
+{
+    return pal_powercap_get_expected_name(domain_id);
+}
+
+/**
+  @brief   This API is used to set powercap protocol info
+           1. Caller       -  Test Suite.
+           2. Prerequisite -  Powercap protocol info table.
+  @param   param_identifier  id of parameter which will be set
+  @param   domain_id         powercap domain ID.
+  @param   param_value       value of parameter
+  @return  none
+**/
+void val_powercap_save_info(uint32_t param_identifier, uint32_t domain_id, uint32_t param_value)
+{
+    POWERCAP_DOMAIN_INFO_s *domain;
+
+    /* Domains beyond a table reduced with MAX_NUM_OF_POWERCAP_DOMAINS are not recorded */
+    if (param_identifier == NUM_POWERCAP_DOMAINS) {
+        g_powercap_info_table.num_domains = param_value;
+        return;
+    }
+    if (domain_id >= MAX_NUM_OF_POWERCAP_DOMAINS)
+        return;
+
+    domain = &g_powercap_info_table.domain_info[domain_id];
+    switch (param_identifier)
+    {
+    case POWERCAP_DOMAIN_ATTRIBUTE:
+        domain->attributes = param_value;
+        break;
+    case POWERCAP_MIN_PAI:
+        domain->min_pai = param_value;
+        break;
+    case POWERCAP_MAX_PAI:
+        domain->max_pai = param_value;
+        break;
+    case POWERCAP_PAI_STEP:
+        domain->pai_step = param_value;
+        break;
+    case POWERCAP_MIN_CAP:
+        domain->min_cap = param_value;
+        break;
+    case POWERCAP_MAX_CAP:
+        domain->max_cap = param_value;
+        break;
+    case POWERCAP_CAP_STEP:
+        domain->cap_step = param_value;
+        break;
+    case POWERCAP_SUSTAINABLE_POWER:
+        domain->sustainable_power = param_value;
+        break;
+    case POWERCAP_CURRENT_CAP:
+        domain->current_cap = param_value;
+        break;
+    default:
+        val_print(VAL_PRINT_ERR, "\nUnidentified parameter %d", param_identifier);
+    }
+}
+
+/**
+  @brief   This API is used to get powercap protocol info
+           1. Caller       -  Test Suite.
+           2. Prerequisite -  Powercap protocol info table.
+  @param   param_identifier  id of parameter which will be set
+  @param   domain_id         powercap domain ID.
+  @return  param_value       value of the parameter
+**/
+uint32_t val_powercap_get_info(uint32_t param_identifier, uint32_t domain_id)
+{
+    POWERCAP_DOMAIN_INFO_s *domain;
+
+    if (param_identifier == NUM_POWERCAP_DOMAINS)
+        return g_powercap_info_table.num_domains;
+    if (domain_id >= MAX_NUM_OF_POWERCAP_DOMAINS)
+        return 0;
+
+    domain = &g_powercap_info_table.domain_info[domain_id];
+    switch (param_identifier)
+    {
+    case POWERCAP_DOMAIN_ATTRIBUTE:
+        return domain->attributes;
+    case POWERCAP_MIN_PAI:
+        return domain->min_pai;
+    case POWERCAP_MAX_PAI:
+        return domain->max_pai;
+    case POWERCAP_PAI_STEP:
+        return domain->pai_step;
+    case POWERCAP_MIN_CAP:
+        return domain->min_cap;
+    case POWERCAP_MAX_CAP:
+        return domain->max_cap;
+    case POWERCAP_CAP_STEP:
+        return domain->cap_step;
+    case POWERCAP_SUSTAINABLE_POWER:
+        return domain->sustainable_power;
+    case POWERCAP_CURRENT_CAP:
+        return domain->current_cap;
+    default:
+        val_print(VAL_PRINT_ERR, "\nUnidentified parameter %d", param_identifier);
+    }
+
+    return 0;
+}
+#endif
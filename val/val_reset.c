@@ -33,13 +33,13 @@ uint32_t val_reset_execute_tests(void)
     val_memset((void *)&g_reset_info_table, 0, sizeof(g_reset_info_table));
 
     if (val_agent_check_protocol_support(PROTOCOL_RESET)) {
-        if (RUN_TEST(reset_query_protocol_version(&version)))
+        if (RUN_SETUP_TEST(reset_query_protocol_version(&version)))
             return VAL_STATUS_FAIL;
 
-        RUN_TEST(reset_query_protocol_attributes());
+        RUN_SETUP_TEST(reset_query_protocol_attributes());
         RUN_TEST(reset_query_mandatory_command_support());
         RUN_TEST(reset_invalid_messageid_call());
-        RUN_TEST(reset_query_domain_attributes());
+        RUN_SETUP_TEST(reset_query_domain_attributes());
         RUN_TEST(reset_query_domain_attributes_invalid_id());
         RUN_TEST(reset_query_reset_command_invalid_id());
         RUN_TEST(reset_query_reset_command_invalid_flag());
@@ -48,8 +48,9 @@ uint32_t val_reset_execute_tests(void)
         RUN_TEST(reset_query_invalid_notify_enable());
 
         if (version == RESET_PROTOCOL_VERSION_2) {
-            RUN_TEST(reset_query_domain_attributes_scmi_v3());
+            RUN_SETUP_TEST(reset_query_domain_attributes_scmi_v3());
         }
+        RUN_TEST(reset_latency_benchmark());
     }
     else
         val_print(VAL_PRINT_ERR, "\n Calling agent have no access to RESET protocol");
@@ -57,6 +58,30 @@ uint32_t val_reset_execute_tests(void)
     return VAL_STATUS_PASS;
 }
 
+/**
+  @brief   This API is called from soak runs to execute the state restoring
+           subset of reset tests. Info table is kept from the compliance run.
+  @param   none
+  @return  number of failed tests
+**/
+uint32_t val_reset_execute_soak_tests(void)
+{
+    uint32_t version = 0;
+    uint32_t num_fail = 0;
+
+    if (val_agent_check_protocol_support(PROTOCOL_RESET)) {
+        if (RUN_SOAK_TEST(reset_query_protocol_version(&version)))
+            return 1;
+
+        num_fail += RUN_SOAK_TEST(reset_query_protocol_attributes());
+        num_fail += RUN_SOAK_TEST(reset_query_domain_attributes());
+        num_fail += RUN_SOAK_TEST(reset_query_notify_invalid_id());
+        num_fail += RUN_SOAK_TEST(reset_query_invalid_notify_enable());
+    }
+
+    return num_fail;
+}
+
 /**
   @brief   This API is used to set reset protocol info
            1. Caller       -  Test Suite.
@@ -80,6 +105,10 @@ void val_reset_save_info(uint32_t param_identifier, uint32_t domain_id, uint32_t
         g_reset_info_table.domain_info[domain_id].notify_support =
                 param_value;
         break;
+    case RESET_DOMAIN_LATENCY:
+        g_reset_info_table.domain_info[domain_id].latency =
+                param_value;
+        break;
     default:
         val_print(VAL_PRINT_ERR, "\nUnidentified parameter %d", param_identifier);
     }
@@ -107,6 +136,9 @@ uint32_t val_reset_get_info(uint32_t param_identifier, uint32_t domain_id)
     case RESET_NOTIFY_SUPPORT:
         param_value = g_reset_info_table.domain_info[domain_id].notify_support;
         break;
+    case RESET_DOMAIN_LATENCY:
+        param_value = g_reset_info_table.domain_info[domain_id].latency;
+        break;
     default:
         val_print(VAL_PRINT_ERR, "\nUnidentified parameter %d", param_identifier);
     }
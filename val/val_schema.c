@@ -0,0 +1,220 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_schema.h"
+
+/* Nothing here may call into the rest of VAL, the mocker links this file on its own */
+
+/* Message with a fixed set of return words, one reserved mask per word */
+#define SCHEMA_FIXED(protocol_id, msg_type, msg_id, num_params, reserved) \
+    {VAL_SCHEMA_HDR(protocol_id, msg_type, msg_id), num_params, NUM_ELEMS(reserved), \
+     0, 0, 0, 0, reserved, NULL}
+
+/* Command with a status only */
+#define SCHEMA_STATUS_ONLY(protocol_id, msg_id, num_params) \
+    {VAL_SCHEMA_HDR(protocol_id, COMMAND_MSG, msg_id), num_params, 0, 0, 0, 0, 0, NULL, NULL}
+
+/* Fixed words followed by the entries counted by a bitfield of one of them */
+#define SCHEMA_ENTRIES(protocol_id, msg_id, num_params, reserved, count_word, count_field, \
+                       entry_reserved) \
+    {VAL_SCHEMA_HDR(protocol_id, COMMAND_MSG, msg_id), num_params, NUM_ELEMS(reserved), \
+     NUM_ELEMS(entry_reserved), count_word, count_field, reserved, entry_reserved}
+
+/* One word without reserved bits, such as a version or a level */
+static const uint32_t g_word_rsvd[] = {0};
+static const uint32_t g_stats_rsvd_pd[] = {VAL_SCHEMA_MASK(PROTOCOL_ATTR_RESERVED), 0, 0, 0};
+static const uint32_t g_attr_rsvd_base[] = {VAL_SCHEMA_MASK(BASE_ATTR_RESERVED)};
+static const uint32_t g_attr_rsvd_system_power[] = {0xFFFFFFFF};
+static const uint32_t g_stats_rsvd_perf[] = {VAL_SCHEMA_MASK(PERF_ATTR_RESERVED), 0, 0, 0};
+static const uint32_t g_attr_rsvd_clock[] = {VAL_SCHEMA_MASK(CLOCK_ATTR_RESERVED)};
+static const uint32_t g_stats_rsvd_sensor[] = {VAL_SCHEMA_MASK(SENSOR_ATTR_RESERVED), 0, 0, 0};
+static const uint32_t g_attr_rsvd_domains[] = {VAL_SCHEMA_MASK(PROTOCOL_ATTR_RESERVED)};
+
+static const uint32_t g_perf_msg_attr_rsvd[] = {VAL_SCHEMA_MASK(PERF_MSG_ATTR_RESERVED)};
+static const uint32_t g_perf_domain_attr_rsvd[] = {
+    VAL_SCHEMA_MASK(PERF_DOMAIN_ATTR_RESERVED), VAL_SCHEMA_MASK(PERF_RATE_LIMIT_RESERVED), 0, 0,
+    0, 0, 0, 0
+};
+static const uint32_t g_perf_levels_rsvd[] = {VAL_SCHEMA_MASK(PERF_LEVELS_RESERVED)};
+static const uint32_t g_perf_level_entry_rsvd[] = {
+    0, 0, VAL_SCHEMA_MASK(PERF_LEVEL_LATENCY_RESERVED)
+};
+static const uint32_t g_perf_limits_rsvd[] = {0, 0};
+static const uint32_t g_perf_fast_channel_rsvd[] = {
+    VAL_SCHEMA_MASK(PERF_FC_ATTR_RESERVED), VAL_SCHEMA_MASK(PERF_RATE_LIMIT_RESERVED), 0, 0, 0,
+    0, 0, 0, 0, 0, 0
+};
+static const uint32_t g_perf_limits_changed_rsvd[] = {0, 0, 0, 0};
+static const uint32_t g_perf_level_changed_rsvd[] = {0, 0, 0};
+
+static const uint32_t g_system_power_notifier_rsvd[] = {0, 0, 0};
+
+static const VAL_SCHEMA_MSG_s g_schema_table[] = {
+    SCHEMA_FIXED(PROTOCOL_BASE, COMMAND_MSG, BASE_PROTOCOL_VERSION, 0, g_word_rsvd),
+    SCHEMA_FIXED(PROTOCOL_BASE, COMMAND_MSG, BASE_PROTOCOL_ATTRIBUTES, 0, g_attr_rsvd_base),
+
+    SCHEMA_FIXED(PROTOCOL_POWER_DOMAIN, COMMAND_MSG, PD_PROTOCOL_VERSION, 0, g_word_rsvd),
+    SCHEMA_FIXED(PROTOCOL_POWER_DOMAIN, COMMAND_MSG, PD_PROTOCOL_ATTRIBUTES, 0, g_stats_rsvd_pd),
+
+    SCHEMA_FIXED(PROTOCOL_SYSTEM_POWER, COMMAND_MSG, SYSTEM_POWER_PROTOCOL_VERSION, 0,
+                 g_word_rsvd),
+    SCHEMA_FIXED(PROTOCOL_SYSTEM_POWER, COMMAND_MSG, SYSTEM_POWER_PROTOCOL_ATTRIBUTES, 0,
+                 g_attr_rsvd_system_power),
+    SCHEMA_STATUS_ONLY(PROTOCOL_SYSTEM_POWER, SYSTEM_POWER_STATE_SET, 2),
+    SCHEMA_STATUS_ONLY(PROTOCOL_SYSTEM_POWER, SYSTEM_POWER_STATE_NOTIFY, 1),
+    SCHEMA_FIXED(PROTOCOL_SYSTEM_POWER, NOTIFICATION_MSG, SYSTEM_POWER_STATE_NOTIFIER, 0,
+                 g_system_power_notifier_rsvd),
+
+    SCHEMA_FIXED(PROTOCOL_PERFORMANCE, COMMAND_MSG, PERFORMANCE_PROTOCOL_VERSION, 0,
+                 g_word_rsvd),
+    SCHEMA_FIXED(PROTOCOL_PERFORMANCE, COMMAND_MSG, PERFORMANCE_PROTOCOL_ATTRIBUTES, 0,
+                 g_stats_rsvd_perf),
+    SCHEMA_FIXED(PROTOCOL_PERFORMANCE, COMMAND_MSG, PERFORMANCE_PROTOCOL_MESSAGE_ATTRIBUTES, 1,
+                 g_perf_msg_attr_rsvd),
+    SCHEMA_FIXED(PROTOCOL_PERFORMANCE, COMMAND_MSG, PERFORMANCE_DOMAIN_ATTRIBUTES, 1,
+                 g_perf_domain_attr_rsvd),
+    SCHEMA_ENTRIES(PROTOCOL_PERFORMANCE, PERFORMANCE_DESCRIBE_LEVELS, 2, g_perf_levels_rsvd,
+                   0, PERF_LEVELS_RETURNED, g_perf_level_entry_rsvd),
+    SCHEMA_STATUS_ONLY(PROTOCOL_PERFORMANCE, PERFORMANCE_LIMITS_SET, 3),
+    SCHEMA_FIXED(PROTOCOL_PERFORMANCE, COMMAND_MSG, PERFORMANCE_LIMITS_GET, 1,
+                 g_perf_limits_rsvd),
+    SCHEMA_STATUS_ONLY(PROTOCOL_PERFORMANCE, PERFORMANCE_LEVEL_SET, 2),
+    SCHEMA_FIXED(PROTOCOL_PERFORMANCE, COMMAND_MSG, PERFORMANCE_LEVEL_GET, 1, g_word_rsvd),
+    SCHEMA_STATUS_ONLY(PROTOCOL_PERFORMANCE, PERFORMANCE_NOTIFY_LIMITS, 2),
+    SCHEMA_STATUS_ONLY(PROTOCOL_PERFORMANCE, PERFORMANCE_NOTIFY_LEVEL, 2),
+    SCHEMA_FIXED(PROTOCOL_PERFORMANCE, COMMAND_MSG, PERFORMANCE_DESCRIBE_FASTCHANNEL, 2,
+                 g_perf_fast_channel_rsvd),
+    SCHEMA_FIXED(PROTOCOL_PERFORMANCE, NOTIFICATION_MSG, PERFORMANCE_LIMITS_CHANGED, 0,
+                 g_perf_limits_changed_rsvd),
+    SCHEMA_FIXED(PROTOCOL_PERFORMANCE, NOTIFICATION_MSG, PERFORMANCE_LEVEL_CHANGED, 0,
+                 g_perf_level_changed_rsvd),
+
+    SCHEMA_FIXED(PROTOCOL_CLOCK, COMMAND_MSG, CLOCK_PROTOCOL_VERSION, 0, g_word_rsvd),
+    SCHEMA_FIXED(PROTOCOL_CLOCK, COMMAND_MSG, CLOCK_PROTOCOL_ATTRIBUTES, 0, g_attr_rsvd_clock),
+
+    SCHEMA_FIXED(PROTOCOL_SENSOR, COMMAND_MSG, SENSOR_PROTOCOL_VERSION, 0, g_word_rsvd),
+    SCHEMA_FIXED(PROTOCOL_SENSOR, COMMAND_MSG, SENSOR_PROTOCOL_ATTRIBUTES, 0,
+                 g_stats_rsvd_sensor),
+
+    SCHEMA_FIXED(PROTOCOL_RESET, COMMAND_MSG, RESET_PROTOCOL_VERSION, 0, g_word_rsvd),
+    SCHEMA_FIXED(PROTOCOL_RESET, COMMAND_MSG, RESET_PROTOCOL_ATTRIBUTES, 0, g_attr_rsvd_domains),
+
+    SCHEMA_FIXED(PROTOCOL_VOLTAGE, COMMAND_MSG, VOLTAGE_PROTOCOL_VERSION, 0, g_word_rsvd),
+    SCHEMA_FIXED(PROTOCOL_VOLTAGE, COMMAND_MSG, VOLTAGE_PROTOCOL_ATTRIBUTES, 0,
+                 g_attr_rsvd_domains),
+
+    SCHEMA_FIXED(PROTOCOL_POWERCAP, COMMAND_MSG, POWERCAP_PROTOCOL_VERSION, 0, g_word_rsvd),
+    SCHEMA_FIXED(PROTOCOL_POWERCAP, COMMAND_MSG, POWERCAP_PROTOCOL_ATTRIBUTES, 0,
+                 g_attr_rsvd_domains),
+};
+
+/**
+  @brief   This API returns the schema of a message
+           1. Caller       -  VAL and the mocker.
+  @param   msg_hdr  message header, the token is ignored
+  @return  schema, NULL if the message has none
+**/
+const VAL_SCHEMA_MSG_s *val_schema_find(uint32_t msg_hdr)
+{
+    uint32_t i;
+
+    msg_hdr &= VAL_SCHEMA_HDR_MASK;
+    for (i = 0; i < NUM_ELEMS(g_schema_table); i++)
+    {
+        if (g_schema_table[i].msg_hdr == msg_hdr)
+            return &g_schema_table[i];
+    }
+
+    return NULL;
+}
+
+/**
+  @brief   This API checks the number of parameters of a command against its
+           schema
+           1. Caller       -  VAL and the mocker.
+  @param   msg_hdr     command header, the token is ignored
+  @param   num_params  number of parameters sent
+  @return  VAL_SCHEMA_OK, VAL_SCHEMA_UNKNOWN or VAL_SCHEMA_BAD_COUNT
+**/
+uint32_t val_schema_check_params(uint32_t msg_hdr, size_t num_params)
+{
+    const VAL_SCHEMA_MSG_s *schema = val_schema_find(msg_hdr);
+
+    if (schema == NULL)
+        return VAL_SCHEMA_UNKNOWN;
+
+    return (num_params == schema->num_params) ? VAL_SCHEMA_OK : VAL_SCHEMA_BAD_COUNT;
+}
+
+/**
+  @brief   This API checks the return values of a successful message against
+           its schema, the count and every reserved bit in one pass
+           1. Caller       -  VAL and the mocker.
+  @param   msg_hdr      message header, the token is ignored
+  @param   num_returns  number of return values received
+  @param   returns      return values
+  @param   result       outcome, the first fault found
+  @return  VAL_SCHEMA_OK or the fault, as in result->error
+**/
+uint32_t val_schema_decode(uint32_t msg_hdr, size_t num_returns, const uint32_t *returns,
+                           VAL_SCHEMA_RESULT_s *result)
+{
+    const VAL_SCHEMA_MSG_s *schema = val_schema_find(msg_hdr);
+    uint32_t i, mask;
+
+    result->error = VAL_SCHEMA_OK;
+    result->expected_count = 0;
+    result->num_entries = 0;
+    result->word = 0;
+    result->reserved_bits = 0;
+
+    if (schema == NULL) {
+        result->error = VAL_SCHEMA_UNKNOWN;
+        return result->error;
+    }
+
+    result->expected_count = schema->num_returns;
+    if ((schema->entry_words != 0) && (num_returns > schema->count_word)) {
+        result->num_entries = VAL_SCHEMA_BITS_(returns[schema->count_word], schema->count_low,
+                                               schema->count_high);
+        result->expected_count += result->num_entries * schema->entry_words;
+    }
+
+    if (num_returns != result->expected_count) {
+        result->error = VAL_SCHEMA_BAD_COUNT;
+        return result->error;
+    }
+
+    for (i = 0; i < num_returns; i++)
+    {
+        if (i < schema->num_returns)
+            mask = schema->reserved ? schema->reserved[i] : 0;
+        else
+            mask = schema->entry_reserved ?
+                   schema->entry_reserved[(i - schema->num_returns) % schema->entry_words] : 0;
+
+        if (returns[i] & mask) {
+            result->error = VAL_SCHEMA_RESERVED_SET;
+            result->word = i;
+            result->reserved_bits = returns[i] & mask;
+            return result->error;
+        }
+    }
+
+    return VAL_SCHEMA_OK;
+}
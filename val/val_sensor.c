@@ -33,10 +33,10 @@ uint32_t val_sensor_execute_tests(void)
     val_memset((void *)&g_sensor_info_table, 0, sizeof(g_sensor_info_table));
 
     if (val_agent_check_protocol_support(PROTOCOL_SENSOR)) {
-        if (RUN_TEST(sensor_query_protocol_version(&version)))
+        if (RUN_SETUP_TEST(sensor_query_protocol_version(&version)))
             return VAL_STATUS_FAIL;
 
-        RUN_TEST(sensor_query_protocol_attributes());
+        RUN_SETUP_TEST(sensor_query_protocol_attributes());
         RUN_TEST(sensor_query_mandatory_command_support());
         RUN_TEST(sensor_invalid_messageid_call());
         RUN_TEST(sensor_trip_point_nfy_event_ctrl_check());
@@ -51,20 +51,23 @@ uint32_t val_sensor_execute_tests(void)
         RUN_TEST(sensor_reading_get_async_mode_not_supported());
 
         if (version == SENSOR_PROTOCOL_VERSION_1)
-            RUN_TEST(sensor_query_description_get());
+            RUN_SETUP_TEST(sensor_query_description_get());
 
         if (version == SENSOR_PROTOCOL_VERSION_2) {
-            RUN_TEST(sensor_query_description_get_scmi_v3());
+            RUN_SETUP_TEST(sensor_query_description_get_scmi_v3());
             RUN_TEST(sensor_axis_description_check());
             RUN_TEST(sensor_axis_desc_invalid_id_check());
             RUN_TEST(sensor_supported_update_intervals_check());
             RUN_TEST(sensor_update_interval_invalid_id_check());
-            RUN_TEST(sensor_read_configuration_check());
+            RUN_SETUP_TEST(sensor_read_configuration_check());
             RUN_TEST(sensor_read_configuration_invalid_id_check());
             RUN_TEST(sensor_set_configuration_check());
             RUN_TEST(sensor_set_configuration_invalid_id_check());
             RUN_TEST(sensor_request_sensor_notification_check());
             RUN_TEST(sensor_request_notification_invalid_id_check());
+            RUN_TEST(sensor_multi_axis_reading_capture());
+            RUN_TEST(sensor_timestamp_clock_correlation());
+            RUN_TEST(sensor_trip_point_notification_storm());
         }
     }
     else
@@ -74,6 +77,39 @@ uint32_t val_sensor_execute_tests(void)
     return VAL_STATUS_PASS;
 }
 
+/**
+  @brief   This API is called from soak runs to execute the state restoring
+           subset of sensor tests. Info table is kept from the compliance run.
+  @param   none
+  @return  number of failed tests
+**/
+uint32_t val_sensor_execute_soak_tests(void)
+{
+    uint32_t version = 0;
+    uint32_t num_fail = 0;
+
+    if (val_agent_check_protocol_support(PROTOCOL_SENSOR)) {
+        if (RUN_SOAK_TEST(sensor_query_protocol_version(&version)))
+            return 1;
+
+        num_fail += RUN_SOAK_TEST(sensor_query_protocol_attributes());
+        num_fail += RUN_SOAK_TEST(sensor_reading_get_sync_mode());
+        num_fail += RUN_SOAK_TEST(sensor_reading_get_async_mode());
+
+        if (version == SENSOR_PROTOCOL_VERSION_1)
+            num_fail += RUN_SOAK_TEST(sensor_query_description_get());
+
+        if (version == SENSOR_PROTOCOL_VERSION_2) {
+            num_fail += RUN_SOAK_TEST(sensor_query_description_get_scmi_v3());
+            num_fail += RUN_SOAK_TEST(sensor_read_configuration_check());
+            num_fail += RUN_SOAK_TEST(sensor_set_configuration_check());
+            num_fail += RUN_SOAK_TEST(sensor_request_sensor_notification_check());
+        }
+    }
+
+    return num_fail;
+}
+
 /**
   @brief   This API is used to set sensor protocol info
            1. Caller       -  Test Suite.
@@ -147,6 +183,10 @@ uint32_t val_sensor_get_info(uint32_t param_identifier)
 **/
 void val_sensor_save_desc_info(uint32_t param_identifier, uint32_t sensor_id, uint32_t param_value)
 {
+    /* Sensors beyond a table reduced with MAX_NUM_OF_SENSORS are not recorded */
+    if (sensor_id >= MAX_NUM_OF_SENSORS)
+        return;
+
     switch (param_identifier)
     {
     case SENSOR_NUM_OF_TRIP_POINTS:
@@ -171,6 +211,10 @@ void val_sensor_save_desc_info(uint32_t param_identifier, uint32_t sensor_id, ui
 uint32_t val_sensor_get_desc_info(uint32_t param_identifier, uint32_t sensor_id)
 {
     uint32_t param_value = 0;
+
+    if (sensor_id >= MAX_NUM_OF_SENSORS)
+        return param_value;
+
     switch (param_identifier)
     {
     case SENSOR_NUM_OF_TRIP_POINTS:
@@ -226,6 +270,16 @@ uint32_t val_sensor_get_expected_stats_addr_len(void)
     return pal_sensor_get_expected_stats_addr_len();
 }
 
+/**
+  @brief   This API is used for checking the sensor timestamp clock drift
+  @param   drift_ppb  expected drift against the agent clock, in ppb
+  @return  VAL_STATUS_PASS if the platform knows its drift, else skip
+**/
+uint32_t val_sensor_get_expected_clock_drift(int32_t *drift_ppb)
+{
+    return pal_sensor_get_expected_clock_drift(drift_ppb);
+}
+
 /**
   @brief   This API is used to set extended sensor protocol info
            1. Caller       -  Test Suite.
@@ -237,6 +291,10 @@ uint32_t val_sensor_get_expected_stats_addr_len(void)
 **/
 void val_sensor_ext_save_desc_info(uint32_t param_identifier, uint32_t sensor_id, uint32_t param_value)
 {
+    /* Sensors beyond a table reduced with MAX_NUM_OF_SENSORS are not recorded */
+    if (sensor_id >= MAX_NUM_OF_SENSORS)
+        return;
+
     switch (param_identifier)
     {
     case SENSOR_CONT_NOTIFY_UPDATE_SUPPORT:
@@ -254,6 +312,9 @@ void val_sensor_ext_save_desc_info(uint32_t param_identifier, uint32_t sensor_id
     case SENSOR_STATE:
         g_sensor_info_table.ext_desc_info[sensor_id].sensor_state = param_value;
         break;
+    case SENSOR_TIMESTAMP_EXPONENT:
+        g_sensor_info_table.ext_desc_info[sensor_id].timestamp_exponent = param_value;
+        break;
     default:
         val_print(VAL_PRINT_ERR, "\nUnidentified parameter %d", param_identifier);
     }
@@ -270,6 +331,10 @@ void val_sensor_ext_save_desc_info(uint32_t param_identifier, uint32_t sensor_id
 uint32_t val_sensor_ext_get_desc_info(uint32_t param_identifier, uint32_t sensor_id)
 {
     uint32_t param_value = 0;
+
+    if (sensor_id >= MAX_NUM_OF_SENSORS)
+        return param_value;
+
     switch (param_identifier)
     {
     case SENSOR_CONT_NOTIFY_UPDATE_SUPPORT:
@@ -287,6 +352,9 @@ uint32_t val_sensor_ext_get_desc_info(uint32_t param_identifier, uint32_t sensor
     case SENSOR_STATE:
         param_value = g_sensor_info_table.ext_desc_info[sensor_id].sensor_state;
         break;
+    case SENSOR_TIMESTAMP_EXPONENT:
+        param_value = g_sensor_info_table.ext_desc_info[sensor_id].timestamp_exponent;
+        break;
     default:
         val_print(VAL_PRINT_ERR, "\nUnidentified parameter %d", param_identifier);
     }
@@ -333,4 +401,159 @@ uint32_t val_get_notify_enable_config(uint32_t notify_enable_flag)
     return notify_enable_config;
 }
 
+/**
+  @brief   This API prepares a capture for readings of a sensor
+           1. Caller       -  Test Suite.
+  @param   capture   capture to reset
+  @param   num_axes  readings per sample, 1 for a sensor without axes
+  @return  none
+**/
+void val_sensor_capture_init(SENSOR_CAPTURE_s *capture, uint32_t num_axes)
+{
+    capture->num_axes = (num_axes > SENSOR_CAPTURE_MAX_AXES) ? SENSOR_CAPTURE_MAX_AXES : num_axes;
+    capture->num_samples = 0;
+    capture->num_dropped = 0;
+}
+
+/**
+  @brief   This API decodes the sensor reading structures of a SENSOR_READING_GET
+           response, SENSOR_READING_COMPLETE delayed response or SENSOR_UPDATE
+           notification and appends them as one sample of every axis. Once the
+           capture is full further samples are only counted.
+           1. Caller       -  Test Suite.
+  @param   capture    capture to append to
+  @param   readings   first word of the sensor reading structures
+  @param   num_words  number of words from readings to the end of the message
+  @return  VAL_STATUS_FAIL if the words do not hold one reading per axis
+**/
+uint32_t val_sensor_capture_add(SENSOR_CAPTURE_s *capture, const uint32_t *readings,
+                                uint32_t num_words)
+{
+    uint32_t axis, sample;
+    const uint32_t *reading;
+
+    if (num_words != (capture->num_axes * SENSOR_READING_WORDS))
+        return VAL_STATUS_FAIL;
+
+    if (capture->num_samples == SENSOR_CAPTURE_MAX_SAMPLES) {
+        capture->num_dropped++;
+        return VAL_STATUS_PASS;
+    }
+
+    sample = capture->num_samples++;
+    for (axis = 0; axis < capture->num_axes; axis++)
+    {
+        reading = &readings[axis * SENSOR_READING_WORDS];
+        capture->value[axis][sample] = (int64_t)
+            (((uint64_t)reading[SENSOR_READING_VAL_HIGH_OFFSET] << 32) |
+             reading[SENSOR_READING_VAL_LOW_OFFSET]);
+        capture->timestamp[axis][sample] =
+            ((uint64_t)reading[SENSOR_READING_TS_HIGH_OFFSET] << 32) |
+            reading[SENSOR_READING_TS_LOW_OFFSET];
+    }
+
+    return VAL_STATUS_PASS;
+}
+
+/**
+  @brief   This function returns the integer square root of a value
+  @param   value  input value
+  @return  largest root whose square does not exceed value
+**/
+static uint64_t val_sensor_isqrt(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ull << 62;
+
+    while (bit > value)
+        bit >>= 2;
+
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else
+            root >>= 1;
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+/**
+  @brief   This API computes min, max, mean and standard deviation of one axis
+           over the captured samples, in raw sensor units. Deviations from the
+           mean are clamped to 32 bits so the variance cannot overflow.
+           1. Caller       -  Test Suite.
+  @param   capture  capture holding the samples
+  @param   axis     axis index
+  @param   stats    statistics of the axis
+  @return  none
+**/
+void val_sensor_capture_stats(const SENSOR_CAPTURE_s *capture, uint32_t axis,
+                              SENSOR_AXIS_STATS_s *stats)
+{
+    const int64_t *value = capture->value[axis];
+    uint32_t num_samples = capture->num_samples;
+    uint32_t i;
+    int64_t sum = 0;
+    uint64_t deviation, square, variance = 0, remainder = 0;
+
+    val_memset(stats, 0, sizeof(*stats));
+    if (num_samples == 0)
+        return;
+
+    stats->min = value[0];
+    stats->max = value[0];
+    for (i = 0; i < num_samples; i++)
+    {
+        if (value[i] < stats->min)
+            stats->min = value[i];
+        if (value[i] > stats->max)
+            stats->max = value[i];
+        sum += value[i];
+    }
+    stats->mean = sum / (int64_t)num_samples;
+
+    /* Average the squares as quotient and remainder so the sum cannot overflow */
+    for (i = 0; i < num_samples; i++)
+    {
+        deviation = (value[i] > stats->mean) ? (uint64_t)(value[i] - stats->mean) :
+                                               (uint64_t)(stats->mean - value[i]);
+        if (deviation > 0xFFFFFFFFull)
+            deviation = 0xFFFFFFFFull;
+        square = deviation * deviation;
+        variance += square / num_samples;
+        remainder += square % num_samples;
+        if (remainder >= num_samples) {
+            variance += remainder / num_samples;
+            remainder %= num_samples;
+        }
+    }
+    stats->stddev = val_sensor_isqrt(variance);
+}
+
+/**
+  @brief   This API converts a sensor timestamp to nanoseconds using the
+           timestamp exponent field of the sensor descriptor
+           1. Caller       -  Test Suite.
+  @param   timestamp           timestamp in sensor units
+  @param   timestamp_exponent  5 bit two's complement power of ten, in seconds
+  @return  timestamp in nanoseconds
+**/
+uint64_t val_sensor_timestamp_to_ns(uint64_t timestamp, uint32_t timestamp_exponent)
+{
+    int32_t exponent = (int32_t)timestamp_exponent;
+
+    if (exponent & (1 << (SENSOR_TIMESTAMP_EXP_BITS - 1)))
+        exponent -= (1 << SENSOR_TIMESTAMP_EXP_BITS);
+
+    for (; exponent > SENSOR_TIMESTAMP_EXP_NS; exponent--)
+        timestamp *= 10;
+    for (; exponent < SENSOR_TIMESTAMP_EXP_NS; exponent++)
+        timestamp /= 10;
+
+    return timestamp;
+}
+
 #endif
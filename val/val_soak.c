@@ -0,0 +1,320 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_benchmark.h"
+#include "val_soak.h"
+
+typedef struct {
+    uint32_t protocol_id;
+    uint32_t (*execute_soak_tests)(void);
+} SOAK_PROTOCOL_s;
+
+static const SOAK_PROTOCOL_s g_soak_protocol_list[] = {
+    {PROTOCOL_BASE, val_base_execute_soak_tests},
+#ifdef POWER_DOMAIN_PROTOCOL
+    {PROTOCOL_POWER_DOMAIN, val_power_domain_execute_soak_tests},
+#endif
+#ifdef SYSTEM_POWER_PROTOCOL
+    {PROTOCOL_SYSTEM_POWER, val_system_power_execute_soak_tests},
+#endif
+#ifdef PERFORMANCE_PROTOCOL
+    {PROTOCOL_PERFORMANCE, val_performance_execute_soak_tests},
+#endif
+#ifdef CLOCK_PROTOCOL
+    {PROTOCOL_CLOCK, val_clock_execute_soak_tests},
+#endif
+#ifdef SENSOR_PROTOCOL
+    {PROTOCOL_SENSOR, val_sensor_execute_soak_tests},
+#endif
+#ifdef RESET_PROTOCOL
+    {PROTOCOL_RESET, val_reset_execute_soak_tests},
+#endif
+#ifdef VOLTAGE_PROTOCOL
+    {PROTOCOL_VOLTAGE, val_voltage_execute_soak_tests},
+#endif
+#ifdef POWERCAP_PROTOCOL
+    {PROTOCOL_POWERCAP, val_powercap_execute_soak_tests},
+#endif
+};
+
+static uint32_t g_soak_interval_errors[VAL_NUM_PROTOCOLS];
+static uint32_t g_soak_total_errors;
+static uint32_t g_soak_drift_events;
+static SOAK_DRIFT_HISTORY_s g_soak_drift[VAL_NUM_PROTOCOLS + 1];
+static VAL_HIST_s g_soak_interval_all;
+static VAL_HIST_s g_soak_total_all;
+
+/**
+  @brief   This API fills a soak configuration with the build time defaults
+           1. Caller       -  App layer.
+  @param   config  soak configuration
+  @return  none
+**/
+void val_soak_get_default_config(SOAK_CONFIG_s *config)
+{
+    config->duration_sec = SOAK_DURATION_SEC;
+    config->interval_sec = SOAK_INTERVAL_SEC;
+    config->max_iterations = SOAK_MAX_ITERATIONS;
+    config->drift_window = SOAK_DEFAULT_DRIFT_WINDOW;
+    config->drift_threshold_pct = SOAK_DEFAULT_DRIFT_THRESHOLD;
+}
+
+/**
+  @brief   This function appends interval latencies to a drift history,
+           dropping the oldest entry once the window is full
+  @param   history  drift history
+  @param   window   number of intervals kept
+  @param   mean     interval mean latency
+  @param   p99      interval tail latency
+  @return  none
+**/
+static void val_soak_drift_push(SOAK_DRIFT_HISTORY_s *history, uint32_t window,
+                                uint64_t mean, uint64_t p99)
+{
+    uint32_t i;
+
+    if (history->num_entries == window) {
+        for (i = 1; i < window; i++) {
+            history->mean[i - 1] = history->mean[i];
+            history->p99[i - 1] = history->p99[i];
+        }
+        history->num_entries--;
+    }
+
+    history->mean[history->num_entries] = mean;
+    history->p99[history->num_entries] = p99;
+    history->num_entries++;
+}
+
+/**
+  @brief   This function checks a full window of samples for monotonic drift.
+           Drift is a strictly rising series whose last value is at least
+           threshold percent above its first value. Percentiles only move
+           between histogram buckets, so a flat stretch or a single bucket
+           step is never taken as drift.
+  @param   series     samples, oldest first
+  @param   count      number of samples
+  @param   threshold  rise in percent
+  @return  rise in percent when drifting, 0 otherwise
+**/
+static uint32_t val_soak_drift_check(uint64_t *series, uint32_t count, uint32_t threshold)
+{
+    uint32_t i;
+
+    if (series[0] == 0)
+        return 0;
+
+    for (i = 1; i < count; i++) {
+        if (series[i] <= series[i - 1])
+            return 0;
+    }
+
+    if ((series[count - 1] * 100) < (series[0] * (100 + threshold)))
+        return 0;
+
+    return (uint32_t)(((series[count - 1] - series[0]) * 100) / series[0]);
+}
+
+/**
+  @brief   This function records the interval mean and p99 latency and
+           reports drift
+  @param   config  soak configuration
+  @param   slot    protocol slot or SOAK_ALL_PROTOCOLS
+  @param   name    printable name of the slot
+  @param   hist    interval latency histogram of the slot
+  @return  number of drift events detected
+**/
+static uint32_t val_soak_drift_update(SOAK_CONFIG_s *config, uint32_t slot, char *name,
+                                      VAL_HIST_s *hist)
+{
+    SOAK_DRIFT_HISTORY_s *history = &g_soak_drift[slot];
+    uint32_t rise, num_events = 0;
+
+    if (hist->count == 0)
+        return 0;
+
+    val_soak_drift_push(history, config->drift_window, val_hist_mean(hist),
+                        val_hist_percentile(hist, 99));
+
+    if (history->num_entries < config->drift_window)
+        return 0;
+
+    rise = val_soak_drift_check(history->mean, history->num_entries, config->drift_threshold_pct);
+    if (rise) {
+        val_print(VAL_PRINT_ERR, "\n       DRIFT %-12s: mean rose %d%% over %d intervals",
+                  name, rise, history->num_entries);
+        num_events++;
+    }
+
+    rise = val_soak_drift_check(history->p99, history->num_entries, config->drift_threshold_pct);
+    if (rise) {
+        val_print(VAL_PRINT_ERR, "\n       DRIFT %-12s: p99 rose %d%% over %d intervals",
+                  name, rise, history->num_entries);
+        num_events++;
+    }
+
+    return num_events;
+}
+
+/**
+  @brief   This function prints the latency and error report of one interval
+           and resets the interval counters
+  @param   config      soak configuration
+  @param   interval    interval number
+  @param   elapsed_ns  time since the soak run started
+  @param   iterations  iterations completed in this interval
+  @return  none
+**/
+static void val_soak_report_interval(SOAK_CONFIG_s *config, uint32_t interval,
+                                     uint64_t elapsed_ns, uint32_t iterations)
+{
+    uint32_t i, protocol_id, interval_errors = 0;
+    uint32_t elapsed_sec = (uint32_t)(elapsed_ns / NS_PER_SEC);
+    VAL_HIST_s *hist;
+
+    for (i = 0; i < NUM_ELEMS(g_soak_protocol_list); i++)
+        interval_errors += g_soak_interval_errors[g_soak_protocol_list[i].protocol_id -
+                                                  PROTOCOL_BASE];
+
+    val_print(VAL_PRINT_ERR, "\n\n     SOAK INTERVAL %d [%02d:%02d:%02d] ITERATIONS: %d ERRORS: %d",
+              interval, elapsed_sec / 3600, (elapsed_sec / 60) % 60, elapsed_sec % 60,
+              iterations, interval_errors);
+
+    val_hist_reset(&g_soak_interval_all);
+    for (i = 0; i < NUM_ELEMS(g_soak_protocol_list); i++) {
+        protocol_id = g_soak_protocol_list[i].protocol_id;
+        hist = val_latency_get_protocol_hist(protocol_id);
+
+        val_hist_print(VAL_PRINT_ERR, val_get_protocol_str(protocol_id), hist);
+        if (g_soak_interval_errors[protocol_id - PROTOCOL_BASE])
+            val_print(VAL_PRINT_ERR, " err=%d", g_soak_interval_errors[protocol_id - PROTOCOL_BASE]);
+
+        g_soak_drift_events += val_soak_drift_update(config, protocol_id - PROTOCOL_BASE,
+                                                     val_get_protocol_str(protocol_id), hist);
+        val_hist_merge(&g_soak_interval_all, hist);
+        g_soak_interval_errors[protocol_id - PROTOCOL_BASE] = 0;
+    }
+
+    val_hist_print(VAL_PRINT_ERR, "ALL", &g_soak_interval_all);
+    val_hist_print_buckets(VAL_PRINT_TEST, &g_soak_interval_all);
+    g_soak_drift_events += val_soak_drift_update(config, SOAK_ALL_PROTOCOLS, "ALL",
+                                                 &g_soak_interval_all);
+
+    val_hist_merge(&g_soak_total_all, &g_soak_interval_all);
+    g_soak_total_errors += interval_errors;
+    val_latency_reset();
+}
+
+/**
+  @brief   This API runs the state restoring subset of the compliance tests in
+           a loop for the configured duration, reporting latency histograms,
+           error counts and latency drift for every interval.
+           Must be called after the compliance run so that the protocol info
+           tables are populated. If the platform timer is not implemented the
+           interval and duration are counted in iterations instead.
+           1. Caller       -  App layer.
+  @param   config  soak configuration
+  @return  VAL_STATUS_PASS if no error or drift was seen, VAL_STATUS_FAIL otherwise
+**/
+uint32_t val_soak_execute(SOAK_CONFIG_s *config)
+{
+    uint64_t start_time, interval_start, now, interval_ns, duration_ns;
+    uint32_t i, protocol_id, prev_level, timer_available;
+    uint32_t iteration = 0, interval = 0, interval_iterations = 0;
+
+    if ((config->duration_sec == 0) && (config->max_iterations == 0))
+        return VAL_STATUS_SKIP;
+
+    if (config->interval_sec == 0)
+        config->interval_sec = SOAK_INTERVAL_SEC;
+    if (config->drift_window > SOAK_MAX_DRIFT_WINDOW)
+        config->drift_window = SOAK_MAX_DRIFT_WINDOW;
+    if (config->drift_window < SOAK_MIN_DRIFT_WINDOW)
+        config->drift_window = SOAK_MIN_DRIFT_WINDOW;
+
+    val_memset((void *)g_soak_interval_errors, 0, sizeof(g_soak_interval_errors));
+    val_memset((void *)g_soak_drift, 0, sizeof(g_soak_drift));
+    val_hist_reset(&g_soak_total_all);
+    g_soak_total_errors = 0;
+    g_soak_drift_events = 0;
+
+    val_print(VAL_PRINT_ERR, "\n\n          *** Starting SOAK run ***");
+    val_print(VAL_PRINT_ERR, "\n     DURATION: %d s INTERVAL: %d s MAX ITERATIONS: %d",
+              config->duration_sec, config->interval_sec, config->max_iterations);
+    val_print(VAL_PRINT_ERR, "\n     DRIFT WINDOW: %d intervals THRESHOLD: %d%%",
+              config->drift_window, config->drift_threshold_pct);
+
+    interval_ns = (uint64_t)config->interval_sec * NS_PER_SEC;
+    duration_ns = (uint64_t)config->duration_sec * NS_PER_SEC;
+
+    val_latency_reset();
+    val_latency_record_enable(1);
+
+    start_time = val_get_time_ns();
+    interval_start = start_time;
+    timer_available = 1;
+
+    while (1) {
+        prev_level = val_set_print_level(0);
+        for (i = 0; i < NUM_ELEMS(g_soak_protocol_list); i++) {
+            protocol_id = g_soak_protocol_list[i].protocol_id;
+            g_soak_interval_errors[protocol_id - PROTOCOL_BASE] +=
+                g_soak_protocol_list[i].execute_soak_tests();
+        }
+        val_set_print_level(prev_level);
+
+        iteration++;
+        interval_iterations++;
+        now = val_get_time_ns();
+
+        if ((iteration == 1) && (now == start_time)) {
+            timer_available = 0;
+            val_print(VAL_PRINT_WARN, "\n     Platform timer unavailable, counting iterations");
+        }
+
+        if (timer_available ? ((now - interval_start) >= interval_ns) :
+                              (interval_iterations >= config->interval_sec)) {
+            val_soak_report_interval(config, ++interval, now - start_time, interval_iterations);
+            interval_start = now;
+            interval_iterations = 0;
+        }
+
+        if (config->max_iterations && (iteration >= config->max_iterations))
+            break;
+        /* With only an iteration count there is no duration to stop on */
+        if (config->duration_sec &&
+            (timer_available ? ((now - start_time) >= duration_ns) :
+                               (iteration >= config->duration_sec)))
+            break;
+    }
+
+    if (interval_iterations)
+        val_soak_report_interval(config, ++interval, now - start_time, interval_iterations);
+
+    val_latency_record_enable(0);
+
+    val_print(VAL_PRINT_ERR, "\n\n     SOAK SUMMARY ITERATIONS: %d INTERVALS: %d", iteration, interval);
+    val_print(VAL_PRINT_ERR, "\n     ERRORS: %d DRIFT EVENTS: %d", g_soak_total_errors,
+              g_soak_drift_events);
+    val_hist_print(VAL_PRINT_ERR, "ALL", &g_soak_total_all);
+
+    if (g_soak_total_errors || g_soak_drift_events)
+        return VAL_STATUS_FAIL;
+
+    return VAL_STATUS_PASS;
+}
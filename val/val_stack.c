@@ -0,0 +1,123 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_stack.h"
+
+static uintptr_t g_stack_top;
+static uintptr_t g_stack_limit;
+static uintptr_t g_stack_painted_top;
+static uint32_t g_stack_test_num;
+static uint32_t g_stack_max_used;
+static uint32_t g_stack_max_test_num;
+
+/**
+  @brief   This API records the stack depth the high-water marks are measured
+           from and the lowest address the stack is painted down to
+           1. Caller       -  VAL initialization, when built with STACK_USAGE.
+  @param   none
+  @return  none
+**/
+void val_stack_init(void)
+{
+    volatile uint32_t marker;
+
+    g_stack_top = (uintptr_t)&marker;
+    g_stack_limit = (uintptr_t)pal_get_stack_limit();
+    g_stack_limit = (g_stack_limit + sizeof(uint32_t) - 1) & ~(uintptr_t)(sizeof(uint32_t) - 1);
+    if (g_stack_limit >= g_stack_top)
+        g_stack_limit = 0;
+
+    g_stack_painted_top = 0;
+    g_stack_max_used = 0;
+    g_stack_max_test_num = 0;
+}
+
+/**
+  @brief   This API paints the unused stack below the caller, leaving a guard
+           for the frame of this function
+           1. Caller       -  val_test_initialize, when built with STACK_USAGE.
+  @param   test_num  test the next measurement is charged to
+  @return  none
+**/
+void val_stack_paint(uint32_t test_num)
+{
+    volatile uint32_t marker;
+    volatile uint32_t *word;
+    uintptr_t end;
+
+    g_stack_painted_top = 0;
+    g_stack_test_num = test_num;
+    if (!g_stack_limit)
+        return;
+
+    end = ((uintptr_t)&marker - VAL_STACK_GUARD_BYTES) & ~(uintptr_t)(sizeof(uint32_t) - 1);
+    if (end <= g_stack_limit)
+        return;
+
+    for (word = (uint32_t *)g_stack_limit; (uintptr_t)word < end; word++)
+        *word = VAL_STACK_PAINT_WORD;
+    g_stack_painted_top = end;
+}
+
+/**
+  @brief   This API returns the deepest stack use since the last paint, from
+           the depth recorded by val_stack_init, and keeps the run maximum
+           1. Caller       -  val_report_status, when built with STACK_USAGE.
+  @param   none
+  @return  high-water mark in bytes, 0 if the stack was not painted
+**/
+uint32_t val_stack_measure(void)
+{
+    volatile uint32_t *word;
+    uint32_t used;
+
+    if (!g_stack_painted_top)
+        return 0;
+
+    for (word = (uint32_t *)g_stack_limit; (uintptr_t)word < g_stack_painted_top; word++)
+    {
+        if (*word != VAL_STACK_PAINT_WORD)
+            break;
+    }
+
+    used = (uint32_t)(g_stack_top - (uintptr_t)word);
+    if (used > g_stack_max_used) {
+        g_stack_max_used = used;
+        g_stack_max_test_num = g_stack_test_num;
+    }
+
+    return used;
+}
+
+/**
+  @brief   This API prints the deepest stack use of the run and the test that
+           reached it
+           1. Caller       -  App layer, in the test summary.
+  @param   none
+  @return  none
+**/
+void val_stack_report(void)
+{
+    if (!g_stack_max_used)
+        return;
+
+    val_print(VAL_PRINT_ERR, "\n  STACK HIGH-WATER: %d bytes in test %d of %d painted",
+              g_stack_max_used, g_stack_max_test_num, (uint32_t)(g_stack_top - g_stack_limit));
+    if ((g_stack_top - g_stack_max_used) <= g_stack_limit)
+        val_print(VAL_PRINT_ERR, ", stack limit reached");
+}
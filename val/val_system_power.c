@@ -33,15 +33,16 @@ uint32_t val_system_power_execute_tests(void)
     val_memset((void *)&g_system_power_info_table, 0, sizeof(g_system_power_info_table));
 
     if (val_agent_check_protocol_support(PROTOCOL_SYSTEM_POWER)) {
-        if (RUN_TEST(system_power_query_protocol_version(&version)))
+        if (RUN_SETUP_TEST(system_power_query_protocol_version(&version)))
             return VAL_STATUS_FAIL;
 
         RUN_TEST(system_power_query_protocol_attributes());
-        RUN_TEST(system_power_query_mandatory_command_support());
+        RUN_SETUP_TEST(system_power_query_mandatory_command_support());
         RUN_TEST(system_power_invalid_messageid_call());
         RUN_TEST(system_power_state_set_invalid_parameters());
         RUN_TEST(system_power_state_get_check());
         RUN_TEST(system_power_state_notify_invalid_parameters());
+        RUN_TEST(system_power_suspend_resume_latency());
     }
     else
         val_print(VAL_PRINT_ERR, "\n Calling agent have no access to SYSTEM POWER protocol");
@@ -49,6 +50,29 @@ uint32_t val_system_power_execute_tests(void)
     return VAL_STATUS_PASS;
 }
 
+/**
+  @brief   This API is called from soak runs to execute the state restoring
+           subset of system power tests. Info table is kept from the compliance run.
+  @param   none
+  @return  number of failed tests
+**/
+uint32_t val_system_power_execute_soak_tests(void)
+{
+    uint32_t version = 0;
+    uint32_t num_fail = 0;
+
+    if (val_agent_check_protocol_support(PROTOCOL_SYSTEM_POWER)) {
+        if (RUN_SOAK_TEST(system_power_query_protocol_version(&version)))
+            return 1;
+
+        num_fail += RUN_SOAK_TEST(system_power_query_protocol_attributes());
+        num_fail += RUN_SOAK_TEST(system_power_state_get_check());
+        num_fail += RUN_SOAK_TEST(system_power_state_notify_invalid_parameters());
+    }
+
+    return num_fail;
+}
+
 /**
   @brief   This API is used to set system_power protocol info
            1. Caller       -  Test Suite.
@@ -32,23 +32,24 @@ uint32_t val_voltage_execute_tests(void)
     uint32_t version = 0;
 
     if (val_agent_check_protocol_support(PROTOCOL_VOLTAGE)) {
-        if (RUN_TEST(voltage_query_protocol_version(&version)))
+        if (RUN_SETUP_TEST(voltage_query_protocol_version(&version)))
             return VAL_STATUS_FAIL;
 
-        RUN_TEST(voltage_query_protocol_attributes());
+        RUN_SETUP_TEST(voltage_query_protocol_attributes());
         RUN_TEST(voltage_query_mandatory_command_support());
         RUN_TEST(voltage_invalid_messageid_call());
         RUN_TEST(voltage_query_domain_attributes());
         RUN_TEST(voltage_query_domain_attributes_invalid_id());
-        RUN_TEST(voltage_query_describe_levels());
+        RUN_SETUP_TEST(voltage_query_describe_levels());
         RUN_TEST(voltage_query_describe_level_invalid_voltage_id());
         RUN_TEST(voltage_set_operating_mode());
         RUN_TEST(voltage_invalid_domain_set_operating_mode());
-        RUN_TEST(voltage_query_config_operating_mode());
+        RUN_SETUP_TEST(voltage_query_config_operating_mode());
         RUN_TEST(voltage_set_voltage_level());
         RUN_TEST(voltage_set_voltage_invalid_domain());
         RUN_TEST(voltage_set_invalid_voltage_level());
-        RUN_TEST(voltage_query_current_level());
+        RUN_SETUP_TEST(voltage_query_current_level());
+        RUN_TEST(voltage_level_ramp_benchmark());
 
     }
     else
@@ -57,6 +58,32 @@ uint32_t val_voltage_execute_tests(void)
     return VAL_STATUS_PASS;
 }
 
+/**
+  @brief   This API is called from soak runs to execute the state restoring
+           subset of voltage tests. Info table is kept from the compliance run.
+  @param   none
+  @return  number of failed tests
+**/
+uint32_t val_voltage_execute_soak_tests(void)
+{
+    uint32_t version = 0;
+    uint32_t num_fail = 0;
+
+    if (val_agent_check_protocol_support(PROTOCOL_VOLTAGE)) {
+        if (RUN_SOAK_TEST(voltage_query_protocol_version(&version)))
+            return 1;
+
+        num_fail += RUN_SOAK_TEST(voltage_query_protocol_attributes());
+        num_fail += RUN_SOAK_TEST(voltage_query_domain_attributes());
+        num_fail += RUN_SOAK_TEST(voltage_query_describe_levels());
+        num_fail += RUN_SOAK_TEST(voltage_query_config_operating_mode());
+        num_fail += RUN_SOAK_TEST(voltage_set_voltage_level());
+        num_fail += RUN_SOAK_TEST(voltage_query_current_level());
+    }
+
+    return num_fail;
+}
+
 
 /**
   @brief   This API is used for checking num of voltage domain
@@ -79,6 +106,10 @@ uint32_t val_voltage_get_expected_num_domains(void)
 **/
 void val_voltage_save_info(uint32_t param_identifier, uint32_t domain_id, uint32_t param_value)
 {
+    /* Domains beyond a table reduced with MAX_NUM_OF_VOLTAGE_DOMAINS are not recorded */
+    if ((param_identifier != NUM_VOLTAGE_DOMAINS) && (domain_id >= MAX_NUM_OF_VOLTAGE_DOMAINS))
+        return;
+
     switch (param_identifier)
     {
     case NUM_VOLTAGE_DOMAINS:
@@ -97,7 +128,7 @@ void val_voltage_save_info(uint32_t param_identifier, uint32_t domain_id, uint32
         g_voltage_info_table.domain_info[domain_id].highest_voltage_level = param_value;
         break;
     case VOLTAGE_STEP_SIZE:
-        g_voltage_info_table.domain_info[domain_id].highest_voltage_level = param_value;
+        g_voltage_info_table.domain_info[domain_id].step_voltage_level = param_value;
         break;
     case OPERATIONAL_VOLTAGE:
         g_voltage_info_table.domain_info[domain_id].operational_voltage = param_value;
@@ -116,6 +147,9 @@ void val_voltage_save_info(uint32_t param_identifier, uint32_t domain_id, uint32
 **/
 void val_voltage_save_level(uint32_t domain_id, uint32_t level_index, uint32_t voltage)
 {
+    if ((domain_id >= MAX_NUM_OF_VOLTAGE_DOMAINS) || (level_index >= MAX_NUMBER_VOLTAGE_LEVELS))
+        return;
+
     g_voltage_info_table.domain_info[domain_id].voltage_array[level_index] = voltage;
 }
 
@@ -129,6 +163,9 @@ void val_voltage_save_level(uint32_t domain_id, uint32_t level_index, uint32_t v
 **/
 uint32_t val_voltage_get_level(uint32_t domain_id, uint32_t level_index)
 {
+    if ((domain_id >= MAX_NUM_OF_VOLTAGE_DOMAINS) || (level_index >= MAX_NUMBER_VOLTAGE_LEVELS))
+        return 0;
+
     return g_voltage_info_table.domain_info[domain_id].voltage_array[level_index];
 }
 
@@ -144,6 +181,9 @@ uint32_t val_voltage_get_info(uint32_t param_identifier, uint32_t domain_id)
 {
     uint32_t param_value = 0;
 
+    if ((param_identifier != NUM_VOLTAGE_DOMAINS) && (domain_id >= MAX_NUM_OF_VOLTAGE_DOMAINS))
+        return param_value;
+
     switch (param_identifier)
     {
     case NUM_VOLTAGE_DOMAINS:
@@ -162,7 +202,7 @@ uint32_t val_voltage_get_info(uint32_t param_identifier, uint32_t domain_id)
         param_value = g_voltage_info_table.domain_info[domain_id].highest_voltage_level;
         break;
     case VOLTAGE_STEP_SIZE:
-        param_value = g_voltage_info_table.domain_info[domain_id].highest_voltage_level;
+        param_value = g_voltage_info_table.domain_info[domain_id].step_voltage_level;
         break;
     default:
         val_print(VAL_PRINT_ERR, "\nUnidentified parameter %d", param_identifier);
@@ -0,0 +1,325 @@
+/** @file
+ * Copyright (c) 2021, Arm Limited or its affiliates. All rights reserved.
+ * SPDX-License-Identifier : Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+**/
+
+#include "val_interface.h"
+#include "val_benchmark.h"
+#include "val_watchdog.h"
+
+static uint64_t g_watchdog_budget_ns;
+static uint64_t g_watchdog_start_ns;
+static uint32_t g_watchdog_expired;
+
+static const char *g_checkpoint_file;
+static uint32_t g_checkpoint_key[CHECKPOINT_MAX_ENTRIES];
+static uint32_t g_checkpoint_outcome[CHECKPOINT_MAX_ENTRIES];
+static uint32_t g_checkpoint_count;
+static uint32_t g_checkpoint_key_running;
+static uint32_t g_checkpoint_ordinal;
+static uint32_t g_checkpoint_restored;
+static uint32_t g_checkpoint_setup_test;
+static uint32_t g_checkpoint_replay;
+static uint32_t g_checkpoint_print_level;
+static uint32_t g_checkpoint_progress;
+
+/**
+  @brief   This API fills a watchdog configuration with the build time defaults
+           1. Caller       -  App layer.
+  @param   config  watchdog configuration
+  @return  none
+**/
+void val_watchdog_get_default_config(WATCHDOG_CONFIG_s *config)
+{
+    config->test_timeout_ms = TEST_TIMEOUT_MS;
+    config->checkpoint_file = NULL;
+}
+
+/**
+  @brief   This function returns the outcome recorded for a test in the checkpoint
+  @param   key  test key, see CHECKPOINT_KEY
+  @return  recorded outcome, CHECKPOINT_STARTED if the test has not finished
+**/
+static uint32_t val_checkpoint_find(uint32_t key)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_checkpoint_count; i++)
+    {
+        if (g_checkpoint_key[i] == key)
+            return g_checkpoint_outcome[i];
+    }
+
+    return CHECKPOINT_STARTED;
+}
+
+/**
+  @brief   This function loads the checkpoint of an earlier run, keeping the
+           last outcome of every test. A test that was started but never
+           finished brought the earlier run down and is marked aborted,
+           unless it saved progress to carry on from.
+  @param   file  checkpoint file
+  @return  none
+**/
+static void val_checkpoint_load(const char *file)
+{
+    uint32_t key[CHECKPOINT_MAX_ENTRIES];
+    uint32_t outcome[CHECKPOINT_MAX_ENTRIES];
+    uint32_t num_entries, i, j;
+
+    num_entries = pal_checkpoint_load(file, key, outcome, CHECKPOINT_MAX_ENTRIES);
+
+    g_checkpoint_count = 0;
+    for (i = 0; i < num_entries; i++)
+    {
+        for (j = 0; j < g_checkpoint_count; j++)
+        {
+            if (g_checkpoint_key[j] == key[i])
+                break;
+        }
+
+        if (j == g_checkpoint_count)
+            g_checkpoint_key[g_checkpoint_count++] = key[i];
+        g_checkpoint_outcome[j] = outcome[i];
+    }
+
+    for (j = 0; j < g_checkpoint_count; j++)
+    {
+        if (g_checkpoint_outcome[j] == CHECKPOINT_STARTED)
+            g_checkpoint_outcome[j] = CHECKPOINT_ABORTED;
+    }
+}
+
+/**
+  @brief   This API sets up the per test watchdog and, if a checkpoint file is
+           given, loads the results of an earlier run to resume from
+           1. Caller       -  App layer.
+  @param   config  watchdog configuration
+  @return  VAL_STATUS_PASS
+**/
+uint32_t val_watchdog_init(WATCHDOG_CONFIG_s *config)
+{
+    g_watchdog_budget_ns = (uint64_t)config->test_timeout_ms * NS_PER_MS;
+    g_watchdog_start_ns = 0;
+    g_checkpoint_file = config->checkpoint_file;
+    g_checkpoint_count = 0;
+    g_checkpoint_ordinal = 0;
+
+    if (g_checkpoint_file == NULL)
+        return VAL_STATUS_PASS;
+
+    val_checkpoint_load(g_checkpoint_file);
+    if (g_checkpoint_count)
+        val_print(VAL_PRINT_ERR, "\n\n        Resuming from %s, %d tests recorded",
+                  g_checkpoint_file, g_checkpoint_count);
+
+    return VAL_STATUS_PASS;
+}
+
+/**
+  @brief   This API ends checkpointing once the compliance run has finished,
+           so the next run starts from the first test
+           1. Caller       -  App layer.
+  @param   none
+  @return  none
+**/
+void val_watchdog_run_complete(void)
+{
+    if (g_checkpoint_file != NULL)
+        pal_checkpoint_remove(g_checkpoint_file);
+
+    g_checkpoint_file = NULL;
+    g_checkpoint_count = 0;
+}
+
+/**
+  @brief   This API marks the next test as one whose discovered information
+           is used by later tests. On resume it is run again silently instead
+           of being skipped.
+           1. Caller       -  RUN_SETUP_TEST.
+  @param   none
+  @return  none
+**/
+void val_watchdog_set_setup_test(void)
+{
+    g_checkpoint_setup_test = 1;
+}
+
+/**
+  @brief   This API arms the watchdog for a test and checks the checkpoint
+           for a result from an earlier run
+           1. Caller       -  val_test_initialize.
+  @param   test_num  test number
+  @return  VAL_STATUS_SKIP if the recorded result is reused, else VAL_STATUS_PASS
+**/
+uint32_t val_watchdog_start(uint32_t test_num)
+{
+    uint32_t setup_test = g_checkpoint_setup_test;
+
+    g_checkpoint_setup_test = 0;
+    g_checkpoint_restored = CHECKPOINT_STARTED;
+    g_checkpoint_progress = 0;
+    g_checkpoint_key_running = CHECKPOINT_KEY(++g_checkpoint_ordinal, test_num);
+    g_watchdog_expired = 0;
+    g_watchdog_start_ns = val_get_time_ns();
+
+    if (g_checkpoint_file == NULL)
+        return VAL_STATUS_PASS;
+
+    g_checkpoint_restored = val_checkpoint_find(g_checkpoint_key_running);
+    if (g_checkpoint_restored == CHECKPOINT_STARTED) {
+        pal_checkpoint_append(g_checkpoint_file, g_checkpoint_key_running, CHECKPOINT_STARTED);
+        return VAL_STATUS_PASS;
+    }
+
+    /* The progress record stays the last one until the test saves more or ends */
+    if (g_checkpoint_restored >= CHECKPOINT_PROGRESS) {
+        g_checkpoint_progress = g_checkpoint_restored - CHECKPOINT_PROGRESS;
+        g_checkpoint_restored = CHECKPOINT_STARTED;
+        val_print(VAL_PRINT_TEST, "\n       Resuming from progress 0x%x saved in checkpoint",
+                  g_checkpoint_progress);
+        return VAL_STATUS_PASS;
+    }
+
+    if (setup_test && (g_checkpoint_restored != CHECKPOINT_TIMED_OUT) &&
+        (g_checkpoint_restored != CHECKPOINT_ABORTED)) {
+        g_checkpoint_print_level = val_set_print_level(0);
+        g_checkpoint_replay = 1;
+        return VAL_STATUS_PASS;
+    }
+
+    val_print(VAL_PRINT_TEST, "\n       Result restored from checkpoint");
+    return VAL_STATUS_SKIP;
+}
+
+/**
+  @brief   This API checks whether the running test has used up its budget.
+           Once it has, the transport is no longer called so a hung platform
+           cannot stall the run.
+           1. Caller       -  VAL message APIs.
+  @param   none
+  @return  1 if the budget is exhausted, else 0
+**/
+uint32_t val_watchdog_expired(void)
+{
+    if (g_watchdog_expired)
+        return 1;
+
+    if ((g_watchdog_budget_ns == 0) || (g_watchdog_start_ns == 0))
+        return 0;
+
+    if ((val_get_time_ns() - g_watchdog_start_ns) <= g_watchdog_budget_ns)
+        return 0;
+
+    g_watchdog_expired = 1;
+    val_print(VAL_PRINT_ERR, "\n       WATCHDOG       : %d ms budget exceeded, aborting test",
+              (uint32_t)(g_watchdog_budget_ns / NS_PER_MS));
+
+    return 1;
+}
+
+/**
+  @brief   This API aborts the running test after the transport reported that
+           the platform did not answer. The test is marked timed out and the
+           channel is reset when it ends, as if its budget had run out.
+           1. Caller       -  VAL message APIs.
+  @param   none
+  @return  none
+**/
+void val_watchdog_expire(void)
+{
+    if (g_watchdog_expired)
+        return;
+
+    g_watchdog_expired = 1;
+    val_print(VAL_PRINT_ERR, "\n       WATCHDOG       : transport error, aborting test");
+}
+
+/**
+  @brief   This API disarms the watchdog and records the test outcome. A test
+           that overran its budget is marked timed out and the channel is reset
+           so a late response is not taken for the reply to the next test.
+           1. Caller       -  val_report_status.
+  @param   status  status returned by the test
+  @return  test outcome, CHECKPOINT_PASSED to CHECKPOINT_ABORTED
+**/
+uint32_t val_watchdog_stop(uint32_t status)
+{
+    uint32_t outcome;
+
+    switch (status)
+    {
+    case VAL_STATUS_PASS:
+        outcome = CHECKPOINT_PASSED;
+        break;
+    case VAL_STATUS_SKIP:
+        outcome = CHECKPOINT_SKIPPED;
+        break;
+    default:
+        outcome = CHECKPOINT_FAILED;
+        break;
+    }
+
+    if (g_checkpoint_replay) {
+        val_set_print_level(g_checkpoint_print_level);
+        g_checkpoint_replay = 0;
+    }
+
+    if (g_watchdog_expired || ((g_watchdog_budget_ns != 0) && (g_watchdog_start_ns != 0) &&
+        ((val_get_time_ns() - g_watchdog_start_ns) > g_watchdog_budget_ns))) {
+        outcome = CHECKPOINT_TIMED_OUT;
+        pal_reset_channel();
+    }
+    g_watchdog_start_ns = 0;
+    g_watchdog_expired = 0;
+
+    if (g_checkpoint_restored != CHECKPOINT_STARTED)
+        return g_checkpoint_restored;
+
+    if (g_checkpoint_file != NULL)
+        pal_checkpoint_append(g_checkpoint_file, g_checkpoint_key_running, outcome);
+
+    return outcome;
+}
+
+/**
+  @brief   This API records how far the running test has got, for a test
+           that may take the agent down on purpose, such as a system suspend.
+           If the agent restarts, the test is run again instead of being
+           marked aborted and reads the progress back.
+           1. Caller       -  Test Suite.
+  @param   progress  test defined progress, below 0xFFFFFF00
+  @return  none
+**/
+void val_checkpoint_save_progress(uint32_t progress)
+{
+    if ((g_checkpoint_file == NULL) || (g_checkpoint_restored != CHECKPOINT_STARTED))
+        return;
+
+    pal_checkpoint_append(g_checkpoint_file, g_checkpoint_key_running,
+                          CHECKPOINT_PROGRESS + progress);
+}
+
+/**
+  @brief   This API returns the progress the running test saved in an earlier
+           run that went down before the test finished
+           1. Caller       -  Test Suite.
+  @param   none
+  @return  saved progress, 0 if there is none
+**/
+uint32_t val_checkpoint_get_progress(void)
+{
+    return g_checkpoint_progress;
+}